@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face-link-options.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nfd {
+
+FaceLinkOptions::FaceLinkOptions(const Block& wire)
+{
+  wire.parse();
+  for (const Block& element : wire.elements()) {
+    switch (element.type()) {
+      case tlv::InterestRateLimit:
+        interestRate = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::InterestBurstLimit:
+        interestBurst = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::DataRateLimit:
+        dataRate = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::DataBurstLimit:
+        dataBurst = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::Packing:
+        wantPacking = ndn::encoding::readNonNegativeInteger(element) != 0;
+        break;
+      case tlv::SendQueueTarget:
+        sendQueueTarget = time::nanoseconds(ndn::encoding::readNonNegativeInteger(element));
+        break;
+      case tlv::InterestWeight:
+        interestWeight = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::DataWeight:
+        dataWeight = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::NackWeight:
+        nackWeight = ndn::encoding::readNonNegativeInteger(element);
+        break;
+      case tlv::IngressWeight:
+        ingressWeight = ndn::encoding::readNonNegativeInteger(element);
+        break;
+    }
+  }
+}
+
+Block
+FaceLinkOptions::appendTo(Block wire) const
+{
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+
+  wire.parse();
+  if (interestRate) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::InterestRateLimit, *interestRate));
+  }
+  if (interestBurst) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::InterestBurstLimit, *interestBurst));
+  }
+  if (dataRate) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::DataRateLimit, *dataRate));
+  }
+  if (dataBurst) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::DataBurstLimit, *dataBurst));
+  }
+  if (wantPacking) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::Packing, *wantPacking));
+  }
+  if (sendQueueTarget) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::SendQueueTarget,
+                                               static_cast<uint64_t>(sendQueueTarget->count())));
+  }
+  if (interestWeight) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::InterestWeight, *interestWeight));
+  }
+  if (dataWeight) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::DataWeight, *dataWeight));
+  }
+  if (nackWeight) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::NackWeight, *nackWeight));
+  }
+  if (ingressWeight) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::IngressWeight, *ingressWeight));
+  }
+  wire.encode();
+  return wire;
+}
+
+} // namespace nfd
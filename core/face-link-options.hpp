@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_FACE_LINK_OPTIONS_HPP
+#define NFD_CORE_FACE_LINK_OPTIONS_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of NFD-specific fields appended to face management messages
+ *
+ *  These numbers are even and greater than 31, so that the fields are non-critical and
+ *  can be ignored by ControlParameters and FaceStatus decoders that do not recognize them.
+ */
+enum {
+  InterestRateLimit  = 0xd0,
+  InterestBurstLimit = 0xd2,
+  DataRateLimit      = 0xd4,
+  DataBurstLimit     = 0xd6,
+  Packing            = 0xd8,
+  SendQueueTarget    = 0xda,
+  InterestWeight     = 0xe2,
+  DataWeight         = 0xe4,
+  NackWeight         = 0xe6,
+  IngressWeight      = 0xe8,
+};
+
+} // namespace tlv
+
+/** \brief link service options of a face that ndn-cxx face management messages cannot carry
+ *
+ *  They are appended to the ControlParameters of a faces/update command to change the options
+ *  of a face, and to its response and each FaceStatus of the faces/list and faces/query datasets
+ *  to report the options in effect. A zero rate disables the limit. Packing is enabled by
+ *  a non-zero value. SendQueueTarget is the CoDel target of the send queue in nanoseconds.
+ *  InterestWeight, DataWeight, and NackWeight are the relative weights of these traffic
+ *  classes in the send queue, which must be positive. IngressWeight is the positive weight of the
+ *  face in the ingress scheduler of the forwarder, which unlike the other fields is not a link
+ *  service option and is supported by every face.
+ *
+ *  \code
+ *  InterestRateLimit := INTEREST-RATE-LIMIT-TYPE TLV-LENGTH NonNegativeInteger
+ *  InterestBurstLimit := INTEREST-BURST-LIMIT-TYPE TLV-LENGTH NonNegativeInteger
+ *  DataRateLimit := DATA-RATE-LIMIT-TYPE TLV-LENGTH NonNegativeInteger
+ *  DataBurstLimit := DATA-BURST-LIMIT-TYPE TLV-LENGTH NonNegativeInteger
+ *  Packing := PACKING-TYPE TLV-LENGTH NonNegativeInteger
+ *  SendQueueTarget := SEND-QUEUE-TARGET-TYPE TLV-LENGTH NonNegativeInteger
+ *  InterestWeight := INTEREST-WEIGHT-TYPE TLV-LENGTH NonNegativeInteger
+ *  DataWeight := DATA-WEIGHT-TYPE TLV-LENGTH NonNegativeInteger
+ *  NackWeight := NACK-WEIGHT-TYPE TLV-LENGTH NonNegativeInteger
+ *  IngressWeight := INGRESS-WEIGHT-TYPE TLV-LENGTH NonNegativeInteger
+ *  \endcode
+ */
+class FaceLinkOptions
+{
+public:
+  FaceLinkOptions() = default;
+
+  /** \brief decode the fields among the elements of \p wire, ignoring other elements
+   *  \throw tlv::Error a field is malformed
+   */
+  explicit
+  FaceLinkOptions(const Block& wire);
+
+  /** \return a copy of \p wire with the present fields appended to its elements
+   */
+  Block
+  appendTo(Block wire) const;
+
+  /** \return whether no field is present
+   */
+  bool
+  empty() const
+  {
+    return !hasRateLimits() && !wantPacking && !sendQueueTarget && !hasWeights() &&
+           !ingressWeight;
+  }
+
+  /** \return whether a rate or burst limit is present
+   */
+  bool
+  hasRateLimits() const
+  {
+    return interestRate || interestBurst || dataRate || dataBurst;
+  }
+
+  /** \return whether a traffic class weight is present
+   */
+  bool
+  hasWeights() const
+  {
+    return interestWeight || dataWeight || nackWeight;
+  }
+
+public:
+  optional<uint64_t> interestRate; ///< incoming Interests per second
+  optional<uint64_t> interestBurst; ///< incoming Interests
+  optional<uint64_t> dataRate; ///< octets of outgoing Data per second
+  optional<uint64_t> dataBurst; ///< octets of outgoing Data
+  optional<bool> wantPacking; ///< whether to pack several packets into one datagram
+  optional<time::nanoseconds> sendQueueTarget; ///< CoDel target of the send queue
+  optional<uint64_t> interestWeight; ///< send queue weight of the Interest class
+  optional<uint64_t> dataWeight; ///< send queue weight of the Data class
+  optional<uint64_t> nackWeight; ///< send queue weight of the Nack class
+  optional<uint64_t> ingressWeight; ///< weight of the face in the ingress scheduler
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_FACE_LINK_OPTIONS_HPP
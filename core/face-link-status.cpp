@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face-link-status.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nfd {
+
+FaceLinkStatus::FaceLinkStatus(const Block& wire)
+{
+  wire.parse();
+  for (const Block& element : wire.elements()) {
+    switch (element.type()) {
+      case tlv::SendQueueSojournP50:
+        sojournP50 = time::nanoseconds(ndn::encoding::readNonNegativeInteger(element));
+        break;
+      case tlv::SendQueueSojournP90:
+        sojournP90 = time::nanoseconds(ndn::encoding::readNonNegativeInteger(element));
+        break;
+      case tlv::SendQueueSojournP99:
+        sojournP99 = time::nanoseconds(ndn::encoding::readNonNegativeInteger(element));
+        break;
+    }
+  }
+}
+
+Block
+FaceLinkStatus::appendTo(Block wire) const
+{
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+
+  wire.parse();
+  if (sojournP50) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::SendQueueSojournP50,
+                                               static_cast<uint64_t>(sojournP50->count())));
+  }
+  if (sojournP90) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::SendQueueSojournP90,
+                                               static_cast<uint64_t>(sojournP90->count())));
+  }
+  if (sojournP99) {
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::SendQueueSojournP99,
+                                               static_cast<uint64_t>(sojournP99->count())));
+  }
+  wire.encode();
+  return wire;
+}
+
+} // namespace nfd
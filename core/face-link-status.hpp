@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_FACE_LINK_STATUS_HPP
+#define NFD_CORE_FACE_LINK_STATUS_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of NFD-specific status fields appended to FaceStatus
+ *
+ *  These numbers are even and greater than 31, so that the fields are non-critical and
+ *  can be ignored by FaceStatus decoders that do not recognize them. They follow the numbers
+ *  of the FaceLinkOptions fields.
+ */
+enum {
+  SendQueueSojournP50 = 0xdc,
+  SendQueueSojournP90 = 0xde,
+  SendQueueSojournP99 = 0xe0,
+};
+
+} // namespace tlv
+
+/** \brief link service status of a face that the ndn-cxx FaceStatus cannot carry
+ *
+ *  It is appended to each FaceStatus of the faces/list and faces/query datasets. The fields
+ *  are the 50th, 90th, and 99th percentiles of the time that outgoing LpPackets spent in the
+ *  send queue of the face, in nanoseconds. They are absent if no packet has left the queue.
+ *
+ *  \code
+ *  SendQueueSojournP50 := SEND-QUEUE-SOJOURN-P50-TYPE TLV-LENGTH NonNegativeInteger
+ *  SendQueueSojournP90 := SEND-QUEUE-SOJOURN-P90-TYPE TLV-LENGTH NonNegativeInteger
+ *  SendQueueSojournP99 := SEND-QUEUE-SOJOURN-P99-TYPE TLV-LENGTH NonNegativeInteger
+ *  \endcode
+ */
+class FaceLinkStatus
+{
+public:
+  FaceLinkStatus() = default;
+
+  /** \brief decode the fields among the elements of \p wire, ignoring other elements
+   *  \throw tlv::Error a field is malformed
+   */
+  explicit
+  FaceLinkStatus(const Block& wire);
+
+  /** \return a copy of \p wire with the present fields appended to its elements
+   */
+  Block
+  appendTo(Block wire) const;
+
+  /** \return whether no field is present
+   */
+  bool
+  empty() const
+  {
+    return !sojournP50 && !sojournP90 && !sojournP99;
+  }
+
+public:
+  optional<time::nanoseconds> sojournP50;
+  optional<time::nanoseconds> sojournP90;
+  optional<time::nanoseconds> sojournP99;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_FACE_LINK_STATUS_HPP
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "latency-status.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
+
+namespace nfd {
+
+std::ostream&
+operator<<(std::ostream& os, TraceStage stage)
+{
+  switch (stage) {
+    case TraceStage::RECEIVE:
+      return os << "receive";
+    case TraceStage::INCOMING:
+      return os << "incoming";
+    case TraceStage::CS_LOOKUP:
+      return os << "cs-lookup";
+    case TraceStage::STRATEGY:
+      return os << "strategy";
+    case TraceStage::SEND:
+      return os << "send";
+    case TraceStage::TRANSMIT:
+      return os << "transmit";
+  }
+  return os << static_cast<int>(stage);
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+FaceLatencyStatus::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
+{
+  using ndn::encoding::prependNonNegativeIntegerBlock;
+
+  size_t totalLength = 0;
+
+  for (auto it = stages.rbegin(); it != stages.rend(); ++it) {
+    size_t stageLength = 0;
+    stageLength += prependNonNegativeIntegerBlock(encoder, tlv::Latency99, it->p99.count());
+    stageLength += prependNonNegativeIntegerBlock(encoder, tlv::Latency90, it->p90.count());
+    stageLength += prependNonNegativeIntegerBlock(encoder, tlv::Latency50, it->p50.count());
+    stageLength += prependNonNegativeIntegerBlock(encoder, tlv::NSamples, it->nSamples);
+    stageLength += prependNonNegativeIntegerBlock(encoder, tlv::LatencyStage,
+                                                  static_cast<uint64_t>(it->stage));
+    stageLength += encoder.prependVarNumber(stageLength);
+    stageLength += encoder.prependVarNumber(tlv::StageLatency);
+    totalLength += stageLength;
+  }
+
+  totalLength += prependNonNegativeIntegerBlock(encoder, ndn::tlv::nfd::FaceId, faceId);
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::FaceLatency);
+  return totalLength;
+}
+
+template size_t
+FaceLatencyStatus::wireEncode<ndn::encoding::EncoderTag>(ndn::EncodingBuffer&) const;
+
+template size_t
+FaceLatencyStatus::wireEncode<ndn::encoding::EstimatorTag>(ndn::EncodingEstimator&) const;
+
+Block
+FaceLatencyStatus::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+  return buffer.block();
+}
+
+/** \brief read the NonNegativeInteger at \p it, which must be of \p type, and advance \p it
+ */
+static uint64_t
+readField(Block::element_const_iterator& it, Block::element_const_iterator end, uint32_t type)
+{
+  if (it == end || it->type() != type) {
+    NDN_THROW(FaceLatencyStatus::Error("Missing required field of TLV-TYPE " + to_string(type)));
+  }
+  return ndn::encoding::readNonNegativeInteger(*it++);
+}
+
+void
+FaceLatencyStatus::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::FaceLatency) {
+    NDN_THROW(Error("Expecting FaceLatency element, but TLV-TYPE is " + to_string(wire.type())));
+  }
+  wire.parse();
+
+  auto it = wire.elements_begin();
+  faceId = readField(it, wire.elements_end(), ndn::tlv::nfd::FaceId);
+
+  stages.clear();
+  for (; it != wire.elements_end(); ++it) {
+    if (it->type() != tlv::StageLatency) {
+      NDN_THROW(Error("Expecting StageLatency element, but TLV-TYPE is " + to_string(it->type())));
+    }
+    it->parse();
+
+    auto field = it->elements_begin();
+    auto end = it->elements_end();
+    auto stage = readField(field, end, tlv::LatencyStage);
+    if (stage >= N_TRACE_STAGES) {
+      NDN_THROW(Error("Invalid LatencyStage " + to_string(stage)));
+    }
+
+    Stage s;
+    s.stage = static_cast<TraceStage>(stage);
+    s.nSamples = readField(field, end, tlv::NSamples);
+    s.p50 = time::nanoseconds(readField(field, end, tlv::Latency50));
+    s.p90 = time::nanoseconds(readField(field, end, tlv::Latency90));
+    s.p99 = time::nanoseconds(readField(field, end, tlv::Latency99));
+    stages.push_back(s);
+  }
+}
+
+} // namespace nfd
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_LATENCY_STATUS_HPP
+#define NFD_CORE_LATENCY_STATUS_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace nfd {
+
+/** \brief points on the forwarding path of an Interest at which a sampled Interest is timestamped
+ */
+enum class TraceStage {
+  RECEIVE,   ///< Transport::receive on the incoming face
+  INCOMING,  ///< Forwarder::onIncomingInterest
+  CS_LOOKUP, ///< Content Store lookup has completed
+  STRATEGY,  ///< Interest is dispatched to the strategy
+  SEND,      ///< LinkService::sendInterest on an outgoing face
+  TRANSMIT,  ///< link-layer packet is passed to Transport::send on the outgoing face
+};
+
+/** \brief number of trace stages
+ */
+constexpr size_t N_TRACE_STAGES = 6;
+
+std::ostream&
+operator<<(std::ostream& os, TraceStage stage);
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of the latency status dataset
+ */
+enum {
+  FaceLatency  = 0xb0,
+  StageLatency = 0xb2,
+  LatencyStage = 0xb4,
+  NSamples     = 0xb6,
+  Latency50    = 0xb8,
+  Latency90    = 0xba,
+  Latency99    = 0xbc,
+};
+
+} // namespace tlv
+
+/** \brief an item in the latency status dataset
+ *
+ *  It reports the latency of sampled Interests received on a face, from TraceStage::RECEIVE
+ *  to each later stage, so that the cost of a stage is the increase over the previous one.
+ *
+ *  \code
+ *  FaceLatency := FACE-LATENCY-TYPE TLV-LENGTH
+ *                   FaceId
+ *                   StageLatency*
+ *
+ *  StageLatency := STAGE-LATENCY-TYPE TLV-LENGTH
+ *                    LatencyStage
+ *                    NSamples
+ *                    Latency50
+ *                    Latency90
+ *                    Latency99
+ *  \endcode
+ *  Latency50, Latency90, and Latency99 are percentiles in nanoseconds.
+ */
+class FaceLatencyStatus
+{
+public:
+  class Error : public ndn::tlv::Error
+  {
+  public:
+    using ndn::tlv::Error::Error;
+  };
+
+  struct Stage
+  {
+    TraceStage stage = TraceStage::RECEIVE;
+    uint64_t nSamples = 0;
+    time::nanoseconds p50 = 0_ns;
+    time::nanoseconds p90 = 0_ns;
+    time::nanoseconds p99 = 0_ns;
+  };
+
+  FaceLatencyStatus() = default;
+
+  explicit
+  FaceLatencyStatus(const Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& encoder) const;
+
+  Block
+  wireEncode() const;
+
+  void
+  wireDecode(const Block& wire);
+
+public:
+  uint64_t faceId = 0;
+  std::vector<Stage> stages;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_LATENCY_STATUS_HPP
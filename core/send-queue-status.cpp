@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "send-queue-status.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
+
+namespace nfd {
+
+std::ostream&
+operator<<(std::ostream& os, TxClass cls)
+{
+  switch (cls) {
+    case TxClass::PRIORITY:
+      return os << "priority";
+    case TxClass::INTEREST:
+      return os << "interest";
+    case TxClass::DATA:
+      return os << "data";
+    case TxClass::NACK:
+      return os << "nack";
+  }
+  return os << static_cast<int>(cls);
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+FaceSendQueueStatus::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
+{
+  using ndn::encoding::prependNonNegativeIntegerBlock;
+
+  size_t totalLength = 0;
+
+  for (auto it = classes.rbegin(); it != classes.rend(); ++it) {
+    size_t classLength = 0;
+    classLength += prependNonNegativeIntegerBlock(encoder, tlv::NQueueDropped, it->nDropped);
+    classLength += prependNonNegativeIntegerBlock(encoder, tlv::QueueLength, it->queueLength);
+    classLength += prependNonNegativeIntegerBlock(encoder, tlv::ClassWeight, it->weight);
+    classLength += prependNonNegativeIntegerBlock(encoder, tlv::TrafficClass,
+                                                  static_cast<uint64_t>(it->txClass));
+    classLength += encoder.prependVarNumber(classLength);
+    classLength += encoder.prependVarNumber(tlv::ClassQueue);
+    totalLength += classLength;
+  }
+
+  totalLength += prependNonNegativeIntegerBlock(encoder, ndn::tlv::nfd::FaceId, faceId);
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::FaceSendQueue);
+  return totalLength;
+}
+
+template size_t
+FaceSendQueueStatus::wireEncode<ndn::encoding::EncoderTag>(ndn::EncodingBuffer&) const;
+
+template size_t
+FaceSendQueueStatus::wireEncode<ndn::encoding::EstimatorTag>(ndn::EncodingEstimator&) const;
+
+Block
+FaceSendQueueStatus::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+  return buffer.block();
+}
+
+/** \brief read the NonNegativeInteger at \p it, which must be of \p type, and advance \p it
+ */
+static uint64_t
+readField(Block::element_const_iterator& it, Block::element_const_iterator end, uint32_t type)
+{
+  if (it == end || it->type() != type) {
+    NDN_THROW(FaceSendQueueStatus::Error("Missing required field of TLV-TYPE " + to_string(type)));
+  }
+  return ndn::encoding::readNonNegativeInteger(*it++);
+}
+
+void
+FaceSendQueueStatus::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::FaceSendQueue) {
+    NDN_THROW(Error("Expecting FaceSendQueue element, but TLV-TYPE is " + to_string(wire.type())));
+  }
+  wire.parse();
+
+  auto it = wire.elements_begin();
+  faceId = readField(it, wire.elements_end(), ndn::tlv::nfd::FaceId);
+
+  classes.clear();
+  for (; it != wire.elements_end(); ++it) {
+    if (it->type() != tlv::ClassQueue) {
+      NDN_THROW(Error("Expecting ClassQueue element, but TLV-TYPE is " + to_string(it->type())));
+    }
+    it->parse();
+
+    auto field = it->elements_begin();
+    auto end = it->elements_end();
+    auto txClass = readField(field, end, tlv::TrafficClass);
+    if (txClass >= TX_CLASS_COUNT) {
+      NDN_THROW(Error("Invalid TrafficClass " + to_string(txClass)));
+    }
+
+    Class c;
+    c.txClass = static_cast<TxClass>(txClass);
+    c.weight = readField(field, end, tlv::ClassWeight);
+    c.queueLength = readField(field, end, tlv::QueueLength);
+    c.nDropped = readField(field, end, tlv::NQueueDropped);
+    classes.push_back(c);
+  }
+}
+
+} // namespace nfd
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SEND_QUEUE_STATUS_HPP
+#define NFD_CORE_SEND_QUEUE_STATUS_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace nfd {
+
+/** \brief traffic class of an outgoing LpPacket
+ */
+enum class TxClass {
+  PRIORITY, ///< management, /localhost, /localhop, and link control traffic
+  INTEREST,
+  DATA,
+  NACK,
+};
+
+/** \brief number of traffic classes
+ */
+constexpr size_t TX_CLASS_COUNT = 4;
+
+std::ostream&
+operator<<(std::ostream& os, TxClass cls);
+
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of the send queue status dataset
+ */
+enum {
+  FaceSendQueue = 0xc0,
+  ClassQueue    = 0xc2,
+  TrafficClass  = 0xc4,
+  ClassWeight   = 0xc6,
+  QueueLength   = 0xc8,
+  NQueueDropped = 0xca,
+};
+
+} // namespace tlv
+
+/** \brief an item in the send queue status dataset
+ *
+ *  It reports the state of the send queue of each traffic class on a face.
+ *
+ *  \code
+ *  FaceSendQueue := FACE-SEND-QUEUE-TYPE TLV-LENGTH
+ *                     FaceId
+ *                     ClassQueue*
+ *
+ *  ClassQueue := CLASS-QUEUE-TYPE TLV-LENGTH
+ *                  TrafficClass
+ *                  ClassWeight
+ *                  QueueLength
+ *                  NQueueDropped
+ *  \endcode
+ *  QueueLength is the number of LpPackets currently queued, and NQueueDropped is the number
+ *  of LpPackets dropped by the queue since the face was created.
+ */
+class FaceSendQueueStatus
+{
+public:
+  class Error : public ndn::tlv::Error
+  {
+  public:
+    using ndn::tlv::Error::Error;
+  };
+
+  struct Class
+  {
+    TxClass txClass = TxClass::PRIORITY;
+    uint64_t weight = 0;
+    uint64_t queueLength = 0;
+    uint64_t nDropped = 0;
+  };
+
+  FaceSendQueueStatus() = default;
+
+  explicit
+  FaceSendQueueStatus(const Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& encoder) const;
+
+  Block
+  wireEncode() const;
+
+  void
+  wireDecode(const Block& wire);
+
+public:
+  uint64_t faceId = 0;
+  std::vector<Class> classes;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SEND_QUEUE_STATUS_HPP
@@ -28,6 +28,9 @@
 
 #include "core/common.hpp"
 
+#include <array>
+#include <cmath>
+
 namespace nfd {
 
 /** \brief represents a counter that encloses an integer value
@@ -129,6 +132,72 @@ private:
   const T* m_table;
 };
 
+/** \brief represents a distribution of durations, from which percentiles can be estimated
+ *
+ *  Durations are counted in buckets whose bounds are powers of two microseconds, so that
+ *  a percentile is estimated within a factor of two, using constant memory and time.
+ */
+class DurationHistogram : noncopyable
+{
+public:
+  /** \brief number of buckets
+   *
+   *  Bucket 0 counts durations under 1 microsecond; bucket i counts durations in
+   *  [2^(i-1), 2^i) microseconds; the last bucket also counts all longer durations.
+   */
+  static constexpr size_t N_BUCKETS = 28;
+
+  /** \brief record a duration
+   */
+  void
+  add(time::nanoseconds duration) noexcept
+  {
+    size_t i = 0;
+    for (auto us = duration.count() / 1000; us > 0 && i < N_BUCKETS - 1; us >>= 1) {
+      ++i;
+    }
+    ++m_buckets[i];
+    ++m_count;
+  }
+
+  /** \brief count of recorded durations
+   */
+  uint64_t
+  getCount() const noexcept
+  {
+    return m_count;
+  }
+
+  /** \brief estimate a percentile of recorded durations
+   *  \param p percentile, between 0 and 100
+   *  \return upper bound of the bucket containing the percentile, or zero if nothing is recorded;
+   *          for the last bucket, its lower bound is returned instead
+   */
+  time::nanoseconds
+  getPercentile(double p) const noexcept
+  {
+    if (m_count == 0) {
+      return time::nanoseconds::zero();
+    }
+
+    auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * m_count)));
+    uint64_t cumulative = 0;
+    size_t i = 0;
+    for (; i < N_BUCKETS - 1; ++i) {
+      cumulative += m_buckets[i];
+      if (cumulative >= rank) {
+        break;
+      }
+    }
+    auto bound = i < N_BUCKETS - 1 ? i : i - 1;
+    return time::microseconds(uint64_t(1) << bound);
+  }
+
+private:
+  std::array<uint64_t, N_BUCKETS> m_buckets{};
+  uint64_t m_count = 0;
+};
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_COMMON_COUNTER_HPP
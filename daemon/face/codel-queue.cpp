@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "codel-queue.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace face {
+
+CodelQueue::CodelQueue(const Options& options)
+  : m_options(options)
+{
+}
+
+bool
+CodelQueue::enqueue(lp::Packet&& packet, size_t size, time::steady_clock::TimePoint now,
+                    shared_ptr<PacketTrace> trace)
+{
+  if (m_items.size() >= m_options.capacity) {
+    return false;
+  }
+
+  m_items.push_back({std::move(packet), size, now, std::move(trace)});
+  m_nBytes += size;
+  m_maxPacketSize = std::max(m_maxPacketSize, size);
+  return true;
+}
+
+bool
+CodelQueue::doDequeue(time::steady_clock::TimePoint now, optional<Item>& item)
+{
+  if (m_items.empty()) {
+    item = nullopt;
+    m_firstAboveTime = {};
+    return false;
+  }
+
+  item = std::move(m_items.front());
+  m_items.pop_front();
+  m_nBytes -= item->size;
+
+  // a queue holding no more than one packet cannot be drained any faster, so it is not congested
+  if (now - item->enqueueTime < m_options.target || m_nBytes <= m_maxPacketSize) {
+    m_firstAboveTime = {};
+    return false;
+  }
+
+  if (m_firstAboveTime == time::steady_clock::TimePoint{}) {
+    m_firstAboveTime = now + m_options.interval;
+    return false;
+  }
+  return now >= m_firstAboveTime;
+}
+
+time::steady_clock::TimePoint
+CodelQueue::controlLaw(time::steady_clock::TimePoint t) const
+{
+  return t + time::nanoseconds(static_cast<time::nanoseconds::rep>(
+               m_options.interval.count() / std::sqrt(m_count)));
+}
+
+CodelQueue::DequeueResult
+CodelQueue::dequeue(time::steady_clock::TimePoint now)
+{
+  DequeueResult res;
+  bool okToDrop = doDequeue(now, res.item);
+
+  if (m_isDropping) {
+    if (!okToDrop) {
+      // sojourn time fell below target, leave dropping state
+      m_isDropping = false;
+    }
+    while (m_isDropping && now >= m_dropNext) {
+      ++m_count;
+      if (m_options.useMarking) {
+        res.isMarked = true;
+        m_dropNext = controlLaw(m_dropNext);
+        break;
+      }
+
+      ++res.nDropped;
+      okToDrop = doDequeue(now, res.item);
+      if (!okToDrop) {
+        m_isDropping = false;
+      }
+      else {
+        m_dropNext = controlLaw(m_dropNext);
+      }
+    }
+  }
+  else if (okToDrop) {
+    if (m_options.useMarking) {
+      res.isMarked = true;
+    }
+    else {
+      ++res.nDropped;
+      doDequeue(now, res.item);
+    }
+    m_isDropping = true;
+
+    // if the queue was recently in dropping state, resume from the previous drop rate
+    uint32_t delta = m_count - m_lastCount;
+    m_count = 1;
+    if (delta > 1 && now - m_dropNext < 16 * m_options.interval) {
+      m_count = delta;
+    }
+    m_dropNext = controlLaw(now);
+    m_lastCount = m_count;
+  }
+
+  return res;
+}
+
+} // namespace face
+} // namespace nfd
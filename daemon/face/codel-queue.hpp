@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_CODEL_QUEUE_HPP
+#define NFD_DAEMON_FACE_CODEL_QUEUE_HPP
+
+#include "face-common.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <deque>
+
+namespace nfd {
+namespace face {
+
+class PacketTrace;
+
+/** \brief a FIFO queue of outgoing LpPackets managed by CoDel
+ *  \sa https://tools.ietf.org/html/rfc8289
+ *
+ *  Each packet is timestamped when it is enqueued. When it is dequeued, the time it has spent
+ *  in the queue (sojourn time) is compared against a target: if the sojourn time stays above
+ *  the target for at least one interval, the queue enters the dropping state, in which it
+ *  signals congestion on one packet every interval/sqrt(count), until the sojourn time falls
+ *  below the target again. Congestion is signaled either by dropping the packet, or, if marking
+ *  is enabled, by asking the caller to add a congestion mark to it.
+ *
+ *  The queue does not depend on the transport reporting its own queue length, and therefore
+ *  works the same way on every kind of face.
+ */
+class CodelQueue : noncopyable
+{
+public:
+  /** \brief Options that control the behavior of CodelQueue
+   */
+  struct Options
+  {
+    /** \brief acceptable standing queue delay
+     */
+    time::nanoseconds target = 5_ms;
+
+    /** \brief time during which the sojourn time must stay above the target before congestion
+     *         is signaled; should be on the order of the worst-case RTT through the bottleneck
+     */
+    time::nanoseconds interval = 100_ms;
+
+    /** \brief maximum number of packets in the queue
+     *
+     *  Packets arriving at a full queue are dropped.
+     */
+    size_t capacity = 1000;
+
+    /** \brief whether to signal congestion by marking rather than dropping packets
+     */
+    bool useMarking = true;
+  };
+
+  /** \brief a queued packet
+   */
+  struct Item
+  {
+    lp::Packet packet;
+    size_t size; ///< encoded size of the packet, in octets
+    time::steady_clock::TimePoint enqueueTime;
+    shared_ptr<PacketTrace> trace; ///< set if the packet carries an Interest sampled for tracing
+  };
+
+  /** \brief outcome of dequeue()
+   */
+  struct DequeueResult
+  {
+    optional<Item> item; ///< packet to transmit; none if the queue became empty
+    bool isMarked = false; ///< whether the packet must carry a congestion mark
+    size_t nDropped = 0; ///< number of packets dropped by CoDel to produce this result
+  };
+
+  explicit
+  CodelQueue(const Options& options = {});
+
+  /** \brief set options for the queue
+   *
+   *  Packets already in the queue are kept even if they exceed the new capacity.
+   */
+  void
+  setOptions(const Options& options)
+  {
+    m_options = options;
+  }
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \brief append a packet to the queue
+   *  \param packet the packet
+   *  \param size encoded size of the packet, in octets
+   *  \param now current time
+   *  \param trace trace of the sampled Interest carried by the packet, if any
+   *  \retval false the queue is full, and the packet has been dropped
+   */
+  bool
+  enqueue(lp::Packet&& packet, size_t size,
+          time::steady_clock::TimePoint now = time::steady_clock::now(),
+          shared_ptr<PacketTrace> trace = nullptr);
+
+  /** \brief remove the next packet to transmit from the queue, running the CoDel algorithm
+   *  \param now current time
+   */
+  DequeueResult
+  dequeue(time::steady_clock::TimePoint now = time::steady_clock::now());
+
+  bool
+  empty() const
+  {
+    return m_items.empty();
+  }
+
+  /** \brief the packet at the head of the queue
+   *  \pre !empty()
+   */
+  const Item&
+  front() const
+  {
+    BOOST_ASSERT(!m_items.empty());
+    return m_items.front();
+  }
+
+  /** \brief count of packets in the queue
+   */
+  size_t
+  size() const
+  {
+    return m_items.size();
+  }
+
+  /** \brief number of octets in the queue
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
+  /** \brief whether CoDel is currently in the dropping state
+   */
+  bool
+  isDropping() const
+  {
+    return m_isDropping;
+  }
+
+private:
+  /** \brief pop the head of the queue into \p item
+   *  \return whether the sojourn time of \p item has stayed above the target for an interval
+   */
+  bool
+  doDequeue(time::steady_clock::TimePoint now, optional<Item>& item);
+
+  time::steady_clock::TimePoint
+  controlLaw(time::steady_clock::TimePoint t) const;
+
+private:
+  Options m_options;
+  std::deque<Item> m_items;
+  size_t m_nBytes = 0;
+  size_t m_maxPacketSize = 0;
+
+  // CoDel state variables, named after RFC 8289 section 5
+  time::steady_clock::TimePoint m_firstAboveTime; ///< zero when not above the target
+  time::steady_clock::TimePoint m_dropNext;
+  uint32_t m_count = 0;
+  uint32_t m_lastCount = 0;
+  bool m_isDropping = false;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_CODEL_QUEUE_HPP
@@ -27,10 +27,30 @@
 #define NFD_DAEMON_FACE_DATAGRAM_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "receive-buffer-pool.hpp"
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
 #include <array>
+#include <iterator>
+#include <numeric>
+
+#ifdef __linux__
+#include <cerrno>       // for errno
+#include <cstring>      // for std::memcpy()
+#include <netinet/in.h> // for IP_MTU and IPV6_MTU
+#include <netinet/udp.h>
+#include <sys/socket.h> // for recvmmsg() and sendmmsg()
+
+// UDP segmentation offload options, available since Linux 4.18 (UDP_SEGMENT)
+// and 5.0 (UDP_GRO), may be missing from older C library headers
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif // __linux__
 
 namespace nfd {
 namespace face {
@@ -38,16 +58,85 @@ namespace face {
 struct Unicast {};
 struct Multicast {};
 
+/** \brief maximum number of datagrams received or sent in one batch
+ */
+const size_t MAX_DATAGRAM_BATCH_SIZE = 64;
+
+/** \brief Counters provided by DatagramTransport.
+ *  \note The type name DatagramTransportCounters is an implementation detail.
+ *        Use DatagramTransport::Counters in public API.
+ */
+class DatagramTransportCounters : public virtual Transport::Counters
+{
+public:
+  /** \brief histogram of batch sizes
+   *
+   *  Bucket i counts the batches that contained between 2^i and 2^(i+1)-1 datagrams;
+   *  the last bucket also counts all larger batches.
+   */
+  using BatchSizeHistogram = std::array<PacketCounter, 7>;
+
+  /** \brief sizes of batches received with a single recvmmsg call
+   *
+   *  This histogram is updated only if batching is enabled on the transport.
+   */
+  BatchSizeHistogram nInBatches;
+
+  /** \brief sizes of batches sent with a single sendmmsg call
+   *
+   *  This histogram is updated only if batching is enabled on the transport.
+   */
+  BatchSizeHistogram nOutBatches;
+
+  /** \brief count of receive buffers reused from the receive buffer pool
+   */
+  PacketCounter nInBufferPoolHits;
+
+  /** \brief count of receive buffers allocated because no pooled buffer was idle
+   */
+  PacketCounter nInBufferPoolMisses;
+
+  /** \brief largest number of buffers held by the receive buffer pool at the same time
+   */
+  SimpleCounter nInBufferPoolHighWaterMark;
+
+  /** \brief count of incoming bytes copied out of receive buffers
+   *
+   *  Packets are copied while every buffer of the receive buffer pool is in use.
+   */
+  ByteCounter nInBytesCopied;
+};
+
+/** \brief Returns the index of the DatagramTransportCounters::BatchSizeHistogram
+ *         bucket that counts batches of \p batchSize datagrams.
+ *  \pre batchSize > 0
+ */
+inline size_t
+getBatchSizeBucket(size_t batchSize)
+{
+  constexpr size_t nBuckets = std::tuple_size<DatagramTransportCounters::BatchSizeHistogram>::value;
+  size_t bucket = 0;
+  while ((batchSize >>= 1) > 0 && bucket + 1 < nBuckets) {
+    ++bucket;
+  }
+  return bucket;
+}
+
 /** \brief Implements Transport for datagram-based protocols.
  *
  *  \tparam Protocol a datagram-based protocol in Boost.Asio
  */
 template<class Protocol, class Addressing = Unicast>
 class DatagramTransport : public Transport
+                        , protected virtual DatagramTransportCounters
 {
 public:
   typedef Protocol protocol;
 
+  /** \brief counters provided by DatagramTransport
+   */
+  using Counters = DatagramTransportCounters;
+
   /** \brief Construct datagram transport.
    *
    *  \param socket Protocol-specific socket for the created transport
@@ -55,15 +144,79 @@ public:
   explicit
   DatagramTransport(typename protocol::socket&& socket);
 
+  const Counters&
+  getCounters() const override;
+
   ssize_t
   getSendQueueLength() override;
 
+  size_t
+  getBatchSize() const
+  {
+    return m_batchSize;
+  }
+
+  /** \brief Set the maximum number of datagrams received or sent per system call.
+   *
+   *  If \p batchSize is greater than 1, the transport drains the socket with recvmmsg
+   *  on each readiness event, and coalesces outgoing packets queued during the same
+   *  io_service turn into sendmmsg calls. A value of 1 disables batching.
+   *  Batching is only available on Linux; elsewhere this setting is ignored.
+   *  A new receive batch size takes effect after the pending receive operation completes.
+   *
+   *  Each recvmmsg call fills only as many receive slots as recent calls needed, doubling
+   *  them up to \p batchSize while calls return full. A busy face therefore holds up to
+   *  batchSize receive buffers of MAX_NDN_PACKET_SIZE octets, or 65535 octets with UDP GRO.
+   *
+   *  \pre 0 < batchSize <= MAX_DATAGRAM_BATCH_SIZE
+   */
+  void
+  setBatchSize(size_t batchSize);
+
+  bool
+  isGsoEnabled() const
+  {
+    return m_isGsoEnabled;
+  }
+
+  bool
+  isGroEnabled() const
+  {
+    return m_isGroEnabled;
+  }
+
+  /** \brief Enable or disable UDP segmentation offload.
+   *
+   *  When enabled, consecutive outgoing packets of the same size are handed to the kernel
+   *  as a single UDP_SEGMENT (GSO) send, and the socket accepts UDP_GRO coalesced datagrams,
+   *  which are split back into individual packets by receiveDatagram.
+   *  Each feature is enabled only if the running kernel supports it; use isGsoEnabled()
+   *  and isGroEnabled() to find out. GSO is turned off again if a send fails because the
+   *  outgoing interface cannot segment the packets.
+   *  Segmentation offload is only available for UDP on Linux.
+   */
+  void
+  setSegmentationOffload(bool wantOffload);
+
   /** \brief Receive datagram, translate buffer into packet, deliver to parent class.
+   *
+   *  The datagram is copied; the caller retains ownership of \p buffer.
    */
   void
   receiveDatagram(const uint8_t* buffer, size_t nBytesReceived,
                   const boost::system::error_code& error);
 
+  /** \brief Receive datagram located at \p offset in \p buffer, deliver to parent class.
+   *
+   *  The delivered packet shares \p buffer without copying, unless every buffer of the receive
+   *  buffer pool is in use.
+   *  If \p segmentSize is non-zero, the datagram may consist of several datagrams coalesced by
+   *  UDP GRO, each of \p segmentSize octets except the last one, which can be shorter.
+   */
+  void
+  receiveDatagram(const ConstBufferPtr& buffer, size_t offset, size_t nBytesReceived,
+                  const boost::system::error_code& error, size_t segmentSize = 0);
+
 protected:
   void
   doClose() override;
@@ -80,6 +233,22 @@ protected:
   void
   processErrorCode(const boost::system::error_code& error);
 
+  /** \brief Set the socket and destination used for batched transmission.
+   *
+   *  By default, batches are sent on \c m_socket, which must be connected.
+   */
+  void
+  setBatchSendTarget(typename protocol::socket& socket,
+                     const typename protocol::endpoint& destination);
+
+  /** \brief Whether outgoing packets go through the batched transmission queue.
+   */
+  bool
+  isSendQueued() const
+  {
+    return m_batchSize > 1 || m_isGsoEnabled;
+  }
+
   bool
   hasRecentlyReceived() const;
 
@@ -96,14 +265,71 @@ protected:
   NFD_LOG_MEMBER_DECL();
 
 private:
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  void
+  startReceive();
+
+  void
+  handleReceiveBatch(const boost::system::error_code& error);
+
+  void
+  flushSendQueue();
+
+  void
+  resizeBatchBuffers();
+
+#ifdef __linux__
+  /** \brief Adapts the number of receive slots filled for the next recvmmsg call to the number
+   *         of datagrams \p nReceived by the last one, releasing buffers of unused slots
+   */
+  void
+  adjustReceiveSlots(size_t nReceived);
+#endif // __linux__
+
+  size_t
+  getReceiveSlotSize() const;
+
+  shared_ptr<ndn::Buffer>
+  acquireReceiveBuffer();
+
+  /** \brief Copies \p element into its own buffer if every pooled receive buffer is in use
+   *
+   *  Packets can be retained for a long time, e.g., in the PIT or the ContentStore. Once they
+   *  keep every pooled buffer alive, copying them lets the current receive buffer return to
+   *  the pool, instead of allocating a new buffer for every datagram.
+   */
+  Block
+  detachPacket(Block element);
+
+private:
+  ReceiveBufferPool m_receiveBufferPool;
+  shared_ptr<ndn::Buffer> m_receiveBuffer;
   bool m_hasRecentlyReceived;
+
+  size_t m_batchSize = 1;
+  typename protocol::socket* m_batchSendSocket = &m_socket;
+  optional<typename protocol::endpoint> m_batchSendDestination;
+  std::vector<Block> m_sendQueue;
+  bool m_isSendPending = false;
+  bool m_isGsoEnabled = false;
+  bool m_isGroEnabled = false;
+  size_t m_gsoMaxSegmentSize = 0;
+#ifdef __linux__
+  std::vector<shared_ptr<ndn::Buffer>> m_batchBuffers; ///< null slots are refilled before receiving
+  size_t m_nReceiveSlots = 1; ///< number of slots filled for the next recvmmsg call
+  std::vector<typename protocol::endpoint> m_batchSenders;
+  std::vector<::iovec> m_batchIovecs;
+  std::vector<::mmsghdr> m_batchHeaders;
+  std::vector<uint8_t> m_batchControl;
+  std::vector<::iovec> m_sendIovecs;
+  std::vector<size_t> m_batchPacketCounts;
+#endif // __linux__
 };
 
 
 template<class T, class U>
 DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket)
   : m_socket(std::move(socket))
+  , m_receiveBufferPool(ndn::MAX_NDN_PACKET_SIZE, 0)
   , m_hasRecentlyReceived(false)
 {
   boost::asio::socket_base::send_buffer_size sendBufferSizeOption;
@@ -117,10 +343,15 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                              [this] (auto&&... args) {
-                                this->handleReceive(std::forward<decltype(args)>(args)...);
-                              });
+  resizeBatchBuffers();
+  startReceive();
+}
+
+template<class T, class U>
+const typename DatagramTransport<T, U>::Counters&
+DatagramTransport<T, U>::getCounters() const
+{
+  return *this;
 }
 
 template<class T, class U>
@@ -134,6 +365,168 @@ DatagramTransport<T, U>::getSendQueueLength()
   return queueLength;
 }
 
+template<class T, class U>
+void
+DatagramTransport<T, U>::setBatchSize(size_t batchSize)
+{
+  BOOST_ASSERT(batchSize > 0 && batchSize <= MAX_DATAGRAM_BATCH_SIZE);
+
+#ifdef __linux__
+  m_batchSize = batchSize;
+  resizeBatchBuffers();
+#else
+  if (batchSize > 1) {
+    NFD_LOG_FACE_WARN("Datagram batching is not supported on this platform");
+  }
+#endif // __linux__
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::setSegmentationOffload(bool wantOffload)
+{
+#ifdef __linux__
+  int fd = m_batchSendSocket->native_handle();
+  m_isGsoEnabled = false;
+  if (wantOffload) {
+    // probe kernel support without changing the socket defaults
+    int gsoSize = 0;
+    socklen_t len = sizeof(gsoSize);
+    if (::getsockopt(fd, SOL_UDP, UDP_SEGMENT, &gsoSize, &len) == 0) {
+      // every segment must fit in the path MTU of the outgoing interface
+      bool isV4 = m_batchSendSocket->local_endpoint().protocol() == boost::asio::ip::udp::v4();
+      int mtu = 0;
+      len = sizeof(mtu);
+      if (::getsockopt(fd, isV4 ? IPPROTO_IP : IPPROTO_IPV6, isV4 ? IP_MTU : IPV6_MTU,
+                       &mtu, &len) < 0) {
+        mtu = 1500; // not connected, assume Ethernet
+      }
+      size_t headerSize = (isV4 ? 20 : 40) + 8;
+      m_gsoMaxSegmentSize = static_cast<size_t>(mtu) > headerSize ? mtu - headerSize : 0;
+      m_isGsoEnabled = m_gsoMaxSegmentSize > 0;
+    }
+    if (!m_isGsoEnabled) {
+      NFD_LOG_FACE_DEBUG("UDP segmentation offload not supported: " << std::strerror(errno));
+    }
+  }
+
+  bool wasRxBatched = m_batchSize > 1 || m_isGroEnabled;
+  int value = wantOffload ? 1 : 0;
+  if (::setsockopt(m_socket.native_handle(), SOL_UDP, UDP_GRO, &value, sizeof(value)) == 0) {
+    m_isGroEnabled = wantOffload;
+    if (m_isGroEnabled && !wasRxBatched) {
+      // The pending receive operation cannot see the GRO segment size. Abort it, so that
+      // handleReceive restarts the receive loop in batched mode.
+      boost::system::error_code error;
+      m_socket.cancel(error);
+    }
+  }
+  else {
+    m_isGroEnabled = false;
+    if (wantOffload) {
+      NFD_LOG_FACE_DEBUG("UDP receive offload not supported: " << std::strerror(errno));
+    }
+  }
+
+  NFD_LOG_FACE_DEBUG("GSO " << (m_isGsoEnabled ? "enabled" : "disabled") << ", GRO "
+                     << (m_isGroEnabled ? "enabled" : "disabled"));
+  resizeBatchBuffers();
+#else
+  if (wantOffload) {
+    NFD_LOG_FACE_WARN("UDP segmentation offload is not supported on this platform");
+  }
+#endif // __linux__
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::resizeBatchBuffers()
+{
+  // Besides the buffers being received into, the pool keeps buffers for packets that are
+  // still referenced after the next receive operation, e.g., while being forwarded.
+  // Buffers are allocated on demand, so this only bounds the memory used by a busy face,
+  // at 2 * batch size + 16 buffers of getReceiveSlotSize() octets.
+  m_receiveBufferPool.resize(getReceiveSlotSize(), 2 * m_batchSize + 16);
+
+#ifdef __linux__
+  bool isRxBatched = m_batchSize > 1 || m_isGroEnabled;
+  bool isTxBatched = isSendQueued();
+  size_t nSlots = isRxBatched || isTxBatched ? m_batchSize : 0;
+
+  // buffers are acquired from the pool when receiving
+  m_batchBuffers.assign(isRxBatched ? nSlots : 0, nullptr);
+  m_nReceiveSlots = 1;
+  m_batchSenders.resize(isRxBatched ? nSlots : 0);
+  m_batchIovecs.resize(isRxBatched ? nSlots : 0);
+  m_batchHeaders.resize(nSlots);
+  m_batchControl.resize(nSlots * CMSG_SPACE(sizeof(int)));
+  m_batchPacketCounts.resize(nSlots);
+#endif // __linux__
+}
+
+#ifdef __linux__
+template<class T, class U>
+void
+DatagramTransport<T, U>::adjustReceiveSlots(size_t nReceived)
+{
+  if (nReceived >= m_nReceiveSlots) {
+    // all slots were used, more datagrams may be waiting
+    m_nReceiveSlots = std::min(2 * m_nReceiveSlots, m_batchSize);
+    return;
+  }
+  if (4 * nReceived > m_nReceiveSlots) {
+    return;
+  }
+
+  // the load dropped, so that a lightly loaded face holds only a few receive buffers
+  m_nReceiveSlots = std::max<size_t>(m_nReceiveSlots / 2, 1);
+  for (size_t i = m_nReceiveSlots; i < m_batchBuffers.size(); ++i) {
+    m_batchBuffers[i] = nullptr;
+  }
+  m_receiveBufferPool.trim(m_nReceiveSlots);
+}
+#endif // __linux__
+
+template<class T, class U>
+size_t
+DatagramTransport<T, U>::getReceiveSlotSize() const
+{
+  // a GRO coalesced datagram can be as large as the maximum UDP payload
+  return m_isGroEnabled ? std::numeric_limits<uint16_t>::max() : ndn::MAX_NDN_PACKET_SIZE;
+}
+
+template<class T, class U>
+shared_ptr<ndn::Buffer>
+DatagramTransport<T, U>::acquireReceiveBuffer()
+{
+  auto buffer = m_receiveBufferPool.acquire();
+  nInBufferPoolHits.set(m_receiveBufferPool.getNHits());
+  nInBufferPoolMisses.set(m_receiveBufferPool.getNMisses());
+  nInBufferPoolHighWaterMark.set(m_receiveBufferPool.getHighWaterMark());
+  return buffer;
+}
+
+template<class T, class U>
+Block
+DatagramTransport<T, U>::detachPacket(Block element)
+{
+  if (element.getBuffer()->size() == element.size() || !m_receiveBufferPool.isExhausted()) {
+    return element;
+  }
+
+  nInBytesCopied += element.size();
+  return Block(element.wire(), element.size());
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::setBatchSendTarget(typename protocol::socket& socket,
+                                            const typename protocol::endpoint& destination)
+{
+  m_batchSendSocket = &socket;
+  m_batchSendDestination = destination;
+}
+
 template<class T, class U>
 void
 DatagramTransport<T, U>::doClose()
@@ -161,6 +554,16 @@ DatagramTransport<T, U>::doSend(const Block& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (isSendQueued()) {
+    m_sendQueue.push_back(packet);
+    if (!m_isSendPending) {
+      // collect all packets sent during this io_service turn into the same batch
+      m_isSendPending = true;
+      getGlobalIoService().post([this] { flushSendQueue(); });
+    }
+    return;
+  }
+
   m_socket.async_send(boost::asio::buffer(packet),
                       // 'packet' is copied into the lambda to retain the underlying Buffer
                       [this, packet] (auto&&... args) {
@@ -176,37 +579,264 @@ DatagramTransport<T, U>::receiveDatagram(const uint8_t* buffer, size_t nBytesRec
   if (error)
     return processErrorCode(error);
 
+  receiveDatagram(make_shared<ndn::Buffer>(buffer, nBytesReceived), 0, nBytesReceived, error);
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::receiveDatagram(const ConstBufferPtr& buffer, size_t offset,
+                                         size_t nBytesReceived,
+                                         const boost::system::error_code& error,
+                                         size_t segmentSize)
+{
+  if (error)
+    return processErrorCode(error);
+
+  if (segmentSize > 0 && nBytesReceived > segmentSize) {
+    NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes in segments of " << segmentSize);
+    for (size_t i = 0; i < nBytesReceived && getState() == TransportState::UP; i += segmentSize) {
+      receiveDatagram(buffer, offset + i, std::min(segmentSize, nBytesReceived - i), error);
+    }
+    return;
+  }
+
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes from " << m_sender);
 
   bool isOk = false;
   Block element;
-  std::tie(isOk, element) = Block::fromBuffer(buffer, nBytesReceived);
+  std::tie(isOk, element) = Block::fromBuffer(buffer, offset);
   if (!isOk) {
     NFD_LOG_FACE_WARN("Failed to parse incoming packet from " << m_sender);
     // This packet won't extend the face lifetime
     return;
   }
-  if (element.size() != nBytesReceived) {
+  // the buffer may extend beyond the datagram, so the element could be larger
+  if (element.size() > nBytesReceived) {
     NFD_LOG_FACE_WARN("Received datagram size and decoded element size don't match");
     // This packet won't extend the face lifetime
     return;
   }
+
+  if (element.size() == nBytesReceived) {
+    m_hasRecentlyReceived = true;
+    this->receive(detachPacket(std::move(element)), makeEndpointId(m_sender));
+    return;
+  }
+
+  // the datagram contains several packets packed by the sender; all of them must be valid
+  std::vector<Block> elements;
+  elements.push_back(std::move(element));
+  for (size_t pos = offset + elements.back().size(), end = offset + nBytesReceived;
+       pos < end; pos += elements.back().size()) {
+    std::tie(isOk, element) = Block::fromBuffer(buffer, pos);
+    if (!isOk || element.size() > end - pos) {
+      NFD_LOG_FACE_WARN("Failed to parse packed packet from " << m_sender);
+      // This packet won't extend the face lifetime
+      return;
+    }
+    elements.push_back(std::move(element));
+  }
   m_hasRecentlyReceived = true;
 
-  this->receive(element, makeEndpointId(m_sender));
+  NFD_LOG_FACE_TRACE("Unpacked " << elements.size() << " packets");
+  auto endpoint = makeEndpointId(m_sender);
+  for (const auto& packet : elements) {
+    if (getState() != TransportState::UP) {
+      break;
+    }
+    this->receive(detachPacket(packet), endpoint);
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::startReceive()
+{
+  if (m_batchSize > 1 || m_isGroEnabled) {
+    // wait for readiness only, the datagrams are read by handleReceiveBatch
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           [this] (const auto& error, size_t) { this->handleReceiveBatch(error); });
+    return;
+  }
+
+  // release the previous buffer first, so that it can be reused if no packet refers to it
+  m_receiveBuffer = nullptr;
+  m_receiveBuffer = acquireReceiveBuffer();
+  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer->data(),
+                                                  ndn::MAX_NDN_PACKET_SIZE),
+                              m_sender,
+                              [this] (auto&&... args) {
+                                this->handleReceive(std::forward<decltype(args)>(args)...);
+                              });
 }
 
 template<class T, class U>
 void
 DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
 {
-  receiveDatagram(m_receiveBuffer.data(), nBytesReceived, error);
+  receiveDatagram(m_receiveBuffer, 0, nBytesReceived, error);
 
   if (m_socket.is_open())
-    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                                [this] (auto&&... args) {
-                                  this->handleReceive(std::forward<decltype(args)>(args)...);
-                                });
+    startReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleReceiveBatch(const boost::system::error_code& error)
+{
+  if (error) {
+    processErrorCode(error);
+  }
+#ifdef __linux__
+  else {
+    const size_t slotSize = getReceiveSlotSize();
+    const size_t controlSize = CMSG_SPACE(sizeof(int));
+    const size_t nSlots = m_nReceiveSlots;
+    for (size_t i = 0; i < nSlots; ++i) {
+      if (m_batchBuffers[i] == nullptr) {
+        m_batchBuffers[i] = acquireReceiveBuffer();
+      }
+      BOOST_ASSERT(m_batchBuffers[i]->size() >= slotSize);
+      m_batchIovecs[i].iov_base = m_batchBuffers[i]->data();
+      m_batchIovecs[i].iov_len = slotSize;
+      m_batchHeaders[i] = {};
+      m_batchHeaders[i].msg_hdr.msg_name = m_batchSenders[i].data();
+      m_batchHeaders[i].msg_hdr.msg_namelen = m_batchSenders[i].capacity();
+      m_batchHeaders[i].msg_hdr.msg_iov = &m_batchIovecs[i];
+      m_batchHeaders[i].msg_hdr.msg_iovlen = 1;
+      if (m_isGroEnabled) {
+        m_batchHeaders[i].msg_hdr.msg_control = &m_batchControl[i * controlSize];
+        m_batchHeaders[i].msg_hdr.msg_controllen = controlSize;
+      }
+    }
+
+    int nMessages = ::recvmmsg(m_socket.native_handle(), m_batchHeaders.data(), nSlots,
+                               MSG_DONTWAIT, nullptr);
+    if (nMessages < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        processErrorCode(boost::system::error_code(errno, boost::system::system_category()));
+      }
+    }
+    else if (nMessages > 0) {
+      ++nInBatches[getBatchSizeBucket(nMessages)];
+      NFD_LOG_FACE_TRACE("Received batch of " << nMessages << " datagrams");
+
+      for (int i = 0; i < nMessages && m_socket.is_open(); ++i) {
+        auto& hdr = m_batchHeaders[i].msg_hdr;
+        int segmentSize = 0;
+        for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+          if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            std::memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(segmentSize));
+          }
+        }
+
+        m_batchSenders[i].resize(hdr.msg_namelen);
+        m_sender = m_batchSenders[i];
+        // hand the buffer over to the received packets and refill the slot on the next receive
+        auto buffer = std::move(m_batchBuffers[i]);
+        m_batchBuffers[i] = nullptr;
+        receiveDatagram(buffer, 0, m_batchHeaders[i].msg_len, {}, static_cast<size_t>(segmentSize));
+      }
+      adjustReceiveSlots(static_cast<size_t>(nMessages));
+    }
+  }
+#endif // __linux__
+
+  if (m_socket.is_open())
+    startReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::flushSendQueue()
+{
+  m_isSendPending = false;
+
+#ifdef __linux__
+  // kernel limit on the number of segments in one GSO send
+  const size_t maxGsoSegments = 64;
+  const size_t controlSize = CMSG_SPACE(sizeof(int));
+
+  auto it = m_sendQueue.begin();
+  while (it != m_sendQueue.end() && m_batchSendSocket->is_open()) {
+    // Each message carries either one packet, or with GSO a run of consecutive packets of
+    // the same size; only the last packet of a run may be shorter.
+    m_sendIovecs.clear();
+    size_t nMessages = 0;
+    bool hasGso = false;
+    for (auto next = it; next != m_sendQueue.end() && nMessages < m_batchSize; ++nMessages) {
+      size_t segmentSize = next->size();
+      size_t totalSize = 0;
+      size_t nPackets = 0;
+      do {
+        m_sendIovecs.push_back({const_cast<uint8_t*>(next->wire()), next->size()});
+        totalSize += next->size();
+        ++nPackets;
+        ++next;
+      } while (m_isGsoEnabled && segmentSize <= m_gsoMaxSegmentSize &&
+               nPackets < maxGsoSegments && std::prev(next)->size() == segmentSize &&
+               next != m_sendQueue.end() && next->size() <= segmentSize &&
+               totalSize + next->size() <= static_cast<size_t>(getMtu()));
+      m_batchPacketCounts[nMessages] = nPackets;
+      hasGso = hasGso || nPackets > 1;
+    }
+
+    for (size_t i = 0, iov = 0; i < nMessages; iov += m_batchPacketCounts[i], ++i) {
+      auto& hdr = m_batchHeaders[i].msg_hdr;
+      m_batchHeaders[i] = {};
+      if (m_batchSendDestination) {
+        hdr.msg_name = m_batchSendDestination->data();
+        hdr.msg_namelen = m_batchSendDestination->size();
+      }
+      hdr.msg_iov = &m_sendIovecs[iov];
+      hdr.msg_iovlen = m_batchPacketCounts[i];
+      if (m_batchPacketCounts[i] > 1) {
+        hdr.msg_control = &m_batchControl[i * controlSize];
+        hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+        auto cmsg = CMSG_FIRSTHDR(&hdr);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t segmentSize = static_cast<uint16_t>(m_sendIovecs[iov].iov_len);
+        std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+      }
+    }
+
+    int nSent = ::sendmmsg(m_batchSendSocket->native_handle(), m_batchHeaders.data(), nMessages,
+                           MSG_DONTWAIT);
+    if (nSent < 0) {
+      if (hasGso && (errno == EIO || errno == EINVAL)) {
+        // the outgoing interface cannot segment, fall back to one datagram per packet
+        NFD_LOG_FACE_WARN("Disabling UDP segmentation offload: " << std::strerror(errno));
+        m_isGsoEnabled = false;
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        // socket buffer is full, resume when the socket becomes writable again
+        m_sendQueue.erase(m_sendQueue.begin(), it);
+        m_isSendPending = true;
+        m_batchSendSocket->async_send(boost::asio::null_buffers(),
+                                      [this] (const auto& error, size_t) {
+                                        if (error) {
+                                          m_isSendPending = false;
+                                          return this->processErrorCode(error);
+                                        }
+                                        this->flushSendQueue();
+                                      });
+        return;
+      }
+      m_sendQueue.clear();
+      return processErrorCode(boost::system::error_code(errno, boost::system::system_category()));
+    }
+
+    ++nOutBatches[getBatchSizeBucket(nSent)];
+    NFD_LOG_FACE_TRACE("Successfully sent batch of " << nSent << " datagrams");
+    it += std::accumulate(m_batchPacketCounts.begin(), m_batchPacketCounts.begin() + nSent,
+                          size_t(0));
+  }
+#endif // __linux__
+
+  m_sendQueue.clear();
 }
 
 template<class T, class U>
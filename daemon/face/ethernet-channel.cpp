@@ -39,12 +39,19 @@ namespace face {
 NFD_LOG_INIT(EthernetChannel);
 
 EthernetChannel::EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                                 time::nanoseconds idleTimeout)
+                                 time::nanoseconds idleTimeout,
+                                 bool wantCongestionMarking,
+                                 bool wantPacketRing,
+                                 shared_ptr<EthernetXdpSocket> xdpSocket)
   : m_localEndpoint(std::move(localEndpoint))
   , m_isListening(false)
   , m_socket(getGlobalIoService())
   , m_pcap(m_localEndpoint->getName())
+  , m_ring(wantPacketRing && !xdpSocket ? make_unique<EthernetPacketRing>(m_localEndpoint->getName())
+                                        : nullptr)
+  , m_xdpSocket(std::move(xdpSocket))
   , m_idleFaceTimeout(idleTimeout)
+  , m_wantCongestionMarking(wantCongestionMarking)
 #ifdef _DEBUG
   , m_nDropped(0)
 #endif
@@ -53,6 +60,12 @@ EthernetChannel::EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> lo
   NFD_LOG_CHAN_INFO("Creating channel");
 }
 
+EthernetChannel::~EthernetChannel()
+{
+  if (m_xdpSocket && m_isListening)
+    m_xdpSocket->setDefaultReceiver(nullptr);
+}
+
 void
 EthernetChannel::connect(const EndpointId& endpointId,
                          const FaceParams& params,
@@ -90,12 +103,33 @@ EthernetChannel::listen(const FaceCreatedCallback& onFaceCreated,
   }
   m_isListening = true;
 
-  try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+  if (m_xdpSocket) {
+    // frames from peers that already have a face are dispatched directly to that face
+    m_xdpSocket->setDefaultReceiver([=] (const uint8_t* payload, size_t length,
+                                         const ethernet::Address& sender) {
+      processIncomingPacket(payload, length, sender, onFaceCreated, onFaceCreationFailed);
+    });
+    NFD_LOG_CHAN_DEBUG("Started listening");
+    return;
+  }
+
+  if (m_ring) {
+    try {
+      m_ring->activate();
+      m_socket.assign(m_ring->getFd());
+    }
+    catch (const EthernetPacketRing::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
   }
-  catch (const PcapHelper::Error& e) {
-    NDN_THROW_NESTED(Error(e.what()));
+  else {
+    try {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+    }
+    catch (const PcapHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
   }
   updateFilter();
 
@@ -125,31 +159,25 @@ EthernetChannel::handleRead(const boost::system::error_code& error,
     return;
   }
 
-  const uint8_t* pkt;
-  size_t len;
-  std::string err;
-  std::tie(pkt, len, err) = m_pcap.readNextPacket();
-
-  if (pkt == nullptr) {
-    NFD_LOG_CHAN_WARN("Read error: " << err);
+  if (m_ring) {
+    m_ring->readPackets([&] (const uint8_t* frame, size_t length) {
+      handleFrame(frame, length, onFaceCreated, onReceiveFailed);
+    });
   }
   else {
-    const ether_header* eh;
-    std::tie(eh, err) = ethernet::checkFrameHeader(pkt, len, m_localEndpoint->getEthernetAddress(),
-                                                   m_localEndpoint->getEthernetAddress());
-    if (eh == nullptr) {
-      NFD_LOG_CHAN_DEBUG(err);
-    }
-    else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt += ethernet::HDR_LEN;
-      len -= ethernet::HDR_LEN;
-      processIncomingPacket(pkt, len, sender, onFaceCreated, onReceiveFailed);
-    }
+    const uint8_t* pkt;
+    size_t len;
+    std::string err;
+    std::tie(pkt, len, err) = m_pcap.readNextPacket();
+
+    if (pkt == nullptr)
+      NFD_LOG_CHAN_WARN("Read error: " << err);
+    else
+      handleFrame(pkt, len, onFaceCreated, onReceiveFailed);
   }
 
 #ifdef _DEBUG
-  size_t nDropped = m_pcap.getNDropped();
+  size_t nDropped = m_ring ? m_ring->getNDropped() : m_pcap.getNDropped();
   if (nDropped - m_nDropped > 0)
     NFD_LOG_CHAN_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
   m_nDropped = nDropped;
@@ -158,6 +186,25 @@ EthernetChannel::handleRead(const boost::system::error_code& error,
   asyncRead(onFaceCreated, onReceiveFailed);
 }
 
+void
+EthernetChannel::handleFrame(const uint8_t* frame, size_t length,
+                             const FaceCreatedCallback& onFaceCreated,
+                             const FaceCreationFailedCallback& onReceiveFailed)
+{
+  const ether_header* eh;
+  std::string err;
+  std::tie(eh, err) = ethernet::checkFrameHeader(frame, length, m_localEndpoint->getEthernetAddress(),
+                                                 m_localEndpoint->getEthernetAddress());
+  if (eh == nullptr) {
+    NFD_LOG_CHAN_DEBUG(err);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  processIncomingPacket(frame + ethernet::HDR_LEN, length - ethernet::HDR_LEN, sender,
+                        onFaceCreated, onReceiveFailed);
+}
+
 void
 EthernetChannel::processIncomingPacket(const uint8_t* packet, size_t length,
                                        const ethernet::Address& sender,
@@ -206,13 +253,30 @@ EthernetChannel::createFace(const ethernet::Address& remoteEndpoint,
   options.allowFragmentation = true;
   options.allowReassembly = true;
   options.reliabilityOptions.isEnabled = params.wantLpReliability;
+
+  if (boost::logic::indeterminate(params.wantCongestionMarking)) {
+    // Use default value for this channel if parameter is indeterminate
+    options.allowCongestionMarking = m_wantCongestionMarking;
+  }
+  else {
+    options.allowCongestionMarking = bool(params.wantCongestionMarking);
+  }
+
+  if (params.baseCongestionMarkingInterval) {
+    options.baseCongestionMarkingInterval = *params.baseCongestionMarkingInterval;
+  }
+  if (params.defaultCongestionThreshold) {
+    options.defaultCongestionThreshold = *params.defaultCongestionThreshold;
+  }
+
   if (params.mtu) {
     options.overrideMtu = *params.mtu;
   }
 
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastEthernetTransport>(*m_localEndpoint, remoteEndpoint,
-                                                         params.persistency, m_idleFaceTimeout);
+                                                         params.persistency, m_idleFaceTimeout,
+                                                         m_ring != nullptr, m_xdpSocket);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(shared_from_this()); // use weak_from_this() in C++17
 
@@ -229,7 +293,7 @@ EthernetChannel::createFace(const ethernet::Address& remoteEndpoint,
 void
 EthernetChannel::updateFilter()
 {
-  if (!isListening())
+  if (!isListening() || m_xdpSocket)
     return;
 
   std::string filter = "(ether proto " + to_string(ethernet::ETHERTYPE_NDN) +
@@ -242,7 +306,10 @@ EthernetChannel::updateFilter()
   filter += " && (not vlan)";
 
   NFD_LOG_CHAN_TRACE("Updating filter: " << filter);
-  m_pcap.setPacketFilter(filter.data());
+  if (m_ring)
+    m_ring->setPacketFilter(filter.data());
+  else
+    m_pcap.setPacketFilter(filter.data());
 }
 
 } // namespace face
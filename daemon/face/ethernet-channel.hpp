@@ -27,7 +27,9 @@
 #define NFD_DAEMON_FACE_ETHERNET_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "ethernet-packet-ring.hpp"
 #include "ethernet-protocol.hpp"
+#include "ethernet-xdp-socket.hpp"
 #include "pcap-helper.hpp"
 #include <ndn-cxx/net/network-interface.hpp>
 
@@ -58,9 +60,21 @@ public:
    *
    * To enable creation of faces upon incoming connections,
    * one needs to explicitly call EthernetChannel::listen method.
+   *
+   * Faces created by this channel mark packets upon congestion if \p wantCongestionMarking
+   * is true, unless FaceParams::wantCongestionMarking says otherwise.
+   *
+   * If \p wantPacketRing is true, the channel and the faces it creates capture frames
+   * with an EthernetPacketRing instead of libpcap. If \p xdpSocket is not null, they
+   * exchange frames through that AF_XDP socket of the interface instead.
    */
   EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                  time::nanoseconds idleTimeout);
+                  time::nanoseconds idleTimeout,
+                  bool wantCongestionMarking = false,
+                  bool wantPacketRing = false,
+                  shared_ptr<EthernetXdpSocket> xdpSocket = nullptr);
+
+  ~EthernetChannel() override;
 
   bool
   isListening() const override
@@ -116,6 +130,11 @@ private:
                         const FaceCreatedCallback& onFaceCreated,
                         const FaceCreationFailedCallback& onReceiveFailed);
 
+  void
+  handleFrame(const uint8_t* frame, size_t length,
+              const FaceCreatedCallback& onFaceCreated,
+              const FaceCreationFailedCallback& onReceiveFailed);
+
   std::pair<bool, shared_ptr<Face>>
   createFace(const ethernet::Address& remoteEndpoint,
              const FaceParams& params);
@@ -128,11 +147,14 @@ private:
   bool m_isListening;
   boost::asio::posix::stream_descriptor m_socket;
   PcapHelper m_pcap;
-  std::map<ethernet::Address, shared_ptr<Face>> m_channelFaces;
+  unique_ptr<EthernetPacketRing> m_ring; ///< used instead of m_pcap if non-null
+  shared_ptr<EthernetXdpSocket> m_xdpSocket; ///< used instead of m_pcap and m_ring if non-null
+  std::unordered_map<ethernet::Address, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
+  const bool m_wantCongestionMarking; ///< Default congestion marking setting of new faces
 
 #ifdef _DEBUG
-  /// number of frames dropped by the kernel, as reported by libpcap
+  /// number of frames dropped by the kernel, as reported by libpcap or the packet ring
   size_t m_nDropped;
 #endif
 };
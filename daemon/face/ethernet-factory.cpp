@@ -63,6 +63,8 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
   //   mcast yes
   //   mcast_group 01:00:5E:00:17:AA
   //   mcast_ad_hoc no
+  //   packet_ring no
+  //   xdp no
   //   whitelist
   //   {
   //     *
@@ -74,6 +76,8 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
 
   UnicastConfig unicastConfig;
   MulticastConfig mcastConfig;
+  bool wantPacketRing = false;
+  optional<EthernetXdpSocket::Mode> xdpMode;
 
   if (configSection) {
     // listen and mcast default to 'yes' but only if face_system.ether section is present
@@ -108,6 +112,36 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
         bool wantAdHoc = ConfigFile::parseYesNo(pair, "face_system.ether");
         mcastConfig.linkType = wantAdHoc ? ndn::nfd::LINK_TYPE_AD_HOC : ndn::nfd::LINK_TYPE_MULTI_ACCESS;
       }
+      else if (key == "packet_ring") {
+        wantPacketRing = ConfigFile::parseYesNo(pair, "face_system.ether");
+#ifndef __linux__
+        if (wantPacketRing) {
+          NDN_THROW(ConfigFile::Error("face_system.ether.packet_ring: "
+                                      "AF_PACKET rings are only supported on Linux"));
+        }
+#endif
+      }
+      else if (key == "xdp") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "generic") {
+          xdpMode = EthernetXdpSocket::Mode::GENERIC;
+        }
+        else if (valueStr == "native") {
+          xdpMode = EthernetXdpSocket::Mode::NATIVE;
+        }
+        else if (valueStr == "no") {
+          xdpMode = nullopt;
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.ether.xdp: '" + valueStr +
+                                      "' is not one of 'no', 'generic', 'native'"));
+        }
+#ifndef __linux__
+        if (xdpMode) {
+          NDN_THROW(ConfigFile::Error("face_system.ether.xdp: AF_XDP is only supported on Linux"));
+        }
+#endif
+      }
       else if (key == "whitelist") {
         mcastConfig.netifPredicate.parseWhitelist(value);
       }
@@ -157,10 +191,18 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     }
   }
 
+  if ((m_wantPacketRing != wantPacketRing || m_xdpMode != xdpMode) &&
+      (!m_channels.empty() || !m_mcastFaces.empty())) {
+    NFD_LOG_WARN("Packet ring and XDP settings apply to new Ethernet channels and faces only");
+  }
+
   // Even if there's no configuration change, we still need to re-apply configuration because
   // netifs may have changed.
   m_unicastConfig = unicastConfig;
   m_mcastConfig = mcastConfig;
+  m_wantPacketRing = wantPacketRing;
+  m_xdpMode = xdpMode;
+  m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
   this->applyConfig(context);
 }
 
@@ -223,7 +265,9 @@ EthernetFactory::createChannel(const shared_ptr<const ndn::net::NetworkInterface
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout);
+  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout,
+                                                   m_wantCongestionMarking, m_wantPacketRing,
+                                                   getXdpSocket(*localEndpoint));
   m_channels[localEndpoint->getName()] = channel;
   return channel;
 }
@@ -249,9 +293,11 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowCongestionMarking = m_wantCongestionMarking;
 
   auto linkService = make_unique<GenericLinkService>(opts);
-  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType);
+  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType,
+                                                           m_wantPacketRing, getXdpSocket(netif));
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[key] = face;
@@ -263,6 +309,32 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   return face;
 }
 
+shared_ptr<EthernetXdpSocket>
+EthernetFactory::getXdpSocket(const ndn::net::NetworkInterface& netif)
+{
+  if (!m_xdpMode) {
+    return nullptr;
+  }
+
+  auto& weakSocket = m_xdpSockets[netif.getName()];
+  auto socket = weakSocket.lock();
+  if (socket != nullptr) {
+    return socket;
+  }
+
+  socket = make_shared<EthernetXdpSocket>(netif, *m_xdpMode);
+  try {
+    socket->activate();
+  }
+  catch (const EthernetXdpSocket::Error& e) {
+    NFD_LOG_WARN("Cannot use AF_XDP on " << netif.getName() << ", falling back to " <<
+                 (m_wantPacketRing ? "packet ring" : "libpcap") << ": " << e.what());
+    return nullptr;
+  }
+  weakSocket = socket;
+  return socket;
+}
+
 shared_ptr<EthernetChannel>
 EthernetFactory::applyUnicastConfigToNetif(const shared_ptr<const ndn::net::NetworkInterface>& netif)
 {
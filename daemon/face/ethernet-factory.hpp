@@ -99,6 +99,12 @@ private:
   shared_ptr<Face>
   applyMcastConfigToNetif(const ndn::net::NetworkInterface& netif);
 
+  /** \brief Get the AF_XDP socket of \p netif, creating it if needed.
+   *  \return the socket, or nullptr if AF_XDP is disabled or cannot be used on \p netif
+   */
+  shared_ptr<EthernetXdpSocket>
+  getXdpSocket(const ndn::net::NetworkInterface& netif);
+
   void
   applyConfig(const FaceSystem::ConfigContext& context);
 
@@ -125,6 +131,17 @@ private:
   /// (ifname, group) => face
   std::map<std::pair<std::string, ethernet::Address>, shared_ptr<Face>> m_mcastFaces;
 
+  /// whether new channels and multicast faces use EthernetPacketRing instead of libpcap
+  bool m_wantPacketRing = false;
+
+  /// whether new channels and multicast faces mark packets when the send queue is congested
+  bool m_wantCongestionMarking = false;
+
+  /// AF_XDP mode of new channels and multicast faces, or nullopt to not use AF_XDP
+  optional<EthernetXdpSocket::Mode> m_xdpMode;
+  /// ifname => AF_XDP socket shared by the channel and faces on that netif
+  std::map<std::string, weak_ptr<EthernetXdpSocket>> m_xdpSockets;
+
   signal::ScopedConnection m_netifAddConn;
 };
 
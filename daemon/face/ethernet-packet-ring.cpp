@@ -0,0 +1,275 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-packet-ring.hpp"
+#include "ethernet-protocol.hpp"
+
+#include <pcap/pcap.h>
+#include <boost/endian/conversion.hpp>
+#include <cerrno>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <cstring> // for strerror()
+#include <net/if.h> // for if_nametoindex()
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#endif
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN  0xffffffff
+#endif
+
+namespace nfd {
+namespace face {
+
+constexpr size_t EthernetPacketRing::BLOCK_SIZE;
+constexpr size_t EthernetPacketRing::N_BLOCKS;
+constexpr unsigned int EthernetPacketRing::RETIRE_BLOCK_TIMEOUT_MS;
+
+EthernetPacketRing::EthernetPacketRing(const std::string& interfaceName)
+  : m_interfaceName(interfaceName)
+{
+}
+
+EthernetPacketRing::~EthernetPacketRing()
+{
+  close();
+}
+
+#ifdef __linux__
+
+static std::string
+getErrnoString()
+{
+  return std::strerror(errno);
+}
+
+void
+EthernetPacketRing::activate()
+{
+  unsigned int ifIndex = if_nametoindex(m_interfaceName.data());
+  if (ifIndex == 0)
+    NDN_THROW(Error("if_nametoindex: " + getErrnoString()));
+
+  // protocol 0: do not receive anything until the socket is bound to the interface
+  m_fd = ::socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+  if (m_fd < 0)
+    NDN_THROW(Error("socket: " + getErrnoString()));
+
+  int version = TPACKET_V3;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+    std::string err = getErrnoString();
+    close();
+    NDN_THROW(Error("setsockopt(PACKET_VERSION): " + err));
+  }
+
+  tpacket_req3 req{};
+  req.tp_block_size = BLOCK_SIZE;
+  req.tp_block_nr = N_BLOCKS;
+  // frames in a TPACKET_V3 block are variable-sized, but the kernel still
+  // validates the frame geometry; any aligned size that divides the block works
+  req.tp_frame_size = TPACKET_ALIGN(TPACKET3_HDRLEN + ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  req.tp_frame_nr = BLOCK_SIZE / req.tp_frame_size * N_BLOCKS;
+  req.tp_retire_blk_tov = RETIRE_BLOCK_TIMEOUT_MS;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+    std::string err = getErrnoString();
+    close();
+    NDN_THROW(Error("setsockopt(PACKET_RX_RING): " + err));
+  }
+
+  void* ring = ::mmap(nullptr, BLOCK_SIZE * N_BLOCKS, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (ring == MAP_FAILED) {
+    std::string err = getErrnoString();
+    close();
+    NDN_THROW(Error("mmap: " + err));
+  }
+  m_ring = static_cast<uint8_t*>(ring);
+  m_blockIndex = 0;
+
+#ifdef PACKET_QDISC_BYPASS
+  // not fatal: frames then go through the interface's queueing discipline, as with libpcap
+  int one = 1;
+  ::setsockopt(m_fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));
+#endif
+
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+  sll.sll_ifindex = static_cast<int>(ifIndex);
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0) {
+    std::string err = getErrnoString();
+    close();
+    NDN_THROW(Error("bind: " + err));
+  }
+}
+
+void
+EthernetPacketRing::close()
+{
+  if (m_ring != nullptr) {
+    ::munmap(m_ring, BLOCK_SIZE * N_BLOCKS);
+    m_ring = nullptr;
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+int
+EthernetPacketRing::getFd() const
+{
+  // we need to duplicate the fd, otherwise both close() and the
+  // caller may attempt to close the same fd and one of them will fail
+  int fd = ::dup(m_fd);
+  if (fd < 0)
+    NDN_THROW(Error("dup: " + getErrnoString()));
+  return fd;
+}
+
+size_t
+EthernetPacketRing::getNDropped() const
+{
+  // the kernel resets its counters on every read, so they must be accumulated here
+  tpacket_stats_v3 stats{};
+  socklen_t len = sizeof(stats);
+  if (m_fd >= 0 && ::getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) == 0)
+    m_nDropped += stats.tp_drops;
+  return m_nDropped;
+}
+
+void
+EthernetPacketRing::setPacketFilter(const char* filter) const
+{
+  pcap_t* dead = pcap_open_dead(DLT_EN10MB, ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  if (dead == nullptr)
+    NDN_THROW(Error("pcap_open_dead failed"));
+
+  bpf_program prog;
+  if (pcap_compile(dead, &prog, filter, 1, PCAP_NETMASK_UNKNOWN) < 0) {
+    std::string err = pcap_geterr(dead);
+    pcap_close(dead);
+    NDN_THROW(Error("pcap_compile: " + err));
+  }
+  pcap_close(dead);
+
+  // struct bpf_insn and struct sock_filter have the same layout
+  sock_fprog fprog{};
+  fprog.len = static_cast<unsigned short>(prog.bf_len);
+  fprog.filter = reinterpret_cast<sock_filter*>(prog.bf_insns);
+  int ret = ::setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  std::string err = ret < 0 ? getErrnoString() : "";
+  pcap_freecode(&prog);
+  if (ret < 0)
+    NDN_THROW(Error("setsockopt(SO_ATTACH_FILTER): " + err));
+}
+
+size_t
+EthernetPacketRing::readPackets(const FrameCallback& onFrame)
+{
+  size_t nFrames = 0;
+  while (m_ring != nullptr) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_ring + m_blockIndex * BLOCK_SIZE);
+    if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+      break;
+
+    auto frameHdr = reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    for (uint32_t i = 0; i < block->hdr.bh1.num_pkts; ++i) {
+      auto hdr = reinterpret_cast<const tpacket3_hdr*>(frameHdr);
+      auto sll = reinterpret_cast<const sockaddr_ll*>(frameHdr + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+      // a frame carrying a VLAN tag stripped by the NIC is not addressed to the untagged
+      // interface, which is what the "not vlan" clause of the filters means to exclude
+      if (hdr->tp_snaplen == hdr->tp_len &&
+          (hdr->tp_status & TP_STATUS_VLAN_VALID) == 0 &&
+          sll->sll_pkttype != PACKET_OUTGOING) {
+        onFrame(frameHdr + hdr->tp_mac, hdr->tp_snaplen);
+        ++nFrames;
+      }
+      frameHdr += hdr->tp_next_offset;
+    }
+
+    __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    m_blockIndex = (m_blockIndex + 1) % N_BLOCKS;
+  }
+  return nFrames;
+}
+
+ssize_t
+EthernetPacketRing::send(const uint8_t* frame, size_t length) const
+{
+  return ::send(m_fd, frame, length, 0);
+}
+
+#else // __linux__
+
+void
+EthernetPacketRing::activate()
+{
+  NDN_THROW(Error("AF_PACKET rings are not supported on this platform"));
+}
+
+void
+EthernetPacketRing::close()
+{
+}
+
+int
+EthernetPacketRing::getFd() const
+{
+  NDN_THROW(Error("AF_PACKET rings are not supported on this platform"));
+}
+
+size_t
+EthernetPacketRing::getNDropped() const
+{
+  return 0;
+}
+
+void
+EthernetPacketRing::setPacketFilter(const char*) const
+{
+  NDN_THROW(Error("AF_PACKET rings are not supported on this platform"));
+}
+
+size_t
+EthernetPacketRing::readPackets(const FrameCallback&)
+{
+  return 0;
+}
+
+ssize_t
+EthernetPacketRing::send(const uint8_t*, size_t) const
+{
+  errno = ENOTSUP;
+  return -1;
+}
+
+#endif // __linux__
+
+} // namespace face
+} // namespace nfd
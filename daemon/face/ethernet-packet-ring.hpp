@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "core/common.hpp"
+
+#ifndef HAVE_LIBPCAP
+#error "Cannot include this file when libpcap is not available"
+#endif
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief Receives and sends NDN Ethernet frames through a Linux AF_PACKET socket
+ *        with a memory-mapped TPACKET_V3 receive ring.
+ *
+ * This is an alternative to PcapHelper for Linux hosts. The kernel writes incoming frames
+ * into a ring of blocks shared with the process, and hands over a whole block at once;
+ * readPackets() then processes every frame in the block without any system call.
+ * A block is handed over when it is full, or after RETIRE_BLOCK_TIMEOUT_MS if it is not,
+ * which bounds the extra latency at low packet rates (see bug #1511).
+ *
+ * The socket is bound to the NDN ethertype on a single interface, so only incoming NDN frames
+ * reach the filter. Outgoing frames are sent with PACKET_QDISC_BYPASS where available.
+ * libpcap is only used to compile the BPF filter expressions.
+ */
+class EthernetPacketRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Invoked for each received frame, including the Ethernet header.
+   * @warning @p frame is valid only until the callback returns.
+   */
+  using FrameCallback = std::function<void(const uint8_t* frame, size_t length)>;
+
+  explicit
+  EthernetPacketRing(const std::string& interfaceName);
+
+  ~EthernetPacketRing();
+
+  /**
+   * @brief Open the socket, map the receive ring, and bind to the interface.
+   * @throw Error on any error, including on platforms other than Linux
+   */
+  void
+  activate();
+
+  /**
+   * @brief Unmap the ring and close the socket.
+   */
+  void
+  close();
+
+  /**
+   * @brief Obtain a file descriptor that becomes readable when a ring block is ready.
+   * @pre activate() has been called.
+   * @return A selectable file descriptor. It is the caller's responsibility to close the fd.
+   * @throw Error on any error
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Get the number of frames dropped by the kernel because the ring was full.
+   */
+  size_t
+  getNDropped() const;
+
+  /**
+   * @brief Compile a pcap-filter(7) expression and attach it to the socket.
+   * @pre activate() has been called.
+   * @throw Error on any error
+   */
+  void
+  setPacketFilter(const char* filter) const;
+
+  /**
+   * @brief Process all frames in the blocks that the kernel has handed over.
+   *
+   * Truncated frames, VLAN-tagged frames, and frames sent by this host are skipped.
+   * Each block is returned to the kernel after all of its frames have been processed.
+   *
+   * @return Number of frames passed to @p onFrame
+   */
+  size_t
+  readPackets(const FrameCallback& onFrame);
+
+  /**
+   * @brief Send a complete Ethernet frame.
+   * @return Number of octets sent, or -1 with errno set
+   */
+  ssize_t
+  send(const uint8_t* frame, size_t length) const;
+
+public:
+  static constexpr size_t BLOCK_SIZE = 256 * 1024;
+  static constexpr size_t N_BLOCKS = 16;
+  static constexpr unsigned int RETIRE_BLOCK_TIMEOUT_MS = 1;
+
+private:
+  std::string m_interfaceName;
+  int m_fd = -1;
+  uint8_t* m_ring = nullptr;
+  size_t m_blockIndex = 0;
+  mutable size_t m_nDropped = 0;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
@@ -25,23 +25,32 @@
 
 #include "ethernet-transport.hpp"
 #include "ethernet-protocol.hpp"
+#include "socket-utils.hpp"
 #include "common/global.hpp"
 
 #include <pcap/pcap.h>
 
-#include <cstring> // for memcpy()
+#include <cerrno>  // for errno
+#include <cstring> // for memcpy(), strerror()
 
 #include <boost/endian/conversion.hpp>
 
+#ifdef __linux__
+#include <sys/socket.h> // for socket()
+#endif
+
 namespace nfd {
 namespace face {
 
 NFD_LOG_INIT(EthernetTransport);
 
 EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                                     const ethernet::Address& remoteEndpoint)
+                                     const ethernet::Address& remoteEndpoint,
+                                     bool wantPacketRing,
+                                     shared_ptr<EthernetXdpSocket> xdpSocket)
   : m_socket(getGlobalIoService())
   , m_pcap(localEndpoint.getName())
+  , m_xdpSocket(std::move(xdpSocket))
   , m_srcAddress(localEndpoint.getEthernetAddress())
   , m_destAddress(remoteEndpoint)
   , m_interfaceName(localEndpoint.getName())
@@ -50,12 +59,34 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
   , m_nDropped(0)
 #endif
 {
-  try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+  if (m_xdpSocket) {
+#ifdef __linux__
+    // this socket never receives anything, since it is not bound to any protocol
+    int fd = ::socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+      NDN_THROW(Error("socket: "s + std::strerror(errno)));
+    m_socket.assign(fd);
+#endif
+    m_xdpSocket->addReceiver(m_destAddress, *this);
+  }
+  else if (wantPacketRing) {
+    try {
+      m_ring = make_unique<EthernetPacketRing>(m_interfaceName);
+      m_ring->activate();
+      m_socket.assign(m_ring->getFd());
+    }
+    catch (const EthernetPacketRing::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
   }
-  catch (const PcapHelper::Error& e) {
-    NDN_THROW_NESTED(Error(e.what()));
+  else {
+    try {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+    }
+    catch (const PcapHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
   }
 
   // Set initial transport state based upon the state of the underlying NetworkInterface
@@ -68,10 +99,17 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
 
   m_netifMtuChangedConn = localEndpoint.onMtuChanged.connect(
     [this] (uint32_t, uint32_t mtu) {
-      setMtu(mtu);
+      setMtuFromNetif(mtu);
     });
 
-  asyncRead();
+  if (!m_xdpSocket)
+    asyncRead();
+}
+
+EthernetTransport::~EthernetTransport()
+{
+  if (m_xdpSocket)
+    m_xdpSocket->removeReceiver(m_destAddress, *this);
 }
 
 void
@@ -87,14 +125,59 @@ EthernetTransport::doClose()
     m_socket.close(error);
   }
   m_pcap.close();
+  if (m_xdpSocket)
+    m_xdpSocket->removeReceiver(m_destAddress, *this);
 
   // Ensure that the Transport stays alive at least
   // until all pending handlers are dispatched
   getGlobalIoService().post([this] {
+    // the ring is unmapped only now, since doClose can be called while a frame
+    // in the ring is being processed
+    if (m_ring)
+      m_ring->close();
     this->setState(TransportState::CLOSED);
   });
 }
 
+ssize_t
+EthernetTransport::getSendQueueLength()
+{
+  if (m_xdpSocket)
+    return static_cast<ssize_t>(m_xdpSocket->getTxQueueBytes(m_destAddress));
+
+  if (!m_socket.is_open())
+    return QUEUE_ERROR;
+
+  ssize_t queueLength = getTxQueueLength(m_socket.native_handle());
+  if (queueLength == QUEUE_ERROR) {
+    NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+  }
+  return queueLength;
+}
+
+void
+EthernetTransport::setMtuFromNetif(uint32_t netifMtu)
+{
+  ssize_t mtu = netifMtu;
+  if (m_xdpSocket) {
+    // a frame, including its header, must fit in a UMEM chunk
+    mtu = std::min<ssize_t>(mtu, EthernetXdpSocket::FRAME_SIZE - ethernet::HDR_LEN);
+  }
+  this->setMtu(mtu);
+}
+
+void
+EthernetTransport::setPacketFilter(const char* filter)
+{
+  if (m_xdpSocket)
+    return;
+
+  if (m_ring)
+    m_ring->setPacketFilter(filter);
+  else
+    m_pcap.setPacketFilter(filter);
+}
+
 void
 EthernetTransport::handleNetifStateChange(ndn::net::InterfaceState netifState)
 {
@@ -135,9 +218,30 @@ EthernetTransport::sendPacket(const ndn::Block& block)
   buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
 
   // send the frame
-  int sent = pcap_inject(m_pcap, buffer.buf(), buffer.size());
+  if (m_xdpSocket) {
+    if (!m_xdpSocket->send(buffer.buf(), buffer.size()))
+      NFD_LOG_FACE_DEBUG("AF_XDP transmit ring full, frame dropped");
+    else
+      NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
+    return;
+  }
+
+  ssize_t sent = 0;
+  if (m_ring) {
+    sent = m_ring->send(buffer.buf(), buffer.size());
+    if (sent < 0 && (errno == ENOBUFS || errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // the device queue is full; as on any Ethernet link, this is a loss rather than a failure
+      NFD_LOG_FACE_DEBUG("Send queue full, frame dropped");
+      return;
+    }
+  }
+  else {
+    sent = pcap_inject(m_pcap, buffer.buf(), buffer.size());
+  }
+
   if (sent < 0)
-    handleError("Send operation failed: " + m_pcap.getLastError());
+    handleError("Send operation failed: " +
+                (m_ring ? std::string(std::strerror(errno)) : m_pcap.getLastError()));
   else if (static_cast<size_t>(sent) < buffer.size())
     handleError("Failed to send the full frame: size=" + to_string(buffer.size()) +
                 " sent=" + to_string(sent));
@@ -168,31 +272,30 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
     return;
   }
 
-  const uint8_t* pkt;
-  size_t len;
-  std::string err;
-  std::tie(pkt, len, err) = m_pcap.readNextPacket();
-
-  if (pkt == nullptr) {
-    NFD_LOG_FACE_WARN("Read error: " << err);
+  if (m_ring) {
+    m_ring->readPackets([this] (const uint8_t* frame, size_t length) {
+      // stop delivering frames once a previous one has caused the transport to close
+      if (m_socket.is_open())
+        handleFrame(frame, length);
+    });
   }
   else {
-    const ether_header* eh;
-    std::tie(eh, err) = ethernet::checkFrameHeader(pkt, len, m_srcAddress,
-                                                   m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
-    if (eh == nullptr) {
-      NFD_LOG_FACE_WARN(err);
-    }
-    else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt += ethernet::HDR_LEN;
-      len -= ethernet::HDR_LEN;
-      receivePayload(pkt, len, sender);
-    }
+    const uint8_t* pkt;
+    size_t len;
+    std::string err;
+    std::tie(pkt, len, err) = m_pcap.readNextPacket();
+
+    if (pkt == nullptr)
+      NFD_LOG_FACE_WARN("Read error: " << err);
+    else
+      handleFrame(pkt, len);
   }
 
+  if (!m_socket.is_open())
+    return;
+
 #ifdef _DEBUG
-  size_t nDropped = m_pcap.getNDropped();
+  size_t nDropped = getNDropped();
   if (nDropped - m_nDropped > 0)
     NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
   m_nDropped = nDropped;
@@ -201,6 +304,28 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
   asyncRead();
 }
 
+void
+EthernetTransport::handleFrame(const uint8_t* frame, size_t length)
+{
+  const ether_header* eh;
+  std::string err;
+  std::tie(eh, err) = ethernet::checkFrameHeader(frame, length, m_srcAddress,
+                                                 m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
+  if (eh == nullptr) {
+    NFD_LOG_FACE_WARN(err);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  receivePayload(frame + ethernet::HDR_LEN, length - ethernet::HDR_LEN, sender);
+}
+
+size_t
+EthernetTransport::getNDropped() const
+{
+  return m_ring ? m_ring->getNDropped() : m_pcap.getNDropped();
+}
+
 void
 EthernetTransport::receivePayload(const uint8_t* payload, size_t length,
                                   const ethernet::Address& sender)
@@ -215,11 +340,33 @@ EthernetTransport::receivePayload(const uint8_t* payload, size_t length,
     // This packet won't extend the face lifetime
     return;
   }
+
+  // The frame may contain several packets packed by the sender, followed by padding.
+  // Padding consists of zero octets, which never start a valid TLV element. As with UDP
+  // datagrams, the whole frame is dropped if any other octets cannot be parsed.
+  std::vector<Block> packedElements;
+  for (size_t pos = element.size(); pos < length && payload[pos] != 0;
+       pos += packedElements.back().size()) {
+    Block next;
+    std::tie(isOk, next) = Block::fromBuffer(payload + pos, length - pos);
+    if (!isOk) {
+      NFD_LOG_FACE_WARN("Failed to parse packed packet from " << sender);
+      // This packet won't extend the face lifetime
+      return;
+    }
+    packedElements.push_back(std::move(next));
+  }
   m_hasRecentlyReceived = true;
 
   EndpointId endpoint;
   endpoint = (m_destAddress.isMulticast() == true) ? sender : endpoint;
   this->receive(element, endpoint);
+  for (const auto& packet : packedElements) {
+    if (getState() != TransportState::UP) {
+      break;
+    }
+    this->receive(packet, endpoint);
+  }
 }
 
 void
@@ -26,7 +26,9 @@
 #ifndef NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
 #define NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
 
+#include "ethernet-packet-ring.hpp"
 #include "ethernet-protocol.hpp"
+#include "ethernet-xdp-socket.hpp"
 #include "pcap-helper.hpp"
 #include "transport.hpp"
 
@@ -57,13 +59,51 @@ public:
   receivePayload(const uint8_t* payload, size_t length,
                  const ethernet::Address& sender);
 
+  /**
+   * @brief Returns the number of octets waiting to be transmitted on the interface
+   *
+   * With libpcap or a packet ring, this is the SIOCOUTQ value of the AF_PACKET socket, i.e.
+   * frames sent by this face that the device has not released yet. With AF_XDP, the TX ring is
+   * shared by all faces on the interface, and this is the part of its occupancy made of frames
+   * sent to the destination address of this face.
+   */
+  ssize_t
+  getSendQueueLength() final;
+
 protected:
+  /**
+   * @param wantPacketRing if true, use an EthernetPacketRing instead of libpcap
+   * @param xdpSocket if not null, exchange frames through this AF_XDP socket of the
+   *                  interface instead; @p wantPacketRing is then ignored
+   * @throw Error the capture handle cannot be opened
+   */
   EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                    const ethernet::Address& remoteEndpoint);
+                    const ethernet::Address& remoteEndpoint,
+                    bool wantPacketRing = false,
+                    shared_ptr<EthernetXdpSocket> xdpSocket = nullptr);
+
+  ~EthernetTransport() override;
 
   void
   doClose() final;
 
+  /**
+   * @brief Sets the MTU of the transport from the MTU of the network interface
+   *
+   * With AF_XDP, the MTU is at most EthernetXdpSocket::FRAME_SIZE minus the Ethernet header,
+   * because larger frames would not fit in a UMEM chunk and would be dropped.
+   */
+  void
+  setMtuFromNetif(uint32_t netifMtu);
+
+  /**
+   * @brief Installs a BPF filter on whichever capture handle is in use
+   *
+   * This has no effect with an AF_XDP socket, which dispatches frames by address.
+   */
+  void
+  setPacketFilter(const char* filter);
+
   bool
   hasRecentlyReceived() const
   {
@@ -95,12 +135,24 @@ private:
   void
   handleRead(const boost::system::error_code& error);
 
+  void
+  handleFrame(const uint8_t* frame, size_t length);
+
+  size_t
+  getNDropped() const;
+
   void
   handleError(const std::string& errorMessage);
 
 protected:
   boost::asio::posix::stream_descriptor m_socket;
   PcapHelper m_pcap;
+  /// used instead of m_pcap if non-null; closed only after doClose returns to the
+  /// io_service, because a received frame may cause the transport to be closed
+  unique_ptr<EthernetPacketRing> m_ring;
+  /// used instead of m_pcap and m_ring if non-null; m_socket then only
+  /// holds per-face state of the interface, such as multicast memberships
+  shared_ptr<EthernetXdpSocket> m_xdpSocket;
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   std::string m_interfaceName;
@@ -110,7 +162,7 @@ private:
   signal::ScopedConnection m_netifMtuChangedConn;
   bool m_hasRecentlyReceived;
 #ifdef _DEBUG
-  /// number of frames dropped by the kernel, as reported by libpcap
+  /// number of frames dropped by the kernel, as reported by libpcap or the packet ring
   size_t m_nDropped;
 #endif
 };
@@ -0,0 +1,569 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-xdp-socket.hpp"
+#include "ethernet-transport.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
+
+#ifdef __linux__
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+#endif // __linux__
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(EthernetXdpSocket);
+
+constexpr size_t EthernetXdpSocket::FRAME_SIZE;
+constexpr uint32_t EthernetXdpSocket::RING_SIZE;
+constexpr size_t EthernetXdpSocket::N_FRAMES;
+const time::nanoseconds EthernetXdpSocket::COUNTERS_CHECK_INTERVAL = 10_s;
+
+EthernetXdpSocket::EthernetXdpSocket(const ndn::net::NetworkInterface& netif, Mode mode)
+  : m_interfaceName(netif.getName())
+  , m_interfaceIndex(netif.getIndex())
+  , m_localAddress(netif.getEthernetAddress())
+  , m_mode(mode)
+  , m_socket(getGlobalIoService())
+{
+}
+
+EthernetXdpSocket::~EthernetXdpSocket()
+{
+  close();
+}
+
+void
+EthernetXdpSocket::addReceiver(const ethernet::Address& remote, EthernetTransport& transport)
+{
+  m_receivers[remote] = &transport;
+}
+
+void
+EthernetXdpSocket::removeReceiver(const ethernet::Address& remote, const EthernetTransport& transport)
+{
+  auto it = m_receivers.find(remote);
+  if (it != m_receivers.end() && it->second == &transport) {
+    m_receivers.erase(it);
+  }
+}
+
+void
+EthernetXdpSocket::dispatchFrame(const uint8_t* frame, size_t length)
+{
+  // the XDP program only redirects frames with the NDN ethertype
+  if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN) {
+    NFD_LOG_DEBUG("Received frame too short: " << length << " bytes");
+    return;
+  }
+
+  auto eh = reinterpret_cast<const ether_header*>(frame);
+  ethernet::Address sender(eh->ether_shost);
+  ethernet::Address dest(eh->ether_dhost);
+  const uint8_t* payload = frame + ethernet::HDR_LEN;
+  size_t payloadLength = length - ethernet::HDR_LEN;
+
+  if (dest.isMulticast()) {
+    if (sender == m_localAddress)
+      return;
+    auto it = m_receivers.find(dest);
+    if (it != m_receivers.end())
+      it->second->receivePayload(payload, payloadLength, sender);
+  }
+  else if (dest == m_localAddress) {
+    auto it = m_receivers.find(sender);
+    if (it != m_receivers.end())
+      it->second->receivePayload(payload, payloadLength, sender);
+    else if (m_defaultReceiver)
+      m_defaultReceiver(payload, payloadLength, sender);
+  }
+}
+
+void
+EthernetXdpSocket::asyncRead()
+{
+  m_socket.async_read_some(boost::asio::null_buffers(),
+                           [this] (const auto& e, auto) { this->handleRead(e); });
+}
+
+void
+EthernetXdpSocket::scheduleCountersCheck()
+{
+  m_countersCheckEvent = getScheduler().schedule(COUNTERS_CHECK_INTERVAL, [this] {
+    checkCounters();
+    scheduleCountersCheck();
+  });
+}
+
+void
+EthernetXdpSocket::checkCounters()
+{
+  Counters counters = getCounters();
+  uint64_t nFillRingEmpty = counters.nFillRingEmpty - m_checkedCounters.nFillRingEmpty;
+  uint64_t nRxRingFull = counters.nRxRingFull - m_checkedCounters.nRxRingFull;
+  uint64_t nRxDropped = counters.nRxDropped - m_checkedCounters.nRxDropped;
+  uint64_t nTxDropped = counters.nTxDropped - m_checkedCounters.nTxDropped;
+  uint64_t nTxInvalid = counters.nTxInvalid - m_checkedCounters.nTxInvalid;
+  m_checkedCounters = counters;
+
+  if (nFillRingEmpty + nRxRingFull + nRxDropped + nTxDropped + nTxInvalid > 0) {
+    NFD_LOG_WARN("AF_XDP losses on " << m_interfaceName << " in the last " <<
+                 time::duration_cast<time::seconds>(COUNTERS_CHECK_INTERVAL) <<
+                 ": fill-ring-empty=" << nFillRingEmpty << " rx-ring-full=" << nRxRingFull <<
+                 " rx-dropped=" << nRxDropped << " tx-dropped=" << nTxDropped <<
+                 " tx-invalid=" << nTxInvalid);
+  }
+}
+
+#ifdef __linux__
+
+static std::string
+getErrnoString()
+{
+  return std::strerror(errno);
+}
+
+static int
+bpf(int cmd, bpf_attr& attr)
+{
+  return static_cast<int>(::syscall(__NR_bpf, cmd, &attr, sizeof(attr)));
+}
+
+void
+EthernetXdpSocket::activate()
+{
+  try {
+    m_fd = ::socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (m_fd < 0)
+      NDN_THROW(Error("socket(AF_XDP): " + getErrnoString()));
+
+    void* umem = ::mmap(nullptr, N_FRAMES * FRAME_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (umem == MAP_FAILED)
+      NDN_THROW(Error("mmap: " + getErrnoString()));
+    m_umem = static_cast<uint8_t*>(umem);
+
+    xdp_umem_reg reg{};
+    reg.addr = reinterpret_cast<uintptr_t>(m_umem);
+    reg.len = N_FRAMES * FRAME_SIZE;
+    reg.chunk_size = FRAME_SIZE;
+    if (::setsockopt(m_fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0)
+      NDN_THROW(Error("setsockopt(XDP_UMEM_REG): " + getErrnoString()));
+
+    uint32_t ringSize = RING_SIZE;
+    for (int opt : {XDP_UMEM_FILL_RING, XDP_UMEM_COMPLETION_RING, XDP_RX_RING, XDP_TX_RING}) {
+      if (::setsockopt(m_fd, SOL_XDP, opt, &ringSize, sizeof(ringSize)) < 0)
+        NDN_THROW(Error("setsockopt(SOL_XDP, " + to_string(opt) + "): " + getErrnoString()));
+    }
+
+    xdp_mmap_offsets off{};
+    socklen_t optlen = sizeof(off);
+    if (::getsockopt(m_fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) < 0)
+      NDN_THROW(Error("getsockopt(XDP_MMAP_OFFSETS): " + getErrnoString()));
+
+    mapRing(m_rxRing, XDP_PGOFF_RX_RING, off.rx.producer, off.rx.consumer, off.rx.desc,
+            sizeof(xdp_desc));
+    mapRing(m_txRing, XDP_PGOFF_TX_RING, off.tx.producer, off.tx.consumer, off.tx.desc,
+            sizeof(xdp_desc));
+    mapRing(m_fillRing, XDP_UMEM_PGOFF_FILL_RING, off.fr.producer, off.fr.consumer, off.fr.desc,
+            sizeof(uint64_t));
+    mapRing(m_completionRing, XDP_UMEM_PGOFF_COMPLETION_RING, off.cr.producer, off.cr.consumer,
+            off.cr.desc, sizeof(uint64_t));
+
+    // the first half of the UMEM is handed to the kernel for receiving, the rest is kept for sending
+    auto fill = reinterpret_cast<uint64_t*>(m_fillRing.descs);
+    for (uint32_t i = 0; i < RING_SIZE; ++i) {
+      fill[i] = i * FRAME_SIZE;
+    }
+    __atomic_store_n(m_fillRing.producer, RING_SIZE, __ATOMIC_RELEASE);
+    for (size_t i = RING_SIZE; i < N_FRAMES; ++i) {
+      m_freeTxFrames.push_back(i * FRAME_SIZE);
+    }
+    m_txFrameLengths.assign(N_FRAMES, 0);
+    m_txFrameDestinations.assign(N_FRAMES, {});
+    m_txQueueBytes.clear();
+
+    sockaddr_xdp sxdp{};
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = static_cast<uint32_t>(m_interfaceIndex);
+    sxdp.sxdp_queue_id = 0;
+    sxdp.sxdp_flags = XDP_ZEROCOPY;
+    m_isZeroCopy = m_mode == Mode::NATIVE &&
+                   ::bind(m_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) == 0;
+    if (!m_isZeroCopy) {
+      sxdp.sxdp_flags = XDP_COPY;
+      if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) < 0)
+        NDN_THROW(Error("bind(AF_XDP): " + getErrnoString()));
+    }
+
+    attachProgram();
+
+    m_socket.assign(::dup(m_fd));
+  }
+  catch (const Error&) {
+    close();
+    throw;
+  }
+
+  NFD_LOG_INFO("Receiving NDN frames on " << m_interfaceName << " through AF_XDP (" <<
+               (m_mode == Mode::NATIVE ? "native" : "generic") << " mode, " <<
+               (m_isZeroCopy ? "zero-copy" : "copy") << ")");
+  asyncRead();
+  m_checkedCounters = getCounters();
+  scheduleCountersCheck();
+}
+
+void
+EthernetXdpSocket::attachProgram()
+{
+  bpf_attr attr{};
+  attr.map_type = BPF_MAP_TYPE_XSKMAP;
+  attr.key_size = sizeof(uint32_t);
+  attr.value_size = sizeof(uint32_t);
+  attr.max_entries = 1;
+  int mapFd = bpf(BPF_MAP_CREATE, attr);
+  if (mapFd < 0)
+    NDN_THROW(Error("bpf(BPF_MAP_CREATE): " + getErrnoString()));
+
+  uint32_t queueId = 0;
+  attr = {};
+  attr.map_fd = static_cast<uint32_t>(mapFd);
+  attr.key = reinterpret_cast<uintptr_t>(&queueId);
+  attr.value = reinterpret_cast<uintptr_t>(&m_fd);
+  if (bpf(BPF_MAP_UPDATE_ELEM, attr) < 0) {
+    std::string err = getErrnoString();
+    ::close(mapFd);
+    NDN_THROW(Error("bpf(BPF_MAP_UPDATE_ELEM): " + err));
+  }
+
+  // if (data + 14 <= data_end && ethertype == NDN)
+  //   return bpf_redirect_map(&xsks, rx_queue_index, XDP_PASS);
+  // return XDP_PASS;
+  const bpf_insn insns[] = {
+    {BPF_LDX | BPF_MEM | BPF_W, 2, 1, offsetof(xdp_md, data), 0},
+    {BPF_LDX | BPF_MEM | BPF_W, 3, 1, offsetof(xdp_md, data_end), 0},
+    {BPF_ALU64 | BPF_MOV | BPF_X, 4, 2, 0, 0},
+    {BPF_ALU64 | BPF_ADD | BPF_K, 4, 0, 0, ethernet::HDR_LEN},
+    {BPF_JMP | BPF_JGT | BPF_X, 4, 3, 8, 0},
+    {BPF_LDX | BPF_MEM | BPF_H, 4, 2, 12, 0},
+    {BPF_JMP | BPF_JNE | BPF_K, 4, 0, 6, boost::endian::native_to_big(ethernet::ETHERTYPE_NDN)},
+    {BPF_LDX | BPF_MEM | BPF_W, 2, 1, offsetof(xdp_md, rx_queue_index), 0},
+    {BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0, mapFd},
+    {0, 0, 0, 0, 0},
+    {BPF_ALU64 | BPF_MOV | BPF_K, 3, 0, 0, XDP_PASS},
+    {BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map},
+    {BPF_JMP | BPF_EXIT, 0, 0, 0, 0},
+    {BPF_ALU64 | BPF_MOV | BPF_K, 0, 0, 0, XDP_PASS},
+    {BPF_JMP | BPF_EXIT, 0, 0, 0, 0},
+  };
+  static const char license[] = "GPL";
+
+  attr = {};
+  attr.prog_type = BPF_PROG_TYPE_XDP;
+  attr.insn_cnt = sizeof(insns) / sizeof(insns[0]);
+  attr.insns = reinterpret_cast<uintptr_t>(insns);
+  attr.license = reinterpret_cast<uintptr_t>(license);
+  int progFd = bpf(BPF_PROG_LOAD, attr);
+  std::string err = progFd < 0 ? getErrnoString() : "";
+  // the program holds a reference to the map
+  ::close(mapFd);
+  if (progFd < 0)
+    NDN_THROW(Error("bpf(BPF_PROG_LOAD): " + err));
+
+  // the program stays attached as long as the link fd is open, so it
+  // cannot outlive this socket even if NFD terminates abnormally
+  attr = {};
+  attr.link_create.prog_fd = static_cast<uint32_t>(progFd);
+  attr.link_create.target_fd = static_cast<uint32_t>(m_interfaceIndex);
+  attr.link_create.attach_type = BPF_XDP;
+  attr.link_create.flags = m_mode == Mode::NATIVE ? XDP_FLAGS_DRV_MODE : XDP_FLAGS_SKB_MODE;
+  m_linkFd = bpf(BPF_LINK_CREATE, attr);
+  err = m_linkFd < 0 ? getErrnoString() : "";
+  ::close(progFd);
+  if (m_linkFd < 0)
+    NDN_THROW(Error("bpf(BPF_LINK_CREATE): " + err));
+}
+
+void
+EthernetXdpSocket::mapRing(Ring& ring, uint64_t pageOffset, uint64_t producerOffset,
+                           uint64_t consumerOffset, uint64_t descsOffset, size_t descSize)
+{
+  size_t areaSize = descsOffset + RING_SIZE * descSize;
+  void* area = ::mmap(nullptr, areaSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      m_fd, static_cast<off_t>(pageOffset));
+  if (area == MAP_FAILED)
+    NDN_THROW(Error("mmap(AF_XDP ring): " + getErrnoString()));
+
+  auto base = static_cast<uint8_t*>(area);
+  ring.area = area;
+  ring.areaSize = areaSize;
+  ring.producer = reinterpret_cast<uint32_t*>(base + producerOffset);
+  ring.consumer = reinterpret_cast<uint32_t*>(base + consumerOffset);
+  ring.descs = base + descsOffset;
+}
+
+void
+EthernetXdpSocket::unmapRing(Ring& ring)
+{
+  if (ring.area != nullptr) {
+    ::munmap(ring.area, ring.areaSize);
+  }
+  ring = {};
+}
+
+void
+EthernetXdpSocket::close()
+{
+  m_countersCheckEvent.cancel();
+  if (m_socket.is_open()) {
+    boost::system::error_code error;
+    m_socket.cancel(error);
+    m_socket.close(error);
+  }
+  if (m_linkFd >= 0) {
+    // detaches the XDP program, returning NDN frames to the kernel network stack
+    ::close(m_linkFd);
+    m_linkFd = -1;
+  }
+  unmapRing(m_rxRing);
+  unmapRing(m_txRing);
+  unmapRing(m_fillRing);
+  unmapRing(m_completionRing);
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  if (m_umem != nullptr) {
+    ::munmap(m_umem, N_FRAMES * FRAME_SIZE);
+    m_umem = nullptr;
+  }
+  m_freeTxFrames.clear();
+  m_txFrameLengths.clear();
+  m_txFrameDestinations.clear();
+  m_txQueueBytes.clear();
+}
+
+void
+EthernetXdpSocket::handleRead(const boost::system::error_code& error)
+{
+  if (error) {
+    // the socket may already have been destructed if the operation was aborted
+    if (error != boost::asio::error::operation_aborted)
+      NFD_LOG_WARN("Receive operation on " << m_interfaceName << " failed: " << error.message());
+    return;
+  }
+
+  auto descs = reinterpret_cast<const xdp_desc*>(m_rxRing.descs);
+  auto fill = reinterpret_cast<uint64_t*>(m_fillRing.descs);
+  uint32_t cons = *m_rxRing.consumer;
+  uint32_t prod = __atomic_load_n(m_rxRing.producer, __ATOMIC_ACQUIRE);
+  uint32_t fillProd = *m_fillRing.producer;
+
+  // every chunk taken from the RX ring came from the fill ring, so there is always room
+  // to give it back; the payload has been copied into a Block when dispatchFrame returns
+  for (; cons != prod; ++cons) {
+    const xdp_desc& desc = descs[cons & (RING_SIZE - 1)];
+    dispatchFrame(m_umem + desc.addr, desc.len);
+    fill[fillProd++ & (RING_SIZE - 1)] = desc.addr & ~static_cast<uint64_t>(FRAME_SIZE - 1);
+  }
+  __atomic_store_n(m_rxRing.consumer, cons, __ATOMIC_RELEASE);
+  __atomic_store_n(m_fillRing.producer, fillProd, __ATOMIC_RELEASE);
+
+  asyncRead();
+}
+
+void
+EthernetXdpSocket::reclaimTxFrames()
+{
+  auto addrs = reinterpret_cast<const uint64_t*>(m_completionRing.descs);
+  uint32_t cons = *m_completionRing.consumer;
+  uint32_t prod = __atomic_load_n(m_completionRing.producer, __ATOMIC_ACQUIRE);
+  for (; cons != prod; ++cons) {
+    uint64_t addr = addrs[cons & (RING_SIZE - 1)];
+    auto queue = m_txQueueBytes.find(m_txFrameDestinations[addr / FRAME_SIZE]);
+    BOOST_ASSERT(queue != m_txQueueBytes.end());
+    queue->second -= m_txFrameLengths[addr / FRAME_SIZE];
+    if (queue->second == 0) {
+      m_txQueueBytes.erase(queue);
+    }
+    m_freeTxFrames.push_back(addr);
+  }
+  __atomic_store_n(m_completionRing.consumer, cons, __ATOMIC_RELEASE);
+}
+
+void
+EthernetXdpSocket::wakeupTx()
+{
+  m_isTxWakeupPending = false;
+  if (m_fd < 0)
+    return;
+
+  // in copy mode, the kernel transmits the queued frames during this call
+  if (::sendto(m_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0) < 0 &&
+      errno != EAGAIN && errno != EBUSY && errno != ENOBUFS && errno != ENETDOWN) {
+    NFD_LOG_DEBUG("Transmit wakeup on " << m_interfaceName << " failed: " << getErrnoString());
+  }
+}
+
+bool
+EthernetXdpSocket::send(const uint8_t* frame, size_t length)
+{
+  if (m_fd < 0 || length < ethernet::HDR_LEN || length > FRAME_SIZE) {
+    ++m_nTxDropped;
+    return false;
+  }
+
+  reclaimTxFrames();
+  uint32_t prod = *m_txRing.producer;
+  if (m_freeTxFrames.empty() || prod - __atomic_load_n(m_txRing.consumer, __ATOMIC_ACQUIRE) >= RING_SIZE) {
+    // flush the pending batch to make room
+    wakeupTx();
+    reclaimTxFrames();
+    if (m_freeTxFrames.empty() || prod - __atomic_load_n(m_txRing.consumer, __ATOMIC_ACQUIRE) >= RING_SIZE) {
+      ++m_nTxDropped;
+      return false;
+    }
+  }
+
+  uint64_t addr = m_freeTxFrames.back();
+  m_freeTxFrames.pop_back();
+  std::memcpy(m_umem + addr, frame, length);
+  ethernet::Address destination(reinterpret_cast<const ether_header*>(frame)->ether_dhost);
+  m_txFrameLengths[addr / FRAME_SIZE] = static_cast<uint16_t>(length);
+  m_txFrameDestinations[addr / FRAME_SIZE] = destination;
+  m_txQueueBytes[destination] += length;
+
+  auto& desc = reinterpret_cast<xdp_desc*>(m_txRing.descs)[prod & (RING_SIZE - 1)];
+  desc.addr = addr;
+  desc.len = static_cast<uint32_t>(length);
+  desc.options = 0;
+  __atomic_store_n(m_txRing.producer, prod + 1, __ATOMIC_RELEASE);
+
+  // frames sent while processing the same event are transmitted with a single system call
+  if (!m_isTxWakeupPending) {
+    m_isTxWakeupPending = true;
+    getGlobalIoService().post([weakSelf = weak_ptr<EthernetXdpSocket>(shared_from_this())] {
+      if (auto self = weakSelf.lock()) {
+        self->wakeupTx();
+      }
+    });
+  }
+  return true;
+}
+
+size_t
+EthernetXdpSocket::getTxQueueBytes(const ethernet::Address& destination)
+{
+  if (m_fd >= 0)
+    reclaimTxFrames();
+  auto queue = m_txQueueBytes.find(destination);
+  return queue == m_txQueueBytes.end() ? 0 : queue->second;
+}
+
+EthernetXdpSocket::Counters
+EthernetXdpSocket::getCounters() const
+{
+  Counters counters;
+  counters.nTxDropped = m_nTxDropped;
+  if (m_fd < 0)
+    return counters;
+
+  xdp_statistics stats{};
+  socklen_t optlen = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_XDP, XDP_STATISTICS, &stats, &optlen) == 0) {
+    counters.nRxDropped = stats.rx_dropped;
+    counters.nRxRingFull = stats.rx_ring_full;
+    counters.nFillRingEmpty = stats.rx_fill_ring_empty_descs;
+    counters.nTxInvalid = stats.tx_invalid_descs;
+  }
+
+  auto occupancy = [] (const Ring& ring) -> size_t {
+    return __atomic_load_n(ring.producer, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(ring.consumer, __ATOMIC_ACQUIRE);
+  };
+  counters.rxRingOccupancy = occupancy(m_rxRing);
+  counters.fillRingOccupancy = occupancy(m_fillRing);
+  counters.txRingOccupancy = occupancy(m_txRing);
+  return counters;
+}
+
+#else // __linux__
+
+void
+EthernetXdpSocket::activate()
+{
+  NDN_THROW(Error("AF_XDP is not supported on this platform"));
+}
+
+void
+EthernetXdpSocket::close()
+{
+}
+
+void
+EthernetXdpSocket::handleRead(const boost::system::error_code&)
+{
+}
+
+bool
+EthernetXdpSocket::send(const uint8_t*, size_t)
+{
+  ++m_nTxDropped;
+  return false;
+}
+
+size_t
+EthernetXdpSocket::getTxQueueBytes(const ethernet::Address&)
+{
+  return 0;
+}
+
+EthernetXdpSocket::Counters
+EthernetXdpSocket::getCounters() const
+{
+  Counters counters;
+  counters.nTxDropped = m_nTxDropped;
+  return counters;
+}
+
+#endif // __linux__
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_XDP_SOCKET_HPP
+#define NFD_DAEMON_FACE_ETHERNET_XDP_SOCKET_HPP
+
+#include "ethernet-protocol.hpp"
+
+#include <ndn-cxx/net/network-interface.hpp>
+
+#include <unordered_map>
+
+namespace nfd {
+namespace face {
+
+class EthernetTransport;
+
+/**
+ * @brief An AF_XDP socket that exchanges the NDN frames of one network interface.
+ *
+ * activate() loads a small XDP program on the interface that redirects every frame with the
+ * NDN ethertype arriving on RX queue 0 into this socket; all other traffic continues to the
+ * kernel network stack. Received frames are written by the kernel into a UMEM area shared
+ * with the process and are consumed from the RX ring without any system call; outgoing frames
+ * are placed in the UMEM and posted on the TX ring, with one wakeup per batch of sends.
+ * Non-IP frames are usually delivered to queue 0; on multi-queue NICs that use other rules,
+ * a flow steering rule for ethertype 0x8624 may be needed.
+ *
+ * Because an interface can only have one such program, a single EthernetXdpSocket serves
+ * the EthernetChannel and every Ethernet face on the interface. Frames are dispatched by
+ * address: to the face of the multicast group they are sent to, to the unicast face of their
+ * sender, or otherwise to the default receiver (the channel).
+ *
+ * UMEM chunks are FRAME_SIZE octets, so frames larger than that are dropped by the kernel;
+ * Ethernet faces using the socket limit their MTU accordingly. Frames lost in the rings
+ * (see Counters) are reported in the log every COUNTERS_CHECK_INTERVAL.
+ * Linux 5.9 or later is required.
+ */
+class EthernetXdpSocket : noncopyable, public std::enable_shared_from_this<EthernetXdpSocket>
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  enum class Mode {
+    GENERIC, ///< XDP_FLAGS_SKB_MODE: works with any driver, including veth
+    NATIVE,  ///< XDP_FLAGS_DRV_MODE: requires driver support, zero-copy if available
+  };
+
+  struct Counters
+  {
+    uint64_t nRxDropped = 0;     ///< frames dropped by the kernel for other reasons
+    uint64_t nRxRingFull = 0;    ///< frames dropped because the RX ring was full
+    uint64_t nFillRingEmpty = 0; ///< times the kernel found no free chunk in the fill ring
+    uint64_t nTxInvalid = 0;     ///< invalid descriptors posted on the TX ring
+    uint64_t nTxDropped = 0;     ///< frames not sent because no TX chunk or slot was free
+    size_t rxRingOccupancy = 0;  ///< frames waiting in the RX ring
+    size_t fillRingOccupancy = 0; ///< free chunks available to the kernel for receiving
+    size_t txRingOccupancy = 0;  ///< frames waiting in the TX ring
+  };
+
+  /**
+   * @brief Invoked for frames addressed to this host that do not belong to any face.
+   */
+  using DefaultReceiveCallback = std::function<void(const uint8_t* payload, size_t length,
+                                                    const ethernet::Address& sender)>;
+
+  /**
+   * @brief Create an AF_XDP socket for @p netif; the object must be owned by a shared_ptr
+   */
+  EthernetXdpSocket(const ndn::net::NetworkInterface& netif, Mode mode);
+
+  ~EthernetXdpSocket();
+
+  /**
+   * @brief Set up the UMEM and rings, attach the XDP program, and start receiving.
+   * @throw Error on any error, including on platforms other than Linux
+   */
+  void
+  activate();
+
+  /**
+   * @brief Detach the XDP program and release all resources.
+   */
+  void
+  close();
+
+  Mode
+  getMode() const
+  {
+    return m_mode;
+  }
+
+  /**
+   * @brief Whether the driver exchanges frames directly with the UMEM (XDP_ZEROCOPY)
+   */
+  bool
+  isZeroCopy() const
+  {
+    return m_isZeroCopy;
+  }
+
+  /**
+   * @brief Deliver frames sent from @p remote (unicast) or to @p remote (multicast) to @p transport
+   */
+  void
+  addReceiver(const ethernet::Address& remote, EthernetTransport& transport);
+
+  void
+  removeReceiver(const ethernet::Address& remote, const EthernetTransport& transport);
+
+  void
+  setDefaultReceiver(DefaultReceiveCallback callback)
+  {
+    m_defaultReceiver = std::move(callback);
+  }
+
+  /**
+   * @brief Queue a complete Ethernet frame for transmission.
+   * @return false if the frame was dropped because the TX ring or UMEM is exhausted
+   */
+  bool
+  send(const uint8_t* frame, size_t length);
+
+  /**
+   * @brief Octets of the frames sent to @p destination that are queued for transmission
+   *        and not yet completed by the kernel
+   *
+   * The TX ring is shared by all faces on the interface; counting octets by destination address
+   * gives the backlog of the face sending to that address rather than that of the interface.
+   */
+  size_t
+  getTxQueueBytes(const ethernet::Address& destination);
+
+  Counters
+  getCounters() const;
+
+public:
+  static constexpr size_t FRAME_SIZE = 4096;
+  static constexpr uint32_t RING_SIZE = 2048;
+  /// half of the UMEM chunks are used for receiving, the other half for sending
+  static constexpr size_t N_FRAMES = 2 * RING_SIZE;
+  /// how often the loss counters are checked and, if any of them increased, logged
+  static const time::nanoseconds COUNTERS_CHECK_INTERVAL;
+
+private:
+  struct Ring
+  {
+    uint32_t* producer = nullptr;
+    uint32_t* consumer = nullptr;
+    uint8_t* descs = nullptr;
+    void* area = nullptr;
+    size_t areaSize = 0;
+  };
+
+  void
+  mapRing(Ring& ring, uint64_t pageOffset, uint64_t producerOffset, uint64_t consumerOffset,
+          uint64_t descsOffset, size_t descSize);
+
+  void
+  unmapRing(Ring& ring);
+
+  void
+  attachProgram();
+
+  void
+  asyncRead();
+
+  void
+  handleRead(const boost::system::error_code& error);
+
+  void
+  dispatchFrame(const uint8_t* frame, size_t length);
+
+  void
+  scheduleCountersCheck();
+
+  void
+  checkCounters();
+
+  void
+  reclaimTxFrames();
+
+  void
+  wakeupTx();
+
+private:
+  std::string m_interfaceName;
+  int m_interfaceIndex;
+  ethernet::Address m_localAddress;
+  Mode m_mode;
+  bool m_isZeroCopy = false;
+
+  int m_fd = -1;
+  int m_linkFd = -1;
+  boost::asio::posix::stream_descriptor m_socket;
+
+  uint8_t* m_umem = nullptr;
+  Ring m_fillRing;
+  Ring m_completionRing;
+  Ring m_rxRing;
+  Ring m_txRing;
+  std::vector<uint64_t> m_freeTxFrames;
+  std::vector<uint16_t> m_txFrameLengths; ///< length of the frame in each UMEM chunk being sent
+  /// destination of the frame in each UMEM chunk being sent
+  std::vector<ethernet::Address> m_txFrameDestinations;
+  /// octets of the frames being sent, by destination; addresses with nothing queued are absent
+  std::unordered_map<ethernet::Address, size_t> m_txQueueBytes;
+  bool m_isTxWakeupPending = false;
+  uint64_t m_nTxDropped = 0;
+
+  std::unordered_map<ethernet::Address, EthernetTransport*> m_receivers;
+  DefaultReceiveCallback m_defaultReceiver;
+
+  Counters m_checkedCounters; ///< counters at the time of the last check
+  scheduler::ScopedEventId m_countersCheckEvent;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_XDP_SOCKET_HPP
@@ -34,6 +34,7 @@
 
 #include <ndn-cxx/encoding/nfd-constants.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/logic/tribool.hpp>
 
 namespace nfd {
@@ -74,6 +75,52 @@ const ssize_t MIN_MTU = 64;
  */
 using EndpointId = ndn::variant<ndn::monostate, ethernet::Address, udp::Endpoint, tcp::Endpoint>;
 
+/** \brief Hash function for IP endpoints, used by channels to index on-demand faces
+ *         by remote endpoint in an unordered container.
+ */
+struct IpEndpointHash
+{
+  template<typename InternetProtocol>
+  size_t
+  operator()(const boost::asio::ip::basic_endpoint<InternetProtocol>& ep) const noexcept
+  {
+    size_t seed = 0;
+    if (ep.address().is_v4()) {
+      boost::hash_combine(seed, ep.address().to_v4().to_ulong());
+    }
+    else {
+      auto addr = ep.address().to_v6();
+      auto bytes = addr.to_bytes();
+      boost::hash_range(seed, bytes.begin(), bytes.end());
+      boost::hash_combine(seed, addr.scope_id());
+    }
+    boost::hash_combine(seed, ep.port());
+    return seed;
+  }
+};
+
+/** \brief Hash function for EndpointId, used to index per-endpoint state in an unordered container.
+ */
+struct EndpointIdHash
+{
+  size_t
+  operator()(const EndpointId& ep) const noexcept
+  {
+    size_t seed = 0;
+    boost::hash_combine(seed, ep.index());
+    if (const auto* addr = ndn::get_if<ethernet::Address>(&ep)) {
+      boost::hash_range(seed, addr->begin(), addr->end());
+    }
+    else if (const auto* udpEp = ndn::get_if<udp::Endpoint>(&ep)) {
+      boost::hash_combine(seed, IpEndpointHash{}(*udpEp));
+    }
+    else if (const auto* tcpEp = ndn::get_if<tcp::Endpoint>(&ep)) {
+      boost::hash_combine(seed, IpEndpointHash{}(*tcpEp));
+    }
+    return seed;
+  }
+};
+
 /** \brief Parameters used to set Transport properties or LinkService options on a newly created face.
  *
  *  Parameters are passed as a struct rather than individually, so that a future change in the list
@@ -24,6 +24,7 @@
  */
 
 #include "face-system.hpp"
+#include "generic-link-service.hpp"
 #include "protocol-factory.hpp"
 #include "netdev-bound.hpp"
 #include "common/global.hpp"
@@ -50,6 +51,11 @@ FaceSystem::FaceSystem(FaceTable& faceTable, shared_ptr<ndn::net::NetworkMonitor
   }
 
   m_netdevBound = make_unique<NetdevBound>(pfCtorParams, *this);
+
+  m_faceTable.afterAdd.connect([this] (const Face& face) { applyGeneralConfig(face); });
+  m_faceTable.beforeRemove.connect([this] (const Face& face) {
+    m_faceOverrides.erase(face.getId());
+  });
 }
 
 ProtocolFactoryCtorParams
@@ -106,15 +112,60 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
   // process general protocol factory config section
   auto generalSection = configSection.get_child_optional(CFGSEC_GENERAL);
   if (generalSection) {
+    auto& general = context.generalConfig;
+    optional<double> interestBurst, dataBurst;
     for (const auto& pair : *generalSection) {
       const std::string& key = pair.first;
       if (key == "enable_congestion_marking") {
-        context.generalConfig.wantCongestionMarking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
+        general.wantCongestionMarking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "pack_packets") {
+        general.wantPacking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "latency_sample_interval") {
+        general.latencySampleInterval = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "interest_rate_limit") {
+        general.interestPolicer.rate = ConfigFile::parseNumber<uint64_t>(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "interest_burst_limit") {
+        interestBurst = ConfigFile::parseNumber<uint64_t>(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "data_rate_limit") {
+        general.dataShaper.rate = ConfigFile::parseNumber<uint64_t>(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "data_burst_limit") {
+        dataBurst = ConfigFile::parseNumber<uint64_t>(pair, CFGSEC_GENERAL_FQ);
+      }
+      else if (key == "interest_weight" || key == "data_weight" || key == "nack_weight") {
+        auto weight = ConfigFile::parseNumber<uint32_t>(pair, CFGSEC_GENERAL_FQ);
+        if (weight == 0) {
+          NDN_THROW(ConfigFile::Error(CFGSEC_GENERAL_FQ + "." + key + " must be positive"));
+        }
+        TxClass cls = key == "interest_weight" ? TxClass::INTEREST :
+                      key == "data_weight" ? TxClass::DATA : TxClass::NACK;
+        general.txClassWeights[static_cast<size_t>(cls)] = weight;
+      }
+      else if (key == "reassembly_max_bytes") {
+        general.reassemblyMaxBytes = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+        if (general.reassemblyMaxBytes == 0) {
+          NDN_THROW(ConfigFile::Error(CFGSEC_GENERAL_FQ + "." + key + " must be positive"));
+        }
+      }
+      else if (key == "reassembly_max_bytes_per_endpoint") {
+        general.reassemblyMaxBytesPerEndpoint = ConfigFile::parseNumber<size_t>(pair,
+                                                                                CFGSEC_GENERAL_FQ);
+        if (general.reassemblyMaxBytesPerEndpoint == 0) {
+          NDN_THROW(ConfigFile::Error(CFGSEC_GENERAL_FQ + "." + key + " must be positive"));
+        }
       }
       else {
         NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_GENERAL_FQ + "." + key));
       }
     }
+    // the burst defaults to one second worth of tokens
+    general.interestPolicer.burst = interestBurst.value_or(general.interestPolicer.rate);
+    general.dataShaper.burst = dataBurst.value_or(general.dataShaper.rate);
   }
 
   // process in protocol factories
@@ -141,6 +192,13 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
     }
   }
 
+  if (!isDryRun) {
+    m_generalConfig = context.generalConfig;
+    for (const Face& face : m_faceTable) {
+      applyGeneralConfig(face);
+    }
+  }
+
   // process netdev_bound section, after factories start providing *+dev schemes
   auto netdevBoundSection = configSection.get_child_optional(CFGSEC_NETDEVBOUND);
   m_netdevBound->processConfig(netdevBoundSection, context);
@@ -164,5 +222,121 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
   }
 }
 
+/** \brief override \p options with the fields present in \p faceOptions
+ */
+static void
+applyLinkOptions(const FaceLinkOptions& faceOptions, GenericLinkService::Options& options)
+{
+  // the burst defaults to one second worth of tokens
+  if (faceOptions.interestRate) {
+    options.interestPolicer.rate = *faceOptions.interestRate;
+    options.interestPolicer.burst = faceOptions.interestBurst.value_or(*faceOptions.interestRate);
+  }
+  else if (faceOptions.interestBurst) {
+    options.interestPolicer.burst = *faceOptions.interestBurst;
+  }
+
+  if (faceOptions.dataRate) {
+    options.dataShaper.rate = *faceOptions.dataRate;
+    options.dataShaper.burst = faceOptions.dataBurst.value_or(*faceOptions.dataRate);
+  }
+  else if (faceOptions.dataBurst) {
+    options.dataShaper.burst = *faceOptions.dataBurst;
+  }
+
+  if (faceOptions.wantPacking) {
+    options.allowPacking = *faceOptions.wantPacking;
+  }
+
+  if (faceOptions.sendQueueTarget) {
+    options.sendQueueTarget = *faceOptions.sendQueueTarget;
+  }
+
+  if (faceOptions.interestWeight) {
+    options.txClassWeights[static_cast<size_t>(TxClass::INTEREST)] =
+      static_cast<uint32_t>(*faceOptions.interestWeight);
+  }
+  if (faceOptions.dataWeight) {
+    options.txClassWeights[static_cast<size_t>(TxClass::DATA)] =
+      static_cast<uint32_t>(*faceOptions.dataWeight);
+  }
+  if (faceOptions.nackWeight) {
+    options.txClassWeights[static_cast<size_t>(TxClass::NACK)] =
+      static_cast<uint32_t>(*faceOptions.nackWeight);
+  }
+}
+
+void
+FaceSystem::setFaceLinkOptions(const Face& face, const FaceLinkOptions& faceOptions)
+{
+  auto linkService = dynamic_cast<GenericLinkService*>(face.getLinkService());
+  BOOST_ASSERT(linkService != nullptr);
+
+  // merge into the overrides, so that they can be applied again on top of the general section
+  FaceLinkOptions& overrides = m_faceOverrides[face.getId()];
+  if (faceOptions.interestRate) {
+    overrides.interestRate = faceOptions.interestRate;
+    overrides.interestBurst = faceOptions.interestBurst;
+  }
+  else if (faceOptions.interestBurst) {
+    overrides.interestBurst = faceOptions.interestBurst;
+  }
+  if (faceOptions.dataRate) {
+    overrides.dataRate = faceOptions.dataRate;
+    overrides.dataBurst = faceOptions.dataBurst;
+  }
+  else if (faceOptions.dataBurst) {
+    overrides.dataBurst = faceOptions.dataBurst;
+  }
+  if (faceOptions.wantPacking) {
+    overrides.wantPacking = faceOptions.wantPacking;
+  }
+  if (faceOptions.sendQueueTarget) {
+    overrides.sendQueueTarget = faceOptions.sendQueueTarget;
+  }
+  if (faceOptions.interestWeight) {
+    overrides.interestWeight = faceOptions.interestWeight;
+  }
+  if (faceOptions.dataWeight) {
+    overrides.dataWeight = faceOptions.dataWeight;
+  }
+  if (faceOptions.nackWeight) {
+    overrides.nackWeight = faceOptions.nackWeight;
+  }
+
+  auto options = linkService->getOptions();
+  applyLinkOptions(faceOptions, options);
+  linkService->setOptions(options);
+}
+
+void
+FaceSystem::applyGeneralConfig(const Face& face) const
+{
+  // Interests from local applications are traced as well
+  face.getTransport()->setLatencySampling(m_generalConfig.latencySampleInterval);
+
+  if (face.getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
+    return;
+  }
+
+  auto linkService = dynamic_cast<GenericLinkService*>(face.getLinkService());
+  if (linkService == nullptr) {
+    return;
+  }
+
+  auto options = linkService->getOptions();
+  options.interestPolicer = m_generalConfig.interestPolicer;
+  options.dataShaper = m_generalConfig.dataShaper;
+  options.allowPacking = m_generalConfig.wantPacking;
+  options.txClassWeights = m_generalConfig.txClassWeights;
+  options.reassemblerOptions.maxBytes = m_generalConfig.reassemblyMaxBytes;
+  options.reassemblerOptions.maxBytesPerEndpoint = m_generalConfig.reassemblyMaxBytesPerEndpoint;
+  auto overrides = m_faceOverrides.find(face.getId());
+  if (overrides != m_faceOverrides.end()) {
+    applyLinkOptions(overrides->second, options);
+  }
+  linkService->setOptions(options);
+}
+
 } // namespace face
 } // namespace nfd
@@ -26,8 +26,11 @@
 #ifndef NFD_DAEMON_FACE_FACE_SYSTEM_HPP
 #define NFD_DAEMON_FACE_FACE_SYSTEM_HPP
 
+#include "generic-link-service.hpp"
 #include "network-predicate.hpp"
+#include "token-bucket.hpp"
 #include "common/config-file.hpp"
+#include "core/face-link-options.hpp"
 
 #include <ndn-cxx/net/network-address.hpp>
 #include <ndn-cxx/net/network-interface.hpp>
@@ -39,6 +42,7 @@ class FaceTable;
 
 namespace face {
 
+class Face;
 class NetdevBound;
 class ProtocolFactory;
 struct ProtocolFactoryCtorParams;
@@ -84,11 +88,32 @@ public:
   void
   setConfigFile(ConfigFile& configFile);
 
+  /** \brief change the link options of \p face, overriding the general section
+   *  \pre \p face has a GenericLinkService
+   *
+   *  Options absent from \p options are left unchanged. A rate without a burst sets the burst
+   *  to one second worth of tokens, as in the general section. The options set on a face are
+   *  kept across configuration reloads, until the face is removed.
+   */
+  void
+  setFaceLinkOptions(const Face& face, const FaceLinkOptions& options);
+
   /** \brief configuration options from "general" section
    */
   struct GeneralConfig
   {
     bool wantCongestionMarking = true;
+    TokenBucket::Options interestPolicer; ///< applied to every non-local face
+    TokenBucket::Options dataShaper; ///< applied to every non-local face
+    bool wantPacking = false; ///< applied to every non-local face
+    size_t latencySampleInterval = 0; ///< trace one in every N received packets; zero disables
+    /// reassembly memory budget of each non-local face
+    size_t reassemblyMaxBytes = LpReassembler::Options().maxBytes;
+    /// reassembly memory budget of each remote endpoint of a non-local face
+    size_t reassemblyMaxBytesPerEndpoint = LpReassembler::Options().maxBytesPerEndpoint;
+    /// send queue weights of the traffic classes of each non-local face, indexed by TxClass
+    std::array<uint32_t, TX_CLASS_COUNT> txClassWeights =
+      GenericLinkService::Options().txClassWeights;
   };
 
   /** \brief context for processing a config section in ProtocolFactory
@@ -109,6 +134,11 @@ private:
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  /** \brief apply per-face options from the general section to \p face
+   */
+  void
+  applyGeneralConfig(const Face& face) const;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief config section name => protocol factory
    */
@@ -124,6 +154,12 @@ private:
 
   FaceTable& m_faceTable;
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
+  GeneralConfig m_generalConfig;
+
+  /** \brief per-face options set through management, which take precedence over
+   *         the general section
+   */
+  std::map<FaceId, FaceLinkOptions> m_faceOverrides;
 };
 
 } // namespace face
@@ -24,12 +24,12 @@
  */
 
 #include "generic-link-service.hpp"
+#include "common/global.hpp"
+#include "fw/scope-prefix.hpp"
 
 #include <ndn-cxx/lp/pit-token.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
-#include <cmath>
-
 namespace nfd {
 namespace face {
 
@@ -39,18 +39,38 @@ constexpr size_t CONGESTION_MARK_SIZE = tlv::sizeOfVarNumber(lp::tlv::Congestion
                                         tlv::sizeOfVarNumber(sizeof(uint64_t)) +        // length
                                         tlv::sizeOfNonNegativeInteger(UINT64_MAX);      // value
 
+/** \brief time between polls of a transport whose send queue is above the threshold
+ */
+constexpr time::nanoseconds SEND_QUEUE_POLL_INTERVAL = 1_ms;
+
+/** \brief the transport send queue limit is at most its capacity divided by this number
+ */
+constexpr size_t TRANSPORT_QUEUE_LIMIT_DIVISOR = 2;
+
 GenericLinkService::GenericLinkService(const GenericLinkService::Options& options)
   : m_options(options)
   , m_fragmenter(m_options.fragmenterOptions, this)
   , m_reassembler(m_options.reassemblerOptions, this)
   , m_reliability(m_options.reliabilityOptions, this)
   , m_lastSeqNo(-2)
-  , m_nextMarkTime(time::steady_clock::TimePoint::max())
-  , m_nMarkedSinceInMarkingState(0)
+  , m_interestPolicer(m_options.interestPolicer)
+  , m_sendQueue(makeSendQueueOptions())
 {
   m_reassembler.beforeTimeout.connect([this] (auto...) { ++this->nReassemblyTimeouts; });
+  m_reassembler.beforeEviction.connect([this] (auto...) { ++this->nReassemblyEvictions; });
   m_reliability.onDroppedInterest.connect([this] (const auto& i) { this->notifyDroppedInterest(i); });
   nReassembling.observe(&m_reassembler);
+  m_sendQueue.onDrop.connect([this] (TxClass cls, size_t nDropped) {
+    NFD_LOG_FACE_DEBUG("send queue congested: DROP " << nDropped << " " << cls);
+    for (size_t i = 0; i < nDropped; ++i) {
+      ++this->nSendQueueDropped;
+      ++this->nClassQueueDropped[static_cast<size_t>(cls)];
+    }
+  });
+  nSendQueueLength.observe(&m_sendQueue);
+  for (size_t i = 0; i < TX_CLASS_COUNT; ++i) {
+    nClassQueueLength[i].observe(&m_sendQueue.getQueue(static_cast<TxClass>(i)));
+  }
 }
 
 void
@@ -60,6 +80,37 @@ GenericLinkService::setOptions(const GenericLinkService::Options& options)
   m_fragmenter.setOptions(m_options.fragmenterOptions);
   m_reassembler.setOptions(m_options.reassemblerOptions);
   m_reliability.setOptions(m_options.reliabilityOptions);
+  m_interestPolicer.setOptions(m_options.interestPolicer);
+  m_sendQueue.setOptions(makeSendQueueOptions());
+  if (!m_options.allowPacking) {
+    flushPackingBuffer();
+  }
+}
+
+TxScheduler::Options
+GenericLinkService::makeSendQueueOptions() const
+{
+  TxScheduler::Options options;
+  options.queueOptions.interval = m_options.baseCongestionMarkingInterval;
+  options.queueOptions.target = m_options.sendQueueTarget;
+  options.queueOptions.capacity = m_options.sendQueueCapacity;
+  options.queueOptions.useMarking = m_options.allowCongestionMarking;
+  options.weights = m_options.txClassWeights;
+  options.shapers[static_cast<size_t>(TxClass::DATA)] = m_options.dataShaper;
+  return options;
+}
+
+/** \brief traffic class of a network layer packet
+ *
+ *  Management and other traffic confined to the local host or the next hop is prioritized.
+ */
+static TxClass
+getTxClass(const Name& name, TxClass defaultClass)
+{
+  if (scope_prefix::LOCALHOST.isPrefixOf(name) || scope_prefix::LOCALHOP.isPrefixOf(name)) {
+    return TxClass::PRIORITY;
+  }
+  return defaultClass;
 }
 
 ssize_t
@@ -87,29 +138,172 @@ GenericLinkService::requestIdlePacket()
   // No need to request Acks to attach to this packet from LpReliability, as they are already
   // attached in sendLpPacket
   NFD_LOG_FACE_TRACE("IDLE packet requested");
-  this->sendLpPacket({});
+  this->sendLpPacket({}, TxClass::PRIORITY);
 }
 
 void
-GenericLinkService::sendLpPacket(lp::Packet&& pkt)
+GenericLinkService::sendLpPacket(lp::Packet&& pkt, TxClass cls, shared_ptr<PacketTrace> trace)
 {
-  const ssize_t mtu = getEffectiveMtu();
-
   if (m_options.reliabilityOptions.isEnabled) {
+    ssize_t mtu = getEffectiveMtu();
+    // leave room for a congestion mark that may be added when the packet leaves the send queue
+    if (m_options.allowCongestionMarking && mtu != MTU_UNLIMITED) {
+      mtu -= CONGESTION_MARK_SIZE;
+    }
     m_reliability.piggyback(pkt, mtu);
   }
 
-  if (m_options.allowCongestionMarking) {
-    checkCongestionLevel(pkt);
+  size_t size = pkt.wireEncode().size();
+  if (!m_sendQueue.enqueue(cls, std::move(pkt), size, time::steady_clock::now(), std::move(trace))) {
+    ++this->nSendQueueDropped;
+    ++this->nClassQueueDropped[static_cast<size_t>(cls)];
+    NFD_LOG_FACE_DEBUG("send queue full: DROP " << cls);
+    return;
   }
+  this->drainSendQueue();
+}
+
+void
+GenericLinkService::drainSendQueue()
+{
+  const ssize_t mtu = getEffectiveMtu();
+
+  while (!m_sendQueue.empty()) {
+    if (isTransportBusy()) {
+      if (!m_sendQueueTimer) {
+        m_sendQueueTimer = getScheduler().schedule(SEND_QUEUE_POLL_INTERVAL,
+                                                   [this] { drainSendQueue(); });
+      }
+      return;
+    }
+
+    const auto now = time::steady_clock::now();
+    auto res = m_sendQueue.dequeue(now);
+    if (!res.item) {
+      if (!m_sendQueue.empty() && !m_sendQueueTimer) {
+        // remaining packets are held back by a shaper
+        m_sendQueueTimer = getScheduler().schedule(res.holdTime, [this] { drainSendQueue(); });
+      }
+      return;
+    }
+
+    this->sendQueueSojournTime.add(now - res.item->enqueueTime);
+
+    lp::Packet& pkt = res.item->packet;
+    if (res.isMarked) {
+      pkt.set<lp::CongestionMarkField>(1);
+      ++this->nCongestionMarked;
+      NFD_LOG_FACE_DEBUG("LpPacket was marked as congested");
+    }
+
+    auto block = pkt.wireEncode();
+    if (mtu != MTU_UNLIMITED && block.size() > static_cast<size_t>(mtu)) {
+      ++this->nOutOverMtu;
+      NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
+      continue;
+    }
+    m_transportQueueLength += block.size();
+    this->transmitPacket(std::move(block), std::move(res.item->trace));
+  }
+
+  m_sendQueueTimer.cancel();
+}
+
+void
+GenericLinkService::transmitPacket(Block&& block, shared_ptr<PacketTrace> trace)
+{
+  const ssize_t mtu = getEffectiveMtu();
+  if (!m_options.allowPacking || mtu == MTU_UNLIMITED) {
+    if (trace != nullptr) {
+      trace->mark(TraceStage::TRANSMIT);
+    }
+    this->sendPacket(block);
+    return;
+  }
+
+  if (m_packingBufferSize + block.size() > static_cast<size_t>(mtu)) {
+    flushPackingBuffer();
+  }
+  m_packingBufferSize += block.size();
+  m_packingBuffer.push_back(std::move(block));
+  if (trace != nullptr) {
+    m_packingTraces.push_back(std::move(trace));
+  }
+
+  if (!m_packingTimer) {
+    m_packingTimer = getScheduler().schedule(m_options.packingDelay, [this] { flushPackingBuffer(); });
+  }
+}
 
-  auto block = pkt.wireEncode();
-  if (mtu != MTU_UNLIMITED && block.size() > static_cast<size_t>(mtu)) {
-    ++this->nOutOverMtu;
-    NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
+void
+GenericLinkService::flushPackingBuffer()
+{
+  m_packingTimer.cancel();
+  if (m_packingBuffer.empty()) {
     return;
   }
-  this->sendPacket(block);
+
+  for (const auto& trace : m_packingTraces) {
+    trace->mark(TraceStage::TRANSMIT);
+  }
+  m_packingTraces.clear();
+
+  if (m_packingBuffer.size() == 1) {
+    this->sendPacket(m_packingBuffer.front());
+  }
+  else {
+    auto buffer = make_shared<ndn::Buffer>();
+    buffer->reserve(m_packingBufferSize);
+    for (const Block& block : m_packingBuffer) {
+      buffer->insert(buffer->end(), block.begin(), block.end());
+    }
+    this->nOutPackedPackets.set(this->nOutPackedPackets + m_packingBuffer.size());
+    ++this->nOutPackedDatagrams;
+    NFD_LOG_FACE_TRACE("sending " << m_packingBuffer.size() << " packed LpPackets in "
+                       << buffer->size() << " octets");
+    // the link-layer packet spans all elements, rather than only the first one
+    this->sendPacket(Block(buffer, buffer->begin(), buffer->end(), false));
+  }
+
+  m_packingBuffer.clear();
+  m_packingBufferSize = 0;
+}
+
+bool
+GenericLinkService::isTransportBusy()
+{
+  size_t limit = getTransportQueueLimit();
+  if (*m_hasTransportQueueLength && m_transportQueueLength < limit) {
+    return false;
+  }
+
+  if (!*m_hasTransportQueueLength) {
+    // forget the queried length once the current handler returns to the io_service
+    *m_hasTransportQueueLength = true;
+    getGlobalIoService().post([flag = m_hasTransportQueueLength] { *flag = false; });
+  }
+
+  ssize_t sendQueueLength = getTransport()->getSendQueueLength();
+  // transports that cannot report their send queue length are never considered busy
+  m_transportQueueLength = static_cast<size_t>(std::max<ssize_t>(sendQueueLength, 0));
+  if (sendQueueLength <= 0) {
+    return false;
+  }
+
+  NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" << limit <<
+                     " capacity=" << getTransport()->getSendQueueCapacity());
+  return static_cast<size_t>(sendQueueLength) >= limit;
+}
+
+size_t
+GenericLinkService::getTransportQueueLimit() const
+{
+  ssize_t capacity = getTransport()->getSendQueueCapacity();
+  if (capacity < 0) {
+    return m_options.defaultCongestionThreshold;
+  }
+  return std::min(m_options.defaultCongestionThreshold,
+                  static_cast<size_t>(capacity) / TRANSPORT_QUEUE_LIMIT_DIVISOR);
 }
 
 void
@@ -119,7 +313,14 @@ GenericLinkService::doSendInterest(const Interest& interest)
 
   encodeLpFields(interest, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), true);
+  shared_ptr<PacketTrace> trace;
+  auto traceTag = interest.getTag<PacketTraceTag>();
+  if (traceTag != nullptr) {
+    trace = traceTag->get();
+  }
+
+  this->sendNetPacket(std::move(lpPacket), true,
+                      getTxClass(interest.getName(), TxClass::INTEREST), std::move(trace));
 }
 
 void
@@ -129,7 +330,7 @@ GenericLinkService::doSendData(const Data& data)
 
   encodeLpFields(data, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(std::move(lpPacket), false, getTxClass(data.getName(), TxClass::DATA));
 }
 
 void
@@ -140,7 +341,8 @@ GenericLinkService::doSendNack(const lp::Nack& nack)
 
   encodeLpFields(nack, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(std::move(lpPacket), false,
+                      getTxClass(nack.getInterest().getName(), TxClass::NACK));
 }
 
 void
@@ -185,7 +387,8 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
 }
 
 void
-GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
+GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest, TxClass cls,
+                                  shared_ptr<PacketTrace> trace)
 {
   std::vector<lp::Packet> frags;
   ssize_t mtu = getEffectiveMtu();
@@ -204,7 +407,8 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
 
   if (m_options.allowFragmentation && mtu != MTU_UNLIMITED) {
     bool isOk = false;
-    std::tie(isOk, frags) = m_fragmenter.fragmentPacket(pkt, mtu);
+    // let the fragmenter encode the sequence numbers, in case the packet is fragmented
+    std::tie(isOk, frags) = m_fragmenter.fragmentPacket(pkt, mtu, m_lastSeqNo + 1);
     if (!isOk) {
       // fragmentation failed (warning is logged by LpFragmenter)
       ++this->nFragmentationErrors;
@@ -228,8 +432,11 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   }
 
   // Only assign sequences to fragments if reliability enabled or if packet contains >1 fragment
-  if (m_options.reliabilityOptions.isEnabled || frags.size() > 1) {
-    // Assign sequences to all fragments
+  if (frags.size() > 1) {
+    // sequences have been encoded by the fragmenter
+    m_lastSeqNo += frags.size();
+  }
+  else if (m_options.reliabilityOptions.isEnabled) {
     this->assignSequences(frags);
   }
 
@@ -237,60 +444,24 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
     m_reliability.handleOutgoing(frags, std::move(pkt), isInterest);
   }
 
-  for (lp::Packet& frag : frags) {
-    this->sendLpPacket(std::move(frag));
-  }
-}
-
-void
-GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
-{
-  ssize_t sendQueueLength = getTransport()->getSendQueueLength();
-  // The transport must support retrieving the current send queue length
-  if (sendQueueLength < 0) {
-    return;
-  }
-
-  if (sendQueueLength > 0) {
-    NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" <<
-                       m_options.defaultCongestionThreshold << " capacity=" <<
-                       getTransport()->getSendQueueCapacity());
-  }
-
-  // sendQueue is above target
-  if (static_cast<size_t>(sendQueueLength) > m_options.defaultCongestionThreshold) {
-    const auto now = time::steady_clock::now();
-
-    if (m_nextMarkTime == time::steady_clock::TimePoint::max()) {
-      m_nextMarkTime = now + m_options.baseCongestionMarkingInterval;
-    }
-    // Mark packet if sendQueue stays above target for one interval
-    else if (now >= m_nextMarkTime) {
-      pkt.set<lp::CongestionMarkField>(1);
-      ++nCongestionMarked;
-      NFD_LOG_FACE_DEBUG("LpPacket was marked as congested");
-
-      ++m_nMarkedSinceInMarkingState;
-      // Decrease the marking interval by the inverse of the square root of the number of packets
-      // marked in this incident of congestion
-      time::nanoseconds interval(static_cast<time::nanoseconds::rep>(
-                                   m_options.baseCongestionMarkingInterval.count() /
-                                   std::sqrt(m_nMarkedSinceInMarkingState + 1)));
-      m_nextMarkTime += interval;
-    }
-  }
-  else if (m_nextMarkTime != time::steady_clock::TimePoint::max()) {
-    // Congestion incident has ended, so reset
-    NFD_LOG_FACE_DEBUG("Send queue length dropped below congestion threshold");
-    m_nextMarkTime = time::steady_clock::TimePoint::max();
-    m_nMarkedSinceInMarkingState = 0;
+  // the Interest is transmitted when its last fragment is
+  for (size_t i = 0; i + 1 < frags.size(); ++i) {
+    this->sendLpPacket(std::move(frags[i]), cls);
   }
+  this->sendLpPacket(std::move(frags.back()), cls, std::move(trace));
 }
 
 void
 GenericLinkService::doReceivePacket(const Block& packet, const EndpointId& endpoint)
 {
   try {
+    if (packet.type() == tlv::Interest || packet.type() == tlv::Data) {
+      // A bare network-layer packet carries no link-layer fields. It is decoded directly, because
+      // wrapping it in an lp::Packet would copy it out of the buffer it was received into.
+      this->decodeNetPacket(packet, lp::Packet(), endpoint);
+      return;
+    }
+
     lp::Packet pkt(packet);
 
     if (m_options.reliabilityOptions.isEnabled) {
@@ -316,6 +487,7 @@ GenericLinkService::doReceivePacket(const Block& packet, const EndpointId& endpo
     Block netPkt;
     lp::Packet firstPkt;
     std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(pkt, endpoint);
+    this->nReassemblyPeakBytes.set(m_reassembler.getPeakBytes());
     if (isReassembled) {
       this->decodeNetPacket(netPkt, firstPkt, endpoint);
     }
@@ -408,6 +580,24 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
     interest->setTag(make_shared<lp::PitToken>(firstPkt.get<lp::PitTokenField>()));
   }
 
+  if (!m_interestPolicer.tryConsume(1)) {
+    ++this->nInInterestsPoliced;
+    if (getTransport()->getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
+      NFD_LOG_FACE_DEBUG("Interest exceeds policer: NACK " << interest->getName());
+      lp::Nack nack(*interest);
+      nack.setReason(lp::NackReason::CONGESTION);
+      auto pitToken = interest->getTag<lp::PitToken>();
+      if (pitToken != nullptr) {
+        nack.setTag(pitToken);
+      }
+      this->sendNack(nack);
+    }
+    else {
+      NFD_LOG_FACE_DEBUG("Interest exceeds policer: DROP " << interest->getName());
+    }
+    return;
+  }
+
   this->receiveInterest(*interest, endpointId);
 }
 
@@ -30,6 +30,7 @@
 #include "lp-fragmenter.hpp"
 #include "lp-reassembler.hpp"
 #include "lp-reliability.hpp"
+#include "tx-scheduler.hpp"
 
 namespace nfd {
 namespace face {
@@ -63,10 +64,23 @@ public:
    */
   PacketCounter nReassemblyTimeouts;
 
+  /** \brief count of dropped partial network-layer packets to stay within the reassembly
+   *         memory budget
+   */
+  PacketCounter nReassemblyEvictions;
+
+  /** \brief highest number of bytes held by partial network-layer packets at any time
+   */
+  ByteCounter nReassemblyPeakBytes;
+
   /** \brief count of invalid reassembled network-layer packets dropped
    */
   PacketCounter nInNetInvalid;
 
+  /** \brief count of incoming Interests rejected by the Interest policer
+   */
+  PacketCounter nInInterestsPoliced;
+
   /** \brief count of network-layer packets that did not require retransmission of a fragment
    */
   PacketCounter nAcknowledged;
@@ -88,6 +102,40 @@ public:
   /** \brief count of outgoing LpPackets that were marked with congestion marks
    */
   PacketCounter nCongestionMarked;
+
+  /** \brief count of outgoing LpPackets currently waiting in the send queue
+   */
+  SizeCounter<TxScheduler> nSendQueueLength;
+
+  /** \brief count of outgoing LpPackets dropped by the send queue, either because it was full
+   *         or to signal congestion when congestion marking is disabled
+   */
+  PacketCounter nSendQueueDropped;
+
+  /** \brief count of outgoing LpPackets currently waiting in the send queue of each traffic
+   *         class, indexed by TxClass
+   */
+  std::array<SizeCounter<CodelQueue>, TX_CLASS_COUNT> nClassQueueLength;
+
+  /** \brief count of outgoing LpPackets of each traffic class dropped by the send queue,
+   *         indexed by TxClass
+   */
+  std::array<PacketCounter, TX_CLASS_COUNT> nClassQueueDropped;
+
+  /** \brief distribution of the time outgoing LpPackets spent in the send queue
+   */
+  DurationHistogram sendQueueSojournTime;
+
+  /** \brief count of outgoing LpPackets sent in a link-layer packet together with other LpPackets
+   */
+  PacketCounter nOutPackedPackets;
+
+  /** \brief count of outgoing link-layer packets carrying more than one LpPacket
+   *
+   *  The average number of LpPackets per packed link-layer packet is
+   *  nOutPackedPackets / nOutPackedDatagrams.
+   */
+  PacketCounter nOutPackedDatagrams;
 };
 
 /** \brief GenericLinkService is a LinkService that implements the NDNLPv2 protocol
@@ -131,26 +179,77 @@ public:
      */
     LpReliability::Options reliabilityOptions;
 
-    /** \brief enables send queue congestion detection and marking
+    /** \brief signals send queue congestion with congestion marks
+     *
+     *  If false, congestion is signaled by dropping packets instead.
      */
     bool allowCongestionMarking = false;
 
-    /** \brief starting value for congestion marking interval
+    /** \brief CoDel interval of the send queue
      *
-     *  Packets are marked if the queue size stays above THRESHOLD for at least one INTERVAL.
+     *  Congestion is signaled if the time packets spend in the send queue stays above
+     *  sendQueueTarget for at least one INTERVAL.
      *
      *  The default value (100 ms) is taken from RFC 8289 (CoDel).
      */
     time::nanoseconds baseCongestionMarkingInterval = 100_ms;
 
-    /** \brief default congestion threshold in bytes
+    /** \brief CoDel target of the send queue
+     *
+     *  The acceptable standing queue delay. RFC 8289 recommends 5-10% of the interval.
      *
-     *  Packets are marked if the queue size stays above THRESHOLD for at least one INTERVAL.
+     *  The default value (5 ms) is taken from RFC 8289 (CoDel).
+     */
+    time::nanoseconds sendQueueTarget = 5_ms;
+
+    /** \brief limit of the transport send queue in bytes
+     *
+     *  Packets are held in the send queue of the link service while the transport reports
+     *  a send queue length at or above this limit, or at or above half of the transport send
+     *  queue capacity if that is lower, so that the standing queue forms where CoDel can observe
+     *  it. Transports that cannot report their send queue length are never held.
      *
      *  The default value (64 KiB) works well for a queue capacity of 200 KiB.
      */
     size_t defaultCongestionThreshold = 65536;
 
+    /** \brief maximum number of packets in the send queue of each traffic class
+     */
+    size_t sendQueueCapacity = 1000;
+
+    /** \brief relative weights of the traffic classes in the send queue, indexed by TxClass
+     *
+     *  While the transport is busy, PRIORITY packets (management, /localhost, /localhop, and
+     *  IDLE packets) are sent first, and the rest of the link is shared among Interests, Data,
+     *  and Nacks in proportion to these weights. The weight of the PRIORITY class is ignored.
+     */
+    std::array<uint32_t, TX_CLASS_COUNT> txClassWeights{{0, 1, 1, 1}};
+
+    /** \brief policer of incoming Interests, counting one token per Interest
+     *
+     *  Interests exceeding the policer are not passed to forwarding. On point-to-point links,
+     *  they are answered with a Nack of reason Congestion; otherwise, they are dropped.
+     *  Disabled by default.
+     */
+    TokenBucket::Options interestPolicer;
+
+    /** \brief shaper of outgoing Data, counting one token per octet
+     *
+     *  Data exceeding the shaper are held in the send queue. Disabled by default.
+     */
+    TokenBucket::Options dataShaper;
+
+    /** \brief enables packing several LpPackets into one link-layer packet, up to the MTU
+     *
+     *  The peer must accept link-layer packets that contain a sequence of TLV elements, which
+     *  DatagramTransport and EthernetTransport do. Packing has no effect if the MTU is unlimited.
+     */
+    bool allowPacking = false;
+
+    /** \brief maximum time an LpPacket waits for other LpPackets to be packed with it
+     */
+    time::nanoseconds packingDelay = 100_us;
+
     /** \brief enables self-learning forwarding support
      */
     bool allowSelfLearning = true;
@@ -203,9 +302,12 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
   requestIdlePacket();
 
   /** \brief send an LpPacket
+   *  \param pkt the LpPacket
+   *  \param cls traffic class of the LpPacket in the send queue
+   *  \param trace trace of the sampled Interest that completes with this LpPacket, if any
    */
   void
-  sendLpPacket(lp::Packet&& pkt);
+  sendLpPacket(lp::Packet&& pkt, TxClass cls, shared_ptr<PacketTrace> trace = nullptr);
 
   void
   doSendInterest(const Interest& interest) OVERRIDE_WITH_TESTS_ELSE_FINAL;
@@ -232,16 +334,51 @@ private: // send path
   /** \brief send a complete network layer packet
    *  \param pkt LpPacket containing a complete network layer packet
    *  \param isInterest whether the network layer packet is an Interest
+   *  \param cls traffic class of the network layer packet
+   *  \param trace trace of the network layer packet, if it is an Interest sampled for tracing
+   */
+  void
+  sendNetPacket(lp::Packet&& pkt, bool isInterest, TxClass cls,
+                shared_ptr<PacketTrace> trace = nullptr);
+
+  /** \brief transmit packets from the send queue while the transport is not busy
+   *
+   *  CoDel decides, as each packet leaves the send queue, whether it should be marked or dropped.
+   */
+  void
+  drainSendQueue();
+
+  /** \brief whether the transport send queue has reached its limit
+   *
+   *  Querying the transport may be a system call, so the send queue length is queried at most
+   *  once per io_service turn while it stays below the limit: later calls in the same turn add
+   *  the bytes sent since the query to the queried length, and query again only when this
+   *  estimate reaches the limit.
+   */
+  bool
+  isTransportBusy();
+
+  /** \brief the send queue length of the transport at or above which it is considered busy
+   */
+  size_t
+  getTransportQueueLimit() const;
+
+  TxScheduler::Options
+  makeSendQueueOptions() const;
+
+  /** \brief send an encoded LpPacket to the transport, packing it with other LpPackets
+   *         if Options::allowPacking is enabled
+   *  \param block the encoded LpPacket
+   *  \param trace trace of the sampled Interest that completes with this LpPacket, if any
+   *  \pre block fits in the effective MTU
    */
   void
-  sendNetPacket(lp::Packet&& pkt, bool isInterest);
+  transmitPacket(Block&& block, shared_ptr<PacketTrace> trace = nullptr);
 
-  /** \brief if the send queue is found to be congested, add a congestion mark to the packet
-   *         according to CoDel
-   *  \sa https://tools.ietf.org/html/rfc8289
+  /** \brief send the LpPackets waiting to be packed as one link-layer packet
    */
   void
-  checkCongestionLevel(lp::Packet& pkt);
+  flushPackingBuffer();
 
 private: // receive path
   void
@@ -303,12 +440,22 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   LpReassembler m_reassembler;
   LpReliability m_reliability;
   lp::Sequence m_lastSeqNo;
+  TokenBucket m_interestPolicer;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  /// Time to mark next packet due to send queue congestion
-  time::steady_clock::TimePoint m_nextMarkTime;
-  /// number of marked packets in the current incident of congestion
-  size_t m_nMarkedSinceInMarkingState;
+  TxScheduler m_sendQueue;
+  /// polls the transport while it is busy and the send queue is not empty
+  scheduler::ScopedEventId m_sendQueueTimer;
+  /// whether m_transportQueueLength was queried in the current io_service turn
+  shared_ptr<bool> m_hasTransportQueueLength = make_shared<bool>(false);
+  /// transport send queue length at the last query, plus the bytes sent since then
+  size_t m_transportQueueLength = 0;
+  /// encoded LpPackets waiting to be packed into the next link-layer packet
+  std::vector<Block> m_packingBuffer;
+  size_t m_packingBufferSize = 0;
+  /// traces of the sampled Interests in m_packingBuffer
+  std::vector<shared_ptr<PacketTrace>> m_packingTraces;
+  scheduler::ScopedEventId m_packingTimer;
 
   friend class LpReliability;
 };
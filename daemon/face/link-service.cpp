@@ -58,6 +58,7 @@ LinkService::sendInterest(const Interest& interest)
   NFD_LOG_FACE_TRACE(__func__);
 
   ++this->nOutInterests;
+  markTrace(interest, TraceStage::SEND);
 
   doSendInterest(interest);
 }
@@ -91,6 +92,11 @@ LinkService::receiveInterest(const Interest& interest, const EndpointId& endpoin
 
   ++this->nInInterests;
 
+  auto trace = m_transport->takeReceivingTrace();
+  if (trace != nullptr) {
+    interest.setTag(make_shared<PacketTraceTag>(std::move(trace)));
+  }
+
   afterReceiveInterest(interest, endpoint);
 }
 
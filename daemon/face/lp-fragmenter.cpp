@@ -26,6 +26,8 @@
 #include "lp-fragmenter.hpp"
 #include "link-service.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
 
 namespace nfd {
@@ -76,7 +78,7 @@ LpFragmenter::getLinkService() const
 }
 
 std::tuple<bool, std::vector<lp::Packet>>
-LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
+LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu, optional<lp::Sequence> firstSequence)
 {
   BOOST_ASSERT(packet.has<lp::FragmentField>());
   BOOST_ASSERT(!packet.has<lp::FragIndexField>());
@@ -93,12 +95,14 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   std::tie(netPktBegin, netPktEnd) = packet.get<lp::FragmentField>();
   size_t netPktSize = std::distance(netPktBegin, netPktEnd);
 
-  // compute size of other NDNLPv2 headers to be placed on the first fragment
+  // collect other NDNLPv2 headers to be placed on the first fragment
+  std::vector<Block> firstHeaders;
   size_t firstHeaderSize = 0;
   const Block& packetWire = packet.wireEncode();
   if (packetWire.type() == lp::tlv::LpPacket) {
     for (const Block& element : packetWire.elements()) {
       if (element.type() != lp::tlv::Fragment) {
+        firstHeaders.push_back(element);
         firstHeaderSize += element.size();
       }
     }
@@ -121,17 +125,43 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   }
 
   // populate fragments
-  std::vector<lp::Packet> frags(fragCount);
-  frags.front() = packet; // copy input packet to preserve other NDNLPv2 fields
+  std::vector<lp::Packet> frags;
+  frags.reserve(fragCount);
   size_t fragIndex = 0;
   auto fragBegin = netPktBegin,
        fragEnd = fragBegin + firstPayloadSize;
   while (fragBegin < netPktEnd) {
-    lp::Packet& frag = frags[fragIndex];
-    frag.add<lp::FragIndexField>(fragIndex);
-    frag.add<lp::FragCountField>(fragCount);
-    frag.set<lp::FragmentField>({fragBegin, fragEnd});
-    BOOST_ASSERT(frag.wireEncode().size() <= mtu);
+    size_t fragSize = std::distance(fragBegin, fragEnd);
+    size_t headerSize = fragIndex == 0 ? firstHeaderSize : 0;
+    size_t seqSize = firstSequence ? 2 + tlv::sizeOfNonNegativeInteger(*firstSequence + fragIndex) : 0;
+    size_t valueSize = seqSize +
+                       2 + tlv::sizeOfNonNegativeInteger(fragIndex) +
+                       2 + tlv::sizeOfNonNegativeInteger(fragCount) +
+                       headerSize +
+                       1 + tlv::sizeOfVarNumber(fragSize) + fragSize;
+
+    // fields are prepended, so they are written from the last to the first
+    ndn::EncodingBuffer encoder(1 + tlv::sizeOfVarNumber(valueSize) + valueSize, 0);
+    encoder.prependByteArray(&*fragBegin, fragSize);
+    encoder.prependVarNumber(fragSize);
+    encoder.prependVarNumber(lp::tlv::Fragment);
+    if (fragIndex == 0) {
+      for (auto it = firstHeaders.rbegin(); it != firstHeaders.rend(); ++it) {
+        encoder.prependByteArray(it->wire(), it->size());
+      }
+    }
+    ndn::encoding::prependNonNegativeIntegerBlock(encoder, lp::tlv::FragCount, fragCount);
+    ndn::encoding::prependNonNegativeIntegerBlock(encoder, lp::tlv::FragIndex, fragIndex);
+    if (firstSequence) {
+      ndn::encoding::prependNonNegativeIntegerBlock(encoder, lp::tlv::Sequence,
+                                                    *firstSequence + fragIndex);
+    }
+    encoder.prependVarNumber(valueSize);
+    encoder.prependVarNumber(lp::tlv::LpPacket);
+    BOOST_ASSERT(encoder.size() == 1 + tlv::sizeOfVarNumber(valueSize) + valueSize);
+    BOOST_ASSERT(encoder.size() <= mtu);
+
+    frags.emplace_back(encoder.block());
 
     ++fragIndex;
     fragBegin = fragEnd;
@@ -139,7 +169,7 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   }
   BOOST_ASSERT(fragIndex == fragCount);
 
-  return std::make_tuple(true, frags);
+  return std::make_tuple(true, std::move(frags));
 }
 
 std::ostream&
@@ -67,10 +67,17 @@ public:
    *  \param packet an LpPacket that contains a network-layer packet;
    *                must have Fragment field, must not have FragIndex and FragCount fields
    *  \param mtu maximum allowable LpPacket size after fragmentation and sequence number assignment
-   *  \return whether fragmentation succeeded, fragmented packets without sequence number
+   *  \param firstSequence if set, and the packet needs more than one fragment, the fragments carry
+   *                       consecutive sequence numbers starting from this value
+   *  \return whether fragmentation succeeded, fragmented packets
+   *
+   *  Each fragment is encoded in a single pass into its own buffer, which holds the NDNLPv2
+   *  headers followed by a slice of the network-layer packet, so that the payload is copied
+   *  only once and the fragment is not re-encoded when it is sent. A packet that fits in a
+   *  single fragment is returned as is, without sequence number.
    */
   std::tuple<bool, std::vector<lp::Packet>>
-  fragmentPacket(const lp::Packet& packet, size_t mtu);
+  fragmentPacket(const lp::Packet& packet, size_t mtu, optional<lp::Sequence> firstSequence = nullopt);
 
 private:
   Options m_options;
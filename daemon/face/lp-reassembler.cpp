@@ -27,8 +27,6 @@
 #include "link-service.hpp"
 #include "common/global.hpp"
 
-#include <numeric>
-
 namespace nfd {
 namespace face {
 
@@ -67,11 +65,15 @@ LpReassembler::receiveFragment(const lp::Packet& packet, const EndpointId& remot
     return FALSE_RETURN;
   }
 
+  ndn::Buffer::const_iterator fragBegin, fragEnd;
+  std::tie(fragBegin, fragEnd) = packet.get<lp::FragmentField>();
+  size_t fragSize = std::distance(fragBegin, fragEnd);
+
   // check for fast path
   if (fragIndex == 0 && fragCount == 1) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = packet.get<lp::FragmentField>();
-    Block netPkt(&*fragBegin, std::distance(fragBegin, fragEnd));
+    // the network-layer packet shares the buffer that the LpPacket was received into
+    Block wire = packet.wireEncode();
+    Block netPkt(wire.getBuffer(), fragBegin, fragEnd);
     return std::make_tuple(true, netPkt, packet);
   }
 
@@ -83,76 +85,213 @@ LpReassembler::receiveFragment(const lp::Packet& packet, const EndpointId& remot
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
   Key key = std::make_tuple(remoteEndpoint, messageIdentifier);
 
-  // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
-    pp.fragCount = fragCount;
-    pp.nReceivedFragments = 0;
+  auto it = m_partialPackets.find(key);
+  if (it == m_partialPackets.end()) { // new PartialPacket
+    it = m_partialPackets.emplace(key, PartialPacket()).first;
+    PartialPacket& pp = it->second;
     pp.fragments.resize(fragCount);
-  }
-  else {
-    if (fragCount != pp.fragCount) {
-      NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+    pp.payload = make_shared<ndn::Buffer>();
+    pp.lastUpdate = time::steady_clock::now();
+    pp.lruPos = m_lru.insert(m_lru.end(), key);
+    if (m_lru.size() == 1) {
+      scheduleSweep();
+    }
+
+    // assume that no fragment has a larger payload than this one's entire wire encoding,
+    // which holds when all fragments but the last are filled up to the same MTU,
+    // but never reserve more than the largest network-layer packet
+    size_t capacity = std::min(fragCount * packet.wireEncode().size(), ndn::MAX_NDN_PACKET_SIZE);
+    if (!reserveBytes(it, capacity)) {
+      NFD_LOG_FACE_WARN("reassembly error, packet over memory budget: DROP");
+      erasePartialPacket(it);
       return FALSE_RETURN;
     }
+    pp.payload->reserve(capacity);
+  }
+  else if (fragCount != it->second.fragments.size()) {
+    NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+    return FALSE_RETURN;
   }
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
+  PartialPacket& pp = it->second;
+  FragmentLocation& location = pp.fragments[fragIndex];
+  if (location.isReceived) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
     return FALSE_RETURN;
   }
 
-  pp.fragments[fragIndex] = packet;
+  if (pp.payload->size() + fragSize > ndn::MAX_NDN_PACKET_SIZE) {
+    erasePartialPacket(it);
+    NDN_THROW(tlv::Error("Reassembled packet exceeds MAX_NDN_PACKET_SIZE"));
+  }
+
+  if (pp.payload->size() + fragSize > pp.nBytes) {
+    // grow the buffer to fit the remaining fragments, assuming they are no larger than this one
+    size_t nRemaining = fragCount - pp.nReceivedFragments - 1;
+    size_t capacity = std::min(pp.payload->size() + fragSize * (1 + nRemaining),
+                               ndn::MAX_NDN_PACKET_SIZE);
+    if (!reserveBytes(it, capacity - pp.nBytes)) {
+      NFD_LOG_FACE_DEBUG("partial packet over memory budget, evicting");
+      ++m_nEvictions;
+      this->beforeEviction(remoteEndpoint, pp.nReceivedFragments);
+      erasePartialPacket(it);
+      return FALSE_RETURN;
+    }
+    pp.payload->reserve(capacity);
+  }
+
+  location.offset = pp.payload->size();
+  location.length = fragSize;
+  location.isReceived = true;
+  pp.payload->insert(pp.payload->end(), fragBegin, fragEnd);
+  pp.isInOrder = pp.isInOrder && fragIndex == pp.nReceivedFragments;
+  if (fragIndex == 0) {
+    pp.firstFragment = packet;
+  }
   ++pp.nReceivedFragments;
 
   // check complete condition
-  if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
+  if (pp.nReceivedFragments == fragCount) {
+    lp::Packet firstFrag(std::move(pp.firstFragment));
+    Block reassembled;
+    try {
+      reassembled = doReassembly(pp);
+    }
+    catch (const tlv::Error&) {
+      erasePartialPacket(it);
+      throw;
+    }
+    erasePartialPacket(it);
     return std::make_tuple(true, reassembled, firstFrag);
   }
 
-  // set drop timer
-  pp.dropTimer = getScheduler().schedule(m_options.reassemblyTimeout, [=] { timeoutPartialPacket(key); });
+  pp.lastUpdate = time::steady_clock::now();
+  m_lru.splice(m_lru.end(), m_lru, pp.lruPos);
 
   return FALSE_RETURN;
 }
 
-Block
-LpReassembler::doReassembly(const Key& key)
+bool
+LpReassembler::reserveBytes(PartialPacketMap::iterator it, size_t nBytes)
 {
-  PartialPacket& pp = m_partialPackets[key];
+  const EndpointId& endpoint = std::get<0>(it->first);
+  size_t totalBytes = it->second.nBytes + nBytes;
+  if (totalBytes > m_options.maxBytesPerEndpoint || totalBytes > m_options.maxBytes) {
+    return false;
+  }
 
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0U,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      ndn::Buffer::const_iterator fragBegin, fragEnd;
-      std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
-    });
+  auto getEndpointBytes = [&] {
+    auto epIt = m_endpointBytes.find(endpoint);
+    return epIt == m_endpointBytes.end() ? 0 : epIt->second;
+  };
+  while (getEndpointBytes() + nBytes > m_options.maxBytesPerEndpoint) {
+    if (!evictOldest(&endpoint, it)) {
+      return false;
+    }
+  }
+  while (m_nBytes + nBytes > m_options.maxBytes) {
+    if (!evictOldest(nullptr, it)) {
+      return false;
+    }
+  }
 
-  ndn::Buffer fragBuffer(payloadSize);
-  auto it = fragBuffer.begin();
+  m_endpointBytes[endpoint] += nBytes;
+  m_nBytes += nBytes;
+  m_peakBytes = std::max(m_peakBytes, m_nBytes);
+  it->second.nBytes += nBytes;
+  return true;
+}
 
-  for (const lp::Packet& frag : pp.fragments) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
-  }
+bool
+LpReassembler::evictOldest(const EndpointId* endpoint, PartialPacketMap::const_iterator except)
+{
+  for (const Key& key : m_lru) {
+    if (endpoint != nullptr && !(std::get<0>(key) == *endpoint)) {
+      continue;
+    }
+    auto it = m_partialPackets.find(key);
+    BOOST_ASSERT(it != m_partialPackets.end());
+    if (it == except) {
+      continue;
+    }
 
-  return Block(&*(fragBuffer.cbegin()), std::distance(fragBuffer.cbegin(), fragBuffer.cend()));
+    NFD_LOG_FACE_DEBUG("evicting partial packet with " << it->second.nReceivedFragments << "/"
+                       << it->second.fragments.size() << " fragments");
+    ++m_nEvictions;
+    this->beforeEviction(std::get<0>(it->first), it->second.nReceivedFragments);
+    erasePartialPacket(it);
+    return true;
+  }
+  return false;
 }
 
 void
-LpReassembler::timeoutPartialPacket(const Key& key)
+LpReassembler::erasePartialPacket(PartialPacketMap::iterator it)
 {
-  auto it = m_partialPackets.find(key);
-  if (it == m_partialPackets.end()) {
-    return;
+  PartialPacket& pp = it->second;
+  if (pp.nBytes > 0) {
+    auto epIt = m_endpointBytes.find(std::get<0>(it->first));
+    BOOST_ASSERT(epIt != m_endpointBytes.end() && epIt->second >= pp.nBytes);
+    epIt->second -= pp.nBytes;
+    if (epIt->second == 0) {
+      m_endpointBytes.erase(epIt);
+    }
+    m_nBytes -= pp.nBytes;
   }
 
-  this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
+  m_lru.erase(pp.lruPos);
   m_partialPackets.erase(it);
+  if (m_lru.empty()) {
+    m_sweepEvent.cancel();
+  }
+}
+
+Block
+LpReassembler::doReassembly(const PartialPacket& pp)
+{
+  if (pp.isInOrder) {
+    // the buffer already holds the packet; the Block takes it over without copying
+    return Block(pp.payload);
+  }
+
+  auto buffer = make_shared<ndn::Buffer>(pp.payload->size());
+  auto it = buffer->begin();
+  for (const FragmentLocation& location : pp.fragments) {
+    auto fragBegin = pp.payload->cbegin() + location.offset;
+    it = std::copy(fragBegin, fragBegin + location.length, it);
+  }
+  return Block(std::move(buffer));
+}
+
+void
+LpReassembler::scheduleSweep()
+{
+  BOOST_ASSERT(!m_lru.empty());
+  const PartialPacket& oldest = m_partialPackets.at(m_lru.front());
+  time::nanoseconds delay = oldest.lastUpdate + m_options.reassemblyTimeout -
+                            time::steady_clock::now();
+  m_sweepEvent = getScheduler().schedule(std::max(delay, time::nanoseconds::zero()),
+                                         [this] { sweep(); });
+}
+
+void
+LpReassembler::sweep()
+{
+  auto now = time::steady_clock::now();
+  while (!m_lru.empty()) {
+    auto it = m_partialPackets.find(m_lru.front());
+    BOOST_ASSERT(it != m_partialPackets.end());
+    if (it->second.lastUpdate + m_options.reassemblyTimeout > now) {
+      break;
+    }
+
+    this->beforeTimeout(std::get<0>(it->first), it->second.nReceivedFragments);
+    erasePartialPacket(it);
+  }
+
+  if (!m_lru.empty()) {
+    scheduleSweep();
+  }
 }
 
 std::ostream&
@@ -30,11 +30,26 @@
 
 #include <ndn-cxx/lp/packet.hpp>
 
+#include <list>
+#include <unordered_map>
+
 namespace nfd {
 namespace face {
 
 /** \brief reassembles fragmented network-layer packets
  *  \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
+ *
+ *  Partial packets are indexed by (remote endpoint, message identifier) in a hash table.
+ *  The payload of each fragment is copied on arrival into a buffer owned by the partial packet,
+ *  which is preallocated from FragCount but never beyond MAX_NDN_PACKET_SIZE, so that the buffer
+ *  holding the received fragment can be released or reused right away. When the fragments
+ *  arrive in order, the reassembled packet is this buffer itself.
+ *
+ *  The memory held by partial packets is bounded, both for the reassembler as a whole and for
+ *  each remote endpoint. Each GenericLinkService owns a reassembler, so these budgets apply to
+ *  a single face. When a budget would be exceeded, the least recently updated partial packets
+ *  are evicted.
+ *  Expired partial packets are dropped by a single timer, rather than one timer per packet.
  */
 class LpReassembler : noncopyable
 {
@@ -52,12 +67,23 @@ public:
     /** \brief timeout before a partially reassembled packet is dropped
      */
     time::nanoseconds reassemblyTimeout = 500_ms;
+
+    /** \brief maximum number of bytes held by all partial packets of this reassembler,
+     *         i.e. of one face
+     */
+    size_t maxBytes = 64 * 1024 * 1024;
+
+    /** \brief maximum number of bytes held by partial packets from a single remote endpoint
+     */
+    size_t maxBytesPerEndpoint = 8 * 1024 * 1024;
   };
 
   explicit
   LpReassembler(const Options& options, const LinkService* linkService = nullptr);
 
   /** \brief set options for reassembler
+   *
+   *  A reduced memory budget takes effect when the next partial packet grows.
    */
   void
   setOptions(const Options& options);
@@ -76,7 +102,8 @@ public:
    *          whether a network-layer packet has been completely received,
    *          the reassembled network-layer packet,
    *          the first fragment for inspecting other NDNLPv2 headers
-   *  \throw tlv::Error packet is malformed
+   *  \throw tlv::Error packet is malformed, or the fragments of its network-layer packet
+   *                    exceed MAX_NDN_PACKET_SIZE
    */
   std::tuple<bool, Block, lp::Packet>
   receiveFragment(const lp::Packet& packet, const EndpointId& remoteEndpoint = {});
@@ -86,6 +113,30 @@ public:
   size_t
   size() const;
 
+  /** \brief number of bytes currently held by partial packets
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
+  /** \brief highest number of bytes held by partial packets at any time
+   */
+  size_t
+  getPeakBytes() const
+  {
+    return m_peakBytes;
+  }
+
+  /** \brief count of partial packets evicted to stay within the memory budget
+   */
+  uint64_t
+  getNEvictions() const
+  {
+    return m_nEvictions;
+  }
+
   /** \brief signals before a partial packet is dropped due to timeout
    *
    *  If a partial packet is incomplete and no new fragment is received
@@ -95,17 +146,13 @@ public:
    */
   signal::Signal<LpReassembler, EndpointId, size_t> beforeTimeout;
 
-private:
-  /** \brief holds all fragments of packet until reassembled
+  /** \brief signals before a partial packet is evicted to stay within the memory budget
+   *
+   *  This signal is emitted with the remote endpoint, and the number of fragments being dropped.
    */
-  struct PartialPacket
-  {
-    std::vector<lp::Packet> fragments;
-    size_t fragCount; ///< total fragments
-    size_t nReceivedFragments; ///< number of received fragments
-    scheduler::ScopedEventId dropTimer;
-  };
+  signal::Signal<LpReassembler, EndpointId, size_t> beforeEviction;
 
+private:
   /** \brief index key for PartialPackets
    */
   typedef std::tuple<
@@ -113,16 +160,82 @@ private:
     lp::Sequence // message identifier (sequence of the first fragment)
   > Key;
 
-  Block
-  doReassembly(const Key& key);
+  struct KeyHash
+  {
+    size_t
+    operator()(const Key& key) const noexcept
+    {
+      size_t seed = EndpointIdHash{}(std::get<0>(key));
+      boost::hash_combine(seed, std::get<1>(key));
+      return seed;
+    }
+  };
+
+  /** \brief location of a fragment payload in PartialPacket::payload
+   */
+  struct FragmentLocation
+  {
+    size_t offset = 0;
+    size_t length = 0;
+    bool isReceived = false;
+  };
+
+  /** \brief holds the payloads of the fragments of a packet until reassembled
+   */
+  struct PartialPacket
+  {
+    shared_ptr<ndn::Buffer> payload; ///< fragment payloads, in order of arrival
+    std::vector<FragmentLocation> fragments; ///< indexed by FragIndex
+    lp::Packet firstFragment; ///< fragment with FragIndex 0, for other NDNLPv2 headers
+    size_t nReceivedFragments = 0;
+    bool isInOrder = true; ///< whether fragments arrived in order of FragIndex
+    size_t nBytes = 0; ///< bytes charged against the memory budget
+    time::steady_clock::TimePoint lastUpdate;
+    std::list<Key>::iterator lruPos; ///< position in m_lru
+  };
+
+  using PartialPacketMap = std::unordered_map<Key, PartialPacket, KeyHash>;
+
+  /** \brief charges \p nBytes more to \p it, evicting other partial packets if necessary
+   *  \retval false the budget cannot be met; \p it has not been charged
+   */
+  bool
+  reserveBytes(PartialPacketMap::iterator it, size_t nBytes);
+
+  /** \brief evicts the least recently updated partial packet from \p endpoint
+   *         (any endpoint if nullptr), other than \p except
+   *  \retval false no such partial packet
+   */
+  bool
+  evictOldest(const EndpointId* endpoint, PartialPacketMap::const_iterator except);
+
+  void
+  erasePartialPacket(PartialPacketMap::iterator it);
+
+  /** \brief concatenates fragment payloads in order of FragIndex
+   *  \throw tlv::Error reassembled packet is malformed
+   */
+  static Block
+  doReassembly(const PartialPacket& pp);
 
   void
-  timeoutPartialPacket(const Key& key);
+  scheduleSweep();
+
+  /** \brief drops partial packets that have not been updated within the reassembly timeout
+   */
+  void
+  sweep();
 
 private:
   Options m_options;
   const LinkService* m_linkService;
-  std::map<Key, PartialPacket> m_partialPackets;
+  PartialPacketMap m_partialPackets;
+  std::list<Key> m_lru; ///< partial packets, least recently updated first
+  std::unordered_map<EndpointId, size_t, EndpointIdHash> m_endpointBytes;
+  size_t m_nBytes = 0;
+  size_t m_peakBytes = 0;
+  uint64_t m_nEvictions = 0;
+  scheduler::ScopedEventId m_sweepEvent;
 };
 
 std::ostream&
@@ -33,10 +33,17 @@ namespace face {
 
 NFD_LOG_INIT(LpReliability);
 
+/** \brief whether TxSequence \a a precedes \a b, allowing for wraparound
+ */
+static bool
+isBefore(lp::Sequence a, lp::Sequence b)
+{
+  return static_cast<int64_t>(a - b) < 0;
+}
+
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
 {
   BOOST_ASSERT(m_linkService != nullptr);
@@ -66,10 +73,10 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
+  auto rto = m_rttEst.getEstimatedRto();
 
-  auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
+  NetPkt* netPkt = allocNetPkt(std::move(pkt), isInterest);
   netPkt->unackedFrags.reserve(frags.size());
 
   for (lp::Packet& frag : frags) {
@@ -80,27 +87,17 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.emplace_hint(unackedFragsIt,
-                                                 std::piecewise_construct,
-                                                 std::forward_as_tuple(txSeq),
-                                                 std::forward_as_tuple(frag));
-    unackedFragsIt->second.sendTime = sendTime;
-    auto rto = m_rttEst.getEstimatedRto();
-    lp::Sequence seq = frag.get<lp::SequenceField>();
-    NFD_LOG_FACE_TRACE("transmitting seq=" << seq << ", txseq=" << txSeq << ", rto=" <<
-                       time::duration_cast<time::milliseconds>(rto).count() << "ms");
-    unackedFragsIt->second.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(txSeq, true);
-    });
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
+    UnackedFrag& unackedFrag = m_unackedFrags.insert(txSeq, lp::Packet(frag), netPkt);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.rtoExpiry = sendTime + rto;
+    NFD_LOG_FACE_TRACE("transmitting seq=" << frag.get<lp::SequenceField>() << ", txseq=" << txSeq <<
+                       ", rto=" << time::duration_cast<time::milliseconds>(rto).count() << "ms");
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
   }
+
+  startRtoTimer();
 }
 
 bool
@@ -113,55 +110,36 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
 
   // Extract and parse Acks
   for (lp::Sequence ackTxSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackTxSeq);
-    if (fragIt == m_unackedFrags.end()) {
+    const UnackedFrag* frag = m_unackedFrags.find(ackTxSeq);
+    if (frag == nullptr) {
       // Ignore an Ack for an unknown TxSequence number
       NFD_LOG_FACE_DEBUG("received ack for unknown txseq=" << ackTxSeq);
       continue;
     }
-    auto& frag = fragIt->second;
 
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
-
-    if (frag.retxCount == 0) {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
+    if (frag->retxCount == 0) {
+      NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() << ", txseq=" <<
                          ackTxSeq << ", retx=0, rtt=" <<
-                         time::duration_cast<time::milliseconds>(now - frag.sendTime).count() << "ms");
+                         time::duration_cast<time::milliseconds>(now - frag->sendTime).count() << "ms");
       // This sequence had no retransmissions, so use it to estimate the RTO
-      m_rttEst.addMeasurement(now - frag.sendTime);
+      m_rttEst.addMeasurement(now - frag->sendTime);
     }
     else {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=" << frag.retxCount);
+      NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() << ", txseq=" <<
+                         ackTxSeq << ", retx=" << frag->retxCount);
     }
 
-    // Look for frags with TxSequence numbers < ackTxSeq (allowing for wraparound) and consider
-    // them lost if a configurable number of Acks containing greater TxSequence numbers have been
-    // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
-
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
-
-    // This set contains TxSequences that have been removed by onLpPacketLost below because they
-    // were part of a network packet that was removed due to a fragment exceeding retx, as well as
-    // any other TxSequences removed by onLpPacketLost. This prevents onLpPacketLost from being
-    // called later for an invalid iterator.
-    std::set<lp::Sequence> removedLpPackets;
-
-    // Resend or fail fragments considered lost. Potentially increment the start of the window.
-    for (lp::Sequence txSeq : lostLpPackets) {
-      if (removedLpPackets.find(txSeq) == removedLpPackets.end()) {
-        auto removedTxSeqs = onLpPacketLost(txSeq, false);
-        for (auto removedTxSeq : removedTxSeqs) {
-          removedLpPackets.insert(removedTxSeq);
-        }
-      }
-    }
+    // Remove the fragment from the window and from its associated network packet.
+    // Potentially increment the start of the window.
+    onLpPacketAcknowledged(ackTxSeq);
+
+    // Resend or fail fragments with TxSequence numbers < ackTxSeq (allowing for wraparound) if a
+    // configurable number of Acks containing greater TxSequence numbers have been received.
+    detectLostLpPackets(ackTxSeq);
   }
 
+  startRtoTimer();
+
   // If packet has Fragment and TxSequence fields, extract TxSequence and add to AckQueue
   if (pkt.has<lp::FragmentField>() && pkt.has<lp::TxSequenceField>()) {
     NFD_LOG_FACE_TRACE("queueing ack for remote txseq=" << pkt.get<lp::TxSequenceField>());
@@ -172,7 +150,6 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
       lp::Sequence pktSequence = pkt.get<lp::SequenceField>();
       isDuplicate = m_recentRecvSeqs.count(pktSequence) > 0;
       // Check for recent received Sequences to remove
-      auto now = time::steady_clock::now();
       auto rto = m_rttEst.getEstimatedRto();
       while (m_recentRecvSeqsQueue.size() > 0 &&
              now > m_recentRecvSeqs[m_recentRecvSeqsQueue.front()] + rto) {
@@ -226,7 +203,7 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (m_unackedFrags.size() > 0 && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstTxSeq()) {
     NDN_THROW(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
@@ -247,44 +224,73 @@ LpReliability::startIdleAckTimer()
   });
 }
 
-std::vector<lp::Sequence>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+void
+LpReliability::startRtoTimer()
 {
-  std::vector<lp::Sequence> lostLpPackets;
+  if (m_unackedFrags.empty()) {
+    m_rtoTimer.cancel();
+    return;
+  }
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
-    }
+  if (m_rtoTimer) {
+    // timer is already running, it will be rescheduled upon expiration if necessary
+    return;
+  }
 
-    if (it->first == ackIt->first) {
-      break;
-    }
+  m_rtoTimer = getScheduler().schedule(m_unackedFrags.front().rtoExpiry - time::steady_clock::now(),
+                                       [this] { onRtoTimerExpired(); });
+}
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
-    NFD_LOG_FACE_TRACE("received ack=" << ackIt->first << " before=" << it->first <<
-                       ", before count=" << unackedFrag.nGreaterSeqAcks);
+void
+LpReliability::onRtoTimerExpired()
+{
+  auto now = time::steady_clock::now();
+  // a fragment considered lost is either removed or retransmitted with a later RTO expiration,
+  // so the start of the window always moves forward
+  while (!m_unackedFrags.empty() && m_unackedFrags.front().rtoExpiry <= now) {
+    onLpPacketLost(m_unackedFrags.getFirstTxSeq(), true);
+  }
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it->first);
-    }
+  startRtoTimer();
+}
+
+void
+LpReliability::detectLostLpPackets(lp::Sequence ackTxSeq)
+{
+  size_t threshold = std::max<size_t>(m_options.seqNumLossThreshold, 1);
+
+  auto pos = std::find_if(m_greatestAckedTxSeqs.begin(), m_greatestAckedTxSeqs.end(),
+                          [ackTxSeq] (lp::Sequence txSeq) { return isBefore(txSeq, ackTxSeq); });
+  if (static_cast<size_t>(std::distance(m_greatestAckedTxSeqs.begin(), pos)) >= threshold) {
+    // not among the greatest acknowledged TxSequences, so no new fragment can be considered lost
+    return;
+  }
+  m_greatestAckedTxSeqs.insert(pos, ackTxSeq);
+  if (m_greatestAckedTxSeqs.size() > threshold) {
+    m_greatestAckedTxSeqs.resize(threshold);
+  }
+  if (m_greatestAckedTxSeqs.size() < threshold) {
+    return;
   }
 
-  return lostLpPackets;
+  lp::Sequence lossBoundary = m_greatestAckedTxSeqs.back();
+  // a fragment considered lost is either removed or retransmitted with a TxSequence after
+  // lossBoundary, so the start of the window always moves forward
+  while (!m_unackedFrags.empty() && isBefore(m_unackedFrags.getFirstTxSeq(), lossBoundary)) {
+    NFD_LOG_FACE_TRACE("received " << threshold << " acks after txseq=" <<
+                       m_unackedFrags.getFirstTxSeq() << ", greatest=" << m_greatestAckedTxSeqs.front());
+    onLpPacketLost(m_unackedFrags.getFirstTxSeq(), false);
+  }
 }
 
-std::vector<lp::Sequence>
+void
 LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
 {
-  BOOST_ASSERT(m_unackedFrags.count(txSeq) > 0);
-  auto txSeqIt = m_unackedFrags.find(txSeq);
+  UnackedFrag* txFrag = m_unackedFrags.find(txSeq);
+  BOOST_ASSERT(txFrag != nullptr);
 
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
-  auto netPkt = txFrag.netPkt;
-  std::vector<lp::Sequence> removedThisTxSeq;
-  lp::Sequence seq = txFrag.pkt.get<lp::SequenceField>();
+  NetPkt* netPkt = txFrag->netPkt;
+  lp::Sequence seq = txFrag->pkt.get<lp::SequenceField>();
 
   if (isTimeout) {
     NFD_LOG_FACE_TRACE("rto timer expired for seq=" << seq << ", txseq=" << txSeq);
@@ -295,14 +301,11 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
   }
 
   // Check if maximum number of retransmissions exceeded
-  if (txFrag.retxCount >= m_options.maxRetx) {
+  if (txFrag->retxCount >= m_options.maxRetx) {
     NFD_LOG_FACE_DEBUG("seq=" << seq << " exceeded allowed retransmissions: DROP");
-    // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        removedThisTxSeq.push_back(netPkt->unackedFrags[i]->first);
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
-      }
+    // Delete all LpPackets of NetPkt from m_unackedFrags (including this one)
+    for (lp::Sequence fragTxSeq : netPkt->unackedFrags) {
+      m_unackedFrags.erase(fragTxSeq);
     }
 
     ++m_linkService->nRetxExhausted;
@@ -316,59 +319,49 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
       onDroppedInterest(Interest(frag));
     }
 
-    // Delete this LpPacket from m_unackedFrags
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    releaseNetPkt(netPkt);
   }
   else {
-    // Assign new TxSequence
-    lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
+    // Move fragment to new TxSequence
+    lp::Packet pkt = std::move(txFrag->pkt);
+    size_t retxCount = txFrag->retxCount + 1;
+    lp::Sequence newTxSeq = assignTxSequence(pkt);
+    m_unackedFrags.erase(txSeq);
     netPkt->didRetx = true;
 
-    // Move fragment to new TxSequence mapping
-    auto newTxFragIt = m_unackedFrags.emplace_hint(
-      m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-        ? m_firstUnackedFrag
-        : m_unackedFrags.end(),
-      std::piecewise_construct,
-      std::forward_as_tuple(newTxSeq),
-      std::forward_as_tuple(txFrag.pkt));
-    auto& newTxFrag = newTxFragIt->second;
-    newTxFrag.retxCount = txFrag.retxCount + 1;
-    newTxFrag.netPkt = netPkt;
-
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
-
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
-
-    // Retransmit fragment
-    m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
+    *fragInNetPkt = newTxSeq;
 
+    // Start RTO for this sequence
+    auto now = time::steady_clock::now();
     auto rto = m_rttEst.getEstimatedRto();
+    UnackedFrag& newTxFrag = m_unackedFrags.insert(newTxSeq, std::move(pkt), netPkt);
+    newTxFrag.sendTime = now;
+    newTxFrag.rtoExpiry = now + rto;
+    newTxFrag.retxCount = retxCount;
+
     NFD_LOG_FACE_TRACE("retransmitting seq=" << seq << ", txseq=" << newTxSeq << ", retx=" <<
-                       txFrag.retxCount << ", rto=" <<
+                       retxCount << ", rto=" <<
                        time::duration_cast<time::milliseconds>(rto).count() << "ms");
 
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(newTxSeq, true);
-    });
+    // Retransmit fragment; Nacks and PRIORITY packets are retransmitted in the DATA class
+    m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt),
+                                netPkt->isInterest ? TxClass::INTEREST : TxClass::DATA);
   }
-
-  return removedThisTxSeq;
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  UnackedFrag* frag = m_unackedFrags.find(txSeq);
+  BOOST_ASSERT(frag != nullptr);
+  NetPkt* netPkt = frag->netPkt;
+  m_unackedFrags.erase(txSeq);
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
+  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
   BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
   *fragInNetPkt = netPkt->unackedFrags.back();
   netPkt->unackedFrags.pop_back();
@@ -381,45 +374,125 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     else {
       ++m_linkService->nAcknowledged;
     }
+    releaseNetPkt(netPkt);
   }
+}
 
-  deleteUnackedFrag(fragIt);
+LpReliability::NetPkt*
+LpReliability::allocNetPkt(lp::Packet&& pkt, bool isInterest)
+{
+  NetPkt* netPkt = nullptr;
+  if (m_freeNetPkts.empty()) {
+    m_netPkts.emplace_back();
+    netPkt = &m_netPkts.back();
+  }
+  else {
+    netPkt = m_freeNetPkts.back();
+    m_freeNetPkts.pop_back();
+  }
+
+  netPkt->pkt = std::move(pkt);
+  netPkt->isInterest = isInterest;
+  netPkt->didRetx = false;
+  return netPkt;
 }
 
 void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
+LpReliability::releaseNetPkt(NetPkt* netPkt)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
+  // the unackedFrags vector keeps its capacity for the next packet
+  netPkt->unackedFrags.clear();
+  netPkt->pkt = lp::Packet();
+  m_freeNetPkts.push_back(netPkt);
+}
+
+LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq)
+{
+  return const_cast<UnackedFrag*>(const_cast<const UnackedFrags*>(this)->find(txSeq));
+}
+
+const LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq) const
+{
+  if (txSeq - m_begin >= m_end - m_begin) {
+    // outside of the window
+    return nullptr;
   }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
+
+  const UnackedFrag& frag = m_slots[txSeq & (m_slots.size() - 1)];
+  return frag.netPkt == nullptr ? nullptr : &frag;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq)
+{
+  UnackedFrag* frag = find(txSeq);
+  if (frag == nullptr) {
+    NDN_THROW(std::out_of_range("No unacknowledged fragment with TxSequence " + to_string(txSeq)));
+  }
+  return *frag;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::insert(lp::Sequence txSeq, lp::Packet&& pkt, NetPkt* netPkt)
+{
+  BOOST_ASSERT(netPkt != nullptr);
+
+  if (empty()) {
+    m_begin = m_end = txSeq;
+  }
+  BOOST_ASSERT(txSeq - m_begin >= m_end - m_begin);
+
+  uint64_t span = txSeq - m_begin + 1;
+  if (span > m_slots.size()) {
+    grow(span);
   }
+
+  UnackedFrag& frag = m_slots[txSeq & (m_slots.size() - 1)];
+  BOOST_ASSERT(frag.netPkt == nullptr);
+  frag.pkt = std::move(pkt);
+  frag.netPkt = netPkt;
+  m_end = txSeq + 1;
+  ++m_size;
+  return frag;
 }
 
-LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
-  : pkt(std::move(pkt))
-  , sendTime(time::steady_clock::now())
-  , retxCount(0)
-  , nGreaterSeqAcks(0)
+void
+LpReliability::UnackedFrags::erase(lp::Sequence txSeq)
 {
+  UnackedFrag* frag = find(txSeq);
+  BOOST_ASSERT(frag != nullptr);
+  *frag = UnackedFrag();
+  --m_size;
+
+  if (empty()) {
+    m_begin = m_end;
+    return;
+  }
+
+  // if this was the first fragment in the window, move the window past the unused slots
+  while (m_slots[m_begin & (m_slots.size() - 1)].netPkt == nullptr) {
+    ++m_begin;
+  }
 }
 
-LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
-  : pkt(std::move(pkt))
-  , isInterest(isInterest)
-  , didRetx(false)
+void
+LpReliability::UnackedFrags::grow(uint64_t span)
 {
+  uint64_t capacity = std::max<uint64_t>(m_slots.size(), 16);
+  while (capacity < span) {
+    capacity *= 2;
+  }
+
+  std::vector<UnackedFrag> slots(capacity);
+  for (lp::Sequence txSeq = m_begin; txSeq != m_end; ++txSeq) {
+    UnackedFrag& frag = m_slots[txSeq & (m_slots.size() - 1)];
+    if (frag.netPkt != nullptr) {
+      slots[txSeq & (capacity - 1)] = std::move(frag);
+    }
+  }
+  m_slots.swap(slots);
 }
 
 std::ostream&
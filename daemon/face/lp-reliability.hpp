@@ -32,7 +32,9 @@
 #include <ndn-cxx/lp/sequence.hpp>
 #include <ndn-cxx/util/rtt-estimator.hpp>
 
+#include <deque>
 #include <queue>
+#include <unordered_map>
 
 namespace nfd {
 namespace face {
@@ -41,6 +43,10 @@ class GenericLinkService;
 
 /** \brief provides for reliable sending and receiving of link-layer packets
  *  \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
+ *
+ *  Unacknowledged fragments are kept in a ring buffer indexed by TxSequence, and share a single
+ *  retransmission timer. The per-packet bookkeeping is drawn from a pool, so that the cost of
+ *  sending and acknowledging a fragment does not depend on the number of fragments in flight.
  */
 class LpReliability : noncopyable
 {
@@ -108,7 +114,7 @@ public:
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+  class UnackedFrags;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief assign TxSequence number to a fragment
@@ -128,56 +134,71 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   startIdleAckTimer();
 
+  /** \brief start the retransmission timer, if not already running, for the first fragment
+   *         in the window; or stop it if there is no unacknowledged fragment
+   *
+   * A single timer serves all unacknowledged fragments. Since fragments are (re)transmitted in
+   * order of TxSequence, the first fragment in the window is the one whose RTO expires first,
+   * unless the estimated RTO has decreased since it was sent.
+   */
+  void
+  startRtoTimer();
+
+  /** \brief handle expiration of the retransmission timer
+   *
+   * Fragments at the start of the window whose RTO has expired are considered lost.
+   */
+  void
+  onRtoTimerExpired();
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
-   *  \return vector containing TxSequences of fragments marked lost by this mechanism
+   *  \param ackTxSeq TxSequence of the fragment that has just been acknowledged
+   *
+   *  Only the greatest acknowledged TxSequences are remembered. A fragment is lost if and only if
+   *  it precedes the seqNumLossThreshold-th greatest of them, so lost fragments are always found
+   *  at the start of the window, without visiting the rest of the window.
    */
-  std::vector<lp::Sequence>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  void
+  detectLostLpPackets(lp::Sequence ackTxSeq);
 
   /** \brief resend (or give up on) a lost fragment
-   *  \return vector of the TxSequences of fragments removed due to a network packet being removed
+   *
+   *  If the maximum number of retransmissions is exceeded, all fragments of the network packet
+   *  are removed from the window.
    */
-  std::vector<lp::Sequence>
+  void
   onLpPacketLost(lp::Sequence txSeq, bool isTimeout);
 
-  /** \brief remove the fragment with the given sequence number from the map of unacknowledged
-   *         fragments, as well as its associated network packet (if any)
-   *  \param fragIt iterator to acknowledged fragment
+  /** \brief remove the fragment with the given TxSequence from the window, as well as from its
+   *         associated network packet
    *
-   *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
-   *  If the associated network packet has been fully transmitted, it will be removed.
+   *  If the associated network packet has been fully acknowledged, it will be released.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
 
-  /** \brief delete a fragment from UnackedFrags and advance acknowledge window if necessary
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
+  /** \brief obtain a NetPkt from the pool
+   */
+  NetPkt*
+  allocNetPkt(lp::Packet&& pkt, bool isInterest);
+
+  /** \brief return a NetPkt to the pool
    */
   void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  releaseNetPkt(NetPkt* netPkt);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief contains a sent fragment that has not been acknowledged and associated data
    */
   class UnackedFrag
   {
-  public:
-    explicit
-    UnackedFrag(lp::Packet pkt);
-
   public:
     lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
     time::steady_clock::TimePoint sendTime;
-    size_t retxCount;
-    size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
-    shared_ptr<NetPkt> netPkt;
+    time::steady_clock::TimePoint rtoExpiry;
+    size_t retxCount = 0;
+    NetPkt* netPkt = nullptr; //!< network packet of this fragment, nullptr if the slot is unused
   };
 
   /** \brief contains a network-layer packet with unacknowledged fragments
@@ -185,13 +206,97 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class NetPkt
   {
   public:
-    NetPkt(lp::Packet&& pkt, bool isInterest);
+    std::vector<lp::Sequence> unackedFrags; //!< TxSequences of unacknowledged fragments
+    lp::Packet pkt;
+    bool isInterest = false;
+    bool didRetx = false;
+  };
 
+  /** \brief unacknowledged fragments, indexed by TxSequence
+   *
+   *  This is a ring buffer that covers the TxSequence range from the first unacknowledged fragment
+   *  to the last transmitted fragment. Fragments are always inserted after the end of the window.
+   *  The slots of fragments that have been acknowledged, retransmitted under a new TxSequence, or
+   *  given up on remain unused until the start of the window moves past them. The capacity doubles
+   *  when the window outgrows it, and is retained afterwards.
+   */
+  class UnackedFrags
+  {
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
-    lp::Packet pkt;
-    bool isInterest;
-    bool didRetx;
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    /** \return number of unacknowledged fragments
+     */
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    size_t
+    count(lp::Sequence txSeq) const
+    {
+      return find(txSeq) != nullptr;
+    }
+
+    /** \return TxSequence of the first unacknowledged fragment
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstTxSeq() const
+    {
+      BOOST_ASSERT(!empty());
+      return m_begin;
+    }
+
+    /** \return first unacknowledged fragment
+     *  \pre !empty()
+     */
+    UnackedFrag&
+    front()
+    {
+      BOOST_ASSERT(!empty());
+      return m_slots[m_begin & (m_slots.size() - 1)];
+    }
+
+    /** \return unacknowledged fragment with TxSequence \p txSeq, or nullptr if there is none
+     */
+    UnackedFrag*
+    find(lp::Sequence txSeq);
+
+    const UnackedFrag*
+    find(lp::Sequence txSeq) const;
+
+    /** \throw std::out_of_range there is no unacknowledged fragment with TxSequence \p txSeq
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq);
+
+    /** \brief store a fragment transmitted with TxSequence \p txSeq
+     *  \pre \p txSeq is after all TxSequences in the window
+     */
+    UnackedFrag&
+    insert(lp::Sequence txSeq, lp::Packet&& pkt, NetPkt* netPkt);
+
+    /** \brief remove a fragment, advancing the start of the window if necessary
+     *  \pre count(txSeq) == 1
+     */
+    void
+    erase(lp::Sequence txSeq);
+
+  private:
+    void
+    grow(uint64_t span);
+
+  private:
+    std::vector<UnackedFrag> m_slots; //!< size is zero or a power of two
+    lp::Sequence m_begin = 0; //!< TxSequence of the first unacknowledged fragment
+    lp::Sequence m_end = 0; //!< TxSequence after the last transmitted fragment
+    size_t m_size = 0;
   };
 
 public:
@@ -204,16 +309,17 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Options m_options;
   GenericLinkService* m_linkService;
   UnackedFrags m_unackedFrags;
-  /** An iterator that points to the first unacknowledged fragment in the current window. The window
-   *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
+  std::deque<NetPkt> m_netPkts; //!< storage of NetPkt, grows to the peak number of packets in flight
+  std::vector<NetPkt*> m_freeNetPkts;
+  /** The greatest TxSequences acknowledged so far, in descending order, up to
+   *  Options::seqNumLossThreshold of them. Fragments before the last one are considered lost.
    */
-  UnackedFrags::iterator m_firstUnackedFrag;
+  std::vector<lp::Sequence> m_greatestAckedTxSeqs;
   std::queue<lp::Sequence> m_ackQueue;
-  std::map<lp::Sequence, time::steady_clock::TimePoint> m_recentRecvSeqs;
+  std::unordered_map<lp::Sequence, time::steady_clock::TimePoint> m_recentRecvSeqs;
   std::queue<lp::Sequence> m_recentRecvSeqsQueue;
   lp::Sequence m_lastTxSeqNo;
+  scheduler::ScopedEventId m_rtoTimer;
   scheduler::ScopedEventId m_idleAckTimer;
   ndn::util::RttEstimator m_rttEst;
 };
@@ -50,8 +50,10 @@ NFD_LOG_INIT(MulticastEthernetTransport);
 
 MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                                                        const ethernet::Address& mcastAddress,
-                                                       ndn::nfd::LinkType linkType)
-  : EthernetTransport(localEndpoint, mcastAddress)
+                                                       ndn::nfd::LinkType linkType,
+                                                       bool wantPacketRing,
+                                                       shared_ptr<EthernetXdpSocket> xdpSocket)
+  : EthernetTransport(localEndpoint, mcastAddress, wantPacketRing, std::move(xdpSocket))
 #if defined(__linux__)
   , m_interfaceIndex(localEndpoint.getIndex())
 #endif
@@ -61,7 +63,7 @@ MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkIn
   this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
   this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
   this->setLinkType(linkType);
-  this->setMtu(localEndpoint.getMtu());
+  this->setMtuFromNetif(localEndpoint.getMtu());
 
   NFD_LOG_FACE_DEBUG("Creating transport");
 
@@ -75,7 +77,7 @@ MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkIn
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().data(),
            m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+  setPacketFilter(filter);
 
   BOOST_ASSERT(m_destAddress.isMulticast());
   if (!m_destAddress.isBroadcast())
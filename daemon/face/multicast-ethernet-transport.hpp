@@ -42,7 +42,9 @@ public:
    */
   MulticastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                              const ethernet::Address& mcastAddress,
-                             ndn::nfd::LinkType linkType);
+                             ndn::nfd::LinkType linkType,
+                             bool wantPacketRing = false,
+                             shared_ptr<EthernetXdpSocket> xdpSocket = nullptr);
 
 private:
   /**
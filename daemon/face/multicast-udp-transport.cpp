@@ -67,6 +67,7 @@ MulticastUdpTransport::MulticastUdpTransport(const protocol::endpoint& multicast
   else {
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
+  this->setBatchSendTarget(m_sendSocket, m_multicastGroup);
 
   NFD_LOG_FACE_DEBUG("Creating transport");
 }
@@ -84,6 +85,11 @@ MulticastUdpTransport::getSendQueueLength()
 void
 MulticastUdpTransport::doSend(const Block& packet)
 {
+  if (isSendQueued()) {
+    // batched transmission goes through m_sendSocket, see setBatchSendTarget()
+    return DatagramTransport::doSend(packet);
+  }
+
   NFD_LOG_FACE_TRACE(__func__);
 
   m_sendSocket.async_send_to(boost::asio::buffer(packet), m_multicastGroup,
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_PACKET_TRACE_HPP
+#define NFD_DAEMON_FACE_PACKET_TRACE_HPP
+
+#include "common/counter.hpp"
+#include "core/latency-status.hpp"
+
+#include <ndn-cxx/tag.hpp>
+
+namespace nfd {
+namespace face {
+
+/** \brief latency histograms of the sampled Interests received on a face
+ *
+ *  The histogram of each stage counts the time from TraceStage::RECEIVE to that stage.
+ */
+class LatencyStats : noncopyable
+{
+public:
+  void
+  record(TraceStage stage, time::nanoseconds latency) noexcept
+  {
+    m_histograms[static_cast<size_t>(stage)].add(latency);
+  }
+
+  const DurationHistogram&
+  get(TraceStage stage) const noexcept
+  {
+    return m_histograms[static_cast<size_t>(stage)];
+  }
+
+private:
+  std::array<DurationHistogram, N_TRACE_STAGES> m_histograms;
+};
+
+/** \brief timestamps an Interest sampled for latency tracing as it reaches each stage
+ *
+ *  The latencies are recorded into the LatencyStats of the face on which the Interest was
+ *  received. If the Interest is forwarded to several upstreams, the SEND and TRANSMIT
+ *  stages are recorded once per upstream.
+ */
+class PacketTrace : noncopyable
+{
+public:
+  explicit
+  PacketTrace(shared_ptr<LatencyStats> stats,
+              time::steady_clock::TimePoint receiveTime = time::steady_clock::now())
+    : m_stats(std::move(stats))
+    , m_receiveTime(receiveTime)
+  {
+  }
+
+  void
+  mark(TraceStage stage, time::steady_clock::TimePoint now = time::steady_clock::now())
+  {
+    m_stats->record(stage, now - m_receiveTime);
+  }
+
+private:
+  shared_ptr<LatencyStats> m_stats;
+  time::steady_clock::TimePoint m_receiveTime;
+};
+
+/** \brief attaches the PacketTrace of a sampled Interest to the Interest
+ *
+ *  The forwarder removes this tag after dispatching the Interest to the strategy, so that
+ *  later transmissions of the same Interest object, such as retransmissions by the strategy,
+ *  are not counted.
+ */
+using PacketTraceTag = ndn::SimpleTag<shared_ptr<PacketTrace>, 21>;
+
+/** \brief record that \p interest has reached \p stage, if it is sampled for latency tracing
+ */
+inline void
+markTrace(const Interest& interest, TraceStage stage)
+{
+  auto tag = interest.getTag<PacketTraceTag>();
+  if (tag != nullptr) {
+    tag->get()->mark(stage);
+  }
+}
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_PACKET_TRACE_HPP
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "receive-buffer-pool.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+namespace face {
+
+ReceiveBufferPool::ReceiveBufferPool(size_t bufferSize, size_t capacity)
+  : m_bufferSize(bufferSize)
+  , m_capacity(capacity)
+{
+  BOOST_ASSERT(bufferSize > 0);
+}
+
+shared_ptr<ndn::Buffer>
+ReceiveBufferPool::acquire()
+{
+  // Start after the most recently acquired buffer: buffers are released in roughly the same
+  // order as they were acquired, so the next one is the most likely to be idle.
+  for (size_t i = 0; i < m_buffers.size(); ++i) {
+    size_t index = (m_nextIndex + i) % m_buffers.size();
+    if (m_buffers[index].use_count() == 1) {
+      ++m_nHits;
+      m_nextIndex = index + 1;
+      return m_buffers[index];
+    }
+  }
+
+  ++m_nMisses;
+  auto buffer = make_shared<ndn::Buffer>(m_bufferSize);
+  if (m_buffers.size() < m_capacity) {
+    m_buffers.push_back(buffer);
+    m_highWaterMark = std::max(m_highWaterMark, m_buffers.size());
+    m_nextIndex = m_buffers.size();
+  }
+  return buffer;
+}
+
+bool
+ReceiveBufferPool::isExhausted() const
+{
+  return m_buffers.size() >= m_capacity &&
+         std::none_of(m_buffers.begin(), m_buffers.end(),
+                      [] (const auto& buffer) { return buffer.use_count() == 1; });
+}
+
+void
+ReceiveBufferPool::resize(size_t bufferSize, size_t capacity)
+{
+  BOOST_ASSERT(bufferSize > 0);
+
+  if (bufferSize != m_bufferSize) {
+    m_buffers.clear();
+    m_bufferSize = bufferSize;
+  }
+  else if (m_buffers.size() > capacity) {
+    m_buffers.resize(capacity);
+  }
+  m_capacity = capacity;
+  m_nextIndex = 0;
+}
+
+void
+ReceiveBufferPool::trim(size_t nIdle)
+{
+  size_t nKeptIdle = 0;
+  std::vector<shared_ptr<ndn::Buffer>> kept;
+  for (auto& buffer : m_buffers) {
+    if (buffer.use_count() > 1 || nKeptIdle++ < nIdle) {
+      kept.push_back(std::move(buffer));
+    }
+  }
+  m_buffers = std::move(kept);
+  m_nextIndex = 0;
+}
+
+} // namespace face
+} // namespace nfd
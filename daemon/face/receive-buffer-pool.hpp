@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
+#define NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace nfd {
+namespace face {
+
+/** \brief A pool of fixed-size buffers that incoming packets are received into.
+ *
+ *  A buffer obtained from acquire() is written by the kernel and then becomes the backing
+ *  storage of the Blocks decoded from it, without copying. The pool retains a reference to
+ *  each of its buffers; a buffer is idle, and can be handed out again, once every other
+ *  reference to it has been released.
+ *
+ *  The pool holds at most \c capacity buffers. If all of them are in use, acquire() allocates
+ *  a buffer that does not belong to the pool and is deallocated when released.
+ */
+class ReceiveBufferPool : noncopyable
+{
+public:
+  ReceiveBufferPool(size_t bufferSize, size_t capacity);
+
+  /** \brief Returns a buffer of getBufferSize() octets with unspecified content.
+   */
+  shared_ptr<ndn::Buffer>
+  acquire();
+
+  size_t
+  getBufferSize() const
+  {
+    return m_bufferSize;
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \brief Changes the size of the buffers and the capacity of the pool.
+   *
+   *  If \p bufferSize differs from the current buffer size, all buffers are removed from
+   *  the pool; otherwise, buffers in excess of \p capacity are removed. Buffers still
+   *  referenced elsewhere remain valid and are deallocated when released.
+   */
+  void
+  resize(size_t bufferSize, size_t capacity);
+
+  /** \brief Removes idle buffers from the pool, so that at most \p nIdle of them remain.
+   */
+  void
+  trim(size_t nIdle);
+
+  /** \brief Returns whether the pool owns getCapacity() buffers and all of them are in use,
+   *         so that acquire() would allocate a buffer that does not belong to the pool.
+   */
+  bool
+  isExhausted() const;
+
+  /** \brief Returns the number of buffers owned by the pool, whether idle or in use.
+   */
+  size_t
+  size() const
+  {
+    return m_buffers.size();
+  }
+
+  /** \brief Returns how many times acquire() returned an idle buffer from the pool.
+   */
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /** \brief Returns how many times acquire() had to allocate a buffer.
+   */
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+  /** \brief Returns the largest number of buffers that the pool has owned at the same time.
+   */
+  size_t
+  getHighWaterMark() const
+  {
+    return m_highWaterMark;
+  }
+
+private:
+  size_t m_bufferSize;
+  size_t m_capacity;
+  std::vector<shared_ptr<ndn::Buffer>> m_buffers;
+  size_t m_nextIndex = 0; ///< where the search for an idle buffer starts
+  uint64_t m_nHits = 0;
+  uint64_t m_nMisses = 0;
+  size_t m_highWaterMark = 0;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shared-udp-transport.hpp"
+#include "socket-utils.hpp"
+#include "common/global.hpp"
+
+#include <cerrno>  // for errno
+#include <cstring> // for std::strerror()
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(SharedUdpTransport);
+
+SharedUdpTransport::SharedUdpTransport(shared_ptr<boost::asio::ip::udp::socket> socket,
+                                       const udp::Endpoint& remoteEndpoint,
+                                       ndn::nfd::FacePersistency persistency,
+                                       time::nanoseconds idleTimeout)
+  : m_socket(std::move(socket))
+  , m_remoteEndpoint(remoteEndpoint)
+  , m_idleTimeout(idleTimeout)
+{
+  this->setLocalUri(FaceUri(m_socket->local_endpoint()));
+  this->setRemoteUri(FaceUri(m_remoteEndpoint));
+  this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  this->setPersistency(persistency);
+  this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  this->setMtu(udp::computeMtu(m_socket->local_endpoint()));
+
+  boost::asio::socket_base::send_buffer_size sendBufferSizeOption;
+  boost::system::error_code error;
+  m_socket->get_option(sendBufferSizeOption, error);
+  if (error) {
+    NFD_LOG_FACE_WARN("Failed to obtain send queue capacity from socket: " << error.message());
+    this->setSendQueueCapacity(QUEUE_ERROR);
+  }
+  else {
+    this->setSendQueueCapacity(sendBufferSizeOption.value());
+  }
+
+  NFD_LOG_FACE_DEBUG("Creating transport");
+
+  if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      m_idleTimeout > time::nanoseconds::zero()) {
+    scheduleClosureWhenIdle();
+  }
+}
+
+void
+SharedUdpTransport::receiveDatagram(const uint8_t* buffer, size_t nBytesReceived)
+{
+  if (getState() != TransportState::UP) {
+    // the channel may still deliver datagrams while the face is closing
+    return;
+  }
+
+  NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
+
+  if (nBytesReceived == 0) {
+    NFD_LOG_FACE_WARN("Failed to parse incoming packet");
+    // This packet won't extend the face lifetime
+    return;
+  }
+
+  // the datagram may contain several packets packed by the sender; all of them must be valid
+  auto datagram = make_shared<ndn::Buffer>(buffer, nBytesReceived);
+  std::vector<Block> elements;
+  for (size_t pos = 0; pos < nBytesReceived; pos += elements.back().size()) {
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(datagram, pos);
+    if (!isOk) {
+      NFD_LOG_FACE_WARN("Failed to parse incoming packet");
+      // This packet won't extend the face lifetime
+      return;
+    }
+    elements.push_back(std::move(element));
+  }
+  m_hasRecentlyReceived = true;
+
+  if (elements.size() > 1) {
+    NFD_LOG_FACE_TRACE("Unpacked " << elements.size() << " packets");
+  }
+  for (const auto& packet : elements) {
+    if (getState() != TransportState::UP) {
+      break;
+    }
+    this->receive(packet);
+  }
+}
+
+ssize_t
+SharedUdpTransport::getSendQueueLength()
+{
+  // doSend never queues, so the socket buffer is the only send queue
+  ssize_t queueLength = getTxQueueLength(m_socket->native_handle());
+  if (queueLength == QUEUE_ERROR) {
+    NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+  }
+  return queueLength;
+}
+
+bool
+SharedUdpTransport::canChangePersistencyToImpl(ndn::nfd::FacePersistency newPersistency) const
+{
+  return true;
+}
+
+void
+SharedUdpTransport::afterChangePersistency(ndn::nfd::FacePersistency oldPersistency)
+{
+  if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
+      m_idleTimeout > time::nanoseconds::zero()) {
+    scheduleClosureWhenIdle();
+  }
+  else {
+    m_closeIfIdleEvent.cancel();
+    setExpirationTime(time::steady_clock::TimePoint::max());
+  }
+}
+
+void
+SharedUdpTransport::doClose()
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // the socket belongs to the channel and stays open
+  m_closeIfIdleEvent.cancel();
+
+  getGlobalIoService().post([this] {
+    this->setState(TransportState::CLOSED);
+  });
+}
+
+void
+SharedUdpTransport::doSend(const Block& packet)
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // A pending asynchronous operation on the shared socket could outlive this transport,
+  // so the datagram is sent synchronously on the non-blocking socket instead.
+  boost::system::error_code error;
+  m_socket->send_to(boost::asio::buffer(packet), m_remoteEndpoint, 0, error);
+  if (error == boost::asio::error::would_block) {
+    NFD_LOG_FACE_DEBUG("Socket buffer full, dropping packet");
+  }
+  else if (error) {
+    // errors on an unconnected socket do not indicate the state of this particular peer
+    NFD_LOG_FACE_DEBUG("Send operation failed: " << error.message());
+  }
+}
+
+void
+SharedUdpTransport::scheduleClosureWhenIdle()
+{
+  m_closeIfIdleEvent = getScheduler().schedule(m_idleTimeout, [this] {
+    if (!m_hasRecentlyReceived) {
+      NFD_LOG_FACE_INFO("Closing due to inactivity");
+      this->close();
+    }
+    else {
+      m_hasRecentlyReceived = false;
+      scheduleClosureWhenIdle();
+    }
+  });
+  setExpirationTime(time::steady_clock::now() + m_idleTimeout);
+}
+
+} // namespace face
+} // namespace nfd
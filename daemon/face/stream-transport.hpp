@@ -30,21 +30,76 @@
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
-#include <queue>
+#include <algorithm>
+#include <deque>
 
 namespace nfd {
 namespace face {
 
+/** \brief Default maximum number of packets written by a single gather write on a stream socket
+ */
+const size_t DEFAULT_STREAM_SEND_BATCH_PACKETS = 64;
+
+/** \brief Default maximum number of bytes written by a single gather write on a stream socket
+ */
+const size_t DEFAULT_STREAM_SEND_BATCH_BYTES = 65536;
+
+/** \brief Size of the buffers that stream transports receive into
+ *
+ *  Incoming packets are normally handed to the link service as Blocks that point into these
+ *  buffers, so that a buffer is released only after all packets received into it have been
+ *  released.
+ */
+const size_t STREAM_RECEIVE_CHUNK_SIZE = 4 * ndn::MAX_NDN_PACKET_SIZE;
+
+/** \brief Incoming packets smaller than this are copied out of the receive buffer
+ *
+ *  A small packet that is retained for a long time, e.g., an Interest in the PIT, would otherwise
+ *  keep alive a whole receive buffer that is much larger than the packet itself.
+ */
+const size_t STREAM_RECEIVE_COPY_THRESHOLD = 512;
+
+/** \brief Maximum number of earlier receive buffers that a stream transport lets incoming
+ *         packets keep alive
+ *
+ *  While this many earlier buffers are still referenced by packets, e.g., Data retained in the
+ *  ContentStore, every incoming packet is copied out of the current buffer, so that the current
+ *  buffer can be reused instead of allocating another one.
+ */
+const size_t MAX_STREAM_RECEIVE_PINNED_CHUNKS = 8;
+
+/** \brief Counters provided by StreamTransport.
+ *  \note The type name StreamTransportCounters is an implementation detail.
+ *        Use StreamTransport::Counters in public API.
+ */
+class StreamTransportCounters : public virtual Transport::Counters
+{
+public:
+  /** \brief count of incoming bytes copied within the receive path
+   *
+   *  Bytes are copied when a packet straddles the end of a receive buffer, when a packet is
+   *  smaller than STREAM_RECEIVE_COPY_THRESHOLD, and while MAX_STREAM_RECEIVE_PINNED_CHUNKS
+   *  earlier receive buffers are still referenced. The link service does not copy unfragmented
+   *  packets again, so only the reassembly of fragmented packets is not counted here.
+   */
+  ByteCounter nInBytesCopied;
+};
+
 /** \brief Implements Transport for stream-based protocols.
  *
  *  \tparam Protocol a stream-based protocol in Boost.Asio
  */
 template<class Protocol>
 class StreamTransport : public Transport
+                      , protected virtual StreamTransportCounters
 {
 public:
   typedef Protocol protocol;
 
+  /** \brief counters provided by StreamTransport
+   */
+  using Counters = StreamTransportCounters;
+
   /** \brief Construct stream transport.
    *
    *  \param socket Protocol-specific socket for the created transport
@@ -52,9 +107,22 @@ public:
   explicit
   StreamTransport(typename protocol::socket&& socket);
 
+  const Counters&
+  getCounters() const override;
+
   ssize_t
   getSendQueueLength() override;
 
+  /** \brief Sets the limits of a single gather write.
+   *
+   *  Queued packets are written to the socket with a single vectored write, which contains up to
+   *  \p maxPackets packets and \p maxBytes bytes. A gather write always contains at least one
+   *  packet, even if the packet is larger than \p maxBytes. Setting \p maxPackets to 1 causes
+   *  each packet to be written separately.
+   */
+  void
+  setSendBatchLimits(size_t maxPackets, size_t maxBytes);
+
 protected:
   void
   doClose() override;
@@ -75,10 +143,21 @@ protected:
   void
   startReceive();
 
+  /** \brief Ensures that the receive buffer has room for a packet of maximum size
+   *         after the partially received packet, if any.
+   */
+  void
+  prepareReceiveBuffer();
+
   void
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  /** \brief Returns the number of earlier receive buffers still referenced by received packets
+   */
+  size_t
+  countPinnedChunks();
+
   void
   processErrorCode(const boost::system::error_code& error);
 
@@ -100,18 +179,26 @@ protected:
   NFD_LOG_MEMBER_DECL();
 
 private:
-  uint8_t m_receiveBuffer[ndn::MAX_NDN_PACKET_SIZE];
-  size_t m_receiveBufferSize;
-  std::queue<Block> m_sendQueue;
+  shared_ptr<ndn::Buffer> m_receiveBuffer;
+  size_t m_receiveBegin; ///< offset of the first byte not yet delivered in a packet
+  size_t m_receiveEnd; ///< offset after the last received byte
+  std::vector<weak_ptr<ndn::Buffer>> m_pinnedChunks; ///< earlier receive buffers
+  std::deque<Block> m_sendQueue;
   size_t m_sendQueueBytes;
+  std::vector<boost::asio::const_buffer> m_sendBuffers; ///< buffers of the pending gather write
+  size_t m_sendBatchPackets;
+  size_t m_sendBatchBytes;
 };
 
 
 template<class T>
 StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&& socket)
   : m_socket(std::move(socket))
-  , m_receiveBufferSize(0)
+  , m_receiveBegin(0)
+  , m_receiveEnd(0)
   , m_sendQueueBytes(0)
+  , m_sendBatchPackets(DEFAULT_STREAM_SEND_BATCH_PACKETS)
+  , m_sendBatchBytes(DEFAULT_STREAM_SEND_BATCH_BYTES)
 {
   // No queue capacity is set because there is no theoretical limit to the size of m_sendQueue.
   // Therefore, protecting against send queue overflows is less critical than in other transport
@@ -120,6 +207,13 @@ StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&&
   startReceive();
 }
 
+template<class T>
+const typename StreamTransport<T>::Counters&
+StreamTransport<T>::getCounters() const
+{
+  return *this;
+}
+
 template<class T>
 ssize_t
 StreamTransport<T>::getSendQueueLength()
@@ -131,6 +225,16 @@ StreamTransport<T>::getSendQueueLength()
   return getSendQueueBytes() + std::max<ssize_t>(0, queueLength);
 }
 
+template<class T>
+void
+StreamTransport<T>::setSendBatchLimits(size_t maxPackets, size_t maxBytes)
+{
+  BOOST_ASSERT(maxPackets > 0);
+  BOOST_ASSERT(maxBytes > 0);
+  m_sendBatchPackets = maxPackets;
+  m_sendBatchBytes = maxBytes;
+}
+
 template<class T>
 void
 StreamTransport<T>::doClose()
@@ -188,7 +292,7 @@ StreamTransport<T>::doSend(const Block& packet)
     return;
 
   bool wasQueueEmpty = m_sendQueue.empty();
-  m_sendQueue.push(packet);
+  m_sendQueue.push_back(packet);
   m_sendQueueBytes += packet.size();
 
   if (wasQueueEmpty)
@@ -199,7 +303,22 @@ template<class T>
 void
 StreamTransport<T>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  BOOST_ASSERT(!m_sendQueue.empty());
+
+  // gather as many queued packets as allowed into a single write;
+  // async_write takes care of partial writes, including those across packet boundaries
+  m_sendBuffers.clear();
+  size_t nBytes = 0;
+  for (const Block& packet : m_sendQueue) {
+    if (!m_sendBuffers.empty() &&
+        (m_sendBuffers.size() >= m_sendBatchPackets || nBytes + packet.size() > m_sendBatchBytes)) {
+      break;
+    }
+    m_sendBuffers.push_back(boost::asio::buffer(packet));
+    nBytes += packet.size();
+  }
+
+  boost::asio::async_write(m_socket, m_sendBuffers,
                            [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
 }
 
@@ -213,10 +332,11 @@ StreamTransport<T>::handleSend(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
 
-  BOOST_ASSERT(!m_sendQueue.empty());
-  BOOST_ASSERT(m_sendQueue.front().size() == nBytesSent);
+  BOOST_ASSERT(m_sendQueue.size() >= m_sendBuffers.size());
+  BOOST_ASSERT(boost::asio::buffer_size(m_sendBuffers) == nBytesSent);
   m_sendQueueBytes -= nBytesSent;
-  m_sendQueue.pop();
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_sendBuffers.size());
+  m_sendBuffers.clear();
 
   if (!m_sendQueue.empty())
     sendFromQueue();
@@ -228,11 +348,43 @@ StreamTransport<T>::startReceive()
 {
   BOOST_ASSERT(getState() == TransportState::UP);
 
-  m_socket.async_receive(boost::asio::buffer(m_receiveBuffer + m_receiveBufferSize,
-                                             ndn::MAX_NDN_PACKET_SIZE - m_receiveBufferSize),
+  prepareReceiveBuffer();
+  m_socket.async_receive(boost::asio::buffer(m_receiveBuffer->data() + m_receiveEnd,
+                                             m_receiveBuffer->size() - m_receiveEnd),
                          [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
 }
 
+template<class T>
+void
+StreamTransport<T>::prepareReceiveBuffer()
+{
+  if (m_receiveBuffer != nullptr &&
+      m_receiveBuffer->size() - m_receiveBegin >= ndn::MAX_NDN_PACKET_SIZE)
+    return;
+
+  // Move the partially received packet to the beginning of a buffer. The current buffer can be
+  // reused only if no Block refers to it; otherwise a new buffer is allocated, and the current
+  // one is released when the last packet received into it is released.
+  size_t nPendingBytes = m_receiveEnd - m_receiveBegin;
+  if (m_receiveBuffer != nullptr && m_receiveBuffer.use_count() == 1) {
+    std::copy(m_receiveBuffer->begin() + m_receiveBegin, m_receiveBuffer->begin() + m_receiveEnd,
+              m_receiveBuffer->begin());
+  }
+  else {
+    auto buffer = make_shared<ndn::Buffer>(STREAM_RECEIVE_CHUNK_SIZE);
+    if (m_receiveBuffer != nullptr) {
+      std::copy(m_receiveBuffer->begin() + m_receiveBegin, m_receiveBuffer->begin() + m_receiveEnd,
+                buffer->begin());
+      m_pinnedChunks.push_back(m_receiveBuffer);
+    }
+    m_receiveBuffer = std::move(buffer);
+  }
+
+  nInBytesCopied += nPendingBytes;
+  m_receiveBegin = 0;
+  m_receiveEnd = nPendingBytes;
+}
+
 template<class T>
 void
 StreamTransport<T>::handleReceive(const boost::system::error_code& error,
@@ -243,41 +395,58 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
 
-  m_receiveBufferSize += nBytesReceived;
-  size_t offset = 0;
-  bool isOk = true;
-  while (m_receiveBufferSize - offset > 0) {
+  m_receiveEnd += nBytesReceived;
+  BOOST_ASSERT(m_receiveEnd <= m_receiveBuffer->size());
+
+  bool mustCopy = countPinnedChunks() >= MAX_STREAM_RECEIVE_PINNED_CHUNKS;
+  bool isTooLarge = false;
+  while (m_receiveBegin < m_receiveEnd) {
+    bool isOk = false;
     Block element;
-    std::tie(isOk, element) = Block::fromBuffer(m_receiveBuffer + offset, m_receiveBufferSize - offset);
-    if (!isOk)
+    std::tie(isOk, element) = Block::fromBuffer(m_receiveBuffer, m_receiveBegin);
+    // bytes after m_receiveEnd have not been received, a packet that extends into them is incomplete
+    if (!isOk || element.size() > m_receiveEnd - m_receiveBegin)
       break;
 
-    offset += element.size();
-    BOOST_ASSERT(offset <= m_receiveBufferSize);
+    if (element.size() > ndn::MAX_NDN_PACKET_SIZE) {
+      isTooLarge = true;
+      break;
+    }
 
+    m_receiveBegin += element.size();
+    if (mustCopy || element.size() < STREAM_RECEIVE_COPY_THRESHOLD) {
+      // copy the packet so that it does not keep the receive buffer alive
+      nInBytesCopied += element.size();
+      element = Block(element.wire(), element.size());
+    }
     this->receive(element);
   }
 
-  if (!isOk && m_receiveBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0) {
+  if (isTooLarge || m_receiveEnd - m_receiveBegin >= ndn::MAX_NDN_PACKET_SIZE) {
     NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
     this->setState(TransportState::FAILED);
     doClose();
     return;
   }
 
-  if (offset > 0) {
-    if (offset != m_receiveBufferSize) {
-      std::copy(m_receiveBuffer + offset, m_receiveBuffer + m_receiveBufferSize, m_receiveBuffer);
-      m_receiveBufferSize -= offset;
-    }
-    else {
-      m_receiveBufferSize = 0;
-    }
+  if (m_receiveBegin == m_receiveEnd && m_receiveBuffer.use_count() == 1) {
+    // no partial packet and no Block refers to the buffer, start over from its beginning
+    m_receiveBegin = m_receiveEnd = 0;
   }
 
   startReceive();
 }
 
+template<class T>
+size_t
+StreamTransport<T>::countPinnedChunks()
+{
+  m_pinnedChunks.erase(std::remove_if(m_pinnedChunks.begin(), m_pinnedChunks.end(),
+                                      [] (const auto& chunk) { return chunk.expired(); }),
+                       m_pinnedChunks.end());
+  return m_pinnedChunks.size();
+}
+
 template<class T>
 void
 StreamTransport<T>::processErrorCode(const boost::system::error_code& error)
@@ -313,16 +482,20 @@ template<class T>
 void
 StreamTransport<T>::resetReceiveBuffer()
 {
-  m_receiveBufferSize = 0;
+  // Blocks may still refer to the current buffer, so it cannot be overwritten
+  m_receiveBuffer = nullptr;
+  m_receiveBegin = m_receiveEnd = 0;
+  m_pinnedChunks.clear();
 }
 
 template<class T>
 void
 StreamTransport<T>::resetSendQueue()
 {
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
   m_sendQueueBytes = 0;
+  m_sendBuffers.clear();
 }
 
 template<class T>
@@ -43,11 +43,22 @@ TcpChannel::TcpChannel(const tcp::Endpoint& localEndpoint, bool wantCongestionMa
   , m_socket(getGlobalIoService())
   , m_wantCongestionMarking(wantCongestionMarking)
   , m_determineFaceScope(std::move(determineFaceScope))
+  , m_sendBatchPackets(DEFAULT_STREAM_SEND_BATCH_PACKETS)
+  , m_sendBatchBytes(DEFAULT_STREAM_SEND_BATCH_BYTES)
 {
   setUri(FaceUri(m_localEndpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
 }
 
+void
+TcpChannel::setSendBatchLimits(size_t maxPackets, size_t maxBytes)
+{
+  BOOST_ASSERT(maxPackets > 0);
+  BOOST_ASSERT(maxBytes > 0);
+  m_sendBatchPackets = maxPackets;
+  m_sendBatchBytes = maxBytes;
+}
+
 void
 TcpChannel::listen(const FaceCreatedCallback& onFaceCreated,
                    const FaceCreationFailedCallback& onAcceptFailed,
@@ -132,6 +143,7 @@ TcpChannel::createFace(ip::tcp::socket&& socket,
     auto faceScope = m_determineFaceScope(socket.local_endpoint().address(),
                                           socket.remote_endpoint().address());
     auto transport = make_unique<TcpTransport>(std::move(socket), params.persistency, faceScope);
+    transport->setSendBatchLimits(m_sendBatchPackets, m_sendBatchBytes);
     face = make_shared<Face>(std::move(linkService), std::move(transport));
     face->setChannel(shared_from_this()); // use weak_from_this() in C++17
 
@@ -94,6 +94,13 @@ public:
           const FaceCreationFailedCallback& onConnectFailed,
           time::nanoseconds timeout = 8_s) override;
 
+  /**
+   * \brief Set the limits of a single gather write on the faces created afterwards
+   * \sa StreamTransport::setSendBatchLimits
+   */
+  void
+  setSendBatchLimits(size_t maxPackets, size_t maxBytes);
+
 private:
   void
   createFace(boost::asio::ip::tcp::socket&& socket,
@@ -127,9 +134,11 @@ private:
   const tcp::Endpoint m_localEndpoint;
   boost::asio::ip::tcp::acceptor m_acceptor;
   boost::asio::ip::tcp::socket m_socket;
-  std::map<tcp::Endpoint, shared_ptr<Face>> m_channelFaces;
+  std::unordered_map<tcp::Endpoint, shared_ptr<Face>, IpEndpointHash> m_channelFaces;
   bool m_wantCongestionMarking;
   DetermineFaceScopeFromAddress m_determineFaceScope;
+  size_t m_sendBatchPackets;
+  size_t m_sendBatchBytes;
 };
 
 } // namespace face
@@ -24,6 +24,7 @@
  */
 
 #include "tcp-factory.hpp"
+#include "stream-transport.hpp"
 
 namespace nfd {
 namespace face {
@@ -50,6 +51,8 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   port 6363
   //   enable_v4 yes
   //   enable_v6 yes
+  //   send_batch_packets 64
+  //   send_batch_bytes 65536
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -67,6 +70,8 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV6 = true;
   IpAddressPredicate local;
   bool isLocalConfigured = false;
+  size_t sendBatchPackets = DEFAULT_STREAM_SEND_BATCH_PACKETS;
+  size_t sendBatchBytes = DEFAULT_STREAM_SEND_BATCH_BYTES;
 
   for (const auto& pair : *configSection) {
     const std::string& key = pair.first;
@@ -83,6 +88,18 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
     else if (key == "enable_v6") {
       enableV6 = ConfigFile::parseYesNo(pair, "face_system.tcp");
     }
+    else if (key == "send_batch_packets") {
+      sendBatchPackets = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+      if (sendBatchPackets == 0) {
+        NDN_THROW(ConfigFile::Error("face_system.tcp.send_batch_packets must be positive"));
+      }
+    }
+    else if (key == "send_batch_bytes") {
+      sendBatchBytes = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+      if (sendBatchBytes == 0) {
+        NDN_THROW(ConfigFile::Error("face_system.tcp.send_batch_bytes must be positive"));
+      }
+    }
     else if (key == "local") {
       isLocalConfigured = true;
       for (const auto& localPair : pair.second) {
@@ -142,6 +159,11 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
     NFD_LOG_WARN("Cannot close tcp6 channel after its creation");
   }
 
+  // the limits apply to faces created afterwards
+  for (const auto& i : m_channels) {
+    i.second->setSendBatchLimits(sendBatchPackets, sendBatchBytes);
+  }
+
   m_local = std::move(local);
 }
 
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "token-bucket.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace face {
+
+TokenBucket::TokenBucket(const Options& options)
+{
+  setOptions(options);
+}
+
+void
+TokenBucket::setOptions(const Options& options)
+{
+  m_options = options;
+  m_tokens = m_options.burst;
+  m_lastUpdate = time::steady_clock::TimePoint::min();
+}
+
+void
+TokenBucket::refill(time::steady_clock::TimePoint now)
+{
+  if (m_lastUpdate == time::steady_clock::TimePoint::min()) {
+    // the bucket is full when first used
+    m_lastUpdate = now;
+    return;
+  }
+
+  if (now > m_lastUpdate) {
+    double elapsedSeconds = time::nanoseconds(now - m_lastUpdate).count() / 1e9;
+    m_tokens = std::min(m_options.burst, m_tokens + m_options.rate * elapsedSeconds);
+    m_lastUpdate = now;
+  }
+}
+
+bool
+TokenBucket::canConsume(double n, time::steady_clock::TimePoint now)
+{
+  if (!isEnabled()) {
+    return true;
+  }
+
+  refill(now);
+  return m_tokens >= std::min(n, m_options.burst);
+}
+
+void
+TokenBucket::consume(double n, time::steady_clock::TimePoint now)
+{
+  if (!isEnabled()) {
+    return;
+  }
+
+  refill(now);
+  m_tokens -= n;
+}
+
+bool
+TokenBucket::tryConsume(double n, time::steady_clock::TimePoint now)
+{
+  if (!canConsume(n, now)) {
+    return false;
+  }
+  consume(n, now);
+  return true;
+}
+
+time::nanoseconds
+TokenBucket::getWaitTime(double n, time::steady_clock::TimePoint now)
+{
+  if (!isEnabled()) {
+    return 0_ns;
+  }
+
+  refill(now);
+  double missing = std::min(n, m_options.burst) - m_tokens;
+  if (missing <= 0.0) {
+    return 0_ns;
+  }
+  return time::nanoseconds(static_cast<time::nanoseconds::rep>(
+           std::ceil(missing / m_options.rate * 1e9)));
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_TOKEN_BUCKET_HPP
+#define NFD_DAEMON_FACE_TOKEN_BUCKET_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace face {
+
+/** \brief a token bucket for policing and shaping traffic
+ *
+ *  Tokens are added at a constant rate, up to the burst size. A request is allowed if the bucket
+ *  holds enough tokens for it. A request larger than the burst size is allowed when the bucket is
+ *  full, so that it is delayed rather than blocked forever, and leaves the bucket in debt.
+ */
+class TokenBucket
+{
+public:
+  /** \brief Options that control the behavior of TokenBucket
+   */
+  struct Options
+  {
+    /** \brief number of tokens added per second; zero disables the bucket
+     */
+    double rate = 0.0;
+
+    /** \brief maximum number of tokens in the bucket
+     */
+    double burst = 0.0;
+  };
+
+  explicit
+  TokenBucket(const Options& options = {});
+
+  /** \brief set options for the bucket, and fill it up
+   */
+  void
+  setOptions(const Options& options);
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \brief whether the bucket limits anything
+   */
+  bool
+  isEnabled() const
+  {
+    return m_options.rate > 0.0;
+  }
+
+  /** \brief whether \p n tokens can be consumed at \p now
+   */
+  bool
+  canConsume(double n, time::steady_clock::TimePoint now = time::steady_clock::now());
+
+  /** \brief consume \p n tokens at \p now, regardless of whether they are available
+   */
+  void
+  consume(double n, time::steady_clock::TimePoint now = time::steady_clock::now());
+
+  /** \brief consume \p n tokens at \p now if they are available
+   *  \return whether the tokens have been consumed
+   */
+  bool
+  tryConsume(double n, time::steady_clock::TimePoint now = time::steady_clock::now());
+
+  /** \brief time from \p now until \p n tokens can be consumed
+   */
+  time::nanoseconds
+  getWaitTime(double n, time::steady_clock::TimePoint now = time::steady_clock::now());
+
+private:
+  void
+  refill(time::steady_clock::TimePoint now);
+
+private:
+  Options m_options;
+  double m_tokens = 0.0;
+  time::steady_clock::TimePoint m_lastUpdate = time::steady_clock::TimePoint::min();
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_TOKEN_BUCKET_HPP
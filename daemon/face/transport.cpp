@@ -119,9 +119,28 @@ Transport::receive(const Block& packet, const EndpointId& endpoint)
   ++this->nInPackets;
   this->nInBytes += packet.size();
 
+  if (m_samplingInterval > 0 && --m_samplingCountdown == 0) {
+    m_samplingCountdown = m_samplingInterval;
+    m_receivingTrace = make_shared<PacketTrace>(m_latencyStats);
+    m_service->receivePacket(packet, endpoint);
+    // the packet was not an Interest, or it was dropped by the LinkService
+    m_receivingTrace.reset();
+    return;
+  }
+
   m_service->receivePacket(packet, endpoint);
 }
 
+void
+Transport::setLatencySampling(size_t interval)
+{
+  m_samplingInterval = interval;
+  m_samplingCountdown = interval;
+  if (interval > 0 && m_latencyStats == nullptr) {
+    m_latencyStats = make_shared<LatencyStats>();
+  }
+}
+
 void
 Transport::setMtu(ssize_t mtu)
 {
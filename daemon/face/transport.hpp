@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_TRANSPORT_HPP
 
 #include "face-common.hpp"
+#include "packet-trace.hpp"
 #include "common/counter.hpp"
 
 namespace nfd {
@@ -258,6 +259,42 @@ public: // dynamic properties
     return QUEUE_UNSUPPORTED;
   }
 
+public: // latency tracing
+  /** \brief trace one in every \p interval received packets
+   *  \param interval sampling interval; zero disables tracing
+   *
+   *  A sampled packet is timestamped when it is received. If it is an Interest, the
+   *  LinkService attaches a PacketTrace to it, which records the latency of each later stage
+   *  into the LatencyStats of this transport.
+   */
+  void
+  setLatencySampling(size_t interval);
+
+  size_t
+  getLatencySampling() const
+  {
+    return m_samplingInterval;
+  }
+
+  /** \return latency histograms of sampled Interests received on this transport,
+   *          or nullptr if tracing has never been enabled
+   */
+  const LatencyStats*
+  getLatencyStats() const
+  {
+    return m_latencyStats.get();
+  }
+
+  /** \brief take the trace of the packet being passed to the LinkService, if it is sampled
+   *
+   *  This may only be invoked from within LinkService::receivePacket.
+   */
+  shared_ptr<PacketTrace>
+  takeReceivingTrace()
+  {
+    return std::move(m_receivingTrace);
+  }
+
 protected: // upper interface to be invoked by subclass
   /** \brief Pass a received link-layer packet to the upper layer for further processing
    *  \param packet the received packet, must be a valid and well-formed TLV block
@@ -349,6 +386,11 @@ private:
   ssize_t m_sendQueueCapacity;
   TransportState m_state;
   time::steady_clock::TimePoint m_expirationTime;
+
+  size_t m_samplingInterval = 0;
+  size_t m_samplingCountdown = 0;
+  shared_ptr<LatencyStats> m_latencyStats;
+  shared_ptr<PacketTrace> m_receivingTrace;
 };
 
 inline const Face*
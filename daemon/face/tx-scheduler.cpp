@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tx-scheduler.hpp"
+
+namespace nfd {
+namespace face {
+
+/** \brief bytes added to the deficit of a class per unit of weight in each round
+ *
+ *  This is large enough for every class with non-zero weight to send at least one packet per round.
+ */
+static const ssize_t QUANTUM = ndn::MAX_NDN_PACKET_SIZE;
+
+static size_t
+nextWeightedClass(size_t cls)
+{
+  return cls % (TX_CLASS_COUNT - 1) + 1;
+}
+
+TxScheduler::TxScheduler(const Options& options)
+{
+  setOptions(options);
+}
+
+void
+TxScheduler::setOptions(const Options& options)
+{
+  m_options = options;
+  for (size_t i = 0; i < TX_CLASS_COUNT; ++i) {
+    m_queues[i].setOptions(m_options.queueOptions);
+    m_shapers[i].setOptions(m_options.shapers[i]);
+  }
+}
+
+size_t
+TxScheduler::size() const
+{
+  size_t n = 0;
+  for (const auto& queue : m_queues) {
+    n += queue.size();
+  }
+  return n;
+}
+
+bool
+TxScheduler::enqueue(TxClass cls, lp::Packet&& packet, size_t size,
+                     time::steady_clock::TimePoint now, shared_ptr<PacketTrace> trace)
+{
+  return m_queues[static_cast<size_t>(cls)].enqueue(std::move(packet), size, now, std::move(trace));
+}
+
+CodelQueue::DequeueResult
+TxScheduler::dequeueFrom(size_t cls, time::steady_clock::TimePoint now)
+{
+  auto res = m_queues[cls].dequeue(now);
+  if (res.nDropped > 0) {
+    onDrop(static_cast<TxClass>(cls), res.nDropped);
+  }
+  return res;
+}
+
+bool
+TxScheduler::isAllowedByShaper(size_t cls, time::steady_clock::TimePoint now)
+{
+  return m_shapers[cls].canConsume(m_queues[cls].front().size, now);
+}
+
+bool
+TxScheduler::hasEligibleClass(time::steady_clock::TimePoint now)
+{
+  for (size_t cls = 1; cls < TX_CLASS_COUNT; ++cls) {
+    if (!m_queues[cls].empty() && isAllowedByShaper(cls, now)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TxScheduler::DequeueResult
+TxScheduler::dequeue(time::steady_clock::TimePoint now)
+{
+  DequeueResult res;
+
+  constexpr size_t priority = static_cast<size_t>(TxClass::PRIORITY);
+  while (!m_queues[priority].empty()) {
+    auto qres = dequeueFrom(priority, now);
+    if (qres.item) {
+      res.item = std::move(qres.item);
+      res.isMarked = qres.isMarked;
+      res.cls = TxClass::PRIORITY;
+      return res;
+    }
+  }
+
+  // deficit round robin among the weighted classes, skipping those held back by their shapers
+  while (hasEligibleClass(now)) {
+    size_t cls = m_current;
+    if (m_queues[cls].empty()) {
+      m_deficits[cls] = 0;
+    }
+    else if (!isAllowedByShaper(cls, now)) {
+      // keep the deficit until the shaper allows the class again
+    }
+    else if (m_deficits[cls] <= 0) {
+      m_deficits[cls] += std::max<ssize_t>(m_options.weights[cls], 1) * QUANTUM;
+    }
+    else {
+      auto qres = dequeueFrom(cls, now);
+      if (qres.item) {
+        // keep serving this class while it has a deficit left, unless it became idle
+        m_deficits[cls] -= static_cast<ssize_t>(qres.item->size);
+        m_shapers[cls].consume(qres.item->size, now);
+        if (m_queues[cls].empty()) {
+          m_deficits[cls] = 0;
+          m_current = nextWeightedClass(m_current);
+        }
+        res.item = std::move(qres.item);
+        res.isMarked = qres.isMarked;
+        res.cls = static_cast<TxClass>(cls);
+        return res;
+      }
+      m_deficits[cls] = 0;
+    }
+    m_current = nextWeightedClass(m_current);
+  }
+
+  if (!empty()) {
+    auto holdTime = time::nanoseconds::max();
+    for (size_t cls = 1; cls < TX_CLASS_COUNT; ++cls) {
+      if (!m_queues[cls].empty()) {
+        holdTime = std::min(holdTime,
+                            m_shapers[cls].getWaitTime(m_queues[cls].front().size, now));
+      }
+    }
+    res.holdTime = holdTime;
+  }
+  return res;
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_TX_SCHEDULER_HPP
+#define NFD_DAEMON_FACE_TX_SCHEDULER_HPP
+
+#include "codel-queue.hpp"
+#include "token-bucket.hpp"
+#include "core/send-queue-status.hpp"
+
+#include <array>
+
+namespace nfd {
+namespace face {
+
+/** \brief schedules outgoing LpPackets of a face among traffic classes
+ *
+ *  Each traffic class has its own CodelQueue. Packets of the PRIORITY class are always sent
+ *  first. The remaining bandwidth is shared among the other classes in proportion to their
+ *  weights, using deficit round robin on packet sizes, so that a bulk transfer in one class
+ *  cannot delay the traffic of another class by more than one round. Each of the other classes
+ *  may also be shaped by a token bucket counting octets, in which case its packets are held
+ *  in the queue until the bucket allows them.
+ */
+class TxScheduler : noncopyable
+{
+public:
+  /** \brief Options that control the behavior of TxScheduler
+   */
+  struct Options
+  {
+    /** \brief options of the queue of each traffic class
+     */
+    CodelQueue::Options queueOptions;
+
+    /** \brief relative weights of the traffic classes, indexed by TxClass
+     *
+     *  The weight of the PRIORITY class is ignored. A class with weight zero is given
+     *  the same share as a class with weight one.
+     */
+    std::array<uint32_t, TX_CLASS_COUNT> weights{{0, 1, 1, 1}};
+
+    /** \brief shapers of the traffic classes, in octets, indexed by TxClass
+     *
+     *  The shaper of the PRIORITY class is ignored. By default, no class is shaped.
+     */
+    std::array<TokenBucket::Options, TX_CLASS_COUNT> shapers;
+  };
+
+  /** \brief outcome of dequeue()
+   */
+  struct DequeueResult
+  {
+    optional<CodelQueue::Item> item; ///< packet to transmit; none if all queues are empty
+    bool isMarked = false; ///< whether the packet must carry a congestion mark
+    TxClass cls = TxClass::PRIORITY; ///< traffic class of the packet
+    /// if there is no packet but the queues are not empty, time until a shaper allows a packet
+    time::nanoseconds holdTime = 0_ns;
+  };
+
+  explicit
+  TxScheduler(const Options& options = {});
+
+  void
+  setOptions(const Options& options);
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \brief append a packet to the queue of its traffic class
+   *  \retval false the queue is full, and the packet has been dropped
+   */
+  bool
+  enqueue(TxClass cls, lp::Packet&& packet, size_t size,
+          time::steady_clock::TimePoint now = time::steady_clock::now(),
+          shared_ptr<PacketTrace> trace = nullptr);
+
+  /** \brief select the next packet to transmit
+   *
+   *  Packets dropped by CoDel while selecting the packet are reported through onDrop.
+   */
+  DequeueResult
+  dequeue(time::steady_clock::TimePoint now = time::steady_clock::now());
+
+  bool
+  empty() const
+  {
+    return size() == 0;
+  }
+
+  /** \brief count of packets in all queues
+   */
+  size_t
+  size() const;
+
+  const CodelQueue&
+  getQueue(TxClass cls) const
+  {
+    return m_queues[static_cast<size_t>(cls)];
+  }
+
+  /** \brief signals after CoDel dropped packets of a traffic class
+   *
+   *  This signal is emitted with the traffic class and the number of packets dropped.
+   */
+  signal::Signal<TxScheduler, TxClass, size_t> onDrop;
+
+private:
+  /** \brief dequeue from the queue of \p cls, reporting drops
+   */
+  CodelQueue::DequeueResult
+  dequeueFrom(size_t cls, time::steady_clock::TimePoint now);
+
+  /** \brief whether the shaper of \p cls allows the packet at the head of its queue
+   *  \pre queue of \p cls is not empty
+   */
+  bool
+  isAllowedByShaper(size_t cls, time::steady_clock::TimePoint now);
+
+  /** \brief whether some weighted class has a packet allowed by its shaper
+   */
+  bool
+  hasEligibleClass(time::steady_clock::TimePoint now);
+
+private:
+  Options m_options;
+  std::array<CodelQueue, TX_CLASS_COUNT> m_queues;
+  std::array<TokenBucket, TX_CLASS_COUNT> m_shapers;
+  std::array<ssize_t, TX_CLASS_COUNT> m_deficits{};
+  size_t m_current = 1; ///< weighted class currently served by deficit round robin
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_TX_SCHEDULER_HPP
@@ -26,9 +26,17 @@
 #include "udp-channel.hpp"
 #include "face.hpp"
 #include "generic-link-service.hpp"
+#include "shared-udp-transport.hpp"
 #include "unicast-udp-transport.hpp"
 #include "common/global.hpp"
 
+#ifdef __linux__
+#include <cerrno>         // for errno
+#include <cstring>        // for std::strerror()
+#include <linux/filter.h> // for sock_filter and sock_fprog
+#include <sys/socket.h>   // for setsockopt()
+#endif // __linux__
+
 namespace nfd {
 namespace face {
 
@@ -38,16 +46,27 @@ namespace ip = boost::asio::ip;
 
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
                        time::nanoseconds idleTimeout,
-                       bool wantCongestionMarking)
+                       bool wantCongestionMarking,
+                       const Options& options)
   : m_localEndpoint(localEndpoint)
-  , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(idleTimeout)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_options(options)
 {
   setUri(FaceUri(m_localEndpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
 }
 
+UdpChannel::~UdpChannel()
+{
+  // In shared socket mode, faces keep the listening sockets alive, so the pending
+  // receive operations must be aborted explicitly before the channel goes away.
+  for (const auto& sock : m_listenSockets) {
+    boost::system::error_code error;
+    sock->socket.close(error);
+  }
+}
+
 void
 UdpChannel::connect(const EndpointId& endpointId,
                     const FaceParams& params,
@@ -56,9 +75,18 @@ UdpChannel::connect(const EndpointId& endpointId,
                     time::nanoseconds timeout)
 {
   if (auto remoteEndpoint = ndn::get_if<udp::Endpoint>(&endpointId)) {
+    if (m_options.wantSharedSocket && !isListening()) {
+      NFD_LOG_CHAN_DEBUG("Face creation for " << *remoteEndpoint << " failed: not listening");
+      if (onConnectFailed)
+        onConnectFailed(504, "Face creation failed: shared socket channel is not listening");
+      return;
+    }
+
     shared_ptr<Face> face;
     try {
-      face = createFace(*remoteEndpoint, params).second;
+      // all listening sockets are bound to the same endpoint, so any of them can send
+      face = createFace(*remoteEndpoint, params,
+                        m_options.wantSharedSocket ? m_listenSockets.front() : nullptr).second;
     }
     catch (const boost::system::system_error& e) {
       NFD_LOG_CHAN_DEBUG("Face creation for " << *remoteEndpoint << " failed: " << e.what());
@@ -85,29 +113,88 @@ UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
     return;
   }
 
-  m_socket.open(m_localEndpoint.protocol());
-  m_socket.set_option(ip::udp::socket::reuse_address(true));
-  if (m_localEndpoint.address().is_v6()) {
-    m_socket.set_option(ip::v6_only(true));
+  openListenSockets();
+
+  for (const auto& sock : m_listenSockets) {
+    waitForNewPeer(sock, onFaceCreated, onFaceCreationFailed);
+  }
+  NFD_LOG_CHAN_DEBUG("Started listening on " << m_listenSockets.size() << " socket(s)");
+}
+
+void
+UdpChannel::openListenSockets()
+{
+  size_t nSockets = std::max<size_t>(m_options.nListenSockets, 1);
+#ifndef __linux__
+  if (nSockets > 1) {
+    NFD_LOG_CHAN_WARN("Multiple listening sockets are not supported on this platform");
+    nSockets = 1;
+  }
+#endif // __linux__
+
+  std::vector<shared_ptr<ListenSocket>> sockets;
+  for (size_t i = 0; i < nSockets; ++i) {
+    auto sock = make_shared<ListenSocket>(getGlobalIoService());
+    sock->socket.open(m_localEndpoint.protocol());
+    sock->socket.set_option(ip::udp::socket::reuse_address(true));
+    if (m_localEndpoint.address().is_v6()) {
+      sock->socket.set_option(ip::v6_only(true));
+    }
+#ifdef __linux__
+    if (nSockets > 1) {
+      const int value = 1;
+      if (::setsockopt(sock->socket.native_handle(), SOL_SOCKET, SO_REUSEPORT,
+                       &value, sizeof(value)) < 0) {
+        NDN_THROW(boost::system::system_error(errno, boost::system::system_category(),
+                                              "Cannot enable SO_REUSEPORT"));
+      }
+    }
+#endif // __linux__
+    if (m_options.wantSharedSocket) {
+      // SharedUdpTransport sends synchronously and must never block
+      sock->socket.non_blocking(true);
+    }
+    sock->socket.bind(m_localEndpoint);
+    sockets.push_back(std::move(sock));
+  }
+
+#ifdef __linux__
+  if (nSockets > 1 && m_options.wantCpuSteering) {
+    // return (receiving CPU) % nSockets as the index of the socket in the SO_REUSEPORT group
+    sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(nSockets)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    sock_fprog prog{};
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    if (::setsockopt(sockets.front()->socket.native_handle(), SOL_SOCKET,
+                     SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+      NFD_LOG_CHAN_WARN("Cannot attach CPU steering program, using flow hash: "
+                        << std::strerror(errno));
+    }
   }
-  m_socket.bind(m_localEndpoint);
+#endif // __linux__
 
-  waitForNewPeer(onFaceCreated, onFaceCreationFailed);
-  NFD_LOG_CHAN_DEBUG("Started listening");
+  m_listenSockets = std::move(sockets);
 }
 
 void
-UdpChannel::waitForNewPeer(const FaceCreatedCallback& onFaceCreated,
+UdpChannel::waitForNewPeer(const shared_ptr<ListenSocket>& sock,
+                           const FaceCreatedCallback& onFaceCreated,
                            const FaceCreationFailedCallback& onReceiveFailed)
 {
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_remoteEndpoint,
-                              [=] (auto&&... args) {
-                                this->handleNewPeer(std::forward<decltype(args)>(args)..., onFaceCreated, onReceiveFailed);
-                              });
+  sock->socket.async_receive_from(boost::asio::buffer(sock->receiveBuffer), sock->remoteEndpoint,
+                                  [=] (auto&&... args) {
+                                    this->handleNewPeer(sock, std::forward<decltype(args)>(args)...,
+                                                        onFaceCreated, onReceiveFailed);
+                                  });
 }
 
 void
-UdpChannel::handleNewPeer(const boost::system::error_code& error,
+UdpChannel::handleNewPeer(const shared_ptr<ListenSocket>& sock,
+                          const boost::system::error_code& error,
                           size_t nBytesReceived,
                           const FaceCreatedCallback& onFaceCreated,
                           const FaceCreationFailedCallback& onReceiveFailed)
@@ -121,37 +208,46 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
     return;
   }
 
-  NFD_LOG_CHAN_TRACE("New peer " << m_remoteEndpoint);
-
+  const udp::Endpoint& remoteEndpoint = sock->remoteEndpoint;
   bool isCreated = false;
   shared_ptr<Face> face;
   try {
     FaceParams params;
     params.persistency = ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
-    std::tie(isCreated, face) = createFace(m_remoteEndpoint, params);
+    std::tie(isCreated, face) = createFace(remoteEndpoint, params, sock);
   }
   catch (const boost::system::system_error& e) {
-    NFD_LOG_CHAN_DEBUG("Face creation for " << m_remoteEndpoint << " failed: " << e.what());
+    NFD_LOG_CHAN_DEBUG("Face creation for " << remoteEndpoint << " failed: " << e.what());
     if (onReceiveFailed)
       onReceiveFailed(504, "Face creation failed: "s + e.what());
     return;
   }
 
-  if (isCreated)
+  if (isCreated) {
+    NFD_LOG_CHAN_TRACE("New peer " << remoteEndpoint);
     onFaceCreated(face);
-  else
+  }
+  else if (!m_options.wantSharedSocket) {
     NFD_LOG_CHAN_DEBUG("Received datagram for existing face");
+  }
 
   // dispatch the datagram to the face for processing
-  auto* transport = static_cast<UnicastUdpTransport*>(face->getTransport());
-  transport->receiveDatagram(m_receiveBuffer.data(), nBytesReceived, error);
+  if (m_options.wantSharedSocket) {
+    auto* transport = static_cast<SharedUdpTransport*>(face->getTransport());
+    transport->receiveDatagram(sock->receiveBuffer.data(), nBytesReceived);
+  }
+  else {
+    auto* transport = static_cast<UnicastUdpTransport*>(face->getTransport());
+    transport->receiveDatagram(sock->receiveBuffer.data(), nBytesReceived, error);
+  }
 
-  waitForNewPeer(onFaceCreated, onReceiveFailed);
+  waitForNewPeer(sock, onFaceCreated, onReceiveFailed);
 }
 
 std::pair<bool, shared_ptr<Face>>
 UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
-                       const FaceParams& params)
+                       const FaceParams& params,
+                       const shared_ptr<ListenSocket>& sock)
 {
   auto it = m_channelFaces.find(remoteEndpoint);
   if (it != m_channelFaces.end()) {
@@ -161,11 +257,6 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   }
 
   // else, create a new face
-  ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
-  socket.set_option(ip::udp::socket::reuse_address(true));
-  socket.bind(m_localEndpoint);
-  socket.connect(remoteEndpoint);
-
   GenericLinkService::Options options;
   options.allowFragmentation = true;
   options.allowReassembly = true;
@@ -190,9 +281,31 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
     options.overrideMtu = *params.mtu;
   }
 
+  unique_ptr<Transport> transport;
+  if (m_options.wantSharedSocket) {
+    BOOST_ASSERT(sock != nullptr);
+    // the face shares ownership of the listening socket it was created on
+    shared_ptr<ip::udp::socket> socket(sock, &sock->socket);
+    transport = make_unique<SharedUdpTransport>(std::move(socket), remoteEndpoint,
+                                                params.persistency, m_idleFaceTimeout);
+  }
+  else {
+    ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
+    socket.set_option(ip::udp::socket::reuse_address(true));
+    socket.bind(m_localEndpoint);
+    socket.connect(remoteEndpoint);
+
+    auto unicastTransport = make_unique<UnicastUdpTransport>(std::move(socket),
+                                                             params.persistency,
+                                                             m_idleFaceTimeout);
+    unicastTransport->setBatchSize(m_options.batchSize);
+    if (m_options.wantSegmentationOffload) {
+      unicastTransport->setSegmentationOffload(true);
+    }
+    transport = std::move(unicastTransport);
+  }
+
   auto linkService = make_unique<GenericLinkService>(options);
-  auto transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
-                                                    m_idleFaceTimeout);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(shared_from_this()); // use weak_from_this() in C++17
 
@@ -40,21 +40,69 @@ namespace face {
 class UdpChannel : public Channel
 {
 public:
+  /** \brief Options that control the sockets of UdpChannel and of the faces it creates
+   */
+  class Options
+  {
+  public:
+    Options() noexcept
+    {
+    }
+
+  public:
+    /** \brief maximum number of datagrams received or sent per system call by each face
+     *  \sa DatagramTransport::setBatchSize
+     */
+    size_t batchSize = 1;
+
+    /** \brief enables UDP segmentation offload on each face
+     *  \sa DatagramTransport::setSegmentationOffload
+     */
+    bool wantSegmentationOffload = false;
+
+    /** \brief number of listening sockets
+     *
+     *  If greater than 1, the channel binds this many sockets to the local endpoint with
+     *  SO_REUSEPORT, and the kernel spreads datagrams from new peers (and, in shared socket
+     *  mode, from all peers) over them. Supported only on Linux.
+     */
+    size_t nListenSockets = 1;
+
+    /** \brief steer datagrams to the listening socket associated with the receiving CPU
+     *
+     *  Attaches a classic BPF program to the SO_REUSEPORT group that selects the socket
+     *  by CPU number instead of by flow hash. Ignored if there is only one listening socket.
+     */
+    bool wantCpuSteering = false;
+
+    /** \brief enables shared socket mode
+     *
+     *  In shared socket mode, faces send and receive through the unconnected listening
+     *  sockets, and the channel demultiplexes incoming datagrams by source endpoint,
+     *  instead of allocating a connected socket for each face.
+     *  Batching and segmentation offload are not available in this mode.
+     */
+    bool wantSharedSocket = false;
+  };
+
   /**
    * \brief Create a UDP channel on the given \p localEndpoint
    *
    * To enable creation of faces upon incoming connections,
    * one needs to explicitly call UdpChannel::listen method.
-   * The created socket is bound to \p localEndpoint.
+   * The created sockets are bound to \p localEndpoint.
    */
   UdpChannel(const udp::Endpoint& localEndpoint,
              time::nanoseconds idleTimeout,
-             bool wantCongestionMarking);
+             bool wantCongestionMarking,
+             const Options& options = {});
+
+  ~UdpChannel() override;
 
   bool
   isListening() const override
   {
-    return m_socket.is_open();
+    return !m_listenSockets.empty();
   }
 
   size_t
@@ -63,8 +111,16 @@ public:
     return m_channelFaces.size();
   }
 
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
   /**
    * \brief Create a unicast UDP face toward \p endpointId
+   *
+   * In shared socket mode, the channel must be listening.
    */
   void
   connect(const EndpointId& endpointId,
@@ -89,32 +145,51 @@ public:
          const FaceCreationFailedCallback& onFaceCreationFailed);
 
 private:
+  struct ListenSocket
+  {
+    explicit
+    ListenSocket(boost::asio::io_service& io)
+      : socket(io)
+    {
+    }
+
+    boost::asio::ip::udp::socket socket;
+    udp::Endpoint remoteEndpoint; ///< The latest peer that sent a datagram to this socket
+    std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> receiveBuffer;
+  };
+
+  void
+  openListenSockets();
+
   void
-  waitForNewPeer(const FaceCreatedCallback& onFaceCreated,
+  waitForNewPeer(const shared_ptr<ListenSocket>& sock,
+                 const FaceCreatedCallback& onFaceCreated,
                  const FaceCreationFailedCallback& onReceiveFailed);
 
   /**
-   * \brief The channel has received a packet from a remote
-   *        endpoint not associated with any UDP face yet
+   * \brief A listening socket has received a datagram from a remote endpoint
+   *
+   * Unless in shared socket mode, the remote endpoint is not associated with any UDP face yet.
    */
   void
-  handleNewPeer(const boost::system::error_code& error,
+  handleNewPeer(const shared_ptr<ListenSocket>& sock,
+                const boost::system::error_code& error,
                 size_t nBytesReceived,
                 const FaceCreatedCallback& onFaceCreated,
                 const FaceCreationFailedCallback& onReceiveFailed);
 
   std::pair<bool, shared_ptr<Face>>
   createFace(const udp::Endpoint& remoteEndpoint,
-             const FaceParams& params);
+             const FaceParams& params,
+             const shared_ptr<ListenSocket>& sock = nullptr);
 
 private:
   const udp::Endpoint m_localEndpoint;
-  udp::Endpoint m_remoteEndpoint; ///< The latest peer that started communicating with us
-  boost::asio::ip::udp::socket m_socket; ///< Socket used to "accept" new peers
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
-  std::map<udp::Endpoint, shared_ptr<Face>> m_channelFaces;
+  std::vector<shared_ptr<ListenSocket>> m_listenSockets; ///< Sockets used to "accept" new peers
+  std::unordered_map<udp::Endpoint, shared_ptr<Face>, IpEndpointHash> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
   bool m_wantCongestionMarking;
+  const Options m_options;
 };
 
 } // namespace face
@@ -66,6 +66,11 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   enable_v4 yes
   //   enable_v6 yes
   //   idle_timeout 600
+  //   batch_size 1
+  //   segmentation_offload no
+  //   listen_sockets 1
+  //   cpu_steering no
+  //   shared_socket no
   //   mcast yes
   //   mcast_group 224.0.23.170
   //   mcast_port 56363
@@ -88,6 +93,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV4 = false;
   bool enableV6 = false;
   uint32_t idleTimeout = 600;
+  UdpChannel::Options channelOptions;
   MulticastConfig mcastConfig;
 
   if (configSection) {
@@ -113,6 +119,30 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
       else if (key == "idle_timeout") {
         idleTimeout = ConfigFile::parseNumber<uint32_t>(pair, "face_system.udp");
       }
+      else if (key == "batch_size") {
+        channelOptions.batchSize = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        if (channelOptions.batchSize < 1 || channelOptions.batchSize > MAX_DATAGRAM_BATCH_SIZE) {
+          NDN_THROW(ConfigFile::Error("face_system.udp.batch_size: '" +
+                                      value.get_value<std::string>() + "' is out of range [1, " +
+                                      to_string(MAX_DATAGRAM_BATCH_SIZE) + "]"));
+        }
+      }
+      else if (key == "segmentation_offload") {
+        channelOptions.wantSegmentationOffload = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
+      else if (key == "listen_sockets") {
+        channelOptions.nListenSockets = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        if (channelOptions.nListenSockets < 1) {
+          NDN_THROW(ConfigFile::Error("face_system.udp.listen_sockets: '" +
+                                      value.get_value<std::string>() + "' must be at least 1"));
+        }
+      }
+      else if (key == "cpu_steering") {
+        channelOptions.wantCpuSteering = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
+      else if (key == "shared_socket") {
+        channelOptions.wantSharedSocket = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
       else if (key == "keep_alive_interval") {
         // ignored
       }
@@ -177,6 +207,8 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
     return;
   }
 
+  m_channelOptions = channelOptions;
+
   if (enableV4) {
     udp::Endpoint endpoint(ip::udp::v4(), port);
     shared_ptr<UdpChannel> v4Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
@@ -302,7 +334,8 @@ UdpFactory::createChannel(const udp::Endpoint& localEndpoint,
                     ", endpoint already allocated to a UDP multicast face"));
   }
 
-  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout, m_wantCongestionMarking);
+  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout,
+                                              m_wantCongestionMarking, m_channelOptions);
   m_channels[localEndpoint] = channel;
   return channel;
 }
@@ -357,6 +390,10 @@ UdpFactory::createMulticastFace(const shared_ptr<const net::NetworkInterface>& n
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<MulticastUdpTransport>(mcastEp, std::move(rxSock), std::move(txSock),
                                                       m_mcastConfig.linkType);
+  transport->setBatchSize(m_channelOptions.batchSize);
+  if (m_channelOptions.wantSegmentationOffload) {
+    transport->setSegmentationOffload(true);
+  }
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[localEp] = face;
@@ -123,6 +123,7 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  UdpChannel::Options m_channelOptions;
   std::map<udp::Endpoint, shared_ptr<UdpChannel>> m_channels;
 
   struct MulticastConfig
@@ -36,8 +36,10 @@ NFD_LOG_INIT(UnicastEthernetTransport);
 UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                                                    const ethernet::Address& remoteEndpoint,
                                                    ndn::nfd::FacePersistency persistency,
-                                                   time::nanoseconds idleTimeout)
-  : EthernetTransport(localEndpoint, remoteEndpoint)
+                                                   time::nanoseconds idleTimeout,
+                                                   bool wantPacketRing,
+                                                   shared_ptr<EthernetXdpSocket> xdpSocket)
+  : EthernetTransport(localEndpoint, remoteEndpoint, wantPacketRing, std::move(xdpSocket))
   , m_idleTimeout(idleTimeout)
 {
   this->setLocalUri(FaceUri::fromDev(m_interfaceName));
@@ -45,7 +47,7 @@ UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterf
   this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
   this->setPersistency(persistency);
   this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
-  this->setMtu(localEndpoint.getMtu());
+  this->setMtuFromNetif(localEndpoint.getMtu());
 
   NFD_LOG_FACE_DEBUG("Creating transport");
 
@@ -59,7 +61,7 @@ UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterf
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().data(),
            m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+  setPacketFilter(filter);
 
   if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
       m_idleTimeout > time::nanoseconds::zero()) {
@@ -43,7 +43,9 @@ public:
   UnicastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                            const ethernet::Address& remoteEndpoint,
                            ndn::nfd::FacePersistency persistency,
-                           time::nanoseconds idleTimeout);
+                           time::nanoseconds idleTimeout,
+                           bool wantPacketRing = false,
+                           shared_ptr<EthernetXdpSocket> xdpSocket = nullptr);
 
 protected:
   bool
@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unix-shm-channel.hpp"
+#include "face.hpp"
+#include "generic-link-service.hpp"
+#include "unix-shm-transport.hpp"
+#include "common/global.hpp"
+
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h> // for chmod()
+#include <unistd.h>
+
+#ifndef MSG_CMSG_CLOEXEC
+#define MSG_CMSG_CLOEXEC 0
+#endif
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(UnixShmChannel);
+
+const time::milliseconds UnixShmChannel::SETUP_TIMEOUT = 5_s;
+
+UnixShmChannel::UnixShmChannel(const unix_stream::Endpoint& endpoint, bool wantCongestionMarking)
+  : m_endpoint(endpoint)
+  , m_acceptor(getGlobalIoService())
+  , m_socket(getGlobalIoService())
+  , m_size(0)
+  , m_wantCongestionMarking(wantCongestionMarking)
+{
+  setUri(FaceUri(m_endpoint));
+  NFD_LOG_CHAN_INFO("Creating channel");
+}
+
+UnixShmChannel::~UnixShmChannel()
+{
+  if (isListening()) {
+    // use the non-throwing variants during destruction
+    // and ignore any errors
+    boost::system::error_code error;
+    m_acceptor.close(error);
+    NFD_LOG_CHAN_DEBUG("Removing socket file");
+    boost::filesystem::remove(m_endpoint.path(), error);
+  }
+}
+
+void
+UnixShmChannel::listen(const FaceCreatedCallback& onFaceCreated,
+                       const FaceCreationFailedCallback& onAcceptFailed,
+                       int backlog/* = acceptor::max_connections*/)
+{
+  if (isListening()) {
+    NFD_LOG_CHAN_WARN("Already listening");
+    return;
+  }
+
+  removeStaleUnixSocket(m_endpoint);
+
+  m_acceptor.open();
+  m_acceptor.bind(m_endpoint);
+  m_acceptor.listen(backlog);
+
+  if (::chmod(m_endpoint.path().data(), 0666) < 0) {
+    NDN_THROW_ERRNO(Error("Failed to chmod " + m_endpoint.path()));
+  }
+
+  accept(onFaceCreated, onAcceptFailed);
+  NFD_LOG_CHAN_DEBUG("Started listening");
+}
+
+void
+UnixShmChannel::accept(const FaceCreatedCallback& onFaceCreated,
+                       const FaceCreationFailedCallback& onAcceptFailed)
+{
+  m_acceptor.async_accept(m_socket, [=] (const auto& e) { this->handleAccept(e, onFaceCreated, onAcceptFailed); });
+}
+
+void
+UnixShmChannel::handleAccept(const boost::system::error_code& error,
+                             const FaceCreatedCallback& onFaceCreated,
+                             const FaceCreationFailedCallback& onAcceptFailed)
+{
+  if (error) {
+    if (error != boost::asio::error::operation_aborted) {
+      NFD_LOG_CHAN_DEBUG("Accept failed: " << error.message());
+      if (onAcceptFailed)
+        onAcceptFailed(500, "Accept failed: " + error.message());
+    }
+    return;
+  }
+
+  NFD_LOG_CHAN_TRACE("Incoming connection via fd " << m_socket.native_handle());
+
+  auto socket = make_shared<Socket>(std::move(m_socket));
+  auto timeoutEvent = getScheduler().schedule(SETUP_TIMEOUT, [weakSocket = weak_ptr<Socket>(socket)] {
+    auto socket = weakSocket.lock();
+    if (socket) {
+      NFD_LOG_DEBUG("Setup timed out on fd " << socket->native_handle());
+      boost::system::error_code ec;
+      socket->close(ec);
+    }
+  });
+  socket->async_receive(boost::asio::null_buffers(), [=] (const auto& e, size_t) mutable {
+    timeoutEvent.cancel();
+    if (!e)
+      this->handleSetup(*socket, onFaceCreated);
+  });
+
+  // prepare accepting the next connection
+  accept(onFaceCreated, onAcceptFailed);
+}
+
+void
+UnixShmChannel::handleSetup(Socket& socket, const FaceCreatedCallback& onFaceCreated)
+{
+  uint8_t version = 0;
+  iovec iov{&version, sizeof(version)};
+  alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * 3)];
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t nRecv = ::recvmsg(socket.native_handle(), &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+
+  // take ownership of every received descriptor before validating anything else
+  std::vector<int> fds;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); nRecv >= 0 && cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      size_t nFds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      const uint8_t* data = CMSG_DATA(cmsg);
+      for (size_t i = 0; i < nFds; ++i) {
+        int fd = -1;
+        std::memcpy(&fd, data + i * sizeof(int), sizeof(int));
+        fds.push_back(fd);
+      }
+    }
+  }
+
+  auto reject = [&] (const std::string& reason) {
+    NFD_LOG_CHAN_DEBUG("Rejecting setup on fd " << socket.native_handle() << ": " << reason);
+    for (int fd : fds) {
+      ::close(fd);
+    }
+    boost::system::error_code ec;
+    socket.close(ec);
+  };
+
+  if (nRecv != 1 || version != UnixShmRegion::VERSION) {
+    return reject("malformed setup message");
+  }
+  if (fds.size() != 3 || (msg.msg_flags & MSG_CTRUNC) != 0) {
+    return reject("expecting 3 file descriptors, got " + to_string(fds.size()));
+  }
+
+  // the descriptor is owned by the transport from here on
+  int socketFd = socket.native_handle();
+  unique_ptr<UnixShmTransport> transport;
+  try {
+    auto region = UnixShmRegion::attach(fds[0]);
+    fds.erase(fds.begin());
+    transport = make_unique<UnixShmTransport>(std::move(socket), std::move(region), fds[0], fds[1]);
+  }
+  catch (const UnixShmRing::Error& e) {
+    // the rings are checked before the transport takes over the doorbells
+    return reject(e.what());
+  }
+  catch (const std::exception& e) {
+    // the transport owns the doorbells once constructed, and closes them if construction fails
+    if (fds.size() == 3)
+      fds.erase(fds.begin());
+    else
+      fds.clear();
+    return reject(e.what());
+  }
+
+  uint8_t reply = UnixShmRegion::VERSION;
+  if (::send(socketFd, &reply, sizeof(reply), MSG_DONTWAIT | MSG_NOSIGNAL) !=
+      static_cast<ssize_t>(sizeof(reply))) {
+    NFD_LOG_CHAN_DEBUG("Cannot reply to setup on fd " << socketFd << ": " << std::strerror(errno));
+    return;
+  }
+
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = m_wantCongestionMarking;
+  auto linkService = make_unique<GenericLinkService>(options);
+  auto face = make_shared<Face>(std::move(linkService), std::move(transport));
+  face->setChannel(shared_from_this()); // use weak_from_this() in C++17
+
+  ++m_size;
+  connectFaceClosedSignal(*face, [this] { --m_size; });
+
+  onFaceCreated(face);
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_UNIX_SHM_CHANNEL_HPP
+#define NFD_DAEMON_FACE_UNIX_SHM_CHANNEL_HPP
+
+#include "unix-stream-channel.hpp"
+
+namespace nfd {
+namespace face {
+
+/**
+ * \brief Class implementing a local channel that creates shared memory faces
+ *
+ * A local application sets up a face by connecting to the channel's Unix socket and sending
+ * a single octet equal to UnixShmRegion::VERSION, together with three file descriptors in
+ * an SCM_RIGHTS control message:
+ *  -# the UnixShmRegion, created with UnixShmRegion::create() or an equivalent;
+ *  -# the doorbell written by the application to wake up NFD (an eventfd);
+ *  -# the doorbell written by NFD to wake up the application (an eventfd).
+ *
+ * NFD validates the region, creates a face with UnixShmTransport, and replies with a single
+ * octet equal to UnixShmRegion::VERSION. If the setup fails, or does not arrive within
+ * SETUP_TIMEOUT, the connection is closed without a reply.
+ * The connection must remain open for the lifetime of the face.
+ */
+class UnixShmChannel : public Channel
+{
+public:
+  using Error = UnixStreamChannel::Error;
+
+  static const time::milliseconds SETUP_TIMEOUT;
+
+  /**
+   * \brief Create a shared memory channel listening on the specified endpoint
+   *
+   * UnixShmChannel::listen needs to be called to accept applications.
+   */
+  UnixShmChannel(const unix_stream::Endpoint& endpoint, bool wantCongestionMarking);
+
+  ~UnixShmChannel() override;
+
+  bool
+  isListening() const override
+  {
+    return m_acceptor.is_open();
+  }
+
+  size_t
+  size() const override
+  {
+    return m_size;
+  }
+
+  void
+  connect(const EndpointId&,
+          const FaceParams&,
+          const FaceCreatedCallback&,
+          const FaceCreationFailedCallback&,
+          time::nanoseconds) override
+  {
+  }
+
+  /**
+   * \brief Start listening
+   *
+   * Faces created in this way will have on-demand persistency.
+   *
+   * \param onFaceCreated  Callback to notify successful creation of the face
+   * \param onAcceptFailed Callback to notify when channel fails (accept call
+   *                       returns an error)
+   * \param backlog        The maximum length of the queue of pending incoming
+   *                       connections
+   * \throw Error
+   */
+  void
+  listen(const FaceCreatedCallback& onFaceCreated,
+         const FaceCreationFailedCallback& onAcceptFailed,
+         int backlog = boost::asio::local::stream_protocol::acceptor::max_connections);
+
+private:
+  using Socket = boost::asio::local::stream_protocol::socket;
+
+  void
+  accept(const FaceCreatedCallback& onFaceCreated,
+         const FaceCreationFailedCallback& onAcceptFailed);
+
+  void
+  handleAccept(const boost::system::error_code& error,
+               const FaceCreatedCallback& onFaceCreated,
+               const FaceCreationFailedCallback& onAcceptFailed);
+
+  void
+  handleSetup(Socket& socket, const FaceCreatedCallback& onFaceCreated);
+
+private:
+  const unix_stream::Endpoint m_endpoint;
+  boost::asio::local::stream_protocol::acceptor m_acceptor;
+  Socket m_socket;
+  size_t m_size;
+  bool m_wantCongestionMarking;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_UNIX_SHM_CHANNEL_HPP
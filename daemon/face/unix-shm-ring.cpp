@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unix-shm-ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace face {
+
+constexpr uint32_t UnixShmRing::WRAP_MARKER;
+constexpr size_t UnixShmRing::RECORD_ALIGNMENT;
+constexpr size_t UnixShmRing::RECORD_HEADER_SIZE;
+constexpr uint32_t UnixShmRegion::MAGIC;
+constexpr uint32_t UnixShmRegion::VERSION;
+constexpr size_t UnixShmRegion::MIN_RING_CAPACITY;
+constexpr size_t UnixShmRegion::MAX_RING_CAPACITY;
+constexpr size_t UnixShmRegion::DEFAULT_RING_CAPACITY;
+
+UnixShmRing::UnixShmRing(Control& control, uint8_t* data, size_t capacity)
+  : m_control(control)
+  , m_data(data)
+  , m_capacity(capacity)
+  , m_head(control.head.load(std::memory_order_acquire))
+  , m_tail(control.tail.load(std::memory_order_acquire))
+{
+  BOOST_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  BOOST_ASSERT(capacity % RECORD_ALIGNMENT == 0);
+
+  // the control block comes from the peer, so a ring that does not start empty is refused
+  // here rather than detected later as an inconsistency
+  if (m_head % RECORD_ALIGNMENT != 0 || m_tail % RECORD_ALIGNMENT != 0) {
+    NDN_THROW(Error("Ring cursors are not aligned: head=" + to_string(m_head) +
+                    " tail=" + to_string(m_tail)));
+  }
+  if (m_head != m_tail) {
+    NDN_THROW(Error("Ring is not empty: head=" + to_string(m_head) + " tail=" + to_string(m_tail)));
+  }
+  if (m_head >= capacity) {
+    NDN_THROW(Error("Ring cursors exceed the capacity: head=" + to_string(m_head) +
+                    " capacity=" + to_string(capacity)));
+  }
+}
+
+bool
+UnixShmRing::push(const uint8_t* payload, size_t length, bool& shouldNotify)
+{
+  BOOST_ASSERT(length <= getMaxPayloadLength());
+
+  size_t recordSize = getRecordSize(length);
+  size_t offset = m_head & (m_capacity - 1);
+  size_t contiguous = m_capacity - offset;
+  // a record that does not fit before the end of the ring also consumes the rest of it
+  size_t needed = recordSize > contiguous ? contiguous + recordSize : recordSize;
+
+  auto hasRoom = [&] (uint64_t tail) {
+    // a tail that is ahead of the producer cursor can only come from a misbehaving consumer,
+    // in which case the ring stays full
+    uint64_t used = m_head - tail;
+    return used <= m_capacity && m_capacity - used >= needed;
+  };
+
+  if (!hasRoom(m_control.tail.load(std::memory_order_acquire))) {
+    // ask for a notification, then check again in case the consumer drained the ring
+    // before it could see the flag
+    m_control.isProducerWaiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasRoom(m_control.tail.load(std::memory_order_acquire))) {
+      return false;
+    }
+  }
+
+  uint64_t oldHead = m_head;
+  if (recordSize > contiguous) {
+    uint32_t marker = WRAP_MARKER;
+    std::memcpy(m_data + offset, &marker, sizeof(marker));
+    m_head += contiguous;
+    offset = 0;
+  }
+
+  uint32_t length32 = static_cast<uint32_t>(length);
+  std::memcpy(m_data + offset, &length32, sizeof(length32));
+  std::memcpy(m_data + offset + RECORD_HEADER_SIZE, payload, length);
+  m_head += recordSize;
+
+  m_control.head.store(m_head, std::memory_order_release);
+  // the consumer needs a notification only if it had drained everything up to oldHead,
+  // i.e. it may be about to wait, or already waiting, for the ring to become non-empty
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  shouldNotify = m_control.tail.load(std::memory_order_relaxed) == oldHead;
+  return true;
+}
+
+UnixShmRegion::UnixShmRegion(int fd, void* addr, size_t ringCapacity)
+  : m_fd(fd)
+  , m_addr(static_cast<uint8_t*>(addr))
+  , m_ringCapacity(ringCapacity)
+{
+}
+
+UnixShmRegion::~UnixShmRegion()
+{
+  ::munmap(m_addr, getRegionSize(m_ringCapacity));
+  ::close(m_fd);
+}
+
+static bool
+isValidRingCapacity(uint64_t capacity)
+{
+  return capacity >= UnixShmRegion::MIN_RING_CAPACITY &&
+         capacity <= UnixShmRegion::MAX_RING_CAPACITY &&
+         (capacity & (capacity - 1)) == 0;
+}
+
+unique_ptr<UnixShmRegion>
+UnixShmRegion::create(size_t ringCapacity)
+{
+  if (!isValidRingCapacity(ringCapacity)) {
+    NDN_THROW(Error("Invalid ring capacity " + to_string(ringCapacity)));
+  }
+
+#ifdef __linux__
+  int fd = ::memfd_create("nfd-shm-face", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    NDN_THROW_ERRNO(Error("memfd_create failed"));
+  }
+
+  size_t size = getRegionSize(ringCapacity);
+  // NFD refuses regions that could shrink under its mapping and cause SIGBUS
+  if (::ftruncate(fd, static_cast<off_t>(size)) < 0 ||
+      ::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) < 0) {
+    int errsv = errno;
+    ::close(fd);
+    errno = errsv;
+    NDN_THROW_ERRNO(Error("Cannot size or seal the shared memory region"));
+  }
+
+  void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    int errsv = errno;
+    ::close(fd);
+    errno = errsv;
+    NDN_THROW_ERRNO(Error("Cannot map the shared memory region"));
+  }
+
+  // the file is zero-filled, so both rings start empty
+  auto header = static_cast<Header*>(addr);
+  header->magic = MAGIC;
+  header->version = VERSION;
+  header->ringCapacity = ringCapacity;
+
+  return unique_ptr<UnixShmRegion>(new UnixShmRegion(fd, addr, ringCapacity));
+#else
+  NDN_THROW(Error("Shared memory faces are supported on Linux only"));
+#endif // __linux__
+}
+
+unique_ptr<UnixShmRegion>
+UnixShmRegion::attach(int fd)
+{
+#ifdef __linux__
+  auto fail = [fd] (const std::string& why) {
+    ::close(fd);
+    NDN_THROW(Error(why));
+  };
+
+  int seals = ::fcntl(fd, F_GET_SEALS);
+  if (seals < 0 || (seals & F_SEAL_SHRINK) == 0) {
+    fail("Shared memory region is not sealed against shrinking");
+  }
+
+  Header header{};
+  struct stat st;
+  if (::fstat(fd, &st) < 0 ||
+      ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+    fail("Cannot read the shared memory region header");
+  }
+  if (header.magic != MAGIC || header.version != VERSION) {
+    fail("Unrecognized shared memory region format");
+  }
+  if (!isValidRingCapacity(header.ringCapacity)) {
+    fail("Invalid ring capacity " + to_string(header.ringCapacity));
+  }
+
+  size_t ringCapacity = static_cast<size_t>(header.ringCapacity);
+  size_t size = getRegionSize(ringCapacity);
+  if (static_cast<uint64_t>(st.st_size) < size) {
+    fail("Shared memory region is too small");
+  }
+
+  void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    fail("Cannot map the shared memory region: "s + std::strerror(errno));
+  }
+
+  return unique_ptr<UnixShmRegion>(new UnixShmRegion(fd, addr, ringCapacity));
+#else
+  ::close(fd);
+  NDN_THROW(Error("Shared memory faces are supported on Linux only"));
+#endif // __linux__
+}
+
+UnixShmRing::Control&
+UnixShmRegion::getControl(Direction dir) const noexcept
+{
+  // the Header occupies the first slot
+  return *reinterpret_cast<UnixShmRing::Control*>(m_addr + sizeof(UnixShmRing::Control) * (1 + dir));
+}
+
+uint8_t*
+UnixShmRegion::getData(Direction dir) const noexcept
+{
+  return m_addr + sizeof(UnixShmRing::Control) * 3 + m_ringCapacity * dir;
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_UNIX_SHM_RING_HPP
+#define NFD_DAEMON_FACE_UNIX_SHM_RING_HPP
+
+#include "core/common.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#ifndef HAVE_UNIX_SOCKETS
+#error "Cannot include this file when UNIX sockets are not available"
+#endif
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory rings require lock-free 64-bit atomics");
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief A single-producer single-consumer ring of variable-length records in shared memory.
+ *
+ * Each record is a 32-bit length in host byte order followed by the payload, padded to
+ * a multiple of 8 octets. A record never wraps around the end of the ring; if it does not fit
+ * in the remaining contiguous space, the producer writes WRAP_MARKER and starts over at offset 0.
+ *
+ * head and tail are free-running byte counters; the offset is the counter modulo the capacity.
+ * Each side keeps its own cursor in process memory and only publishes it to the shared control
+ * block, so that a misbehaving peer cannot move our cursor. Cursors and lengths published by
+ * the peer are validated before use; pop() reports an inconsistent ring instead of reading
+ * outside of it.
+ *
+ * The consumer is notified only when the ring transitions from empty to non-empty, and the
+ * producer only when it found the ring full, so that a busy ring needs no system call at all.
+ */
+class UnixShmRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Shared control block of a ring.
+   *
+   * Each field is on its own cache line to avoid false sharing between producer and consumer.
+   */
+  struct Control
+  {
+    alignas(64) std::atomic<uint64_t> head;      ///< written by the producer only
+    alignas(64) std::atomic<uint64_t> tail;      ///< written by the consumer only
+    alignas(64) std::atomic<uint32_t> isProducerWaiting; ///< set by the producer when the ring is full
+  };
+
+  static constexpr uint32_t WRAP_MARKER = 0xFFFFFFFF;
+  static constexpr size_t RECORD_ALIGNMENT = 8;
+  static constexpr size_t RECORD_HEADER_SIZE = sizeof(uint32_t);
+
+public:
+  /**
+   * @param control shared control block
+   * @param data shared data area of @p capacity octets
+   * @param capacity a power of two, and a multiple of RECORD_ALIGNMENT
+   *
+   * The local cursors are initialized from the control block, which must describe an empty ring:
+   * head and tail are equal, aligned to RECORD_ALIGNMENT, and less than @p capacity.
+   *
+   * @throw Error the control block was not initialized as an empty ring
+   */
+  UnixShmRing(Control& control, uint8_t* data, size_t capacity);
+
+  static constexpr size_t
+  getRecordSize(size_t payloadLength) noexcept
+  {
+    return (RECORD_HEADER_SIZE + payloadLength + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+  }
+
+  /**
+   * @brief Largest payload that can be pushed into an empty ring.
+   */
+  size_t
+  getMaxPayloadLength() const noexcept
+  {
+    return m_capacity / 2 - RECORD_HEADER_SIZE;
+  }
+
+  /**
+   * @brief Append a record (producer side).
+   * @param[out] shouldNotify set to true if the consumer may be waiting and must be notified
+   * @retval false the ring is full; the consumer will notify the producer after draining it
+   */
+  bool
+  push(const uint8_t* payload, size_t length, bool& shouldNotify);
+
+  /**
+   * @brief Number of octets occupied in the ring, as seen by the producer.
+   */
+  size_t
+  getOccupancy() const noexcept
+  {
+    uint64_t used = m_head - m_control.tail.load(std::memory_order_acquire);
+    return static_cast<size_t>(std::min<uint64_t>(used, m_capacity));
+  }
+
+  /**
+   * @brief Consume every available record (consumer side).
+   *
+   * @p f is invoked as f(const uint8_t* payload, size_t length) for each record; the payload is
+   * valid only until @p f returns. The consumer cursor is published after the ring is drained,
+   * then the ring is checked again to close the race with a producer that saw it non-empty.
+   *
+   * @param[out] shouldNotifyProducer set to true if the producer was waiting for space
+   * @retval false the ring is inconsistent; the peer must not be trusted any further
+   */
+  template<typename F>
+  bool
+  pop(const F& f, bool& shouldNotifyProducer);
+
+private:
+  Control& m_control;
+  uint8_t* const m_data;
+  const size_t m_capacity;
+  uint64_t m_head; ///< producer cursor
+  uint64_t m_tail; ///< consumer cursor
+};
+
+template<typename F>
+bool
+UnixShmRing::pop(const F& f, bool& shouldNotifyProducer)
+{
+  while (true) {
+    uint64_t head = m_control.head.load(std::memory_order_acquire);
+    uint64_t avail = head - m_tail;
+    if (avail > m_capacity || avail % RECORD_ALIGNMENT != 0) {
+      return false;
+    }
+
+    while (m_tail != head) {
+      size_t offset = m_tail & (m_capacity - 1);
+      size_t contiguous = m_capacity - offset;
+      uint32_t length = 0;
+      std::memcpy(&length, m_data + offset, sizeof(length));
+
+      if (length == WRAP_MARKER) {
+        if (contiguous > head - m_tail) {
+          return false;
+        }
+        m_tail += contiguous;
+        continue;
+      }
+
+      size_t recordSize = getRecordSize(length);
+      if (recordSize > contiguous || recordSize > head - m_tail) {
+        return false;
+      }
+      f(m_data + offset + RECORD_HEADER_SIZE, length);
+      m_tail += recordSize;
+    }
+
+    m_control.tail.store(m_tail, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_control.head.load(std::memory_order_relaxed) == m_tail) {
+      break;
+    }
+  }
+
+  if (m_control.isProducerWaiting.load(std::memory_order_relaxed) != 0 &&
+      m_control.isProducerWaiting.exchange(0, std::memory_order_relaxed) != 0) {
+    shouldNotifyProducer = true;
+  }
+  return true;
+}
+
+/**
+ * @brief A shared memory region holding one ring in each direction between NFD and a local
+ *        application.
+ *
+ * The region is backed by a file descriptor (a sealed memfd on Linux) and laid out as:
+ * a Header, the Control blocks of both rings, then the data areas of both rings.
+ * The application creates and initializes the region; NFD attaches to it after validating
+ * the header and the size of the backing file.
+ */
+class UnixShmRegion : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  enum Direction {
+    TO_NFD   = 0, ///< application to NFD
+    FROM_NFD = 1, ///< NFD to application
+  };
+
+  struct Header
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t ringCapacity;
+  };
+
+  static constexpr uint32_t MAGIC = 0x4E444E52; // "NDNR"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t MIN_RING_CAPACITY = 1 << 15;
+  static constexpr size_t MAX_RING_CAPACITY = 1 << 26;
+  static constexpr size_t DEFAULT_RING_CAPACITY = 1 << 21;
+
+  static constexpr size_t
+  getRegionSize(size_t ringCapacity) noexcept
+  {
+    return sizeof(UnixShmRing::Control) * 3 + ringCapacity * 2;
+  }
+
+  /**
+   * @brief Create and initialize a region (application side).
+   * @throw Error the region cannot be created, including on platforms other than Linux
+   */
+  static unique_ptr<UnixShmRegion>
+  create(size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+  /**
+   * @brief Map a region created by the peer (NFD side).
+   * @param fd file descriptor of the region; ownership is transferred even on failure
+   * @throw Error the region is invalid
+   */
+  static unique_ptr<UnixShmRegion>
+  attach(int fd);
+
+  ~UnixShmRegion();
+
+  int
+  getFd() const noexcept
+  {
+    return m_fd;
+  }
+
+  size_t
+  getRingCapacity() const noexcept
+  {
+    return m_ringCapacity;
+  }
+
+  UnixShmRing::Control&
+  getControl(Direction dir) const noexcept;
+
+  uint8_t*
+  getData(Direction dir) const noexcept;
+
+private:
+  UnixShmRegion(int fd, void* addr, size_t ringCapacity);
+
+private:
+  const int m_fd;
+  uint8_t* const m_addr;
+  const size_t m_ringCapacity;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_UNIX_SHM_RING_HPP
@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "unix-shm-transport.hpp"
+#include "common/global.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(UnixShmTransport);
+
+UnixShmTransport::UnixShmTransport(boost::asio::local::stream_protocol::socket&& controlSocket,
+                                   unique_ptr<UnixShmRegion> region,
+                                   int nfdDoorbellFd, int appDoorbellFd)
+  : m_controlSocket(std::move(controlSocket))
+  , m_region(std::move(region))
+  , m_rxRing(m_region->getControl(UnixShmRegion::TO_NFD),
+             m_region->getData(UnixShmRegion::TO_NFD), m_region->getRingCapacity())
+  , m_txRing(m_region->getControl(UnixShmRegion::FROM_NFD),
+             m_region->getData(UnixShmRegion::FROM_NFD), m_region->getRingCapacity())
+  , m_nfdDoorbell(getGlobalIoService())
+  , m_appDoorbellFd(appDoorbellFd)
+{
+  this->setLocalUri(FaceUri(m_controlSocket.local_endpoint()));
+  this->setRemoteUri(FaceUri::fromFd(m_controlSocket.native_handle()));
+  this->setScope(ndn::nfd::FACE_SCOPE_LOCAL);
+  this->setPersistency(ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  this->setMtu(MTU_UNLIMITED);
+
+  NFD_LOG_FACE_DEBUG("Creating transport with ring capacity " << m_region->getRingCapacity());
+
+  boost::system::error_code error;
+  m_nfdDoorbell.assign(nfdDoorbellFd, error);
+  if (error) {
+    ::close(nfdDoorbellFd);
+  }
+  else {
+    m_nfdDoorbell.non_blocking(true, error);
+  }
+  int flags = ::fcntl(m_appDoorbellFd, F_GETFL);
+  if (error || flags < 0 || ::fcntl(m_appDoorbellFd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    ::close(m_appDoorbellFd);
+    NDN_THROW(Error("Doorbells must be pollable and non-blocking"));
+  }
+
+  waitForControlEof();
+  // if the application queued packets before the face was created, it has already rung
+  // the doorbell, so the first wait completes immediately
+  waitForDoorbell();
+}
+
+UnixShmTransport::~UnixShmTransport()
+{
+  if (m_appDoorbellFd >= 0)
+    ::close(m_appDoorbellFd);
+}
+
+ssize_t
+UnixShmTransport::getSendQueueLength()
+{
+  if (getState() != TransportState::UP)
+    return 0;
+  return static_cast<ssize_t>(m_txRing.getOccupancy() + m_sendQueueBytes);
+}
+
+void
+UnixShmTransport::doClose()
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  // Cancel all outstanding operations and close the descriptors.
+  // Use the non-throwing variants and ignore errors, if any.
+  boost::system::error_code error;
+  m_controlSocket.cancel(error);
+  m_controlSocket.close(error);
+  m_nfdDoorbell.cancel(error);
+  m_nfdDoorbell.close(error);
+
+  m_sendQueue.clear();
+  m_sendQueueBytes = 0;
+
+  // Ensure that the Transport stays alive, and the region stays mapped,
+  // at least until all pending handlers are dispatched
+  getGlobalIoService().post([this] {
+    this->setState(TransportState::CLOSED);
+  });
+}
+
+void
+UnixShmTransport::doSend(const Block& packet)
+{
+  NFD_LOG_FACE_TRACE(__func__);
+
+  if (getState() != TransportState::UP)
+    return;
+
+  if (packet.size() > m_txRing.getMaxPayloadLength()) {
+    NFD_LOG_FACE_WARN("Dropping packet of " << packet.size() << " bytes larger than the ring");
+    return;
+  }
+
+  // preserve ordering: once a packet is queued, later packets must wait behind it
+  bool shouldNotify = false;
+  if (!m_sendQueue.empty() || !m_txRing.push(packet.wire(), packet.size(), shouldNotify)) {
+    m_sendQueue.push_back(packet);
+    m_sendQueueBytes += packet.size();
+    return;
+  }
+
+  if (shouldNotify)
+    ringAppDoorbell();
+}
+
+void
+UnixShmTransport::waitForDoorbell()
+{
+  m_nfdDoorbell.async_read_some(boost::asio::null_buffers(),
+                                [this] (const auto& error, size_t) { this->handleDoorbell(error); });
+}
+
+void
+UnixShmTransport::handleDoorbell(const boost::system::error_code& error)
+{
+  if (error == boost::asio::error::operation_aborted || getState() != TransportState::UP)
+    return;
+
+  if (error) {
+    return fail("Doorbell wait failed: " + error.message());
+  }
+
+  // reset the doorbell before looking at the rings, so that no wakeup is lost
+  uint8_t buffer[64];
+  while (::read(m_nfdDoorbell.native_handle(), buffer, sizeof(buffer)) > 0)
+    ;
+
+  receiveFromRing();
+  if (getState() != TransportState::UP)
+    return;
+
+  sendFromQueue();
+  if (getState() != TransportState::UP)
+    return;
+
+  waitForDoorbell();
+}
+
+void
+UnixShmTransport::waitForControlEof()
+{
+  m_controlSocket.async_receive(boost::asio::buffer(m_controlBuffer),
+                                [this] (const auto& error, size_t) { this->handleControlRead(error); });
+}
+
+void
+UnixShmTransport::handleControlRead(const boost::system::error_code& error)
+{
+  if (error == boost::asio::error::operation_aborted || getState() != TransportState::UP)
+    return;
+
+  if (error == boost::asio::error::eof) {
+    NFD_LOG_FACE_TRACE("Application closed the control connection");
+    this->setState(TransportState::CLOSING);
+    doClose();
+    return;
+  }
+  if (error) {
+    return fail("Control connection failed: " + error.message());
+  }
+
+  // nothing is expected on the control connection after setup; ignore it
+  waitForControlEof();
+}
+
+void
+UnixShmTransport::receiveFromRing()
+{
+  bool shouldNotifyProducer = false;
+  bool isOk = m_rxRing.pop([this] (const uint8_t* payload, size_t length) {
+    if (getState() != TransportState::UP)
+      return;
+
+    NFD_LOG_FACE_TRACE("Received: " << length << " bytes");
+
+    bool isParsed = false;
+    Block element;
+    std::tie(isParsed, element) = Block::fromBuffer(payload, length);
+    if (!isParsed || element.size() != length) {
+      NFD_LOG_FACE_WARN("Failed to parse incoming packet");
+      return;
+    }
+    this->receive(element);
+  }, shouldNotifyProducer);
+
+  if (!isOk) {
+    return fail("Receive ring is inconsistent");
+  }
+  if (shouldNotifyProducer && getState() == TransportState::UP)
+    ringAppDoorbell();
+}
+
+void
+UnixShmTransport::sendFromQueue()
+{
+  bool shouldNotify = false;
+  while (!m_sendQueue.empty()) {
+    const Block& packet = m_sendQueue.front();
+    bool thisNotify = false;
+    if (!m_txRing.push(packet.wire(), packet.size(), thisNotify))
+      break;
+
+    shouldNotify = shouldNotify || thisNotify;
+    m_sendQueueBytes -= packet.size();
+    m_sendQueue.pop_front();
+  }
+
+  if (shouldNotify)
+    ringAppDoorbell();
+}
+
+void
+UnixShmTransport::ringAppDoorbell()
+{
+  uint64_t one = 1;
+  if (::write(m_appDoorbellFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+    fail("Cannot notify the application: "s + std::strerror(errno));
+  }
+}
+
+void
+UnixShmTransport::fail(const std::string& reason)
+{
+  NFD_LOG_FACE_ERROR(reason);
+  this->setState(TransportState::FAILED);
+  doClose();
+}
+
+} // namespace face
+} // namespace nfd
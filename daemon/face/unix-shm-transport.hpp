@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_UNIX_SHM_TRANSPORT_HPP
+#define NFD_DAEMON_FACE_UNIX_SHM_TRANSPORT_HPP
+
+#include "transport.hpp"
+#include "unix-shm-ring.hpp"
+
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief A Transport that exchanges packets with a local application through a pair of
+ *        shared memory rings.
+ *
+ * Packets are copied into and out of a UnixShmRegion without any system call while both
+ * sides keep up with each other. Each side has an eventfd "doorbell" that the peer writes
+ * only when a ring becomes non-empty, or when a full ring gets room again.
+ * The Unix stream socket used to set up the face is kept open: the face is closed when the
+ * application closes it, which also covers the application exiting or crashing.
+ */
+class UnixShmTransport final : public Transport
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @param controlSocket the connection on which the region was received
+   * @param region the mapped shared memory region
+   * @param nfdDoorbellFd descriptor written by the application to wake up NFD
+   * @param appDoorbellFd descriptor written by NFD to wake up the application
+   *
+   * Ownership of both descriptors is transferred to the transport, unless the constructor
+   * throws UnixShmRing::Error, which happens before the descriptors are taken over.
+   *
+   * @throw UnixShmRing::Error a ring in @p region does not start empty
+   */
+  UnixShmTransport(boost::asio::local::stream_protocol::socket&& controlSocket,
+                   unique_ptr<UnixShmRegion> region,
+                   int nfdDoorbellFd, int appDoorbellFd);
+
+  ~UnixShmTransport() override;
+
+  ssize_t
+  getSendQueueLength() override;
+
+private:
+  void
+  doClose() override;
+
+  void
+  doSend(const Block& packet) override;
+
+  void
+  waitForDoorbell();
+
+  void
+  handleDoorbell(const boost::system::error_code& error);
+
+  void
+  waitForControlEof();
+
+  void
+  handleControlRead(const boost::system::error_code& error);
+
+  /** @brief Deliver every packet in the receive ring.
+   */
+  void
+  receiveFromRing();
+
+  /** @brief Move queued packets into the send ring until it is full.
+   */
+  void
+  sendFromQueue();
+
+  void
+  ringAppDoorbell();
+
+  void
+  fail(const std::string& reason);
+
+private:
+  boost::asio::local::stream_protocol::socket m_controlSocket;
+  unique_ptr<UnixShmRegion> m_region;
+  UnixShmRing m_rxRing;
+  UnixShmRing m_txRing;
+  boost::asio::posix::stream_descriptor m_nfdDoorbell;
+  int m_appDoorbellFd;
+  uint8_t m_controlBuffer[64];
+
+  /// packets that did not fit in the send ring, in the order they must be sent
+  std::deque<Block> m_sendQueue;
+  size_t m_sendQueueBytes = 0;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_UNIX_SHM_TRANSPORT_HPP
@@ -37,6 +37,36 @@ namespace face {
 
 NFD_LOG_INIT(UnixStreamChannel);
 
+void
+removeStaleUnixSocket(const unix_stream::Endpoint& endpoint)
+{
+  namespace fs = boost::filesystem;
+
+  fs::path socketPath(endpoint.path());
+  fs::file_type type = fs::symlink_status(socketPath).type();
+
+  if (type == fs::socket_file) {
+    boost::system::error_code error;
+    boost::asio::local::stream_protocol::socket socket(getGlobalIoService());
+    socket.connect(endpoint, error);
+    NFD_LOG_TRACE("connect() on existing socket file returned: " << error.message());
+    if (!error) {
+      // someone answered, leave the socket alone
+      NDN_THROW(UnixStreamChannel::Error("Socket file at " + endpoint.path() + " belongs to another NFD process"));
+    }
+    else if (error == boost::asio::error::connection_refused ||
+             error == boost::asio::error::timed_out) {
+      // no one is listening on the remote side,
+      // we can safely remove the stale socket
+      NFD_LOG_DEBUG("Removing stale socket file " << endpoint.path());
+      fs::remove(socketPath);
+    }
+  }
+  else if (type != fs::file_not_found) {
+    NDN_THROW(UnixStreamChannel::Error(endpoint.path() + " already exists and is not a socket file"));
+  }
+}
+
 UnixStreamChannel::UnixStreamChannel(const unix_stream::Endpoint& endpoint,
                                      bool wantCongestionMarking)
   : m_endpoint(endpoint)
@@ -44,6 +74,8 @@ UnixStreamChannel::UnixStreamChannel(const unix_stream::Endpoint& endpoint,
   , m_socket(getGlobalIoService())
   , m_size(0)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_sendBatchPackets(DEFAULT_STREAM_SEND_BATCH_PACKETS)
+  , m_sendBatchBytes(DEFAULT_STREAM_SEND_BATCH_BYTES)
 {
   setUri(FaceUri(m_endpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -61,6 +93,15 @@ UnixStreamChannel::~UnixStreamChannel()
   }
 }
 
+void
+UnixStreamChannel::setSendBatchLimits(size_t maxPackets, size_t maxBytes)
+{
+  BOOST_ASSERT(maxPackets > 0);
+  BOOST_ASSERT(maxBytes > 0);
+  m_sendBatchPackets = maxPackets;
+  m_sendBatchBytes = maxBytes;
+}
+
 void
 UnixStreamChannel::listen(const FaceCreatedCallback& onFaceCreated,
                           const FaceCreationFailedCallback& onAcceptFailed,
@@ -71,31 +112,7 @@ UnixStreamChannel::listen(const FaceCreatedCallback& onFaceCreated,
     return;
   }
 
-  namespace fs = boost::filesystem;
-
-  fs::path socketPath(m_endpoint.path());
-  fs::file_type type = fs::symlink_status(socketPath).type();
-
-  if (type == fs::socket_file) {
-    boost::system::error_code error;
-    boost::asio::local::stream_protocol::socket socket(getGlobalIoService());
-    socket.connect(m_endpoint, error);
-    NFD_LOG_CHAN_TRACE("connect() on existing socket file returned: " << error.message());
-    if (!error) {
-      // someone answered, leave the socket alone
-      NDN_THROW(Error("Socket file at " + m_endpoint.path() + " belongs to another NFD process"));
-    }
-    else if (error == boost::asio::error::connection_refused ||
-             error == boost::asio::error::timed_out) {
-      // no one is listening on the remote side,
-      // we can safely remove the stale socket
-      NFD_LOG_CHAN_DEBUG("Removing stale socket file");
-      fs::remove(socketPath);
-    }
-  }
-  else if (type != fs::file_not_found) {
-    NDN_THROW(Error(m_endpoint.path() + " already exists and is not a socket file"));
-  }
+  removeStaleUnixSocket(m_endpoint);
 
   m_acceptor.open();
   m_acceptor.bind(m_endpoint);
@@ -136,6 +153,7 @@ UnixStreamChannel::handleAccept(const boost::system::error_code& error,
   options.allowCongestionMarking = m_wantCongestionMarking;
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnixStreamTransport>(std::move(m_socket));
+  transport->setSendBatchLimits(m_sendBatchPackets, m_sendBatchBytes);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(shared_from_this()); // use weak_from_this() in C++17
 
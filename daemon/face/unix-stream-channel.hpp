@@ -109,6 +109,13 @@ public:
          const FaceCreationFailedCallback& onAcceptFailed,
          int backlog = boost::asio::local::stream_protocol::acceptor::max_connections);
 
+  /**
+   * \brief Set the limits of a single gather write on the faces created afterwards
+   * \sa StreamTransport::setSendBatchLimits
+   */
+  void
+  setSendBatchLimits(size_t maxPackets, size_t maxBytes);
+
 private:
   void
   accept(const FaceCreatedCallback& onFaceCreated,
@@ -125,8 +132,21 @@ private:
   boost::asio::local::stream_protocol::socket m_socket;
   size_t m_size;
   bool m_wantCongestionMarking;
+  size_t m_sendBatchPackets;
+  size_t m_sendBatchBytes;
 };
 
+/**
+ * \brief Make sure that a Unix socket can be bound at \p endpoint
+ *
+ * A socket file left behind by an NFD process that is no longer running is removed.
+ *
+ * \throw UnixStreamChannel::Error the path is in use by another NFD process,
+ *                                 or exists and is not a socket file
+ */
+void
+removeStaleUnixSocket(const unix_stream::Endpoint& endpoint);
+
 } // namespace face
 } // namespace nfd
 
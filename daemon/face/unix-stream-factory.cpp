@@ -24,6 +24,7 @@
  */
 
 #include "unix-stream-factory.hpp"
+#include "stream-transport.hpp"
 
 #include <boost/filesystem.hpp>
 
@@ -48,6 +49,9 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   // {
   //   path /run/nfd.sock        ; on Linux
   //   path /var/run/nfd.sock    ; on other platforms
+  //   shm_path /run/nfd-shm.sock
+  //   send_batch_packets 64
+  //   send_batch_bytes 65536
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -64,6 +68,9 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
 #else
   std::string path = "/var/run/nfd.sock";
 #endif // __linux__
+  std::string shmPath;
+  size_t sendBatchPackets = DEFAULT_STREAM_SEND_BATCH_PACKETS;
+  size_t sendBatchBytes = DEFAULT_STREAM_SEND_BATCH_BYTES;
 
   for (const auto& pair : *configSection) {
     const std::string& key = pair.first;
@@ -72,6 +79,26 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
     if (key == "path") {
       path = value.get_value<std::string>();
     }
+    else if (key == "shm_path") {
+      shmPath = value.get_value<std::string>();
+#ifndef __linux__
+      if (!shmPath.empty()) {
+        NDN_THROW(ConfigFile::Error("face_system.unix.shm_path is supported on Linux only"));
+      }
+#endif // __linux__
+    }
+    else if (key == "send_batch_packets") {
+      sendBatchPackets = ConfigFile::parseNumber<size_t>(pair, "face_system.unix");
+      if (sendBatchPackets == 0) {
+        NDN_THROW(ConfigFile::Error("face_system.unix.send_batch_packets must be positive"));
+      }
+    }
+    else if (key == "send_batch_bytes") {
+      sendBatchBytes = ConfigFile::parseNumber<size_t>(pair, "face_system.unix");
+      if (sendBatchBytes == 0) {
+        NDN_THROW(ConfigFile::Error("face_system.unix.send_batch_bytes must be positive"));
+      }
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option face_system.unix." + key));
     }
@@ -82,17 +109,35 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   }
 
   auto channel = this->createChannel(path);
+  // the limits apply to faces created afterwards
+  channel->setSendBatchLimits(sendBatchPackets, sendBatchBytes);
   if (!channel->isListening()) {
     channel->listen(this->addFace, nullptr);
   }
+
+  if (!shmPath.empty()) {
+    auto shmChannel = this->createShmChannel(shmPath);
+    if (!shmChannel->isListening()) {
+      shmChannel->listen(this->addFace, nullptr);
+    }
+  }
+  else if (!m_shmChannels.empty()) {
+    NFD_LOG_WARN("Cannot disable shared memory channel after initialization");
+  }
 }
 
-shared_ptr<UnixStreamChannel>
-UnixStreamFactory::createChannel(const std::string& unixSocketPath)
+static unix_stream::Endpoint
+makeEndpoint(const std::string& unixSocketPath)
 {
   boost::filesystem::path p(unixSocketPath);
   p = boost::filesystem::canonical(p.parent_path()) / p.filename();
-  unix_stream::Endpoint endpoint(p.string());
+  return unix_stream::Endpoint(p.string());
+}
+
+shared_ptr<UnixStreamChannel>
+UnixStreamFactory::createChannel(const std::string& unixSocketPath)
+{
+  auto endpoint = makeEndpoint(unixSocketPath);
 
   auto it = m_channels.find(endpoint);
   if (it != m_channels.end())
@@ -103,10 +148,27 @@ UnixStreamFactory::createChannel(const std::string& unixSocketPath)
   return channel;
 }
 
+shared_ptr<UnixShmChannel>
+UnixStreamFactory::createShmChannel(const std::string& unixSocketPath)
+{
+  auto endpoint = makeEndpoint(unixSocketPath);
+
+  auto it = m_shmChannels.find(endpoint);
+  if (it != m_shmChannels.end())
+    return it->second;
+
+  auto channel = make_shared<UnixShmChannel>(endpoint, m_wantCongestionMarking);
+  m_shmChannels[endpoint] = channel;
+  return channel;
+}
+
 std::vector<shared_ptr<const Channel>>
 UnixStreamFactory::doGetChannels() const
 {
-  return getChannelsFromMap(m_channels);
+  auto channels = getChannelsFromMap(m_channels);
+  auto shmChannels = getChannelsFromMap(m_shmChannels);
+  channels.insert(channels.end(), shmChannels.begin(), shmChannels.end());
+  return channels;
 }
 
 } // namespace face
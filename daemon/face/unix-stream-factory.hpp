@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_UNIX_STREAM_FACTORY_HPP
 
 #include "protocol-factory.hpp"
+#include "unix-shm-channel.hpp"
 #include "unix-stream-channel.hpp"
 
 namespace nfd {
@@ -55,6 +56,19 @@ public:
   shared_ptr<UnixStreamChannel>
   createChannel(const std::string& unixSocketPath);
 
+  /**
+   * \brief Create shared memory channel using specified socket path
+   *
+   * If this method is called twice with the same path, only one channel
+   * will be created.  The second call will just retrieve the existing
+   * channel.
+   *
+   * \returns always a valid pointer to a UnixShmChannel object,
+   *          an exception will be thrown if the channel cannot be created.
+   */
+  shared_ptr<UnixShmChannel>
+  createShmChannel(const std::string& unixSocketPath);
+
 private:
   /** \brief process face_system.unix config section
    */
@@ -68,6 +82,7 @@ private:
 private:
   bool m_wantCongestionMarking = false;
   std::map<unix_stream::Endpoint, shared_ptr<UnixStreamChannel>> m_channels;
+  std::map<unix_stream::Endpoint, shared_ptr<UnixShmChannel>> m_shmChannels;
 };
 
 } // namespace face
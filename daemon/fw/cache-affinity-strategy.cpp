@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cache-affinity-strategy.hpp"
+#include "algorithm.hpp"
+#include "common/logger.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(CacheAffinityStrategy);
+NFD_REGISTER_STRATEGY(CacheAffinityStrategy);
+
+const time::milliseconds CacheAffinityStrategy::RETX_SUPPRESSION_INITIAL(10);
+const time::milliseconds CacheAffinityStrategy::RETX_SUPPRESSION_MAX(250);
+
+CacheAffinityStrategy::CacheAffinityStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+  , ProcessNackTraits(this)
+  , m_retxSuppression(RETX_SUPPRESSION_INITIAL,
+                      RetxSuppressionExponential::DEFAULT_MULTIPLIER,
+                      RETX_SUPPRESSION_MAX)
+{
+  ParsedInstanceName parsed = parseInstanceName(name);
+  if (!parsed.parameters.empty()) {
+    processParams(parsed.parameters);
+  }
+
+  if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+    NDN_THROW(std::invalid_argument(
+      "CacheAffinityStrategy does not support version " + to_string(*parsed.version)));
+  }
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+
+  NFD_LOG_DEBUG("prefix-length=" << m_prefixLength);
+}
+
+const Name&
+CacheAffinityStrategy::getStrategyName()
+{
+  static Name strategyName("/localhost/nfd/strategy/cache-affinity/%FD%01");
+  return strategyName;
+}
+
+static uint64_t
+getParamValue(const std::string& param, const std::string& value)
+{
+  try {
+    if (!value.empty() && value[0] == '-')
+      NDN_THROW(boost::bad_lexical_cast());
+
+    return boost::lexical_cast<uint64_t>(value);
+  }
+  catch (const boost::bad_lexical_cast&) {
+    NDN_THROW(std::invalid_argument("Value of " + param + " must be a non-negative integer"));
+  }
+}
+
+void
+CacheAffinityStrategy::processParams(const PartialName& parsed)
+{
+  for (const auto& component : parsed) {
+    std::string parsedStr(reinterpret_cast<const char*>(component.value()), component.value_size());
+    auto n = parsedStr.find("~");
+    if (n == std::string::npos) {
+      NDN_THROW(std::invalid_argument("Format is <parameter>~<value>"));
+    }
+
+    auto f = parsedStr.substr(0, n);
+    auto s = parsedStr.substr(n + 1);
+    if (f == "prefix-length") {
+      m_prefixLength = getParamValue(f, s);
+    }
+    else {
+      NDN_THROW(std::invalid_argument("Parameter should be prefix-length"));
+    }
+  }
+}
+
+double
+CacheAffinityStrategy::computeScore(size_t key, FaceId faceId, uint64_t cost)
+{
+  // mix the key with the FaceId using the splitmix64 finalizer
+  uint64_t h = static_cast<uint64_t>(key) ^ (static_cast<uint64_t>(faceId) * 0x9e3779b97f4a7c15ULL);
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+
+  // map the hash onto the open interval (0,1)
+  double u = (static_cast<double>(h >> 11) + 0.5) / static_cast<double>(uint64_t(1) << 53);
+
+  // weighted rendezvous hashing: a nexthop with weight w wins with probability w / sum(w)
+  double weight = 1.0 / (1.0 + static_cast<double>(cost));
+  return -weight / std::log(u);
+}
+
+fib::NextHopList::const_iterator
+CacheAffinityStrategy::findBestNextHop(const Face& inFace, const Interest& interest,
+                                       const fib::NextHopList& nexthops,
+                                       const shared_ptr<pit::Entry>& pitEntry,
+                                       bool wantUnused) const
+{
+  size_t key = name_tree::computeHash(interest.getName(), m_prefixLength > 0 ?
+                                      m_prefixLength : std::numeric_limits<size_t>::max());
+  auto now = time::steady_clock::now();
+
+  auto found = nexthops.end();
+  double bestScore = 0.0;
+  for (auto it = nexthops.begin(); it != nexthops.end(); ++it) {
+    if (!isNextHopEligible(inFace, interest, *it, pitEntry, wantUnused, now))
+      continue;
+
+    double score = computeScore(key, it->getFace().getId(), it->getCost());
+    if (found == nexthops.end() || score > bestScore) {
+      found = it;
+      bestScore = score;
+    }
+  }
+  return found;
+}
+
+void
+CacheAffinityStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                            const shared_ptr<pit::Entry>& pitEntry)
+{
+  RetxSuppressionResult suppression = m_retxSuppression.decidePerPitEntry(*pitEntry);
+  if (suppression == RetxSuppressionResult::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " suppressed");
+    return;
+  }
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+
+  if (suppression == RetxSuppressionResult::NEW) {
+    auto it = findBestNextHop(ingress.face, interest, nexthops, pitEntry, false);
+    if (it == nexthops.end()) {
+      NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
+
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(pitEntry, ingress.face, nackHeader);
+
+      this->rejectPendingInterest(pitEntry);
+      return;
+    }
+
+    Face& outFace = it->getFace();
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " newPitEntry-to=" << outFace.getId());
+    this->sendInterest(pitEntry, outFace, interest);
+    return;
+  }
+
+  // fail over to the highest-ranked upstream that is not in use
+  auto it = findBestNextHop(ingress.face, interest, nexthops, pitEntry, true);
+  if (it != nexthops.end()) {
+    Face& outFace = it->getFace();
+    this->sendInterest(pitEntry, outFace, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmit-unused-to=" << outFace.getId());
+    return;
+  }
+
+  // find an eligible upstream that is used earliest
+  it = findEligibleNextHopWithEarliestOutRecord(ingress.face, interest, nexthops, pitEntry);
+  if (it == nexthops.end()) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmitNoNextHop");
+  }
+  else {
+    Face& outFace = it->getFace();
+    this->sendInterest(pitEntry, outFace, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmit-retry-to=" << outFace.getId());
+  }
+}
+
+void
+CacheAffinityStrategy::afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
+                                        const shared_ptr<pit::Entry>& pitEntry)
+{
+  if (nack.getReason() != lp::NackReason::DUPLICATE && pitEntry->hasInRecords()) {
+    // fail over to the highest-ranked upstream that has not been tried
+    const pit::InRecord& inRecord = pitEntry->getInRecords().front();
+    const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+    const fib::NextHopList& nexthops = fibEntry.getNextHops();
+
+    auto it = findBestNextHop(inRecord.getFace(), inRecord.getInterest(), nexthops, pitEntry, true);
+    if (it != nexthops.end()) {
+      Face& outFace = it->getFace();
+      NFD_LOG_DEBUG(nack.getInterest() << " nack from=" << ingress << " reason=" << nack.getReason()
+                    << " failover-to=" << outFace.getId());
+      this->sendInterest(pitEntry, outFace, inRecord.getInterest());
+      return;
+    }
+  }
+
+  this->processNack(ingress.face, nack, pitEntry);
+}
+
+} // namespace fw
+} // namespace nfd
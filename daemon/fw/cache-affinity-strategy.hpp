@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CACHE_AFFINITY_STRATEGY_HPP
+#define NFD_DAEMON_FW_CACHE_AFFINITY_STRATEGY_HPP
+
+#include "strategy.hpp"
+#include "process-nack-traits.hpp"
+#include "retx-suppression-exponential.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief A forwarding strategy that preserves cache locality among upstreams
+ *
+ *  This strategy ranks the eligible nexthops of each Interest by weighted rendezvous
+ *  (highest-random-weight) hashing of the first \c prefix-length components of the Interest
+ *  name, so that Interests for the same content are consistently forwarded to the same
+ *  upstream cache, while different contents are spread across all nexthops. The weight of
+ *  each nexthop is derived from its routing cost: a nexthop with a lower cost attracts a
+ *  proportionally larger share of the namespace.
+ *
+ *  A new Interest is forwarded to the highest-ranked nexthop (except downstream).
+ *  A consumer retransmission that is not suppressed by exponential backoff is forwarded to
+ *  the highest-ranked nexthop that has not been used yet, which provides failover after
+ *  a timeout. If all nexthops have been used, the one used earliest is retried.
+ *  When a Nack is received, the Interest is forwarded to the highest-ranked nexthop that has
+ *  not been tried yet; if none remains, Nacks are processed as in \c ProcessNackTraits.
+ *
+ *  The strategy accepts one optional parameter:
+ *  - \c prefix-length~K: number of leading name components used as the hashing key.
+ *    Zero (the default) means the whole Interest name is used.
+ */
+class CacheAffinityStrategy : public Strategy
+                            , public ProcessNackTraits<CacheAffinityStrategy>
+{
+public:
+  explicit
+  CacheAffinityStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+  static const Name&
+  getStrategyName();
+
+  void
+  afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief Compute the rendezvous score of a nexthop for a given hashing key
+   *  \param key hash value of the Interest name prefix
+   *  \param faceId the nexthop face
+   *  \param cost the nexthop routing cost
+   *  \return a positive score; the nexthop with the highest score is preferred
+   */
+  static double
+  computeScore(size_t key, FaceId faceId, uint64_t cost);
+
+  size_t
+  getPrefixLength() const
+  {
+    return m_prefixLength;
+  }
+
+private:
+  void
+  processParams(const PartialName& parsed);
+
+  /** \brief Find the eligible nexthop with the highest rendezvous score
+   *  \param wantUnused if true, nexthops with unexpired out-records are skipped
+   */
+  fib::NextHopList::const_iterator
+  findBestNextHop(const Face& inFace, const Interest& interest, const fib::NextHopList& nexthops,
+                  const shared_ptr<pit::Entry>& pitEntry, bool wantUnused) const;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const time::milliseconds RETX_SUPPRESSION_INITIAL;
+  static const time::milliseconds RETX_SUPPRESSION_MAX;
+  RetxSuppressionExponential m_retxSuppression;
+
+private:
+  size_t m_prefixLength = 0;
+
+  friend ProcessNackTraits<CacheAffinityStrategy>;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CACHE_AFFINITY_STRATEGY_HPP
@@ -0,0 +1,380 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "congestion-aware-strategy.hpp"
+#include "algorithm.hpp"
+#include "common/logger.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(CongestionAwareStrategy);
+NFD_REGISTER_STRATEGY(CongestionAwareStrategy);
+
+constexpr double CongestionAwareStrategy::MARK_RATE_ALPHA;
+constexpr double CongestionAwareStrategy::SHARE_CHANGE_ON_MARK;
+constexpr double CongestionAwareStrategy::SHARE_CHANGE_ON_TIMEOUT;
+const time::milliseconds CongestionAwareStrategy::RETX_SUPPRESSION_INITIAL(10);
+const time::milliseconds CongestionAwareStrategy::RETX_SUPPRESSION_MAX(250);
+const time::nanoseconds CongestionAwareStrategy::MEASUREMENTS_LIFETIME = 5_min;
+
+CongestionAwareStrategy::FaceStats*
+CongestionAwareStrategy::MtInfo::getFaceStats(FaceId faceId)
+{
+  auto it = faces.find(faceId);
+  return it != faces.end() ? &it->second : nullptr;
+}
+
+CongestionAwareStrategy::FaceStats&
+CongestionAwareStrategy::MtInfo::getOrCreateFaceStats(FaceId faceId)
+{
+  return faces.emplace(std::piecewise_construct,
+                       std::forward_as_tuple(faceId),
+                       std::forward_as_tuple(m_rttEstimatorOpts)).first->second;
+}
+
+CongestionAwareStrategy::CongestionAwareStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+  , ProcessNackTraits(this)
+  , m_rttEstimatorOpts(make_shared<RttEstimator::Options>()) // use the default options
+  , m_retxSuppression(RETX_SUPPRESSION_INITIAL,
+                      RetxSuppressionExponential::DEFAULT_MULTIPLIER,
+                      RETX_SUPPRESSION_MAX)
+{
+  ParsedInstanceName parsed = parseInstanceName(name);
+  if (!parsed.parameters.empty()) {
+    NDN_THROW(std::invalid_argument("CongestionAwareStrategy does not accept parameters"));
+  }
+  if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+    NDN_THROW(std::invalid_argument(
+      "CongestionAwareStrategy does not support version " + to_string(*parsed.version)));
+  }
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
+
+const Name&
+CongestionAwareStrategy::getStrategyName()
+{
+  static Name strategyName("/localhost/nfd/strategy/congestion-aware/%FD%01");
+  return strategyName;
+}
+
+void
+CongestionAwareStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                              const shared_ptr<pit::Entry>& pitEntry)
+{
+  RetxSuppressionResult suppression = m_retxSuppression.decidePerPitEntry(*pitEntry);
+  if (suppression == RetxSuppressionResult::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " suppressed");
+    return;
+  }
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  MtInfo& mi = this->getOrCreateMtInfo(fibEntry, interest);
+
+  if (suppression == RetxSuppressionResult::NEW) {
+    normalizeShares(mi, nexthops);
+    auto it = this->selectNextHop(ingress.face, interest, nexthops, pitEntry, mi, false);
+    if (it == nexthops.end()) {
+      NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
+
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(pitEntry, ingress.face, nackHeader);
+
+      this->rejectPendingInterest(pitEntry);
+      return;
+    }
+
+    Face& outFace = it->getFace();
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " newPitEntry-to=" << outFace.getId());
+    this->sendInterest(pitEntry, outFace, interest);
+    return;
+  }
+
+  // a retransmission after the RTO of an upstream indicates loss on that path
+  detectTimeouts(*pitEntry, mi, nexthops);
+  normalizeShares(mi, nexthops);
+
+  auto it = this->selectNextHop(ingress.face, interest, nexthops, pitEntry, mi, true);
+  if (it != nexthops.end()) {
+    Face& outFace = it->getFace();
+    this->sendInterest(pitEntry, outFace, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmit-unused-to=" << outFace.getId());
+    return;
+  }
+
+  // find an eligible upstream that is used earliest
+  it = findEligibleNextHopWithEarliestOutRecord(ingress.face, interest, nexthops, pitEntry);
+  if (it == nexthops.end()) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmitNoNextHop");
+  }
+  else {
+    Face& outFace = it->getFace();
+    this->sendInterest(pitEntry, outFace, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmit-retry-to=" << outFace.getId());
+  }
+}
+
+void
+CongestionAwareStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                                               const FaceEndpoint& ingress, const Data& data)
+{
+  MtInfo* mi = this->findMtInfo(*pitEntry);
+  if (mi == nullptr) {
+    NFD_LOG_DEBUG(pitEntry->getName() << " data from=" << ingress << " no-measurements");
+    return;
+  }
+
+  FaceStats* stats = mi->getFaceStats(ingress.face.getId());
+  if (stats == nullptr) {
+    NFD_LOG_DEBUG(pitEntry->getName() << " data from=" << ingress << " no-face-stats");
+    return;
+  }
+
+  auto outRecord = pitEntry->getOutRecord(ingress.face);
+  if (outRecord != pitEntry->out_end()) {
+    stats->rtt.addMeasurement(time::steady_clock::now() - outRecord->getLastRenewed());
+  }
+
+  bool isMarked = data.getCongestionMark() > 0;
+  stats->markRate += MARK_RATE_ALPHA * ((isMarked ? 1.0 : 0.0) - stats->markRate);
+  NFD_LOG_DEBUG(pitEntry->getName() << " data from=" << ingress << " marked=" << isMarked
+                << " mark-rate=" << stats->markRate << " srtt=" << stats->rtt.getSmoothedRtt());
+
+  if (isMarked) {
+    // the congestion mark stays on the Data, and is propagated to downstreams
+    reduceShare(*mi, this->lookupFib(*pitEntry).getNextHops(), ingress.face.getId(),
+                SHARE_CHANGE_ON_MARK);
+  }
+}
+
+void
+CongestionAwareStrategy::afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry,
+                                              const FaceEndpoint& ingress, const Data& data)
+{
+  if (data.getCongestionMark() == 0) {
+    this->sendData(pitEntry, data, ingress.face);
+    return;
+  }
+
+  // a cached Data does not traverse the congested path again
+  Data unmarkedData(data);
+  unmarkedData.setCongestionMark(0);
+  this->sendData(pitEntry, unmarkedData, ingress.face);
+}
+
+void
+CongestionAwareStrategy::afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
+                                          const shared_ptr<pit::Entry>& pitEntry)
+{
+  if (nack.getReason() == lp::NackReason::CONGESTION && pitEntry->hasInRecords()) {
+    const pit::InRecord& inRecord = pitEntry->getInRecords().front();
+    const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+    const fib::NextHopList& nexthops = fibEntry.getNextHops();
+    MtInfo& mi = this->getOrCreateMtInfo(fibEntry, inRecord.getInterest());
+
+    reduceShare(mi, nexthops, ingress.face.getId(), SHARE_CHANGE_ON_MARK);
+    normalizeShares(mi, nexthops);
+
+    // retry on another upstream instead of returning the Nack
+    auto it = this->selectNextHop(inRecord.getFace(), inRecord.getInterest(), nexthops,
+                                  pitEntry, mi, true);
+    if (it != nexthops.end()) {
+      Face& outFace = it->getFace();
+      NFD_LOG_DEBUG(nack.getInterest() << " nack from=" << ingress << " reason=" << nack.getReason()
+                    << " retry-to=" << outFace.getId());
+      this->sendInterest(pitEntry, outFace, inRecord.getInterest());
+      return;
+    }
+  }
+
+  this->processNack(ingress.face, nack, pitEntry);
+}
+
+CongestionAwareStrategy::MtInfo&
+CongestionAwareStrategy::getOrCreateMtInfo(const fib::Entry& fibEntry, const Interest& interest)
+{
+  measurements::Entry* me = this->getMeasurements().get(fibEntry);
+
+  // If the FIB entry is not under the strategy's namespace, find a part of the prefix
+  // that falls under the strategy's namespace
+  for (size_t prefixLen = fibEntry.getPrefix().size() + 1;
+       me == nullptr && prefixLen <= interest.getName().size(); ++prefixLen) {
+    me = this->getMeasurements().get(interest.getName().getPrefix(prefixLen));
+  }
+
+  // Either the FIB entry or the Interest's name must be under this strategy's namespace
+  BOOST_ASSERT(me != nullptr);
+
+  this->getMeasurements().extendLifetime(*me, MEASUREMENTS_LIFETIME);
+  MtInfo* mi = me->insertStrategyInfo<MtInfo>(m_rttEstimatorOpts).first;
+  BOOST_ASSERT(mi != nullptr);
+  return *mi;
+}
+
+CongestionAwareStrategy::MtInfo*
+CongestionAwareStrategy::findMtInfo(const pit::Entry& pitEntry)
+{
+  measurements::Entry* me = this->getMeasurements().findLongestPrefixMatch(pitEntry,
+                              measurements::EntryWithStrategyInfo<MtInfo>());
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  this->getMeasurements().extendLifetime(*me, MEASUREMENTS_LIFETIME);
+  return me->getStrategyInfo<MtInfo>();
+}
+
+void
+CongestionAwareStrategy::normalizeShares(MtInfo& mi, const fib::NextHopList& nexthops)
+{
+  if (nexthops.empty()) {
+    return;
+  }
+
+  double total = 0.0;
+  for (const auto& nh : nexthops) {
+    total += mi.getOrCreateFaceStats(nh.getFace().getId()).share;
+  }
+
+  if (total <= 0.0) {
+    // nexthops are sorted by cost
+    mi.getOrCreateFaceStats(nexthops.front().getFace().getId()).share = 1.0;
+    return;
+  }
+
+  for (const auto& nh : nexthops) {
+    mi.getOrCreateFaceStats(nh.getFace().getId()).share /= total;
+  }
+}
+
+void
+CongestionAwareStrategy::reduceShare(MtInfo& mi, const fib::NextHopList& nexthops,
+                                     FaceId faceId, double fraction)
+{
+  FaceStats* stats = mi.getFaceStats(faceId);
+  if (stats == nullptr || stats->share <= 0.0) {
+    return;
+  }
+
+  auto now = time::steady_clock::now();
+  if (now - stats->lastReduction < stats->rtt.getSmoothedRtt()) {
+    // react to congestion at most once per RTT
+    return;
+  }
+
+  std::vector<std::pair<FaceStats*, double>> others;
+  double totalWeight = 0.0;
+  for (const auto& nh : nexthops) {
+    if (nh.getFace().getId() == faceId) {
+      continue;
+    }
+    FaceStats& other = mi.getOrCreateFaceStats(nh.getFace().getId());
+    auto rtt = other.rtt.getSmoothedRtt() > 0_ns ? other.rtt.getSmoothedRtt() :
+                                                   other.rtt.getEstimatedRto();
+    double rttUs = std::max<double>(time::duration_cast<time::microseconds>(rtt).count(), 1.0);
+    double weight = (1.0 - other.markRate) / rttUs;
+    others.emplace_back(&other, weight);
+    totalWeight += weight;
+  }
+
+  if (others.empty()) {
+    // there is no other path to shift traffic to
+    return;
+  }
+
+  double delta = stats->share * fraction;
+  stats->share -= delta;
+  stats->lastReduction = now;
+
+  for (auto& other : others) {
+    other.first->share += totalWeight > 0.0 ? delta * other.second / totalWeight :
+                                              delta / others.size();
+  }
+  NFD_LOG_TRACE("face=" << faceId << " share=" << stats->share);
+}
+
+fib::NextHopList::const_iterator
+CongestionAwareStrategy::selectNextHop(const Face& inFace, const Interest& interest,
+                                       const fib::NextHopList& nexthops,
+                                       const shared_ptr<pit::Entry>& pitEntry,
+                                       MtInfo& mi, bool wantUnused)
+{
+  auto now = time::steady_clock::now();
+  std::vector<std::pair<fib::NextHopList::const_iterator, double>> candidates;
+  double total = 0.0;
+  for (auto it = nexthops.begin(); it != nexthops.end(); ++it) {
+    if (!isNextHopEligible(inFace, interest, *it, pitEntry, wantUnused, now)) {
+      continue;
+    }
+    double share = mi.getOrCreateFaceStats(it->getFace().getId()).share;
+    candidates.emplace_back(it, share);
+    total += share;
+  }
+
+  if (candidates.empty()) {
+    return nexthops.end();
+  }
+  if (total <= 0.0) {
+    // none of the eligible nexthops has a share, use the lowest-cost one
+    return candidates.front().first;
+  }
+
+  std::uniform_real_distribution<double> dist(0.0, total);
+  double r = dist(ndn::random::getRandomNumberEngine());
+  for (const auto& candidate : candidates) {
+    if (r < candidate.second) {
+      return candidate.first;
+    }
+    r -= candidate.second;
+  }
+  return candidates.back().first;
+}
+
+void
+CongestionAwareStrategy::detectTimeouts(const pit::Entry& pitEntry, MtInfo& mi,
+                                        const fib::NextHopList& nexthops)
+{
+  auto now = time::steady_clock::now();
+  for (const pit::OutRecord& outRecord : pitEntry.getOutRecords()) {
+    if (outRecord.getIncomingNack() != nullptr) {
+      continue;
+    }
+
+    FaceId faceId = outRecord.getFace().getId();
+    FaceStats* stats = mi.getFaceStats(faceId);
+    if (stats != nullptr && now - outRecord.getLastRenewed() > stats->rtt.getEstimatedRto()) {
+      NFD_LOG_DEBUG(pitEntry.getName() << " timeout face=" << faceId);
+      reduceShare(mi, nexthops, faceId, SHARE_CHANGE_ON_TIMEOUT);
+    }
+  }
+}
+
+} // namespace fw
+} // namespace nfd
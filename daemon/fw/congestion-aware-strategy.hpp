@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CONGESTION_AWARE_STRATEGY_HPP
+#define NFD_DAEMON_FW_CONGESTION_AWARE_STRATEGY_HPP
+
+#include "strategy.hpp"
+#include "process-nack-traits.hpp"
+#include "retx-suppression-exponential.hpp"
+
+#include <ndn-cxx/util/rtt-estimator.hpp>
+
+namespace nfd {
+namespace fw {
+
+/** \brief A multipath forwarding strategy that reacts to hop-by-hop congestion marks
+ *
+ *  This strategy maintains, for each namespace, a forwarding share of every nexthop together
+ *  with an RTT estimate and a moving average of the congestion-mark rate, stored in the
+ *  measurements table. Initially the whole share belongs to the lowest-cost nexthop.
+ *
+ *  A new Interest is forwarded to one eligible nexthop (except downstream), chosen randomly
+ *  in proportion to the forwarding shares. When a marked Data, a Nack-Congestion, or a
+ *  timeout (detected on consumer retransmission after the upstream's RTO has elapsed) is
+ *  observed from an upstream, a fraction of that upstream's share is moved to the other
+ *  nexthops, favoring those with low mark rate and low RTT. The share of an upstream is
+ *  reduced at most once per its smoothed RTT.
+ *
+ *  Congestion marks on Data are propagated downstream, so that consumers can adjust their
+ *  sending rate. A Nack-Congestion is retried on another nexthop if one is available, and
+ *  returned downstream otherwise. Data served from the ContentStore has its congestion
+ *  mark removed, because it did not traverse the congested path.
+ *
+ *  \see Klaus Schneider, Cheng Yi, Beichuan Zhang, and Lixia Zhang,
+ *       "A Practical Congestion Control Scheme for Named Data Networking,"
+ *       ACM ICN 2016.
+ */
+class CongestionAwareStrategy : public Strategy
+                              , public ProcessNackTraits<CongestionAwareStrategy>
+{
+public:
+  explicit
+  CongestionAwareStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+  static const Name&
+  getStrategyName();
+
+public: // triggers
+  void
+  afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                        const FaceEndpoint& ingress, const Data& data) override;
+
+  void
+  afterContentStoreHit(const shared_ptr<pit::Entry>& pitEntry,
+                       const FaceEndpoint& ingress, const Data& data) override;
+
+  void
+  afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE: // StrategyInfo
+  using RttEstimator = ndn::util::RttEstimator;
+
+  /** \brief Per-nexthop state within a namespace
+   */
+  class FaceStats
+  {
+  public:
+    explicit
+    FaceStats(shared_ptr<const RttEstimator::Options> opts)
+      : rtt(std::move(opts))
+    {
+    }
+
+  public:
+    /// fraction of Interests forwarded to this nexthop, between 0 and 1
+    double share = 0.0;
+    /// moving average of the fraction of Data that carried a congestion mark
+    double markRate = 0.0;
+    RttEstimator rtt;
+    /// last time the share was reduced due to congestion
+    time::steady_clock::TimePoint lastReduction;
+  };
+
+  /** \brief StrategyInfo in measurements table
+   */
+  class MtInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1050;
+    }
+
+    explicit
+    MtInfo(shared_ptr<const RttEstimator::Options> opts)
+      : m_rttEstimatorOpts(std::move(opts))
+    {
+    }
+
+    FaceStats*
+    getFaceStats(FaceId faceId);
+
+    FaceStats&
+    getOrCreateFaceStats(FaceId faceId);
+
+  public:
+    std::unordered_map<FaceId, FaceStats> faces;
+
+  private:
+    shared_ptr<const RttEstimator::Options> m_rttEstimatorOpts;
+  };
+
+  /** \brief get or create per-namespace measurements for the FIB entry used by \p interest
+   */
+  MtInfo&
+  getOrCreateMtInfo(const fib::Entry& fibEntry, const Interest& interest);
+
+  /** \brief find per-namespace measurements for \p pitEntry
+   */
+  MtInfo*
+  findMtInfo(const pit::Entry& pitEntry);
+
+private:
+  /** \brief ensure that the shares of \p nexthops sum up to one
+   *
+   *  If no nexthop has a share, the whole share is given to the lowest-cost nexthop.
+   */
+  static void
+  normalizeShares(MtInfo& mi, const fib::NextHopList& nexthops);
+
+  /** \brief move \p fraction of the share of \p faceId to the other nexthops
+   *
+   *  Other nexthops receive the share in proportion to (1 - markRate) / RTT.
+   *  This has no effect if the share of \p faceId has been reduced within its smoothed RTT.
+   */
+  static void
+  reduceShare(MtInfo& mi, const fib::NextHopList& nexthops, FaceId faceId, double fraction);
+
+  /** \brief choose an eligible nexthop randomly in proportion to the forwarding shares
+   *  \param wantUnused if true, nexthops with unexpired out-records are skipped
+   */
+  fib::NextHopList::const_iterator
+  selectNextHop(const Face& inFace, const Interest& interest, const fib::NextHopList& nexthops,
+                const shared_ptr<pit::Entry>& pitEntry, MtInfo& mi, bool wantUnused);
+
+  /** \brief reduce the share of upstreams whose out-records are pending beyond their RTO
+   */
+  static void
+  detectTimeouts(const pit::Entry& pitEntry, MtInfo& mi, const fib::NextHopList& nexthops);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// weight of a new sample in the congestion-mark rate moving average
+  static constexpr double MARK_RATE_ALPHA = 0.125;
+  /// fraction of share moved away upon a congestion mark or Nack-Congestion
+  static constexpr double SHARE_CHANGE_ON_MARK = 0.1;
+  /// fraction of share moved away upon a timeout
+  static constexpr double SHARE_CHANGE_ON_TIMEOUT = 0.5;
+  static const time::milliseconds RETX_SUPPRESSION_INITIAL;
+  static const time::milliseconds RETX_SUPPRESSION_MAX;
+  static const time::nanoseconds MEASUREMENTS_LIFETIME;
+
+private:
+  shared_ptr<const RttEstimator::Options> m_rttEstimatorOpts;
+  RetxSuppressionExponential m_retxSuppression;
+
+  friend ProcessNackTraits<CongestionAwareStrategy>;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CONGESTION_AWARE_STRATEGY_HPP
@@ -36,28 +36,34 @@ NDN_CXX_ASSERT_FORWARD_ITERATOR(FaceTable::const_iterator);
 
 NFD_LOG_INIT(FaceTable);
 
+constexpr size_t FaceTable::SLOTS_PER_PAGE;
+
 FaceTable::FaceTable()
   : m_lastFaceId(face::FACEID_RESERVED_MAX)
+  , m_nFaces(0)
 {
 }
 
 Face*
 FaceTable::get(FaceId id) const
 {
-  auto i = m_faces.find(id);
-  return i == m_faces.end() ? nullptr : i->second.get();
+  size_t pageIndex = id / SLOTS_PER_PAGE;
+  if (pageIndex >= m_pages.size() || m_pages[pageIndex] == nullptr) {
+    return nullptr;
+  }
+  return m_pages[pageIndex]->slots[id % SLOTS_PER_PAGE].get();
 }
 
 size_t
 FaceTable::size() const
 {
-  return m_faces.size();
+  return m_nFaces;
 }
 
 void
 FaceTable::add(shared_ptr<Face> face)
 {
-  if (face->getId() != face::INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != face::INVALID_FACEID && this->get(face->getId()) != nullptr) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
@@ -78,9 +84,21 @@ FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
+  size_t pageIndex = faceId / SLOTS_PER_PAGE;
+  if (pageIndex >= m_pages.size()) {
+    m_pages.resize(pageIndex + 1);
+  }
+  auto& page = m_pages[pageIndex];
+  if (page == nullptr) {
+    page = make_unique<Page>();
+  }
+  auto& slot = page->slots[faceId % SLOTS_PER_PAGE];
+  BOOST_ASSERT(slot == nullptr);
+
   face->setId(faceId);
-  auto ret = m_faces.emplace(faceId, face);
-  BOOST_VERIFY(ret.second);
+  slot = face;
+  ++page->nFaces;
+  ++m_nFaces;
 
   NFD_LOG_INFO("Added face id=" << faceId <<
                " remote=" << face->getRemoteUri() <<
@@ -94,13 +112,20 @@ FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 void
 FaceTable::remove(FaceId faceId)
 {
-  auto i = m_faces.find(faceId);
-  BOOST_ASSERT(i != m_faces.end());
-  shared_ptr<Face> face = i->second;
+  size_t pageIndex = faceId / SLOTS_PER_PAGE;
+  BOOST_ASSERT(pageIndex < m_pages.size() && m_pages[pageIndex] != nullptr);
+  auto& page = m_pages[pageIndex];
+  auto& slot = page->slots[faceId % SLOTS_PER_PAGE];
+  BOOST_ASSERT(slot != nullptr);
+  shared_ptr<Face> face = slot;
 
   this->beforeRemove(*face);
 
-  m_faces.erase(i);
+  slot.reset();
+  --m_nFaces;
+  if (--page->nFaces == 0) {
+    page.reset();
+  }
   face->setId(face::INVALID_FACEID);
 
   NFD_LOG_INFO("Removed face id=" << faceId <<
@@ -111,22 +136,91 @@ FaceTable::remove(FaceId faceId)
   getGlobalIoService().post([face] {});
 }
 
-FaceTable::ForwardRange
-FaceTable::getForwardRange() const
+FaceId
+FaceTable::findNext(FaceId faceId) const
+{
+  FaceId id = faceId + 1;
+  while (id / SLOTS_PER_PAGE < m_pages.size()) {
+    const auto& page = m_pages[id / SLOTS_PER_PAGE];
+    if (page != nullptr) {
+      for (size_t i = id % SLOTS_PER_PAGE; i < SLOTS_PER_PAGE; ++i) {
+        if (page->slots[i] != nullptr) {
+          return id - id % SLOTS_PER_PAGE + i;
+        }
+      }
+    }
+    id = (id / SLOTS_PER_PAGE + 1) * SLOTS_PER_PAGE;
+  }
+  return face::INVALID_FACEID;
+}
+
+FaceId
+FaceTable::findPrevious(FaceId faceId) const
 {
-  return m_faces | boost::adaptors::map_values | boost::adaptors::indirected;
+  FaceId limit = m_pages.size() * SLOTS_PER_PAGE;
+  if (faceId == face::INVALID_FACEID || faceId > limit) {
+    faceId = limit;
+  }
+
+  // scan slots [0, faceId) backwards, one page at a time
+  while (faceId > 0) {
+    size_t pageIndex = (faceId - 1) / SLOTS_PER_PAGE;
+    const auto& page = m_pages[pageIndex];
+    if (page != nullptr) {
+      for (size_t i = (faceId - 1) % SLOTS_PER_PAGE + 1; i > 0; --i) {
+        if (page->slots[i - 1] != nullptr) {
+          return pageIndex * SLOTS_PER_PAGE + i - 1;
+        }
+      }
+    }
+    faceId = pageIndex * SLOTS_PER_PAGE;
+  }
+  return face::INVALID_FACEID;
 }
 
 FaceTable::const_iterator
 FaceTable::begin() const
 {
-  return this->getForwardRange().begin();
+  return {this, this->findNext(face::INVALID_FACEID)};
 }
 
 FaceTable::const_iterator
 FaceTable::end() const
 {
-  return this->getForwardRange().end();
+  return {this, face::INVALID_FACEID};
+}
+
+FaceTable::const_iterator&
+FaceTable::const_iterator::operator++()
+{
+  BOOST_ASSERT(m_table != nullptr && m_faceId != face::INVALID_FACEID);
+  m_faceId = m_table->findNext(m_faceId);
+  return *this;
+}
+
+FaceTable::const_iterator
+FaceTable::const_iterator::operator++(int)
+{
+  const_iterator copy = *this;
+  this->operator++();
+  return copy;
+}
+
+FaceTable::const_iterator&
+FaceTable::const_iterator::operator--()
+{
+  BOOST_ASSERT(m_table != nullptr);
+  m_faceId = m_table->findPrevious(m_faceId);
+  BOOST_ASSERT(m_faceId != face::INVALID_FACEID);
+  return *this;
+}
+
+FaceTable::const_iterator
+FaceTable::const_iterator::operator--(int)
+{
+  const_iterator copy = *this;
+  this->operator--();
+  return copy;
 }
 
 } // namespace nfd
@@ -28,12 +28,17 @@
 
 #include "face/face.hpp"
 
-#include <boost/range/adaptor/indirected.hpp>
-#include <boost/range/adaptor/map.hpp>
+#include <array>
 
 namespace nfd {
 
 /** \brief container of all faces
+ *
+ *  Faces are stored in fixed-size pages of slots indexed by FaceId, so that get() is a constant
+ *  time array access regardless of the number of faces. FaceIds are allocated sequentially and
+ *  are never reused; a page is released as soon as all faces in it have been removed, so that
+ *  memory usage is proportional to the number of live faces, plus one pointer per SLOTS_PER_PAGE
+ *  FaceIds ever allocated.
  */
 class FaceTable : noncopyable
 {
@@ -66,12 +71,74 @@ public:
   size() const;
 
 public: // enumeration
-  using FaceMap = std::map<FaceId, shared_ptr<Face>>;
-  using ForwardRange = boost::indirected_range<const boost::select_second_const_range<FaceMap>>;
-
-  /** \brief ForwardIterator for Face&
+  /** \brief BidirectionalIterator for Face&
+   *
+   *  Faces are visited in ascending order of FaceId.
+   *  An iterator remains valid when other faces are added or removed.
    */
-  using const_iterator = boost::range_iterator<ForwardRange>::type;
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = Face;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+
+    const_iterator() = default;
+
+    Face&
+    operator*() const
+    {
+      return *this->operator->();
+    }
+
+    Face*
+    operator->() const
+    {
+      BOOST_ASSERT(m_table != nullptr);
+      Face* face = m_table->get(m_faceId);
+      BOOST_ASSERT(face != nullptr);
+      return face;
+    }
+
+    const_iterator&
+    operator++();
+
+    const_iterator
+    operator++(int);
+
+    const_iterator&
+    operator--();
+
+    const_iterator
+    operator--(int);
+
+    bool
+    operator==(const const_iterator& other) const
+    {
+      return m_table == other.m_table && m_faceId == other.m_faceId;
+    }
+
+    bool
+    operator!=(const const_iterator& other) const
+    {
+      return !this->operator==(other);
+    }
+
+  private:
+    const_iterator(const FaceTable* table, FaceId faceId)
+      : m_table(table)
+      , m_faceId(faceId)
+    {
+    }
+
+  private:
+    const FaceTable* m_table = nullptr;
+    FaceId m_faceId = face::INVALID_FACEID; ///< current face, INVALID_FACEID denotes end()
+
+    friend FaceTable;
+  };
 
   const_iterator
   begin() const;
@@ -97,12 +164,34 @@ private:
   void
   remove(FaceId faceId);
 
-  ForwardRange
-  getForwardRange() const;
+  /** \return the smallest FaceId in use that is greater than \p faceId,
+   *          or INVALID_FACEID if there is none
+   */
+  FaceId
+  findNext(FaceId faceId) const;
+
+  /** \return the largest FaceId in use that is less than \p faceId,
+   *          or INVALID_FACEID if there is none
+   *  \param faceId a FaceId, or INVALID_FACEID to start from the end of the table
+   */
+  FaceId
+  findPrevious(FaceId faceId) const;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief number of FaceIds covered by each page
+   */
+  static constexpr size_t SLOTS_PER_PAGE = 1024;
 
 private:
+  struct Page
+  {
+    std::array<shared_ptr<Face>, SLOTS_PER_PAGE> slots;
+    size_t nFaces = 0;
+  };
+
   FaceId m_lastFaceId;
-  FaceMap m_faces;
+  size_t m_nFaces;
+  std::vector<unique_ptr<Page>> m_pages; ///< indexed by FaceId / SLOTS_PER_PAGE
 };
 
 } // namespace nfd
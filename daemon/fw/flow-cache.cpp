@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "flow-cache.hpp"
+#include "table/name-tree-hashtable.hpp"
+#include "table/pit-entry.hpp"
+
+namespace nfd {
+namespace fw {
+
+FlowCache::FlowCache(const Fib& fib, const StrategyChoice& strategyChoice)
+  : m_fib(fib)
+  , m_strategyChoice(strategyChoice)
+{
+}
+
+void
+FlowCache::setLimit(size_t nMaxEntries)
+{
+  m_limit = nMaxEntries;
+  if (m_table.size() > m_limit) {
+    m_table.clear();
+  }
+}
+
+const fib::Entry&
+FlowCache::findLongestPrefixMatch(const pit::Entry& pitEntry)
+{
+  const Entry* entry = this->lookup(pitEntry);
+  if (entry == nullptr) {
+    return m_fib.findLongestPrefixMatch(pitEntry);
+  }
+  return *entry->fibEntry;
+}
+
+Strategy&
+FlowCache::findEffectiveStrategy(const pit::Entry& pitEntry)
+{
+  const Entry* entry = this->lookup(pitEntry);
+  if (entry == nullptr) {
+    return m_strategyChoice.findEffectiveStrategy(pitEntry);
+  }
+  return *entry->strategy;
+}
+
+const FlowCache::Entry*
+FlowCache::lookup(const pit::Entry& pitEntry)
+{
+  if (m_limit == 0) {
+    return nullptr;
+  }
+
+  const Name& name = pitEntry.getName();
+  size_t prefixLen = std::min(name.size(),
+                              std::max(m_fib.getMaxEntryDepth(), m_strategyChoice.getMaxEntryDepth()));
+  uint64_t generation = m_fib.getGeneration() + m_strategyChoice.getGeneration();
+  size_t hash = name_tree::computeHash(name, prefixLen);
+
+  auto it = m_table.find(hash);
+  if (it != m_table.end() && it->second.prefix.size() == prefixLen &&
+      name.compare(0, prefixLen, it->second.prefix) == 0) {
+    if (it->second.generation == generation) {
+      ++nHits;
+      return &it->second;
+    }
+    ++nInvalidations;
+  }
+  ++nMisses;
+
+  if (it == m_table.end()) {
+    if (m_table.size() >= m_limit) {
+      m_table.clear();
+    }
+    it = m_table.emplace(hash, Entry{}).first;
+  }
+
+  Entry& entry = it->second;
+  if (entry.prefix.size() != prefixLen || name.compare(0, prefixLen, entry.prefix) != 0) {
+    entry.prefix = name.getPrefix(prefixLen);
+  }
+  entry.generation = generation;
+  entry.fibEntry = &m_fib.findLongestPrefixMatch(pitEntry);
+  entry.strategy = &m_strategyChoice.findEffectiveStrategy(pitEntry);
+  return &entry;
+}
+
+} // namespace fw
+} // namespace nfd
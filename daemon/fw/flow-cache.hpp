@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_FLOW_CACHE_HPP
+#define NFD_DAEMON_FW_FLOW_CACHE_HPP
+
+#include "common/counter.hpp"
+#include "table/fib.hpp"
+#include "table/strategy-choice.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+class Strategy;
+
+/** \brief Memoizes FIB longest prefix match and effective strategy lookups per flow
+ *
+ *  A flow is identified by the first K components of the Interest name, where K is the current
+ *  maximum depth of FIB and Strategy Choice entries. Since no entry is deeper than K, all names
+ *  in a flow share the same FIB entry and effective strategy, so one lookup can serve the entire
+ *  flow. K shrinks again once the deepest entries are erased.
+ *
+ *  The cache is keyed by the hash of those K components. A cached lookup is valid as long as
+ *  neither Fib nor StrategyChoice has changed since it was recorded, which is detected by
+ *  comparing their generation counters; stale entries are refreshed on access.
+ *
+ *  The cache is disabled when its limit is zero, which is the default.
+ */
+class FlowCache : noncopyable
+{
+public:
+  FlowCache(const Fib& fib, const StrategyChoice& strategyChoice);
+
+  /** \brief Change the maximum number of cached flows; zero disables the cache
+   */
+  void
+  setLimit(size_t nMaxEntries);
+
+  size_t
+  getLimit() const
+  {
+    return m_limit;
+  }
+
+  size_t
+  size() const
+  {
+    return m_table.size();
+  }
+
+  /** \brief Equivalent to `fib.findLongestPrefixMatch(pitEntry)`
+   */
+  const fib::Entry&
+  findLongestPrefixMatch(const pit::Entry& pitEntry);
+
+  /** \brief Equivalent to `strategyChoice.findEffectiveStrategy(pitEntry)`
+   */
+  Strategy&
+  findEffectiveStrategy(const pit::Entry& pitEntry);
+
+public:
+  /// lookups answered from the cache
+  PacketCounter nHits;
+  /// lookups not answered from the cache, including stale entries
+  PacketCounter nMisses;
+  /// stale entries found due to FIB or Strategy Choice changes
+  PacketCounter nInvalidations;
+
+private:
+  struct Entry
+  {
+    Name prefix;
+    uint64_t generation;
+    const fib::Entry* fibEntry;
+    Strategy* strategy;
+  };
+
+  /** \return cached or refreshed entry for the flow of \p pitEntry, or nullptr if disabled
+   */
+  const Entry*
+  lookup(const pit::Entry& pitEntry);
+
+private:
+  const Fib& m_fib;
+  const StrategyChoice& m_strategyChoice;
+  size_t m_limit = 0;
+  std::unordered_map<size_t, Entry> m_table;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_FLOW_CACHE_HPP
@@ -52,19 +52,40 @@ Forwarder::Forwarder(FaceTable& faceTable)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
   , m_strategyChoice(*this)
+  , m_flowCache(m_fib, m_strategyChoice)
 {
   m_faceTable.afterAdd.connect([this] (const Face& face) {
     face.afterReceiveInterest.connect(
       [this, &face] (const Interest& interest, const EndpointId& endpointId) {
-        this->startProcessInterest(FaceEndpoint(face, endpointId), interest);
+        if (!m_ingressScheduler.isEnabled()) {
+          this->startProcessInterest(FaceEndpoint(face, endpointId), interest);
+          return;
+        }
+        m_ingressScheduler.schedule(face.getId(),
+          [this, &face, endpointId, interest = interest.shared_from_this()] {
+            this->startProcessInterest(FaceEndpoint(face, endpointId), *interest);
+          });
       });
     face.afterReceiveData.connect(
       [this, &face] (const Data& data, const EndpointId& endpointId) {
-        this->startProcessData(FaceEndpoint(face, endpointId), data);
+        if (!m_ingressScheduler.isEnabled()) {
+          this->startProcessData(FaceEndpoint(face, endpointId), data);
+          return;
+        }
+        m_ingressScheduler.schedule(face.getId(),
+          [this, &face, endpointId, data = data.shared_from_this()] {
+            this->startProcessData(FaceEndpoint(face, endpointId), *data);
+          });
       });
     face.afterReceiveNack.connect(
       [this, &face] (const lp::Nack& nack, const EndpointId& endpointId) {
-        this->startProcessNack(FaceEndpoint(face, endpointId), nack);
+        if (!m_ingressScheduler.isEnabled()) {
+          this->startProcessNack(FaceEndpoint(face, endpointId), nack);
+          return;
+        }
+        m_ingressScheduler.schedule(face.getId(), [this, &face, endpointId, nack] {
+          this->startProcessNack(FaceEndpoint(face, endpointId), nack);
+        });
       });
     face.onDroppedInterest.connect(
       [this, &face] (const Interest& interest) {
@@ -73,6 +94,7 @@ Forwarder::Forwarder(FaceTable& faceTable)
   });
 
   m_faceTable.beforeRemove.connect([this] (const Face& face) {
+    m_ingressScheduler.removeFace(face.getId());
     cleanupOnFaceRemoval(m_nameTree, m_fib, m_pit, face);
   });
 
@@ -92,6 +114,7 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
   NFD_LOG_DEBUG("onIncomingInterest in=" << ingress << " interest=" << interest.getName());
   interest.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
   ++m_counters.nInInterests;
+  face::markTrace(interest, TraceStage::INCOMING);
 
   // drop if HopLimit zero, decrement otherwise (if present)
   if (interest.getHopLimit()) {
@@ -184,6 +207,7 @@ Forwarder::onContentStoreMiss(const FaceEndpoint& ingress,
 {
   NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName());
   ++m_counters.nCsMisses;
+  face::markTrace(interest, TraceStage::CS_LOOKUP);
 
   // insert in-record
   pitEntry->insertOrUpdateInRecord(ingress.face, interest);
@@ -208,14 +232,18 @@ Forwarder::onContentStoreMiss(const FaceEndpoint& ingress,
       // scope control is unnecessary, because privileged app explicitly wants to forward
       this->onOutgoingInterest(pitEntry, *nextHopFace, interest);
     }
+    interest.removeTag<face::PacketTraceTag>();
     return;
   }
 
   // dispatch to strategy: after incoming Interest
+  face::markTrace(interest, TraceStage::STRATEGY);
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) {
       strategy.afterReceiveInterest(ingress, interest, pitEntry);
     });
+  // the Interest is kept in the PIT entry, and later retransmissions must not be traced
+  interest.removeTag<face::PacketTraceTag>();
 }
 
 void
@@ -224,6 +252,7 @@ Forwarder::onContentStoreHit(const FaceEndpoint& ingress, const shared_ptr<pit::
 {
   NFD_LOG_DEBUG("onContentStoreHit interest=" << interest.getName());
   ++m_counters.nCsHits;
+  face::markTrace(interest, TraceStage::CS_LOOKUP);
 
   data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
   data.setTag(interest.getTag<lp::PitToken>());
@@ -236,8 +265,10 @@ Forwarder::onContentStoreHit(const FaceEndpoint& ingress, const shared_ptr<pit::
   this->setExpiryTimer(pitEntry, 0_ms);
 
   // dispatch to strategy: after Content Store hit
+  face::markTrace(interest, TraceStage::STRATEGY);
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.afterContentStoreHit(pitEntry, ingress, data); });
+  interest.removeTag<face::PacketTraceTag>();
 }
 
 void
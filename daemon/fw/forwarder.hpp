@@ -27,7 +27,9 @@
 #define NFD_DAEMON_FW_FORWARDER_HPP
 
 #include "face-table.hpp"
+#include "flow-cache.hpp"
 #include "forwarder-counters.hpp"
+#include "ingress-scheduler.hpp"
 #include "unsolicited-data-policy.hpp"
 #include "face/face-endpoint.hpp"
 #include "table/fib.hpp"
@@ -76,6 +78,12 @@ public:
     m_unsolicitedDataPolicy = std::move(policy);
   }
 
+  FaceTable&
+  getFaceTable()
+  {
+    return m_faceTable;
+  }
+
 public: // forwarding entrypoints and tables
   /** \brief start incoming Interest processing
    *  \param ingress face on which Interest is received and endpoint of the sender
@@ -165,6 +173,18 @@ public: // forwarding entrypoints and tables
     return m_networkRegionTable;
   }
 
+  fw::FlowCache&
+  getFlowCache()
+  {
+    return m_flowCache;
+  }
+
+  fw::IngressScheduler&
+  getIngressScheduler()
+  {
+    return m_ingressScheduler;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   /** \brief incoming Interest pipeline
    */
@@ -255,7 +275,7 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   dispatchToStrategy(pit::Entry& pitEntry, Function trigger)
 #endif
   {
-    trigger(m_strategyChoice.findEffectiveStrategy(pitEntry));
+    trigger(m_flowCache.findEffectiveStrategy(pitEntry));
   }
 
 private:
@@ -272,6 +292,8 @@ private:
   StrategyChoice     m_strategyChoice;
   DeadNonceList      m_deadNonceList;
   NetworkRegionTable m_networkRegionTable;
+  fw::FlowCache      m_flowCache;
+  fw::IngressScheduler m_ingressScheduler;
 
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ingress-scheduler.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(IngressScheduler);
+
+IngressScheduler::IngressScheduler(const Options& options)
+  : m_options(options)
+{
+}
+
+void
+IngressScheduler::setOptions(const Options& options)
+{
+  m_options = options;
+  if (!isEnabled() && m_size > 0) {
+    // flush packets queued while the scheduler was enabled
+    m_processEvent = getScheduler().schedule(0_ns, [this] { processBatch(); });
+  }
+}
+
+void
+IngressScheduler::setWeight(FaceId faceId, uint32_t weight)
+{
+  if (weight == 0) {
+    auto it = m_queues.find(faceId);
+    if (it != m_queues.end()) {
+      it->second.weight = 0;
+    }
+    return;
+  }
+  m_queues[faceId].weight = weight;
+}
+
+uint32_t
+IngressScheduler::getWeight(FaceId faceId) const
+{
+  auto it = m_queues.find(faceId);
+  if (it == m_queues.end() || it->second.weight == 0) {
+    return std::max<uint32_t>(m_options.defaultWeight, 1);
+  }
+  return it->second.weight;
+}
+
+size_t
+IngressScheduler::size(FaceId faceId) const
+{
+  auto it = m_queues.find(faceId);
+  return it == m_queues.end() ? 0 : it->second.tasks.size();
+}
+
+bool
+IngressScheduler::schedule(FaceId faceId, Task task)
+{
+  FaceQueue& queue = m_queues[faceId];
+  if (queue.tasks.size() >= m_options.queueCapacity) {
+    ++nDropped;
+    NFD_LOG_DEBUG("drop face=" << faceId << " queue-full");
+    return false;
+  }
+
+  queue.tasks.push_back(std::move(task));
+  ++m_size;
+  if (!queue.isActive) {
+    queue.isActive = true;
+    m_activeList.push_back(faceId);
+  }
+
+  if (!m_processEvent) {
+    m_processEvent = getScheduler().schedule(0_ns, [this] { processBatch(); });
+  }
+  return true;
+}
+
+void
+IngressScheduler::removeFace(FaceId faceId)
+{
+  auto it = m_queues.find(faceId);
+  if (it == m_queues.end()) {
+    return;
+  }
+  // the face is skipped when it reaches the front of the active list
+  m_size -= it->second.tasks.size();
+  m_queues.erase(it);
+}
+
+void
+IngressScheduler::processBatch()
+{
+  size_t budget = isEnabled() ? m_options.batchSize : std::numeric_limits<size_t>::max();
+
+  while (budget > 0 && !m_activeList.empty()) {
+    FaceId faceId = m_activeList.front();
+    auto it = m_queues.find(faceId);
+    if (it == m_queues.end() || !it->second.isActive) {
+      // the face has been removed
+      m_activeList.pop_front();
+      continue;
+    }
+
+    if (it->second.deficit <= 0) {
+      it->second.deficit += getWeight(faceId);
+    }
+
+    // Serve this face while it has a deficit left. The queue is looked up again after each task,
+    // because processing a packet may remove the face.
+    while (budget > 0 && it != m_queues.end() && it->second.deficit > 0 &&
+           !it->second.tasks.empty()) {
+      Task task = std::move(it->second.tasks.front());
+      it->second.tasks.pop_front();
+      --it->second.deficit;
+      --m_size;
+      --budget;
+      task();
+      it = m_queues.find(faceId);
+    }
+
+    if (it == m_queues.end()) {
+      m_activeList.pop_front();
+    }
+    else if (it->second.tasks.empty()) {
+      // an idle face does not keep its credit
+      it->second.deficit = 0;
+      it->second.isActive = false;
+      m_activeList.pop_front();
+      if (it->second.weight == 0) {
+        m_queues.erase(it);
+      }
+    }
+    else if (it->second.deficit <= 0) {
+      m_activeList.pop_front();
+      m_activeList.push_back(faceId);
+    }
+    // otherwise, the batch is exhausted, and this face continues in the next batch
+  }
+
+  if (m_size > 0) {
+    m_processEvent = getScheduler().schedule(0_ns, [this] { processBatch(); });
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_INGRESS_SCHEDULER_HPP
+#define NFD_DAEMON_FW_INGRESS_SCHEDULER_HPP
+
+#include "common/counter.hpp"
+#include "face/face-common.hpp"
+
+#include <deque>
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief Schedules the processing of incoming packets among faces
+ *
+ *  All faces deliver their packets on the same thread, so a face receiving at line rate would
+ *  otherwise get a share of forwarding capacity proportional to its arrival rate, and could
+ *  starve quieter faces during overload. IngressScheduler queues the packets of each face
+ *  separately, and serves the queues in deficit round robin order, counting one unit of work
+ *  per packet. In every round, each backlogged face may process as many packets as its weight.
+ *
+ *  At most `batchSize` packets are processed before the scheduler yields to the io_service,
+ *  so that receive completions pending on all faces are queued before the next batch.
+ *
+ *  The scheduler is disabled when `batchSize` is zero, which is the default. In that case,
+ *  callers should process packets immediately instead of invoking schedule().
+ */
+class IngressScheduler : noncopyable
+{
+public:
+  /** \brief Options that control the behavior of IngressScheduler
+   */
+  struct Options
+  {
+    /** \brief maximum number of packets processed per io_service iteration; zero disables
+     */
+    size_t batchSize = 0;
+
+    /** \brief maximum number of packets queued per face
+     *
+     *  Packets arriving at a full queue are dropped.
+     */
+    size_t queueCapacity = 1000;
+
+    /** \brief weight of faces without an explicitly assigned weight
+     */
+    uint32_t defaultWeight = 1;
+  };
+
+  /** \brief processing of a packet
+   */
+  using Task = std::function<void()>;
+
+  explicit
+  IngressScheduler(const Options& options = {});
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  void
+  setOptions(const Options& options);
+
+  bool
+  isEnabled() const
+  {
+    return m_options.batchSize > 0;
+  }
+
+  /** \brief assign a weight to a face; zero reverts to the default weight
+   */
+  void
+  setWeight(FaceId faceId, uint32_t weight);
+
+  uint32_t
+  getWeight(FaceId faceId) const;
+
+  /** \brief queue the processing of a packet received on \p faceId
+   *  \retval false the queue of \p faceId is full, and \p task has been dropped
+   */
+  bool
+  schedule(FaceId faceId, Task task);
+
+  /** \brief drop all packets queued for \p faceId, and forget its weight
+   */
+  void
+  removeFace(FaceId faceId);
+
+  /** \brief number of packets queued for all faces
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /** \brief number of packets queued for \p faceId
+   */
+  size_t
+  size(FaceId faceId) const;
+
+public:
+  /** \brief count of packets dropped due to a full queue
+   */
+  PacketCounter nDropped;
+
+private:
+  void
+  processBatch();
+
+private:
+  struct FaceQueue
+  {
+    std::deque<Task> tasks;
+    uint32_t weight = 0;
+    ssize_t deficit = 0;
+    bool isActive = false;
+  };
+
+  Options m_options;
+  std::unordered_map<FaceId, FaceQueue> m_queues;
+  std::deque<FaceId> m_activeList; ///< faces with queued packets, in round robin order
+  size_t m_size = 0;
+  scheduler::ScopedEventId m_processEvent;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_INGRESS_SCHEDULER_HPP
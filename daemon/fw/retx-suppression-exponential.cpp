@@ -32,28 +32,6 @@ const RetxSuppressionExponential::Duration RetxSuppressionExponential::DEFAULT_I
 const RetxSuppressionExponential::Duration RetxSuppressionExponential::DEFAULT_MAX_INTERVAL = 250_ms;
 const float RetxSuppressionExponential::DEFAULT_MULTIPLIER = 2.0f;
 
-class RetxSuppressionExponential::PitInfo : public StrategyInfo
-{
-public:
-  static constexpr int
-  getTypeId()
-  {
-    return 1020;
-  }
-
-  explicit
-  PitInfo(const Duration& initialInterval)
-    : suppressionInterval(initialInterval)
-  {
-  }
-
-public:
-  /** \brief if last transmission occurred within suppressionInterval,
-   *         retransmission will be suppressed
-   */
-  Duration suppressionInterval;
-};
-
 RetxSuppressionExponential::RetxSuppressionExponential(const Duration& initialInterval,
                                                        float multiplier,
                                                        const Duration& maxInterval)
@@ -69,24 +47,30 @@ RetxSuppressionExponential::RetxSuppressionExponential(const Duration& initialIn
 RetxSuppressionResult
 RetxSuppressionExponential::decidePerPitEntry(pit::Entry& pitEntry)
 {
-  bool isNewPitEntry = !hasPendingOutRecords(pitEntry);
+  // equivalent to hasPendingOutRecords() followed by getLastOutgoing(), in a single pass
+  auto now = time::steady_clock::now();
+  bool hasPending = false;
+  auto lastOutgoing = time::steady_clock::TimePoint::min();
+  for (const auto& outRecord : pitEntry.getOutRecords()) {
+    if (outRecord.getExpiry() >= now && outRecord.getIncomingNack() == nullptr) {
+      hasPending = true;
+    }
+    lastOutgoing = std::max(lastOutgoing, outRecord.getLastRenewed());
+  }
+
+  bool isNewPitEntry = !hasPending;
   if (isNewPitEntry) {
     return RetxSuppressionResult::NEW;
   }
 
-  auto lastOutgoing = getLastOutgoing(pitEntry);
-  auto now = time::steady_clock::now();
   auto sinceLastOutgoing = now - lastOutgoing;
-
-  PitInfo* pi = pitEntry.insertStrategyInfo<PitInfo>(m_initialInterval).first;
-  bool shouldSuppress = sinceLastOutgoing < pi->suppressionInterval;
+  bool shouldSuppress = sinceLastOutgoing < getInterval(pitEntry.retxSuppressionInterval);
 
   if (shouldSuppress) {
     return RetxSuppressionResult::SUPPRESS;
   }
 
-  pi->suppressionInterval = std::min(m_maxInterval,
-    time::duration_cast<Duration>(pi->suppressionInterval * m_multiplier));
+  pitEntry.retxSuppressionInterval = getNextInterval(pitEntry.retxSuppressionInterval);
 
   return RetxSuppressionResult::FORWARD;
 }
@@ -104,9 +88,7 @@ RetxSuppressionExponential::decidePerUpstream(pit::Entry& pitEntry, Face& outFac
   auto now = time::steady_clock::now();
   auto sinceLastOutgoing = now - lastOutgoing;
 
-  // insertStrategyInfo does not insert m_initialInterval again if it already exists
-  PitInfo* pi = outRecord->insertStrategyInfo<PitInfo>(m_initialInterval).first;
-  bool shouldSuppress = sinceLastOutgoing < pi->suppressionInterval;
+  bool shouldSuppress = sinceLastOutgoing < getInterval(outRecord->retxSuppressionInterval);
 
   if (shouldSuppress) {
     return RetxSuppressionResult::SUPPRESS;
@@ -118,9 +100,7 @@ RetxSuppressionExponential::decidePerUpstream(pit::Entry& pitEntry, Face& outFac
 void
 RetxSuppressionExponential::incrementIntervalForOutRecord(pit::OutRecord& outRecord)
 {
-  PitInfo* pi = outRecord.insertStrategyInfo<PitInfo>(m_initialInterval).first;
-  pi->suppressionInterval = std::min(m_maxInterval,
-    time::duration_cast<Duration>(pi->suppressionInterval * m_multiplier));
+  outRecord.retxSuppressionInterval = getNextInterval(outRecord.retxSuppressionInterval);
 }
 
 } // namespace fw
@@ -67,10 +67,21 @@ public:
   void
   incrementIntervalForOutRecord(pit::OutRecord& outRecord);
 
-public:
-  /** \brief StrategyInfo on pit::Entry
+private:
+  /** \brief returns the suppression interval stored in a PIT entry or out-record
    */
-  class PitInfo;
+  Duration
+  getInterval(Duration stored) const
+  {
+    return stored == Duration::zero() ? m_initialInterval : stored;
+  }
+
+  Duration
+  getNextInterval(Duration stored) const
+  {
+    return std::min(m_maxInterval,
+                    time::duration_cast<Duration>(getInterval(stored) * m_multiplier));
+  }
 
 public:
   static const Duration DEFAULT_INITIAL_INTERVAL;
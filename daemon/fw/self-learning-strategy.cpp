@@ -36,6 +36,7 @@
 #include <ndn-cxx/lp/prefix-announcement-header.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
+#include <boost/lexical_cast.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 namespace nfd {
@@ -48,6 +49,10 @@ const time::milliseconds SelfLearningStrategy::ROUTE_RENEW_LIFETIME(10_min);
 const time::milliseconds SelfLearningStrategy::RETX_SUPPRESSION_INITIAL(10);
 const time::milliseconds SelfLearningStrategy::RETX_SUPPRESSION_MAX(250);
 const int SelfLearningStrategy::RETX_TRIGGER_BROADCAST_COUNT(7);
+const time::milliseconds SelfLearningStrategy::DEFAULT_DISCOVERY_INTERVAL(100_ms);
+const time::milliseconds SelfLearningStrategy::DEFAULT_MAX_DISCOVERY_INTERVAL(10_s);
+const size_t SelfLearningStrategy::MAX_HELD_INTERESTS(64);
+const time::milliseconds SelfLearningStrategy::ANNOUNCE_BATCH_DELAY(5_ms);
 
 SelfLearningStrategy::SelfLearningStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder)
@@ -58,13 +63,16 @@ SelfLearningStrategy::SelfLearningStrategy(Forwarder& forwarder, const Name& nam
 {
   ParsedInstanceName parsed = parseInstanceName(name);
   if (!parsed.parameters.empty()) {
-    NDN_THROW(std::invalid_argument("SelfLearningStrategy does not accept parameters"));
+    processParams(parsed.parameters);
   }
   if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
     NDN_THROW(std::invalid_argument(
       "SelfLearningStrategy does not support version " + to_string(*parsed.version)));
   }
   this->setInstanceName(makeInstanceName(name, getStrategyName()));
+
+  NFD_LOG_DEBUG("discovery-interval=" << m_discoveryInterval
+                << " discovery-max-interval=" << m_maxDiscoveryInterval);
 }
 
 const Name&
@@ -74,6 +82,50 @@ SelfLearningStrategy::getStrategyName()
   return strategyName;
 }
 
+static uint64_t
+getParamValue(const std::string& param, const std::string& value)
+{
+  try {
+    if (!value.empty() && value[0] == '-')
+      NDN_THROW(boost::bad_lexical_cast());
+
+    return boost::lexical_cast<uint64_t>(value);
+  }
+  catch (const boost::bad_lexical_cast&) {
+    NDN_THROW(std::invalid_argument("Value of " + param + " must be a non-negative integer"));
+  }
+}
+
+void
+SelfLearningStrategy::processParams(const PartialName& parsed)
+{
+  for (const auto& component : parsed) {
+    std::string parsedStr(reinterpret_cast<const char*>(component.value()), component.value_size());
+    auto n = parsedStr.find("~");
+    if (n == std::string::npos) {
+      NDN_THROW(std::invalid_argument("Format is <parameter>~<value>"));
+    }
+
+    auto f = parsedStr.substr(0, n);
+    auto s = parsedStr.substr(n + 1);
+    if (f == "discovery-interval") {
+      m_discoveryInterval = time::milliseconds(getParamValue(f, s));
+    }
+    else if (f == "discovery-max-interval") {
+      m_maxDiscoveryInterval = time::milliseconds(getParamValue(f, s));
+    }
+    else {
+      NDN_THROW(std::invalid_argument("Parameter should be discovery-interval or "
+                                      "discovery-max-interval"));
+    }
+  }
+
+  if (m_maxDiscoveryInterval < m_discoveryInterval) {
+    NDN_THROW(std::invalid_argument("discovery-max-interval must not be less than "
+                                    "discovery-interval"));
+  }
+}
+
 void
 SelfLearningStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
                                            const shared_ptr<pit::Entry>& pitEntry)
@@ -171,7 +223,8 @@ SelfLearningStrategy::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry,
           [&] (const shared_ptr<nfd::Face>& face) {
             NFD_LOG_DEBUG("unicast face created, add route");
             this->addFace(face);
-            addRoute(pitEntry, *face, data, *paTag->get().getPrefixAnn());
+            addRoute(*face, *paTag->get().getPrefixAnn());
+            onRouteLearned(pitEntry->getName(), *face);
           },
           [] (uint32_t, const std::string& reason) {
             NFD_LOG_DEBUG("unicast face creation failied, reason= " << reason);
@@ -179,7 +232,8 @@ SelfLearningStrategy::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry,
       }
       else {
         NFD_LOG_DEBUG("Incoming face= " << ingress.face.getId() << " is not multi-access, announce route to it");
-        addRoute(pitEntry, ingress.face, data, *paTag->get().getPrefixAnn());
+        addRoute(ingress.face, *paTag->get().getPrefixAnn());
+        onRouteLearned(pitEntry->getName(), ingress.face);
       }
     }
     else { // Data contains no PrefixAnnouncement, upstreams do not support self-learning
@@ -269,9 +323,88 @@ SelfLearningStrategy::noNexthopHandler(const FaceEndpoint& ingress, const Intere
     return;
   }
   else { // receive "discovery" Interest, broadcast it
+    discoverInterest(ingress, interest, pitEntry);
+    return;
+  }
+}
+
+void
+SelfLearningStrategy::discoverInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                       const shared_ptr<pit::Entry>& pitEntry)
+{
+  DiscoveryInfo* info = getDiscoveryInfo(interest.getName());
+  if (info == nullptr) {
     broadcastInterest(interest, ingress.face, pitEntry);
     return;
   }
+
+  auto now = time::steady_clock::now();
+  if (info->lastBroadcast != time::steady_clock::TimePoint::min() &&
+      now < info->lastBroadcast + info->interval) {
+    bool isHeld = std::any_of(info->heldEntries.begin(), info->heldEntries.end(),
+                              [&] (const auto& held) { return held.lock() == pitEntry; });
+    if (isHeld) {
+      NFD_LOG_DEBUG("discovery Interest=" << interest << " from=" << ingress << " already held");
+    }
+    else if (info->heldEntries.size() < MAX_HELD_INTERESTS) {
+      NFD_LOG_DEBUG("hold discovery Interest=" << interest << " from=" << ingress
+                    << " interval=" << info->interval);
+      info->heldEntries.push_back(pitEntry);
+    }
+    else {
+      NFD_LOG_DEBUG("reject discovery Interest=" << interest << " from=" << ingress
+                    << " too many held Interests");
+      this->rejectPendingInterest(pitEntry);
+    }
+    return;
+  }
+
+  if (info->isOutstanding) {
+    // previous broadcast did not result in a learned route, back off
+    info->interval = std::min(info->interval * 2, m_maxDiscoveryInterval);
+  }
+  info->lastBroadcast = now;
+  info->isOutstanding = true;
+  broadcastInterest(interest, ingress.face, pitEntry);
+}
+
+void
+SelfLearningStrategy::onRouteLearned(const Name& name, Face& face)
+{
+  DiscoveryInfo* info = getDiscoveryInfo(name);
+  if (info == nullptr) {
+    return;
+  }
+
+  info->interval = m_discoveryInterval;
+  info->isOutstanding = false;
+
+  auto heldEntries = std::move(info->heldEntries);
+  info->heldEntries.clear();
+  for (const auto& weakEntry : heldEntries) {
+    auto pitEntry = weakEntry.lock();
+    if (pitEntry == nullptr || pitEntry->isSatisfied || !pitEntry->hasInRecords() ||
+        pitEntry->getOutRecord(face) != pitEntry->out_end()) {
+      continue;
+    }
+    Interest interest = pitEntry->getInterest();
+    interest.setTag(make_shared<lp::NonDiscoveryTag>(lp::EmptyValue{}));
+    this->sendInterest(pitEntry, face, interest);
+    pitEntry->getOutRecord(face)->insertStrategyInfo<OutRecordInfo>().first->isNonDiscoveryInterest = true;
+    NFD_LOG_DEBUG("release held Interest=" << interest << " to learned Face=" << face.getId());
+  }
+}
+
+SelfLearningStrategy::DiscoveryInfo*
+SelfLearningStrategy::getDiscoveryInfo(const Name& name)
+{
+  measurements::Entry* me = this->getMeasurements().get(name.empty() ? name : name.getPrefix(-1));
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  this->getMeasurements().extendLifetime(*me, 2 * m_maxDiscoveryInterval);
+  return me->insertStrategyInfo<DiscoveryInfo>(m_discoveryInterval).first;
 }
 
 void
@@ -357,15 +490,37 @@ SelfLearningStrategy::needPrefixAnn(const shared_ptr<pit::Entry>& pitEntry)
 }
 
 void
-SelfLearningStrategy::addRoute(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace,
-                               const Data& data, const ndn::PrefixAnnouncement& pa)
+SelfLearningStrategy::addRoute(const Face& inFace, const ndn::PrefixAnnouncement& pa)
 {
-  runOnRibIoService([pitEntryWeak = weak_ptr<pit::Entry>{pitEntry}, inFaceId = inFace.getId(), data, pa] {
-    rib::Service::get().getRibManager().slAnnounce(pa, inFaceId, ROUTE_RENEW_LIFETIME,
-      [] (RibManager::SlAnnounceResult res) {
-        NFD_LOG_DEBUG("Add route via PrefixAnnouncement with result=" << res);
-      });
+  auto it = std::find_if(m_pendingAnnouncements.begin(), m_pendingAnnouncements.end(),
+    [&] (const PendingAnnouncement& pending) {
+      return pending.faceId == inFace.getId() && pending.pa.getAnnouncedName() == pa.getAnnouncedName();
+    });
+  if (it != m_pendingAnnouncements.end()) {
+    it->pa = pa;
+    return;
+  }
+
+  m_pendingAnnouncements.push_back({pa, inFace.getId()});
+  if (m_pendingAnnouncements.size() == 1) {
+    m_announceFlushEvent = getScheduler().schedule(ANNOUNCE_BATCH_DELAY, [this] { flushAnnouncements(); });
+  }
+}
+
+void
+SelfLearningStrategy::flushAnnouncements()
+{
+  NFD_LOG_DEBUG("Hand over " << m_pendingAnnouncements.size() << " PrefixAnnouncements to RIB");
+  runOnRibIoService([batch = std::move(m_pendingAnnouncements)] {
+    auto& ribManager = rib::Service::get().getRibManager();
+    for (const auto& pending : batch) {
+      ribManager.slAnnounce(pending.pa, pending.faceId, ROUTE_RENEW_LIFETIME,
+        [] (RibManager::SlAnnounceResult res) {
+          NFD_LOG_DEBUG("Add route via PrefixAnnouncement with result=" << res);
+        });
+    }
   });
+  m_pendingAnnouncements.clear();
 }
 
 void
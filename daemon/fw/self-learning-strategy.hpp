@@ -44,6 +44,16 @@ namespace fw {
  *  On receiving Data for broadcast Interest, a route will be added to FIB according to the Prefix Announcement
  *  attached to Data. In addition, unicast face will be created when receiving data from a multicast face.
  *
+ *  Discovery broadcasts are rate limited per prefix, where the prefix is the Interest name without
+ *  its last component. After a broadcast, further discovery Interests under the same prefix are held
+ *  for the duration of the discovery interval instead of being broadcast, and are forwarded to the
+ *  learned face once a Prefix Announcement arrives. Each broadcast that does not lead to a learned
+ *  route doubles the interval, up to a maximum. The strategy accepts two parameters:
+ *    - `discovery-interval~<milliseconds>`: initial discovery interval; zero disables rate limiting
+ *    - `discovery-max-interval~<milliseconds>`: maximum discovery interval
+ *
+ *  Prefix Announcements learned within a short time window are handed to the RIB thread together.
+ *
  *  \see https://github.com/philoL/NDN-Self-Learning/blob/master/self-learning-v2.pdf
  */
 class SelfLearningStrategy : public Strategy
@@ -84,6 +94,33 @@ public:
     bool isNonDiscoveryInterest = false;
   };
 
+  /// StrategyInfo on measurements::Entry
+  class DiscoveryInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1042;
+    }
+
+    explicit
+    DiscoveryInfo(time::milliseconds initialInterval)
+      : interval(initialInterval)
+    {
+    }
+
+  public:
+    /// time of the last discovery broadcast under this prefix
+    time::steady_clock::TimePoint lastBroadcast = time::steady_clock::TimePoint::min();
+    /// discovery Interests are not broadcast within this interval after lastBroadcast
+    time::milliseconds interval;
+    /// whether the last broadcast has not yet resulted in a learned route
+    bool isOutstanding = false;
+    /// PIT entries of discovery Interests held while a broadcast is outstanding
+    std::vector<weak_ptr<pit::Entry>> heldEntries;
+  };
+
 public: // triggers
   void
   afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
@@ -102,6 +139,8 @@ public: // triggers
                    const shared_ptr<pit::Entry>& pitEntry) override;
 
 private: // operations
+  void
+  processParams(const PartialName& parsed);
 
   /** \brief Send an Interest to all possible faces
    *
@@ -119,6 +158,24 @@ private: // operations
   noNexthopHandler(const FaceEndpoint& ingress, const Interest& interest,
                    const shared_ptr<pit::Entry>& pitEntry);
 
+  /** \brief Broadcast a discovery Interest, subject to per-prefix rate limiting
+   *
+   *  If a discovery broadcast under the same prefix occurred within the discovery interval,
+   *  the PIT entry is held until a route is learned, or rejected if too many entries are held.
+   */
+  void
+  discoverInterest(const FaceEndpoint& ingress, const Interest& interest,
+                   const shared_ptr<pit::Entry>& pitEntry);
+
+  /** \brief Reset discovery state of the prefix of \p name after a route is learned via \p face,
+   *         and forward held discovery Interests to \p face
+   */
+  void
+  onRouteLearned(const Name& name, Face& face);
+
+  DiscoveryInfo*
+  getDiscoveryInfo(const Name& name);
+
   void
   allNexthopTriedHandler(const FaceEndpoint& ingress, const Interest& interest,
                          const shared_ptr<pit::Entry>& pitEntry, const fib::NextHopList& nexthops);
@@ -144,10 +201,15 @@ private: // operations
   needPrefixAnn(const shared_ptr<pit::Entry>& pitEntry);
 
   /** \brief Add a route using RibManager::slAnnounce on the RIB thread
+   *
+   *  Announcements are queued and handed to the RIB thread in a single task after
+   *  ANNOUNCE_BATCH_DELAY. A queued announcement of the same prefix on the same face is replaced.
    */
   void
-  addRoute(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace,
-           const Data& data, const ndn::PrefixAnnouncement& pa);
+  addRoute(const Face& inFace, const ndn::PrefixAnnouncement& pa);
+
+  void
+  flushAnnouncements();
 
   /** \brief renew a route using RibManager::slRenew on the RIB thread
    */
@@ -163,7 +225,21 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   static const time::milliseconds RETX_SUPPRESSION_INITIAL;
   static const time::milliseconds RETX_SUPPRESSION_MAX;
   static const int RETX_TRIGGER_BROADCAST_COUNT;
+  static const time::milliseconds DEFAULT_DISCOVERY_INTERVAL;
+  static const time::milliseconds DEFAULT_MAX_DISCOVERY_INTERVAL;
+  static const size_t MAX_HELD_INTERESTS;
+  static const time::milliseconds ANNOUNCE_BATCH_DELAY;
   RetxSuppressionExponential m_retxSuppression;
+  time::milliseconds m_discoveryInterval = DEFAULT_DISCOVERY_INTERVAL;
+  time::milliseconds m_maxDiscoveryInterval = DEFAULT_MAX_DISCOVERY_INTERVAL;
+
+  struct PendingAnnouncement
+  {
+    ndn::PrefixAnnouncement pa;
+    FaceId faceId;
+  };
+  std::vector<PendingAnnouncement> m_pendingAnnouncements;
+  scheduler::ScopedEventId m_announceFlushEvent;
 
   friend ProcessNackTraits<SelfLearningStrategy>;
 };
@@ -288,8 +288,8 @@ Strategy::lookupFib(const pit::Entry& pitEntry) const
   const Interest& interest = pitEntry.getInterest();
   // has forwarding hint?
   if (interest.getForwardingHint().empty()) {
-    // FIB lookup with Interest name
-    const fib::Entry& fibEntry = fib.findLongestPrefixMatch(pitEntry);
+    // FIB lookup with Interest name, which may be answered by the flow cache
+    const fib::Entry& fibEntry = m_forwarder.getFlowCache().findLongestPrefixMatch(pitEntry);
     NFD_LOG_TRACE("lookupFib noForwardingHint found=" << fibEntry.getPrefix());
     return fibEntry;
   }
@@ -26,6 +26,8 @@
 #include "face-manager.hpp"
 
 #include "common/logger.hpp"
+#include "core/face-link-options.hpp"
+#include "core/face-link-status.hpp"
 #include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
 #include "fw/face-table.hpp"
@@ -40,15 +42,16 @@ namespace nfd {
 
 NFD_LOG_INIT(FaceManager);
 
-FaceManager::FaceManager(FaceSystem& faceSystem,
+FaceManager::FaceManager(FaceSystem& faceSystem, fw::IngressScheduler& ingressScheduler,
                          Dispatcher& dispatcher, CommandAuthenticator& authenticator)
   : ManagerBase("faces", dispatcher, authenticator)
   , m_faceSystem(faceSystem)
   , m_faceTable(faceSystem.getFaceTable())
+  , m_ingressScheduler(ingressScheduler)
 {
   // register handlers for ControlCommand
   registerCommandHandler<ndn::nfd::FaceCreateCommand>("create", bind(&FaceManager::createFace, this, _4, _5));
-  registerCommandHandler<ndn::nfd::FaceUpdateCommand>("update", bind(&FaceManager::updateFace, this, _3, _4, _5));
+  registerCommandHandler<ndn::nfd::FaceUpdateCommand>("update", bind(&FaceManager::updateFace, this, _2, _3, _4, _5));
   registerCommandHandler<ndn::nfd::FaceDestroyCommand>("destroy", bind(&FaceManager::destroyFace, this, _4, _5));
 
   // register handlers for StatusDataset
@@ -182,6 +185,82 @@ makeUpdateFaceResponse(const Face& face)
   return params;
 }
 
+/** \brief the link options in effect on \p face
+ *  \param wantDefaults whether to report options that are disabled or have their default values
+ *
+ *  The fields of disabled limits and, by default, of disabled packing, the default send queue
+ *  target, and the default weights are absent, so that the FaceStatus of a face without
+ *  these options is unchanged.
+ */
+static FaceLinkOptions
+getLinkOptions(const Face& face, const fw::IngressScheduler& ingressScheduler,
+               bool wantDefaults = false)
+{
+  FaceLinkOptions linkOptions;
+  uint32_t ingressWeight = ingressScheduler.getWeight(face.getId());
+  if (ingressWeight != std::max<uint32_t>(ingressScheduler.getOptions().defaultWeight, 1) ||
+      wantDefaults) {
+    linkOptions.ingressWeight = ingressWeight;
+  }
+
+  auto linkService = dynamic_cast<face::GenericLinkService*>(face.getLinkService());
+  if (linkService == nullptr) {
+    return linkOptions;
+  }
+
+  const auto& options = linkService->getOptions();
+  if (options.interestPolicer.rate > 0) {
+    linkOptions.interestRate = static_cast<uint64_t>(options.interestPolicer.rate);
+    linkOptions.interestBurst = static_cast<uint64_t>(options.interestPolicer.burst);
+  }
+  if (options.dataShaper.rate > 0) {
+    linkOptions.dataRate = static_cast<uint64_t>(options.dataShaper.rate);
+    linkOptions.dataBurst = static_cast<uint64_t>(options.dataShaper.burst);
+  }
+  if (options.allowPacking || wantDefaults) {
+    linkOptions.wantPacking = options.allowPacking;
+  }
+  if (options.sendQueueTarget != face::GenericLinkService::Options().sendQueueTarget ||
+      wantDefaults) {
+    linkOptions.sendQueueTarget = options.sendQueueTarget;
+  }
+  if (options.txClassWeights != face::GenericLinkService::Options().txClassWeights ||
+      wantDefaults) {
+    linkOptions.interestWeight = options.txClassWeights[static_cast<size_t>(TxClass::INTEREST)];
+    linkOptions.dataWeight = options.txClassWeights[static_cast<size_t>(TxClass::DATA)];
+    linkOptions.nackWeight = options.txClassWeights[static_cast<size_t>(TxClass::NACK)];
+  }
+  return linkOptions;
+}
+
+/** \return whether \p weight is absent or can be the weight of a traffic class or a face
+ */
+static bool
+isValidWeight(const optional<uint64_t>& weight)
+{
+  return !weight || (*weight > 0 && *weight <= std::numeric_limits<uint32_t>::max());
+}
+
+/** \brief the link status of \p face
+ */
+static FaceLinkStatus
+getLinkStatus(const Face& face)
+{
+  FaceLinkStatus linkStatus;
+  auto linkService = dynamic_cast<face::GenericLinkService*>(face.getLinkService());
+  if (linkService == nullptr) {
+    return linkStatus;
+  }
+
+  const auto& sojournTime = linkService->getCounters().sendQueueSojournTime;
+  if (sojournTime.getCount() > 0) {
+    linkStatus.sojournP50 = sojournTime.getPercentile(50);
+    linkStatus.sojournP90 = sojournTime.getPercentile(90);
+    linkStatus.sojournP99 = sojournTime.getPercentile(99);
+  }
+  return linkStatus;
+}
+
 static ControlParameters
 makeCreateFaceResponse(const Face& face)
 {
@@ -252,10 +331,24 @@ updateLinkServiceOptions(Face& face, const ControlParameters& parameters)
 }
 
 void
-FaceManager::updateFace(const Interest& interest,
+FaceManager::updateFace(const Name& prefix, const Interest& interest,
                         const ControlParameters& parameters,
                         const ndn::mgmt::CommandContinuation& done)
 {
+  // The link options are NFD-specific fields appended to the ControlParameters. They are read
+  // from the Interest name, because applying the command defaults may have re-encoded
+  // the decoded ControlParameters without them.
+  FaceLinkOptions linkOptions;
+  try {
+    size_t parametersIndex = prefix.size() + makeRelPrefix("update").size();
+    linkOptions = FaceLinkOptions(interest.getName().at(parametersIndex).blockFromValue());
+  }
+  catch (const tlv::Error& e) {
+    NFD_LOG_DEBUG("Malformed link options: " << e.what());
+    done(ControlResponse(400, "Malformed link options"));
+    return;
+  }
+
   FaceId faceId = parameters.getFaceId();
   if (faceId == 0) { // Self-update
     auto incomingFaceIdTag = interest.getTag<lp::IncomingFaceIdTag>();
@@ -310,8 +403,33 @@ FaceManager::updateFace(const Interest& interest,
     }
   }
 
+  // the link options other than the ingress weight are implemented by GenericLinkService
+  FaceLinkOptions linkServiceOptions = linkOptions;
+  linkServiceOptions.ingressWeight = nullopt;
+  bool areLinkOptionsValid = linkServiceOptions.empty() ||
+    dynamic_cast<face::GenericLinkService*>(face->getLinkService()) != nullptr;
+  if (!areLinkOptionsValid) {
+    NFD_LOG_TRACE("cannot set link options on face without GenericLinkService");
+    areParamsValid = false;
+  }
+  else if (linkOptions.sendQueueTarget && *linkOptions.sendQueueTarget <= 0_ns) {
+    NFD_LOG_TRACE("cannot set send queue target to zero");
+    areLinkOptionsValid = false;
+    areParamsValid = false;
+  }
+  else if (!isValidWeight(linkOptions.interestWeight) || !isValidWeight(linkOptions.dataWeight) ||
+           !isValidWeight(linkOptions.nackWeight) || !isValidWeight(linkOptions.ingressWeight)) {
+    NFD_LOG_TRACE("cannot set weight to zero or above 2^32-1");
+    areLinkOptionsValid = false;
+    areParamsValid = false;
+  }
+
   if (!areParamsValid) {
-    done(ControlResponse(409, "Invalid properties specified").setBody(response.wireEncode()));
+    Block body = response.wireEncode();
+    if (!areLinkOptionsValid) {
+      body = linkOptions.appendTo(body);
+    }
+    done(ControlResponse(409, "Invalid properties specified").setBody(body));
     return;
   }
 
@@ -320,10 +438,17 @@ FaceManager::updateFace(const Interest& interest,
     face->setPersistency(parameters.getFacePersistency());
   }
   updateLinkServiceOptions(*face, parameters);
+  if (!linkServiceOptions.empty()) {
+    m_faceSystem.setFaceLinkOptions(*face, linkServiceOptions);
+  }
+  if (linkOptions.ingressWeight) {
+    m_ingressScheduler.setWeight(face->getId(), static_cast<uint32_t>(*linkOptions.ingressWeight));
+  }
 
   // Prepare and send ControlResponse
   response = makeUpdateFaceResponse(*face);
-  done(ControlResponse(200, "OK").setBody(response.wireEncode()));
+  Block body = getLinkOptions(*face, m_ingressScheduler, true).appendTo(response.wireEncode());
+  done(ControlResponse(200, "OK").setBody(body));
 }
 
 void
@@ -398,7 +523,8 @@ FaceManager::listFaces(ndn::mgmt::StatusDatasetContext& context)
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
     ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-    context.append(status.wireEncode());
+    Block wire = getLinkOptions(face, m_ingressScheduler).appendTo(status.wireEncode());
+    context.append(getLinkStatus(face).appendTo(wire));
   }
   context.end();
 }
@@ -476,7 +602,8 @@ FaceManager::queryFaces(const Interest& interest,
   for (const auto& face : m_faceTable) {
     if (matchFilter(faceFilter, face)) {
       ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-      context.append(status.wireEncode());
+      Block wire = getLinkOptions(face, m_ingressScheduler).appendTo(status.wireEncode());
+      context.append(getLinkStatus(face).appendTo(wire));
     }
   }
   context.end();
@@ -29,6 +29,7 @@
 #include "manager-base.hpp"
 #include "face/face.hpp"
 #include "face/face-system.hpp"
+#include "fw/ingress-scheduler.hpp"
 
 namespace nfd {
 
@@ -39,7 +40,7 @@ namespace nfd {
 class FaceManager : public ManagerBase
 {
 public:
-  FaceManager(FaceSystem& faceSystem,
+  FaceManager(FaceSystem& faceSystem, fw::IngressScheduler& ingressScheduler,
               Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
 private: // ControlCommand
@@ -48,7 +49,7 @@ private: // ControlCommand
              const ndn::mgmt::CommandContinuation& done);
 
   void
-  updateFace(const Interest& interest,
+  updateFace(const Name& prefix, const Interest& interest,
              const ControlParameters& parameters,
              const ndn::mgmt::CommandContinuation& done);
 
@@ -82,6 +83,7 @@ private: // NotificationStream
 private:
   FaceSystem& m_faceSystem;
   FaceTable& m_faceTable;
+  fw::IngressScheduler& m_ingressScheduler;
   ndn::mgmt::PostNotification m_postNotification;
   signal::ScopedConnection m_faceAddConn;
   signal::ScopedConnection m_faceRemoveConn;
@@ -25,7 +25,10 @@
 
 #include "forwarder-status-manager.hpp"
 #include "fw/forwarder.hpp"
+#include "core/latency-status.hpp"
+#include "core/send-queue-status.hpp"
 #include "core/version.hpp"
+#include "face/generic-link-service.hpp"
 
 namespace nfd {
 
@@ -38,6 +41,10 @@ ForwarderStatusManager::ForwarderStatusManager(Forwarder& forwarder, Dispatcher&
 {
   m_dispatcher.addStatusDataset("status/general", ndn::mgmt::makeAcceptAllAuthorization(),
                                 bind(&ForwarderStatusManager::listGeneralStatus, this, _1, _2, _3));
+  m_dispatcher.addStatusDataset("status/latency", ndn::mgmt::makeAcceptAllAuthorization(),
+                                bind(&ForwarderStatusManager::listLatencyStatus, this, _1, _2, _3));
+  m_dispatcher.addStatusDataset("status/send-queue", ndn::mgmt::makeAcceptAllAuthorization(),
+                                bind(&ForwarderStatusManager::listSendQueueStatus, this, _1, _2, _3));
 }
 
 ndn::nfd::ForwarderStatus
@@ -80,6 +87,69 @@ ForwarderStatusManager::listGeneralStatus(const Name& topPrefix, const Interest&
   for (const auto& subblock : wire.elements()) {
     context.append(subblock);
   }
+
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+  const fw::FlowCache& flowCache = m_forwarder.getFlowCache();
+  context.append(makeNonNegativeIntegerBlock(tlv::NFlowCacheHits, flowCache.nHits));
+  context.append(makeNonNegativeIntegerBlock(tlv::NFlowCacheMisses, flowCache.nMisses));
+  context.append(makeNonNegativeIntegerBlock(tlv::NFlowCacheInvalidations, flowCache.nInvalidations));
+  context.end();
+}
+
+void
+ForwarderStatusManager::listLatencyStatus(const Name& topPrefix, const Interest& interest,
+                                          ndn::mgmt::StatusDatasetContext& context)
+{
+  context.setExpiry(STATUS_FRESHNESS);
+
+  for (const Face& face : m_forwarder.getFaceTable()) {
+    const face::LatencyStats* stats = face.getTransport()->getLatencyStats();
+    if (stats == nullptr) {
+      continue;
+    }
+
+    FaceLatencyStatus status;
+    status.faceId = face.getId();
+    // RECEIVE is the origin of all latencies, so it is not reported
+    for (size_t i = static_cast<size_t>(TraceStage::INCOMING); i < N_TRACE_STAGES; ++i) {
+      auto stage = static_cast<TraceStage>(i);
+      const DurationHistogram& histogram = stats->get(stage);
+      if (histogram.getCount() == 0) {
+        continue;
+      }
+      status.stages.push_back({stage, histogram.getCount(), histogram.getPercentile(50),
+                               histogram.getPercentile(90), histogram.getPercentile(99)});
+    }
+
+    if (!status.stages.empty()) {
+      context.append(status.wireEncode());
+    }
+  }
+  context.end();
+}
+
+void
+ForwarderStatusManager::listSendQueueStatus(const Name& topPrefix, const Interest& interest,
+                                            ndn::mgmt::StatusDatasetContext& context)
+{
+  context.setExpiry(STATUS_FRESHNESS);
+
+  for (const Face& face : m_forwarder.getFaceTable()) {
+    auto linkService = dynamic_cast<const face::GenericLinkService*>(face.getLinkService());
+    if (linkService == nullptr) {
+      continue;
+    }
+
+    const auto& counters = linkService->getCounters();
+    const auto& weights = linkService->getOptions().txClassWeights;
+    FaceSendQueueStatus status;
+    status.faceId = face.getId();
+    for (size_t i = 0; i < TX_CLASS_COUNT; ++i) {
+      status.classes.push_back({static_cast<TxClass>(i), weights[i],
+                                counters.nClassQueueLength[i], counters.nClassQueueDropped[i]});
+    }
+    context.append(status.wireEncode());
+  }
   context.end();
 }
 
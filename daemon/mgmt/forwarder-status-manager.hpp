@@ -34,6 +34,21 @@ namespace nfd {
 
 class Forwarder;
 
+namespace tlv {
+
+/** \brief TLV-TYPE numbers of NFD-specific fields appended to the general status dataset
+ *
+ *  These numbers are even and greater than 31, so that the fields are non-critical and
+ *  can be ignored by ForwarderStatus decoders that do not recognize them.
+ */
+enum {
+  NFlowCacheHits          = 0xa0,
+  NFlowCacheMisses        = 0xa2,
+  NFlowCacheInvalidations = 0xa4,
+};
+
+} // namespace tlv
+
 /**
  * @brief Implements the Forwarder Status of NFD Management Protocol.
  * @sa https://redmine.named-data.net/projects/nfd/wiki/ForwarderStatus
@@ -53,6 +68,23 @@ private:
   listGeneralStatus(const Name& topPrefix, const Interest& interest,
                     ndn::mgmt::StatusDatasetContext& context);
 
+  /** \brief provide latency status dataset
+   *
+   *  The dataset contains a FaceLatencyStatus for every face on which sampled Interests
+   *  have been received.
+   */
+  void
+  listLatencyStatus(const Name& topPrefix, const Interest& interest,
+                    ndn::mgmt::StatusDatasetContext& context);
+
+  /** \brief provide send queue status dataset
+   *
+   *  The dataset contains a FaceSendQueueStatus for every face that has a GenericLinkService.
+   */
+  void
+  listSendQueueStatus(const Name& topPrefix, const Interest& interest,
+                      ndn::mgmt::StatusDatasetContext& context);
+
 private:
   Forwarder& m_forwarder;
   Dispatcher& m_dispatcher;
@@ -29,6 +29,8 @@
 namespace nfd {
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const size_t TablesConfigSection::DEFAULT_FLOW_CACHE_MAX_ENTRIES = 0;
+const size_t TablesConfigSection::DEFAULT_INGRESS_BATCH_SIZE = 0;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -53,6 +55,8 @@ TablesConfigSection::ensureConfigured()
   m_forwarder.getCs().setLimit(DEFAULT_CS_MAX_PACKETS);
   // Don't set default cs_policy because it's already created by CS itself.
   m_forwarder.setUnsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>());
+  m_forwarder.getFlowCache().setLimit(DEFAULT_FLOW_CACHE_MAX_ENTRIES);
+  setIngressBatchSize(DEFAULT_INGRESS_BATCH_SIZE);
 
   m_isConfigured = true;
 }
@@ -89,6 +93,20 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  size_t nFlowCacheMaxEntries = DEFAULT_FLOW_CACHE_MAX_ENTRIES;
+  OptionalConfigSection flowCacheMaxEntriesNode = section.get_child_optional("flow_cache_max_entries");
+  if (flowCacheMaxEntriesNode) {
+    nFlowCacheMaxEntries = ConfigFile::parseNumber<size_t>(*flowCacheMaxEntriesNode,
+                                                           "flow_cache_max_entries", "tables");
+  }
+
+  size_t nIngressBatchSize = DEFAULT_INGRESS_BATCH_SIZE;
+  OptionalConfigSection ingressBatchSizeNode = section.get_child_optional("ingress_batch_size");
+  if (ingressBatchSizeNode) {
+    nIngressBatchSize = ConfigFile::parseNumber<size_t>(*ingressBatchSizeNode,
+                                                        "ingress_batch_size", "tables");
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -110,10 +128,21 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
   }
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
+  m_forwarder.getFlowCache().setLimit(nFlowCacheMaxEntries);
+  setIngressBatchSize(nIngressBatchSize);
 
   m_isConfigured = true;
 }
 
+void
+TablesConfigSection::setIngressBatchSize(size_t batchSize)
+{
+  auto& ingressScheduler = m_forwarder.getIngressScheduler();
+  auto options = ingressScheduler.getOptions();
+  options.batchSize = batchSize;
+  ingressScheduler.setOptions(options);
+}
+
 void
 TablesConfigSection::processStrategyChoiceSection(const ConfigSection& section, bool isDryRun)
 {
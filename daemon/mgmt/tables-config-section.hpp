@@ -40,6 +40,8 @@ namespace nfd {
  *    cs_max_packets 65536
  *    cs_policy lru
  *    cs_unsolicited_policy drop-all
+ *    flow_cache_max_entries 0
+ *    ingress_batch_size 0
  *
  *    strategy_choice
  *    {
@@ -58,8 +60,8 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets, cs_policy, and cs_unsolicited_policy are applied;
- *      defaults are used if an option is omitted.
+ *  \li cs_max_packets, cs_policy, cs_unsolicited_policy, flow_cache_max_entries, and
+ *      ingress_batch_size are applied; defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
  *
@@ -91,8 +93,13 @@ private:
   void
   processNetworkRegionSection(const ConfigSection& section, bool isDryRun);
 
+  void
+  setIngressBatchSize(size_t batchSize);
+
 private:
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const size_t DEFAULT_FLOW_CACHE_MAX_ENTRIES;
+  static const size_t DEFAULT_INGRESS_BATCH_SIZE;
 
   Forwarder& m_forwarder;
 
@@ -139,7 +139,8 @@ Nfd::initializeManagement()
   m_authenticator = CommandAuthenticator::create();
 
   m_forwarderStatusManager = make_unique<ForwarderStatusManager>(*m_forwarder, *m_dispatcher);
-  m_faceManager = make_unique<FaceManager>(*m_faceSystem, *m_dispatcher, *m_authenticator);
+  m_faceManager = make_unique<FaceManager>(*m_faceSystem, m_forwarder->getIngressScheduler(),
+                                           *m_dispatcher, *m_authenticator);
   m_fibManager = make_unique<FibManager>(m_forwarder->getFib(), *m_faceTable,
                                          *m_dispatcher, *m_authenticator);
   m_csManager = make_unique<CsManager>(m_forwarder->getCs(), m_forwarder->getCounters(),
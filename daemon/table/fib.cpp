@@ -97,6 +97,11 @@ Fib::insert(const Name& prefix)
 
   nte.setFibEntry(make_unique<Entry>(prefix));
   ++m_nItems;
+  ++m_generation;
+  if (m_nEntriesAtDepth.size() <= prefix.size()) {
+    m_nEntriesAtDepth.resize(prefix.size() + 1);
+  }
+  ++m_nEntriesAtDepth[prefix.size()];
   return {nte.getFibEntry(), true};
 }
 
@@ -105,11 +110,17 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 {
   BOOST_ASSERT(nte != nullptr);
 
+  --m_nEntriesAtDepth.at(nte->getName().size());
+  while (!m_nEntriesAtDepth.empty() && m_nEntriesAtDepth.back() == 0) {
+    m_nEntriesAtDepth.pop_back();
+  }
+
   nte->setFibEntry(nullptr);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
   }
   --m_nItems;
+  ++m_generation;
 }
 
 void
@@ -138,6 +149,7 @@ Fib::addOrUpdateNextHop(Entry& entry, Face& face, uint64_t cost)
   NextHopList::iterator it;
   bool isNew;
   std::tie(it, isNew) = entry.addOrUpdateNextHop(face, cost);
+  ++m_generation;
 
   if (isNew)
     this->afterNewNextHop(entry.getPrefix(), *it);
@@ -151,7 +163,9 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   if (!isRemoved) {
     return RemoveNextHopResult::NO_SUCH_NEXTHOP;
   }
-  else if (!entry.hasNextHops()) {
+
+  ++m_generation;
+  if (!entry.hasNextHops()) {
     name_tree::Entry* nte = m_nameTree.getEntry(entry);
     this->erase(nte, false);
     return RemoveNextHopResult::FIB_ENTRY_REMOVED;
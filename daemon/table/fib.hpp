@@ -56,6 +56,24 @@ public:
     return m_nItems;
   }
 
+  /** \brief Returns a counter that is incremented on every change to FIB entries or nexthops
+   *
+   *  Results of earlier lookups may be reused as long as the generation has not changed.
+   */
+  uint64_t
+  getGeneration() const
+  {
+    return m_generation;
+  }
+
+  /** \brief Returns the number of components in the deepest FIB entry prefix
+   */
+  size_t
+  getMaxEntryDepth() const
+  {
+    return m_nEntriesAtDepth.empty() ? 0 : m_nEntriesAtDepth.size() - 1;
+  }
+
 public: // lookup
   /** \brief Performs a longest prefix match
    */
@@ -166,6 +184,9 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  uint64_t m_generation = 0;
+  /// number of entries indexed by prefix length; the last element is never zero
+  std::vector<size_t> m_nEntriesAtDepth;
 
   /** \brief The empty FIB entry.
    *
@@ -231,6 +231,13 @@ public:
    */
   time::milliseconds dataFreshnessPeriod = 0_ms;
 
+  /** \brief Retransmission suppression interval of this PIT entry
+   *
+   *  This is maintained by fw::RetxSuppressionExponential, and is stored inline so that
+   *  suppression decisions do not allocate. Zero means the initial interval is in effect.
+   */
+  time::microseconds retxSuppressionInterval = 0_us;
+
 private:
   shared_ptr<const Interest> m_interest;
   InRecordCollection m_inRecords;
@@ -71,6 +71,14 @@ public:
     m_incomingNack.reset();
   }
 
+public:
+  /** \brief Retransmission suppression interval toward \p getFace()
+   *
+   *  This is maintained by fw::RetxSuppressionExponential.
+   *  Zero means the initial interval is in effect.
+   */
+  time::microseconds retxSuppressionInterval = 0_us;
+
 private:
   unique_ptr<lp::NackHeader> m_incomingNack;
 };
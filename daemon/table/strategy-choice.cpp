@@ -65,6 +65,7 @@ StrategyChoice::setDefaultStrategy(const Name& strategyName)
   name_tree::Entry& nte = m_nameTree.lookup(Name());
   nte.setStrategyChoiceEntry(std::move(entry));
   ++m_nItems;
+  ++m_generation;
 }
 
 StrategyChoice::InsertResult
@@ -106,11 +107,16 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
     entry = newEntry.get();
     nte.setStrategyChoiceEntry(std::move(newEntry));
     ++m_nItems;
+    if (m_nEntriesAtDepth.size() <= prefix.size()) {
+      m_nEntriesAtDepth.resize(prefix.size() + 1);
+    }
+    ++m_nEntriesAtDepth[prefix.size()];
     NFD_LOG_TRACE("insert(" << prefix << ") new entry " << strategy->getInstanceName());
   }
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(std::move(strategy));
+  ++m_generation;
   return InsertResult::OK;
 }
 
@@ -157,9 +163,15 @@ StrategyChoice::erase(const Name& prefix)
   Strategy& parentStrategy = this->findEffectiveStrategy(prefix.getPrefix(-1));
   this->changeStrategy(*entry, oldStrategy, parentStrategy);
 
+  --m_nEntriesAtDepth.at(prefix.size());
+  while (!m_nEntriesAtDepth.empty() && m_nEntriesAtDepth.back() == 0) {
+    m_nEntriesAtDepth.pop_back();
+  }
+
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  ++m_generation;
 }
 
 std::pair<bool, Name>
@@ -212,11 +224,13 @@ clearStrategyInfo(const name_tree::Entry& nte)
 
   for (const auto& pitEntry : nte.getPitEntries()) {
     pitEntry->clearStrategyInfo();
+    pitEntry->retxSuppressionInterval = 0_us;
     for (const auto& inRecord : pitEntry->getInRecords()) {
       const_cast<pit::InRecord&>(inRecord).clearStrategyInfo();
     }
     for (const auto& outRecord : pitEntry->getOutRecords()) {
       const_cast<pit::OutRecord&>(outRecord).clearStrategyInfo();
+      const_cast<pit::OutRecord&>(outRecord).retxSuppressionInterval = 0_us;
     }
   }
   if (nte.getMeasurementsEntry() != nullptr) {
@@ -60,6 +60,25 @@ public:
     return m_nItems;
   }
 
+  /** \brief Returns a counter that is incremented on every change to the Strategy Choice table
+   *
+   *  Results of earlier effective strategy lookups may be reused as long as the generation
+   *  has not changed.
+   */
+  uint64_t
+  getGeneration() const
+  {
+    return m_generation;
+  }
+
+  /** \brief Returns the number of components in the deepest entry prefix
+   */
+  size_t
+  getMaxEntryDepth() const
+  {
+    return m_nEntriesAtDepth.empty() ? 0 : m_nEntriesAtDepth.size() - 1;
+  }
+
   /** \brief Set the default strategy
    *
    *  This must be called by forwarder constructor.
@@ -194,6 +213,9 @@ private:
   Forwarder& m_forwarder;
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  uint64_t m_generation = 0;
+  /// number of entries indexed by prefix length; the last element is never zero
+  std::vector<size_t> m_nEntriesAtDepth;
 };
 
 std::ostream&
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/face-link-options.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestFaceLinkOptions)
+
+BOOST_AUTO_TEST_CASE(AppendDecode)
+{
+  ndn::nfd::ControlParameters params;
+  params.setFaceId(262)
+        .setMtu(1400);
+
+  FaceLinkOptions limits1;
+  BOOST_CHECK(limits1.empty());
+  limits1.interestRate = 100;
+  limits1.dataRate = 2000000;
+  limits1.dataBurst = 0;
+  limits1.wantPacking = false;
+  BOOST_CHECK(!limits1.empty());
+  BOOST_CHECK(limits1.hasRateLimits());
+
+  Block wire = limits1.appendTo(params.wireEncode());
+  BOOST_CHECK_EQUAL(wire.type(), params.wireEncode().type());
+  BOOST_CHECK_EQUAL(wire.elements_size(), params.wireEncode().elements_size() + 4);
+
+  // the fields are ignored by the ControlParameters decoder
+  ndn::nfd::ControlParameters params2(wire);
+  BOOST_CHECK_EQUAL(params2.getFaceId(), 262);
+  BOOST_CHECK_EQUAL(params2.getMtu(), 1400);
+
+  FaceLinkOptions limits2(wire);
+  BOOST_CHECK_EQUAL(limits2.interestRate.value_or(0), 100);
+  BOOST_CHECK(!limits2.interestBurst);
+  BOOST_CHECK_EQUAL(limits2.dataRate.value_or(0), 2000000);
+  BOOST_CHECK_EQUAL(limits2.dataBurst.value_or(1), 0);
+  BOOST_CHECK_EQUAL(limits2.wantPacking.value_or(true), false);
+
+  FaceLinkOptions packing1;
+  packing1.wantPacking = true;
+  BOOST_CHECK(!packing1.empty());
+  BOOST_CHECK(!packing1.hasRateLimits());
+  FaceLinkOptions packing2(packing1.appendTo(params.wireEncode()));
+  BOOST_CHECK_EQUAL(packing2.wantPacking.value_or(false), true);
+  BOOST_CHECK(!packing2.hasRateLimits());
+
+  FaceLinkOptions target1;
+  target1.sendQueueTarget = 500_us;
+  BOOST_CHECK(!target1.empty());
+  FaceLinkOptions target2(target1.appendTo(params.wireEncode()));
+  BOOST_CHECK_EQUAL(target2.sendQueueTarget.value_or(0_ns), 500_us);
+  BOOST_CHECK(!target2.wantPacking);
+
+  FaceLinkOptions weights1;
+  weights1.dataWeight = 4;
+  weights1.nackWeight = 2;
+  BOOST_CHECK(!weights1.empty());
+  BOOST_CHECK(weights1.hasWeights());
+  BOOST_CHECK(!weights1.hasRateLimits());
+  FaceLinkOptions weights2(weights1.appendTo(params.wireEncode()));
+  BOOST_CHECK(!weights2.interestWeight);
+  BOOST_CHECK_EQUAL(weights2.dataWeight.value_or(0), 4);
+  BOOST_CHECK_EQUAL(weights2.nackWeight.value_or(0), 2);
+  BOOST_CHECK(!limits2.hasWeights());
+
+  FaceLinkOptions ingress1;
+  ingress1.ingressWeight = 8;
+  BOOST_CHECK(!ingress1.empty());
+  BOOST_CHECK(!ingress1.hasWeights());
+  FaceLinkOptions ingress2(ingress1.appendTo(params.wireEncode()));
+  BOOST_CHECK_EQUAL(ingress2.ingressWeight.value_or(0), 8);
+  BOOST_CHECK(!weights2.ingressWeight);
+
+  // nothing is appended when no field is present
+  Block wire2 = FaceLinkOptions().appendTo(params.wireEncode());
+  BOOST_CHECK_EQUAL(wire2, params.wireEncode());
+  BOOST_CHECK(FaceLinkOptions(wire2).empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeError)
+{
+  // a field whose TLV-LENGTH is invalid for a NonNegativeInteger
+  Block wire(ndn::tlv::nfd::ControlParameters);
+  wire.push_back(ndn::encoding::makeStringBlock(tlv::DataRateLimit, "bad"));
+  wire.encode();
+  BOOST_CHECK_THROW(FaceLinkOptions{wire}, tlv::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceLinkOptions
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/face-link-status.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/mgmt/nfd/face-status.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestFaceLinkStatus)
+
+BOOST_AUTO_TEST_CASE(AppendDecode)
+{
+  ndn::nfd::FaceStatus status;
+  status.setFaceId(262)
+        .setRemoteUri("udp4://192.0.2.1:6363")
+        .setLocalUri("udp4://192.0.2.2:6363");
+
+  FaceLinkStatus linkStatus1;
+  BOOST_CHECK(linkStatus1.empty());
+  linkStatus1.sojournP50 = 64_us;
+  linkStatus1.sojournP90 = 1024_us;
+  linkStatus1.sojournP99 = 8192_us;
+  BOOST_CHECK(!linkStatus1.empty());
+
+  Block wire = linkStatus1.appendTo(status.wireEncode());
+  BOOST_CHECK_EQUAL(wire.elements_size(), status.wireEncode().elements_size() + 3);
+
+  // the fields are ignored by the FaceStatus decoder
+  ndn::nfd::FaceStatus status2(wire);
+  BOOST_CHECK_EQUAL(status2.getFaceId(), 262);
+
+  FaceLinkStatus linkStatus2(wire);
+  BOOST_CHECK_EQUAL(linkStatus2.sojournP50.value_or(0_ns), 64_us);
+  BOOST_CHECK_EQUAL(linkStatus2.sojournP90.value_or(0_ns), 1024_us);
+  BOOST_CHECK_EQUAL(linkStatus2.sojournP99.value_or(0_ns), 8192_us);
+
+  // nothing is appended when no field is present
+  Block wire2 = FaceLinkStatus().appendTo(status.wireEncode());
+  BOOST_CHECK_EQUAL(wire2, status.wireEncode());
+  BOOST_CHECK(FaceLinkStatus(wire2).empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeError)
+{
+  // a field whose TLV-LENGTH is invalid for a NonNegativeInteger
+  Block wire(ndn::tlv::nfd::FaceStatus);
+  wire.push_back(ndn::encoding::makeStringBlock(tlv::SendQueueSojournP90, "bad"));
+  wire.encode();
+  BOOST_CHECK_THROW(FaceLinkStatus{wire}, tlv::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceLinkStatus
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/latency-status.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestLatencyStatus)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  FaceLatencyStatus status1;
+  status1.faceId = 262;
+  status1.stages.push_back({TraceStage::INCOMING, 10, 1_us, 2_us, 4_us});
+  status1.stages.push_back({TraceStage::TRANSMIT, 8, 64_us, 128_us, 1024_us});
+
+  Block wire = status1.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), tlv::FaceLatency);
+
+  FaceLatencyStatus status2(wire);
+  BOOST_CHECK_EQUAL(status2.faceId, 262);
+  BOOST_REQUIRE_EQUAL(status2.stages.size(), 2);
+  BOOST_CHECK_EQUAL(status2.stages[0].stage, TraceStage::INCOMING);
+  BOOST_CHECK_EQUAL(status2.stages[0].nSamples, 10);
+  BOOST_CHECK_EQUAL(status2.stages[0].p50, 1_us);
+  BOOST_CHECK_EQUAL(status2.stages[0].p90, 2_us);
+  BOOST_CHECK_EQUAL(status2.stages[0].p99, 4_us);
+  BOOST_CHECK_EQUAL(status2.stages[1].stage, TraceStage::TRANSMIT);
+  BOOST_CHECK_EQUAL(status2.stages[1].nSamples, 8);
+  BOOST_CHECK_EQUAL(status2.stages[1].p50, 64_us);
+  BOOST_CHECK_EQUAL(status2.stages[1].p90, 128_us);
+  BOOST_CHECK_EQUAL(status2.stages[1].p99, 1024_us);
+
+  FaceLatencyStatus status3;
+  status3.faceId = 1;
+  FaceLatencyStatus status4(status3.wireEncode());
+  BOOST_CHECK_EQUAL(status4.faceId, 1);
+  BOOST_CHECK(status4.stages.empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeError)
+{
+  using ndn::encoding::makeEmptyBlock;
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+
+  // wrong TLV-TYPE
+  BOOST_CHECK_THROW(FaceLatencyStatus{makeEmptyBlock(tlv::StageLatency)}, FaceLatencyStatus::Error);
+
+  // missing FaceId
+  BOOST_CHECK_THROW(FaceLatencyStatus{makeEmptyBlock(tlv::FaceLatency)}, FaceLatencyStatus::Error);
+
+  // unknown stage
+  Block stage(tlv::StageLatency);
+  stage.push_back(makeNonNegativeIntegerBlock(tlv::LatencyStage, N_TRACE_STAGES));
+  stage.push_back(makeNonNegativeIntegerBlock(tlv::NSamples, 1));
+  stage.push_back(makeNonNegativeIntegerBlock(tlv::Latency50, 1000));
+  stage.push_back(makeNonNegativeIntegerBlock(tlv::Latency90, 1000));
+  stage.push_back(makeNonNegativeIntegerBlock(tlv::Latency99, 1000));
+  stage.encode();
+  Block wire(tlv::FaceLatency);
+  wire.push_back(makeNonNegativeIntegerBlock(ndn::tlv::nfd::FaceId, 1));
+  wire.push_back(stage);
+  wire.encode();
+  BOOST_CHECK_THROW(FaceLatencyStatus{wire}, FaceLatencyStatus::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PrintStage)
+{
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(TraceStage::RECEIVE), "receive");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(TraceStage::CS_LOOKUP), "cs-lookup");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(TraceStage::TRANSMIT), "transmit");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLatencyStatus
+
+} // namespace tests
+} // namespace nfd
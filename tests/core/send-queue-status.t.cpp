@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/send-queue-status.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestSendQueueStatus)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  FaceSendQueueStatus status1;
+  status1.faceId = 262;
+  status1.classes.push_back({TxClass::PRIORITY, 0, 1, 0});
+  status1.classes.push_back({TxClass::DATA, 4, 120, 37});
+
+  Block wire = status1.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), tlv::FaceSendQueue);
+
+  FaceSendQueueStatus status2(wire);
+  BOOST_CHECK_EQUAL(status2.faceId, 262);
+  BOOST_REQUIRE_EQUAL(status2.classes.size(), 2);
+  BOOST_CHECK_EQUAL(status2.classes[0].txClass, TxClass::PRIORITY);
+  BOOST_CHECK_EQUAL(status2.classes[0].weight, 0);
+  BOOST_CHECK_EQUAL(status2.classes[0].queueLength, 1);
+  BOOST_CHECK_EQUAL(status2.classes[0].nDropped, 0);
+  BOOST_CHECK_EQUAL(status2.classes[1].txClass, TxClass::DATA);
+  BOOST_CHECK_EQUAL(status2.classes[1].weight, 4);
+  BOOST_CHECK_EQUAL(status2.classes[1].queueLength, 120);
+  BOOST_CHECK_EQUAL(status2.classes[1].nDropped, 37);
+
+  FaceSendQueueStatus status3;
+  status3.faceId = 1;
+  FaceSendQueueStatus status4(status3.wireEncode());
+  BOOST_CHECK_EQUAL(status4.faceId, 1);
+  BOOST_CHECK(status4.classes.empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeError)
+{
+  using ndn::encoding::makeEmptyBlock;
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+
+  // wrong TLV-TYPE
+  BOOST_CHECK_THROW(FaceSendQueueStatus{makeEmptyBlock(tlv::ClassQueue)}, FaceSendQueueStatus::Error);
+
+  // missing FaceId
+  BOOST_CHECK_THROW(FaceSendQueueStatus{makeEmptyBlock(tlv::FaceSendQueue)},
+                    FaceSendQueueStatus::Error);
+
+  // unknown traffic class
+  Block cls(tlv::ClassQueue);
+  cls.push_back(makeNonNegativeIntegerBlock(tlv::TrafficClass, TX_CLASS_COUNT));
+  cls.push_back(makeNonNegativeIntegerBlock(tlv::ClassWeight, 1));
+  cls.push_back(makeNonNegativeIntegerBlock(tlv::QueueLength, 0));
+  cls.push_back(makeNonNegativeIntegerBlock(tlv::NQueueDropped, 0));
+  cls.encode();
+  Block wire(tlv::FaceSendQueue);
+  wire.push_back(makeNonNegativeIntegerBlock(ndn::tlv::nfd::FaceId, 1));
+  wire.push_back(cls);
+  wire.encode();
+  BOOST_CHECK_THROW(FaceSendQueueStatus{wire}, FaceSendQueueStatus::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PrintTxClass)
+{
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(TxClass::PRIORITY), "priority");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(TxClass::INTEREST), "interest");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(TxClass::NACK), "nack");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSendQueueStatus
+
+} // namespace tests
+} // namespace nfd
@@ -87,6 +87,29 @@ BOOST_AUTO_TEST_CASE(SizeCnt)
   BOOST_CHECK_EQUAL(counter2, 98);
 }
 
+BOOST_AUTO_TEST_CASE(DurationHist)
+{
+  DurationHistogram hist;
+  BOOST_CHECK_EQUAL(hist.getCount(), 0);
+  BOOST_CHECK_EQUAL(hist.getPercentile(50), 0_ns);
+
+  hist.add(500_ns); // bucket 0: [0, 1us)
+  for (int i = 0; i < 8; ++i) {
+    hist.add(3_ms); // bucket 12: [2048us, 4096us)
+  }
+  hist.add(1000_s); // last bucket
+  BOOST_CHECK_EQUAL(hist.getCount(), 10);
+
+  BOOST_CHECK_EQUAL(hist.getPercentile(0), 1_us);
+  BOOST_CHECK_EQUAL(hist.getPercentile(10), 1_us);
+  BOOST_CHECK_EQUAL(hist.getPercentile(11), 4096_us);
+  BOOST_CHECK_EQUAL(hist.getPercentile(50), 4096_us);
+  BOOST_CHECK_EQUAL(hist.getPercentile(90), 4096_us);
+  const time::microseconds lastBucketBound(1 << (DurationHistogram::N_BUCKETS - 2));
+  BOOST_CHECK_EQUAL(hist.getPercentile(99), lastBucketBound);
+  BOOST_CHECK_EQUAL(hist.getPercentile(100), lastBucketBound);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCounter
 
 } // namespace tests
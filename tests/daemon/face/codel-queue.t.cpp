@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/codel-queue.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+class CodelQueueFixture
+{
+protected:
+  /** \brief enqueue \p n packets of 100 octets at \p t, identified by consecutive Sequence numbers
+   */
+  void
+  enqueue(size_t n, time::steady_clock::TimePoint t)
+  {
+    for (size_t i = 0; i < n; ++i) {
+      lp::Packet pkt;
+      pkt.set<lp::SequenceField>(++m_lastSeq);
+      BOOST_REQUIRE(queue.enqueue(std::move(pkt), 100, t));
+    }
+  }
+
+  static lp::Sequence
+  getSeq(const CodelQueue::DequeueResult& res)
+  {
+    BOOST_REQUIRE(res.item);
+    return res.item->packet.get<lp::SequenceField>();
+  }
+
+protected:
+  CodelQueue queue;
+  const time::steady_clock::TimePoint t0 = time::steady_clock::TimePoint(1_s);
+
+private:
+  lp::Sequence m_lastSeq = 0;
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestCodelQueue, CodelQueueFixture)
+
+BOOST_AUTO_TEST_CASE(Fifo)
+{
+  CodelQueue::Options options;
+  options.capacity = 3;
+  queue.setOptions(options);
+
+  BOOST_CHECK(queue.empty());
+  enqueue(3, t0);
+  BOOST_CHECK_EQUAL(queue.size(), 3);
+  BOOST_CHECK_EQUAL(queue.getNBytes(), 300);
+  BOOST_CHECK_EQUAL(queue.enqueue(lp::Packet(), 100, t0), false);
+  BOOST_CHECK_EQUAL(queue.size(), 3);
+
+  for (lp::Sequence seq = 1; seq <= 3; ++seq) {
+    auto res = queue.dequeue(t0 + 1_ms);
+    BOOST_CHECK_EQUAL(getSeq(res), seq);
+    BOOST_CHECK_EQUAL(res.item->enqueueTime, t0);
+    BOOST_CHECK_EQUAL(res.isMarked, false);
+    BOOST_CHECK_EQUAL(res.nDropped, 0);
+  }
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK_EQUAL(queue.getNBytes(), 0);
+  BOOST_CHECK(!queue.dequeue(t0 + 1_ms).item);
+}
+
+BOOST_AUTO_TEST_CASE(BelowTarget)
+{
+  // a standing queue with sojourn time below the target is not congested
+  for (int i = 0; i < 4; ++i) {
+    enqueue(1, t0 + i * 1_ms);
+  }
+  for (int i = 4; i <= 500; ++i) {
+    auto now = t0 + i * 1_ms;
+    enqueue(1, now);
+    auto res = queue.dequeue(now);
+    BOOST_CHECK_EQUAL(res.isMarked, false);
+    BOOST_CHECK_EQUAL(res.nDropped, 0);
+  }
+  BOOST_CHECK_EQUAL(queue.isDropping(), false);
+}
+
+BOOST_AUTO_TEST_CASE(SinglePacket)
+{
+  // a queue holding no more than one packet is not congested, however long the sojourn time
+  for (int i = 1; i <= 10; ++i) {
+    enqueue(1, t0 + (i - 1) * 200_ms);
+    auto res = queue.dequeue(t0 + i * 200_ms);
+    BOOST_CHECK_EQUAL(res.isMarked, false);
+    BOOST_CHECK_EQUAL(res.nDropped, 0);
+  }
+  BOOST_CHECK_EQUAL(queue.isDropping(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Mark)
+{
+  // packet i leaves the queue at t0 + 10*i ms
+  enqueue(40, t0);
+  std::vector<lp::Sequence> marked;
+  for (int i = 1; i <= 40; ++i) {
+    auto res = queue.dequeue(t0 + i * 10_ms);
+    BOOST_CHECK_EQUAL(res.nDropped, 0);
+    if (res.isMarked) {
+      marked.push_back(getSeq(res));
+    }
+    // sojourn time is above target since packet 1, so the dropping state starts one interval later
+    BOOST_CHECK_EQUAL(queue.isDropping(), i >= 11 && i < 39);
+  }
+
+  // marks at 110 ms, 210 ms, 210+100/sqrt(2)=280.7 ms, 280.7+100/sqrt(3)=338.4 ms
+  std::vector<lp::Sequence> expectedMarked{11, 21, 29, 34};
+  BOOST_CHECK_EQUAL_COLLECTIONS(marked.begin(), marked.end(),
+                                expectedMarked.begin(), expectedMarked.end());
+}
+
+BOOST_AUTO_TEST_CASE(Drop)
+{
+  CodelQueue::Options options;
+  options.useMarking = false;
+  queue.setOptions(options);
+
+  enqueue(20, t0);
+  for (int i = 1; i <= 10; ++i) {
+    BOOST_CHECK_EQUAL(getSeq(queue.dequeue(t0 + i * 10_ms)), i);
+  }
+
+  // packet 11 is dropped, and packet 12 is returned in its place
+  auto res = queue.dequeue(t0 + 110_ms);
+  BOOST_CHECK_EQUAL(res.nDropped, 1);
+  BOOST_CHECK_EQUAL(res.isMarked, false);
+  BOOST_CHECK_EQUAL(getSeq(res), 12);
+  BOOST_CHECK_EQUAL(queue.isDropping(), true);
+
+  // when the control law is behind, several packets are dropped at once:
+  // at 210 ms, 280.7 ms, 338.4 ms, and 388.4 ms
+  res = queue.dequeue(t0 + 400_ms);
+  BOOST_CHECK_EQUAL(res.nDropped, 4);
+  BOOST_CHECK_EQUAL(getSeq(res), 17);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCodelQueue
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
@@ -85,6 +85,40 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, DatagramTransportFixtures, T)
   BOOST_CHECK(this->receivedPackets->at(0).endpoint == this->receivedPackets->at(1).endpoint);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveBufferPool, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // one buffer has been acquired for the pending receive operation
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferPoolMisses, 1);
+
+  // received packets share their buffers, which cannot be reused while the packets are retained
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  this->remoteWrite(ndn::Buffer(pkt1.begin(), pkt1.end()));
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world!");
+  this->remoteWrite(ndn::Buffer(pkt2.begin(), pkt2.end()));
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 2);
+  BOOST_CHECK(this->receivedPackets->at(0).packet == pkt1);
+  BOOST_CHECK(this->receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK_EQUAL(this->receivedPackets->at(0).packet.getBuffer()->size(),
+                    ndn::MAX_NDN_PACKET_SIZE);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferPoolHits, 0);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferPoolMisses, 3);
+
+  // buffers return to the pool after the packets are released
+  this->receivedPackets->clear();
+  auto pkt3 = ndn::encoding::makeStringBlock(302, "again");
+  this->remoteWrite(ndn::Buffer(pkt3.begin(), pkt3.end()));
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 1);
+  BOOST_CHECK(this->receivedPackets->at(0).packet == pkt3);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferPoolHits, 1);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferPoolMisses, 3);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferPoolHighWaterMark, 3);
+
+  // nothing is copied while the pool has idle buffers
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytesCopied, 0);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveIncomplete, T, DatagramTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -97,10 +131,11 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveIncomplete, T, DatagramTransportFixtures
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
-BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTrailingGarbage, T, DatagramTransportFixtures, T)
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceivePacked, T, DatagramTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
 
+  // a datagram may contain several packets, which are delivered separately
   auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
   auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
   ndn::Buffer buf(pkt1.size() + pkt2.size());
@@ -109,6 +144,24 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTrailingGarbage, T, DatagramTransportFix
 
   this->remoteWrite(buf);
 
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 2);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytes, buf.size());
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 2);
+  BOOST_CHECK(this->receivedPackets->at(0).packet == pkt1);
+  BOOST_CHECK(this->receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTrailingGarbage, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  ndn::Buffer buf(pkt1.begin(), pkt1.end());
+  buf.insert(buf.end(), {0x05, 0x03, 0x00, 0x01});
+
+  this->remoteWrite(buf);
+
   BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 0);
   BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytes, 0);
   BOOST_CHECK_EQUAL(this->receivedPackets->size(), 0);
@@ -163,6 +216,87 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Close, T, DatagramTransportFixtures, T)
   BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
 }
 
+#ifdef __linux__
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(BatchedSend, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  this->transport->setBatchSize(8);
+  BOOST_CHECK_EQUAL(this->transport->getBatchSize(), 8);
+
+  std::vector<Block> blocks;
+  for (uint32_t type = 300; type < 303; ++type) {
+    blocks.push_back(ndn::encoding::makeStringBlock(type, "hello"));
+    this->transport->send(blocks.back());
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, 3);
+
+  for (const auto& block : blocks) {
+    std::vector<uint8_t> readBuf(block.size());
+    this->remoteRead(readBuf);
+    BOOST_CHECK_EQUAL_COLLECTIONS(readBuf.begin(), readBuf.end(), block.begin(), block.end());
+  }
+
+  // all three packets were queued in the same io_service turn and sent with one sendmmsg
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutBatches[getBatchSizeBucket(3)], 1);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(BatchedReceive, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  this->transport->setBatchSize(8);
+
+  // the receive operation started by the constructor is not batched
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  this->remoteWrite(ndn::Buffer(pkt1.begin(), pkt1.end()));
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 1);
+
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world!");
+  this->remoteWrite(ndn::Buffer(pkt2.begin(), pkt2.end()));
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 2);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytes, pkt1.size() + pkt2.size());
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBatches[0], 1);
+  // receive slots are filled as batches need them, rather than all eight at once
+  BOOST_CHECK_LE(this->transport->getCounters().nInBufferPoolMisses, 2);
+
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 2);
+  BOOST_CHECK(this->receivedPackets->at(0).packet == pkt1);
+  BOOST_CHECK(this->receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK(this->receivedPackets->at(0).endpoint == this->receivedPackets->at(1).endpoint);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SegmentationOffloadSend, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  this->transport->setSegmentationOffload(true);
+  if (!this->transport->isGsoEnabled()) {
+    BOOST_TEST_MESSAGE("UDP GSO is not supported by the kernel, using regular sends");
+  }
+
+  // three packets of the same size followed by a shorter one form a single GSO send
+  std::vector<Block> blocks{ndn::encoding::makeStringBlock(300, "hello"),
+                            ndn::encoding::makeStringBlock(301, "world"),
+                            ndn::encoding::makeStringBlock(302, "again"),
+                            ndn::encoding::makeStringBlock(303, "end")};
+  for (const auto& block : blocks) {
+    this->transport->send(block);
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, 4);
+
+  // the receiver gets every packet as a separate datagram
+  for (const auto& block : blocks) {
+    std::vector<uint8_t> readBuf(block.size());
+    this->remoteRead(readBuf);
+    BOOST_CHECK_EQUAL_COLLECTIONS(readBuf.begin(), readBuf.end(), block.begin(), block.end());
+  }
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+#endif // __linux__
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendQueueLength, T, DatagramTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
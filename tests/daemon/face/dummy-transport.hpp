@@ -65,6 +65,7 @@ public:
   ssize_t
   getSendQueueLength() override
   {
+    ++nSendQueueLengthQueries;
     return m_sendQueueLength;
   }
 
@@ -98,12 +99,21 @@ private:
   doSend(const Block& packet) override
   {
     sentPackets.push_back(packet);
+    if (afterSend) {
+      afterSend(packet);
+    }
   }
 
 public:
   std::vector<ndn::nfd::FacePersistency> persistencyHistory;
   std::vector<Block> sentPackets;
 
+  /** \brief if set, invoked after each packet is sent, e.g., to simulate a filling send queue
+   */
+  std::function<void(const Block&)> afterSend;
+
+  size_t nSendQueueLengthQueries = 0;
+
 private:
   ssize_t m_sendQueueLength = 0;
 };
@@ -24,6 +24,7 @@
  */
 
 #include "face/ethernet-factory.hpp"
+#include "face/generic-link-service.hpp"
 
 #include "ethernet-fixture.hpp"
 #include "face-system-fixture.hpp"
@@ -216,6 +217,111 @@ BOOST_AUTO_TEST_CASE(McastAdHoc)
   BOOST_CHECK_EQUAL(this->countEtherMcastFaces(ndn::nfd::LINK_TYPE_AD_HOC), netifs.size());
 }
 
+BOOST_AUTO_TEST_CASE(CongestionMarking)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+
+  auto isMarking = [] (const Face* face) {
+    auto linkService = dynamic_cast<const GenericLinkService*>(face->getLinkService());
+    BOOST_REQUIRE(linkService != nullptr);
+    return linkService->getOptions().allowCongestionMarking;
+  };
+
+  const std::string CONFIG_WITHOUT_MARKING = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        enable_congestion_marking no
+      }
+      ether
+      {
+        listen no
+        mcast yes
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG_WITHOUT_MARKING, false);
+  auto faces = this->listEtherMcastFaces();
+  BOOST_REQUIRE_EQUAL(faces.size(), netifs.size());
+  BOOST_CHECK(std::none_of(faces.begin(), faces.end(), isMarking));
+
+  // the setting applies to faces created afterwards
+  const std::string CONFIG_WITH_MARKING = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        listen no
+        mcast yes
+        mcast_group 01:00:5E:90:10:01
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG_WITH_MARKING, false);
+  g_io.poll();
+  faces = this->listEtherMcastFaces();
+  BOOST_REQUIRE_EQUAL(faces.size(), netifs.size());
+  BOOST_CHECK(std::all_of(faces.begin(), faces.end(), isMarking));
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(PacketRing)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        listen yes
+        mcast yes
+        packet_ring yes
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, this->listUrisOfAvailableNetifs());
+  auto channels = factory.getChannels();
+  BOOST_CHECK(std::all_of(channels.begin(), channels.end(),
+                          [] (const auto& ch) { return ch->isListening(); }));
+  BOOST_CHECK_EQUAL(this->countEtherMcastFaces(), netifs.size());
+}
+
+BOOST_AUTO_TEST_CASE(Xdp)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+
+  // netifs on which AF_XDP cannot be set up fall back to libpcap
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        listen yes
+        mcast yes
+        xdp generic
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, this->listUrisOfAvailableNetifs());
+  auto channels = factory.getChannels();
+  BOOST_CHECK(std::all_of(channels.begin(), channels.end(),
+                          [] (const auto& ch) { return ch->isListening(); }));
+  BOOST_CHECK_EQUAL(this->countEtherMcastFaces(), netifs.size());
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_CASE(ChangeMcastGroup)
 {
   SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
@@ -417,6 +523,38 @@ BOOST_AUTO_TEST_CASE(BadMcastGroup)
   BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadPacketRing)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        packet_ring hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(BadXdp)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        xdp yes
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownOption)
 {
   const std::string CONFIG = R"CONFIG(
@@ -97,7 +97,8 @@ protected:
   void
   initializeMulticast(shared_ptr<ndn::net::NetworkInterface> netif = nullptr,
                       ndn::nfd::LinkType linkType = ndn::nfd::LINK_TYPE_MULTI_ACCESS,
-                      ethernet::Address mcastGroup = {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e})
+                      ethernet::Address mcastGroup = {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e},
+                      bool wantPacketRing = false)
   {
     if (!netif) {
       netif = defaultNetif;
@@ -105,7 +106,7 @@ protected:
 
     localEp = netif->getName();
     remoteEp = mcastGroup;
-    transport = make_unique<MulticastEthernetTransport>(*netif, remoteEp, linkType);
+    transport = make_unique<MulticastEthernetTransport>(*netif, remoteEp, linkType, wantPacketRing);
   }
 
 protected:
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/ethernet-packet-ring.hpp"
+
+#include "tests/test-common.hpp"
+#include "veth-fixture.hpp"
+
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestEthernetPacketRing, VethFixture)
+
+#ifdef __linux__
+
+static std::vector<uint8_t>
+makeFrame(const ndn::net::NetworkInterface& src, uint8_t tag)
+{
+  return VethFixture::makeNdnFrame(ethernet::getBroadcastAddress(), src.getEthernetAddress(),
+                                   ndn::encoding::makeNonNegativeIntegerBlock(300, tag));
+}
+
+/** \brief reads frames from \p ring until \p nExpected have arrived or one second has passed
+ */
+static std::vector<std::vector<uint8_t>>
+readFrames(EthernetPacketRing& ring, size_t nExpected)
+{
+  std::vector<std::vector<uint8_t>> frames;
+  int fd = ring.getFd();
+  for (int i = 0; i < 100 && frames.size() < nExpected; ++i) {
+    pollfd pfd{fd, POLLIN, 0};
+    ::poll(&pfd, 1, 10);
+    ring.readPackets([&frames] (const uint8_t* frame, size_t length) {
+      frames.emplace_back(frame, frame + length);
+    });
+  }
+  ::close(fd);
+  return frames;
+}
+
+BOOST_AUTO_TEST_CASE(ReadPackets)
+{
+  SKIP_IF_NO_VETH_PAIR();
+
+  EthernetPacketRing txRing(veth0->getName());
+  EthernetPacketRing rxRing(veth1->getName());
+  try {
+    txRing.activate();
+    rxRing.activate();
+  }
+  catch (const EthernetPacketRing::Error& e) {
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require AF_PACKET rings: "s + e.what());
+    return;
+  }
+
+  std::vector<std::vector<uint8_t>> sent;
+  for (uint8_t i = 1; i <= 3; ++i) {
+    sent.push_back(makeFrame(*veth0, i));
+    BOOST_REQUIRE_EQUAL(txRing.send(sent.back().data(), sent.back().size()),
+                        static_cast<ssize_t>(sent.back().size()));
+  }
+  // a frame sent on the receiving interface is not delivered back to its own ring
+  auto own = makeFrame(*veth1, 4);
+  BOOST_REQUIRE_EQUAL(rxRing.send(own.data(), own.size()), static_cast<ssize_t>(own.size()));
+
+  auto received = readFrames(rxRing, sent.size() + 1);
+  BOOST_REQUIRE_EQUAL(received.size(), sent.size());
+  for (size_t i = 0; i < sent.size(); ++i) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(received[i].begin(), received[i].end(),
+                                  sent[i].begin(), sent[i].end());
+  }
+  BOOST_CHECK_EQUAL(rxRing.getNDropped(), 0);
+
+  // the sending ring received the frame sent by the other end
+  auto echoed = readFrames(txRing, 1);
+  BOOST_REQUIRE_EQUAL(echoed.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(echoed[0].begin(), echoed[0].end(), own.begin(), own.end());
+}
+
+BOOST_AUTO_TEST_CASE(Close)
+{
+  SKIP_IF_NO_VETH_PAIR();
+
+  EthernetPacketRing txRing(veth0->getName());
+  EthernetPacketRing rxRing(veth1->getName());
+  try {
+    txRing.activate();
+    rxRing.activate();
+  }
+  catch (const EthernetPacketRing::Error& e) {
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require AF_PACKET rings: "s + e.what());
+    return;
+  }
+
+  auto frame = makeFrame(*veth0, 1);
+  BOOST_REQUIRE_EQUAL(txRing.send(frame.data(), frame.size()), static_cast<ssize_t>(frame.size()));
+  // wait until the kernel retires the block that contains the frame
+  std::this_thread::sleep_for(std::chrono::milliseconds(10 * EthernetPacketRing::RETIRE_BLOCK_TIMEOUT_MS));
+
+  // frames still in the ring are discarded, and the socket no longer sends or receives
+  rxRing.close();
+  size_t nFrames = rxRing.readPackets([] (const uint8_t*, size_t) {
+    BOOST_ERROR("unexpected frame after close");
+  });
+  BOOST_CHECK_EQUAL(nFrames, 0);
+  BOOST_CHECK_EQUAL(rxRing.send(frame.data(), frame.size()), -1);
+  BOOST_CHECK_THROW(rxRing.getFd(), EthernetPacketRing::Error);
+  BOOST_CHECK_EQUAL(rxRing.getNDropped(), 0);
+
+  // closing again is harmless
+  rxRing.close();
+}
+
+#endif // __linux__
+
+BOOST_AUTO_TEST_CASE(ActivateFailure)
+{
+  EthernetPacketRing ring("nonexistent-netif");
+  BOOST_CHECK_THROW(ring.activate(), EthernetPacketRing::Error);
+  BOOST_CHECK_EQUAL(ring.readPackets([] (const uint8_t*, size_t) {}), 0);
+  BOOST_CHECK_EQUAL(ring.getNDropped(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEthernetPacketRing
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/ethernet-xdp-socket.hpp"
+
+#include "tests/test-common.hpp"
+#include "dummy-link-service.hpp"
+#include "ethernet-fixture.hpp"
+#include "veth-fixture.hpp"
+
+#include "face/ethernet-packet-ring.hpp"
+#include "face/face.hpp"
+
+#include <ndn-cxx/net/network-monitor-stub.hpp>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestEthernetXdpSocket, EthernetFixture)
+
+#ifdef __linux__
+
+BOOST_AUTO_TEST_CASE(ActivateAndSend)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  auto netif = getRunningNetif();
+
+  auto socket = make_shared<EthernetXdpSocket>(*netif, EthernetXdpSocket::Mode::GENERIC);
+  try {
+    socket->activate();
+  }
+  catch (const EthernetXdpSocket::Error& e) {
+    // requires CAP_NET_ADMIN, CAP_BPF (or CAP_SYS_ADMIN), and Linux 5.9 or later
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require AF_XDP: "s + e.what());
+    return;
+  }
+  BOOST_CHECK(socket->getMode() == EthernetXdpSocket::Mode::GENERIC);
+  BOOST_CHECK_EQUAL(socket->isZeroCopy(), false);
+
+  auto counters = socket->getCounters();
+  BOOST_CHECK_EQUAL(counters.fillRingOccupancy, EthernetXdpSocket::RING_SIZE);
+  BOOST_CHECK_EQUAL(counters.rxRingOccupancy, 0);
+  BOOST_CHECK_EQUAL(counters.txRingOccupancy, 0);
+  BOOST_CHECK_EQUAL(counters.nTxDropped, 0);
+
+  uint8_t frame[ethernet::HDR_LEN + ethernet::MIN_DATA_LEN] = {};
+  std::memcpy(frame, ethernet::getBroadcastAddress().data(), ethernet::ADDR_LEN);
+  std::memcpy(frame + ethernet::ADDR_LEN, netif->getEthernetAddress().data(), ethernet::ADDR_LEN);
+  frame[12] = ethernet::ETHERTYPE_NDN >> 8;
+  frame[13] = ethernet::ETHERTYPE_NDN & 0xFF;
+  BOOST_CHECK_EQUAL(socket->send(frame, sizeof(frame)), true);
+
+  // queued octets are counted by destination; the frame may already have been transmitted
+  BOOST_CHECK_LE(socket->getTxQueueBytes(ethernet::getBroadcastAddress()), sizeof(frame));
+  BOOST_CHECK_EQUAL(socket->getTxQueueBytes(netif->getEthernetAddress()), 0);
+
+  // frames exceeding a UMEM chunk cannot be sent
+  std::vector<uint8_t> jumbo(EthernetXdpSocket::FRAME_SIZE + 1);
+  BOOST_CHECK_EQUAL(socket->send(jumbo.data(), jumbo.size()), false);
+  BOOST_CHECK_EQUAL(socket->getCounters().nTxDropped, 1);
+
+  // neither can frames without a complete Ethernet header
+  BOOST_CHECK_EQUAL(socket->send(frame, ethernet::HDR_LEN - 1), false);
+  BOOST_CHECK_EQUAL(socket->getCounters().nTxDropped, 2);
+
+  socket->close();
+  BOOST_CHECK_EQUAL(socket->send(frame, sizeof(frame)), false);
+  BOOST_CHECK_EQUAL(socket->getTxQueueBytes(ethernet::getBroadcastAddress()), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(ReceiveDispatch, VethFixture)
+{
+  SKIP_IF_NO_VETH_PAIR();
+
+  auto socket = make_shared<EthernetXdpSocket>(*veth1, EthernetXdpSocket::Mode::GENERIC);
+  try {
+    socket->activate();
+  }
+  catch (const EthernetXdpSocket::Error& e) {
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require AF_XDP: "s + e.what());
+    return;
+  }
+
+  // frames from the other end of the pair are sent through a packet ring
+  EthernetPacketRing peer(veth0->getName());
+  peer.activate();
+  auto send = [&peer] (const std::vector<uint8_t>& frame) {
+    BOOST_REQUIRE_EQUAL(peer.send(frame.data(), frame.size()), static_cast<ssize_t>(frame.size()));
+  };
+
+  // the MTU of a face using the socket is limited to what fits in a UMEM chunk
+  auto netif = const_pointer_cast<ndn::net::NetworkInterface>(veth1);
+  netif->setMtu(9000);
+  ethernet::Address group{0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e};
+  auto face = make_unique<Face>(make_unique<DummyLinkService>(),
+                                make_unique<MulticastEthernetTransport>(*netif, group,
+                                  ndn::nfd::LINK_TYPE_MULTI_ACCESS, false, socket));
+  const ssize_t maxMtu = EthernetXdpSocket::FRAME_SIZE - ethernet::HDR_LEN;
+  BOOST_CHECK_EQUAL(face->getTransport()->getMtu(), maxMtu);
+  netif->setMtu(1500);
+  BOOST_CHECK_EQUAL(face->getTransport()->getMtu(), 1500);
+  netif->setMtu(9000);
+  BOOST_CHECK_EQUAL(face->getTransport()->getMtu(), maxMtu);
+
+  std::vector<std::pair<Block, ethernet::Address>> defaultReceived;
+  socket->setDefaultReceiver([&] (const uint8_t* payload, size_t length,
+                                  const ethernet::Address& sender) {
+    defaultReceived.emplace_back(Block(payload, length), sender);
+  });
+
+  // a frame sent to the group goes to the multicast face; a frame sent to this host,
+  // for which there is no unicast face, goes to the default receiver
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  send(makeNdnFrame(group, veth0->getEthernetAddress(), pkt1));
+  send(makeNdnFrame(veth1->getEthernetAddress(), veth0->getEthernetAddress(), pkt2));
+  // frames addressed to another group or host are ignored
+  send(makeNdnFrame({0x01, 0x00, 0x5e, 0x90, 0x10, 0x5f}, veth0->getEthernetAddress(), pkt1));
+  send(makeNdnFrame({0x02, 0x00, 0x00, 0x00, 0x00, 0x01}, veth0->getEthernetAddress(), pkt2));
+
+  LimitedIo limitedIo;
+  limitedIo.defer(100_ms);
+
+  const auto& received = static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK(received[0].packet == pkt1);
+  BOOST_REQUIRE_EQUAL(defaultReceived.size(), 1);
+  BOOST_CHECK(defaultReceived[0].first == pkt2);
+  BOOST_CHECK_EQUAL(defaultReceived[0].second, veth0->getEthernetAddress());
+
+  auto counters = socket->getCounters();
+  BOOST_CHECK_EQUAL(counters.nRxRingFull, 0);
+  BOOST_CHECK_EQUAL(counters.nFillRingEmpty, 0);
+  BOOST_CHECK_EQUAL(counters.rxRingOccupancy, 0);
+}
+
+#endif // __linux__
+
+BOOST_AUTO_TEST_CASE(ActivateFailure)
+{
+  auto netif = ndn::net::NetworkMonitorStub::makeNetworkInterface();
+  netif->setName("nonexistent-netif");
+  netif->setIndex(0x7fffffff);
+
+  auto socket = make_shared<EthernetXdpSocket>(*netif, EthernetXdpSocket::Mode::GENERIC);
+  BOOST_CHECK_THROW(socket->activate(), EthernetXdpSocket::Error);
+  BOOST_CHECK_EQUAL(socket->getCounters().fillRingOccupancy, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEthernetXdpSocket
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
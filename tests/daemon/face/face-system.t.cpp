@@ -24,7 +24,9 @@
  */
 
 #include "face/face-system.hpp"
+#include "face/generic-link-service.hpp"
 #include "face-system-fixture.hpp"
+#include "dummy-transport.hpp"
 
 #include "tests/test-common.hpp"
 
@@ -159,6 +161,166 @@ BOOST_AUTO_TEST_CASE(ChangeProvidedSchemes)
   BOOST_CHECK_EQUAL(faceSystem.getFactoryByScheme("s3"), f1);
 }
 
+BOOST_AUTO_TEST_CASE(PerFaceOptions)
+{
+  auto makeFace = [] (ndn::nfd::FaceScope scope) {
+    return make_shared<Face>(make_unique<GenericLinkService>(),
+                             make_unique<DummyTransport>("dummy://", "dummy://", scope));
+  };
+  auto getOptions = [] (const Face& face) {
+    return static_cast<const GenericLinkService*>(face.getLinkService())->getOptions();
+  };
+
+  auto face1 = makeFace(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  auto localFace = makeFace(ndn::nfd::FACE_SCOPE_LOCAL);
+  faceTable.add(face1);
+  faceTable.add(localFace);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        interest_rate_limit 1000
+        data_rate_limit 12500000
+        data_burst_limit 65536
+        pack_packets yes
+        latency_sample_interval 100
+        data_weight 4
+        reassembly_max_bytes 1048576
+        reassembly_max_bytes_per_endpoint 65536
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(getOptions(*face1).interestPolicer.rate, 0.0);
+
+  parseConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(getOptions(*face1).interestPolicer.rate, 1000.0);
+  BOOST_CHECK_EQUAL(getOptions(*face1).interestPolicer.burst, 1000.0);
+  BOOST_CHECK_EQUAL(getOptions(*face1).dataShaper.rate, 12500000.0);
+  BOOST_CHECK_EQUAL(getOptions(*face1).dataShaper.burst, 65536.0);
+  BOOST_CHECK_EQUAL(getOptions(*face1).allowPacking, true);
+  BOOST_CHECK_EQUAL(getOptions(*face1).txClassWeights[static_cast<size_t>(TxClass::INTEREST)], 1);
+  BOOST_CHECK_EQUAL(getOptions(*face1).txClassWeights[static_cast<size_t>(TxClass::DATA)], 4);
+  BOOST_CHECK_EQUAL(getOptions(*face1).reassemblerOptions.maxBytes, 1048576);
+  BOOST_CHECK_EQUAL(getOptions(*face1).reassemblerOptions.maxBytesPerEndpoint, 65536);
+  BOOST_CHECK_EQUAL(getOptions(*localFace).interestPolicer.rate, 0.0);
+  BOOST_CHECK_EQUAL(getOptions(*localFace).allowPacking, false);
+  // latency sampling applies to local faces as well
+  BOOST_CHECK_EQUAL(face1->getTransport()->getLatencySampling(), 100);
+  BOOST_CHECK_EQUAL(localFace->getTransport()->getLatencySampling(), 100);
+
+  // faces created after the configuration is loaded
+  auto face2 = makeFace(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  faceTable.add(face2);
+  BOOST_CHECK_EQUAL(getOptions(*face2).interestPolicer.rate, 1000.0);
+  BOOST_CHECK_EQUAL(getOptions(*face2).dataShaper.burst, 65536.0);
+  BOOST_CHECK_EQUAL(face2->getTransport()->getLatencySampling(), 100);
+
+  const std::string CONFIG_NEGATIVE = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        interest_rate_limit -1
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG_NEGATIVE, true), ConfigFile::Error);
+
+  const std::string CONFIG_ZERO_BUDGET = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        reassembly_max_bytes 0
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_BUDGET, true), ConfigFile::Error);
+
+  const std::string CONFIG_ZERO_WEIGHT = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        nack_weight 0
+      }
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_WEIGHT, true), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(LinkOptionOverrides)
+{
+  auto face1 = make_shared<Face>(make_unique<GenericLinkService>(), make_unique<DummyTransport>());
+  faceTable.add(face1);
+  auto getOptions = [&face1] {
+    return static_cast<const GenericLinkService*>(face1->getLinkService())->getOptions();
+  };
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        interest_rate_limit 1000
+        data_rate_limit 12500000
+        pack_packets yes
+        data_weight 2
+      }
+    }
+  )CONFIG";
+  parseConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(getOptions().allowPacking, true);
+
+  FaceLinkOptions limits;
+  limits.interestRate = 200;
+  limits.interestBurst = 50;
+  faceSystem.setFaceLinkOptions(*face1, limits);
+  BOOST_CHECK_EQUAL(getOptions().interestPolicer.rate, 200.0);
+  BOOST_CHECK_EQUAL(getOptions().interestPolicer.burst, 50.0);
+  BOOST_CHECK_EQUAL(getOptions().dataShaper.rate, 12500000.0);
+  BOOST_CHECK_EQUAL(getOptions().allowPacking, true);
+
+  // a burst alone keeps the rate
+  limits = FaceLinkOptions();
+  limits.dataBurst = 65536;
+  faceSystem.setFaceLinkOptions(*face1, limits);
+  BOOST_CHECK_EQUAL(getOptions().dataShaper.rate, 12500000.0);
+  BOOST_CHECK_EQUAL(getOptions().dataShaper.burst, 65536.0);
+
+  limits = FaceLinkOptions();
+  limits.wantPacking = false;
+  faceSystem.setFaceLinkOptions(*face1, limits);
+  BOOST_CHECK_EQUAL(getOptions().allowPacking, false);
+  BOOST_CHECK_EQUAL(getOptions().interestPolicer.rate, 200.0);
+
+  limits = FaceLinkOptions();
+  limits.sendQueueTarget = 2_ms;
+  faceSystem.setFaceLinkOptions(*face1, limits);
+  BOOST_CHECK_EQUAL(getOptions().sendQueueTarget, 2_ms);
+
+  limits = FaceLinkOptions();
+  limits.interestWeight = 4;
+  faceSystem.setFaceLinkOptions(*face1, limits);
+  BOOST_CHECK_EQUAL(getOptions().txClassWeights[static_cast<size_t>(TxClass::INTEREST)], 4);
+  BOOST_CHECK_EQUAL(getOptions().txClassWeights[static_cast<size_t>(TxClass::DATA)], 2);
+
+  // the overrides survive a reload of the general section
+  parseConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(getOptions().interestPolicer.rate, 200.0);
+  BOOST_CHECK_EQUAL(getOptions().interestPolicer.burst, 50.0);
+  BOOST_CHECK_EQUAL(getOptions().dataShaper.rate, 12500000.0);
+  BOOST_CHECK_EQUAL(getOptions().dataShaper.burst, 65536.0);
+  BOOST_CHECK_EQUAL(getOptions().allowPacking, false);
+  BOOST_CHECK_EQUAL(getOptions().sendQueueTarget, 2_ms);
+  BOOST_CHECK_EQUAL(getOptions().txClassWeights[static_cast<size_t>(TxClass::INTEREST)], 4);
+  BOOST_CHECK_EQUAL(getOptions().txClassWeights[static_cast<size_t>(TxClass::DATA)], 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestFaceSystem
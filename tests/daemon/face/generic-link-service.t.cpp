@@ -254,6 +254,8 @@ BOOST_AUTO_TEST_CASE(ReceiveBareData)
   BOOST_CHECK_EQUAL(service->getCounters().nInData, 1);
   BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
   BOOST_CHECK_EQUAL(receivedData.back().wireEncode(), data1->wireEncode());
+  // the Data is decoded in place, without copying
+  BOOST_CHECK(receivedData.back().wireEncode().getBuffer() == data1->wireEncode().getBuffer());
 }
 
 BOOST_AUTO_TEST_CASE(ReceiveData)
@@ -269,11 +271,14 @@ BOOST_AUTO_TEST_CASE(ReceiveData)
     data1->wireEncode().begin(), data1->wireEncode().end()));
   lpPacket.set<lp::SequenceField>(0); // force LpPacket encoding
 
-  transport->receivePacket(lpPacket.wireEncode());
+  Block wire = lpPacket.wireEncode();
+  transport->receivePacket(wire);
 
   BOOST_CHECK_EQUAL(service->getCounters().nInData, 1);
   BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
   BOOST_CHECK_EQUAL(receivedData.back().wireEncode(), data1->wireEncode());
+  // the Data shares the buffer of the LpPacket, without copying
+  BOOST_CHECK(receivedData.back().wireEncode().getBuffer() == wire.getBuffer());
 }
 
 BOOST_AUTO_TEST_CASE(ReceiveNack)
@@ -455,6 +460,7 @@ BOOST_AUTO_TEST_CASE(ReassembleFragments)
       BOOST_CHECK_EQUAL(service->getCounters().nReassembling, 0);
     }
   }
+  BOOST_CHECK_GE(service->getCounters().nReassemblyPeakBytes, interest->wireEncode().size());
 }
 
 BOOST_AUTO_TEST_CASE(ReassemblyDisabledDropFragIndex)
@@ -580,7 +586,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicatePacket)
 
 BOOST_AUTO_TEST_SUITE_END() // Reliability
 
-// congestion detection and marking
+// send queue with CoDel congestion detection and marking
 BOOST_AUTO_TEST_SUITE(CongestionMark)
 
 BOOST_AUTO_TEST_CASE(NoCongestion)
@@ -588,327 +594,520 @@ BOOST_AUTO_TEST_CASE(NoCongestion)
   GenericLinkService::Options options;
   options.allowCongestionMarking = true;
   options.baseCongestionMarkingInterval = 100_ms;
-  initialize(options, MTU_UNLIMITED, 65536);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+  options.defaultCongestionThreshold = 65536;
+  initialize(options, MTU_UNLIMITED, 131072);
   BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.getOptions().queueOptions.interval, 100_ms);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.getOptions().queueOptions.target, 5_ms);
 
   auto interest = makeInterest("/12345678");
 
-  // congestion threshold will be 32768 bytes, since min(65536, 65536 / 2) = 32768 bytes
-
   // no congestion
   transport->setSendQueueLength(0);
   face->sendInterest(*interest);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
   lp::Packet pkt1(transport->sentPackets.back());
   BOOST_CHECK_EQUAL(pkt1.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 0);
 
-  // no congestion
-  transport->setSendQueueLength(32768);
+  // transport queue below threshold, no congestion
+  transport->setSendQueueLength(65535);
   face->sendInterest(*interest);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
   lp::Packet pkt2(transport->sentPackets.back());
   BOOST_CHECK_EQUAL(pkt2.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 0);
+
   BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueDropped, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().sendQueueSojournTime.getCount(), 2);
+  BOOST_CHECK_EQUAL(service->getCounters().sendQueueSojournTime.getPercentile(100), 1_us);
 }
 
-BOOST_AUTO_TEST_CASE(CongestionCoDel)
+BOOST_AUTO_TEST_CASE(HoldWhileTransportBusy)
 {
   GenericLinkService::Options options;
   options.allowCongestionMarking = true;
-  options.baseCongestionMarkingInterval = 100_ms;
-  initialize(options, MTU_UNLIMITED, 65536);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  options.defaultCongestionThreshold = 65536;
+  initialize(options, MTU_UNLIMITED, 131072);
 
   auto interest = makeInterest("/12345678");
 
-  // first congested packet, will not be marked
-  transport->setSendQueueLength(65537);
+  // transport queue at threshold, packets are held in the send queue
+  transport->setSendQueueLength(65536);
   face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
-  lp::Packet pkt0(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt0.count<lp::CongestionMarkField>(), 0);
-  time::steady_clock::TimePoint nextMarkTime = time::steady_clock::now() + 100_ms;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-
-  time::nanoseconds markingInterval(
-        static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                            std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-
-  advanceClocks(markingInterval + 1_ms);
   face->sendInterest(*interest);
-  lp::Packet pkt1(transport->sentPackets.back());
-
-  // First congestion mark appears after one interval (100 ms)
-  BOOST_REQUIRE_EQUAL(pkt1.count<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(pkt1.get<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 2);
 
-  // advance clock to half of marking interval cycle
-  advanceClocks(markingInterval / 2); // 50ms
+  advanceClocks(1_ms, 3_ms);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 2);
+
+  // transport queue drains, held packets are sent at next poll
+  transport->setSendQueueLength(100);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().sendQueueSojournTime.getCount(), 2);
+  BOOST_CHECK_EQUAL(service->getCounters().sendQueueSojournTime.getPercentile(50), 4096_us);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+}
 
-  // second congested packet, but within marking interval, will not be marked
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 3);
-  lp::Packet pkt2(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt2.count<lp::CongestionMarkField>(), 0);
+BOOST_AUTO_TEST_CASE(TransportQueueLimit)
+{
+  GenericLinkService::Options options;
+  options.defaultCongestionThreshold = 65536;
+  initialize(options, MTU_UNLIMITED, 65536);
 
-  markingInterval = time::nanoseconds(
-      static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                          std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime += markingInterval;
+  // the limit is half of the transport queue capacity, which is below the threshold
+  transport->setSendQueueLength(32767);
+  face->sendInterest(*makeInterest("/A"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
 
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
+  advanceClocks(1_ms);
+  transport->setSendQueueLength(32768);
+  face->sendInterest(*makeInterest("/B"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 1);
+}
 
-  // advance clocks past end of initial interval cycle
-  this->advanceClocks((markingInterval / 2) + 1_ms);
+BOOST_AUTO_TEST_CASE(QueryQueueLengthOncePerTurn)
+{
+  GenericLinkService::Options options;
+  options.defaultCongestionThreshold = 1000;
+  initialize(options, MTU_UNLIMITED, 65536);
 
-  // first congested packet after waiting marking interval, will be marked
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 4);
-  lp::Packet pkt3(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt3.count<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(pkt3.get<lp::CongestionMarkField>(), 1);
-  markingInterval = time::nanoseconds(
-      static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                          std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime += markingInterval;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 2);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 2);
-
-  // advance clock partway through current marking interval
-  this->advanceClocks(markingInterval - 20_ms);
-
-  // still congested, but within marking interval cycle
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
-  lp::Packet pkt4(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt4.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 2);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 2);
-
-  // advance clocks past end of current marking interval cycle
-  this->advanceClocks(21_ms);
-
-  // still congested, after marking interval cycle
-  transport->setSendQueueLength(66000);
+  auto interest = makeInterest("/12345678");
+  transport->setSendQueueLength(0);
   face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 6);
-  lp::Packet pkt5(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt5.count<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(pkt5.get<lp::CongestionMarkField>(), 1);
-  markingInterval = time::nanoseconds(
-    static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                        std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime += markingInterval;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 3);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 3);
-
-  this->advanceClocks(1_ms);
-
-  // still congested, but within marking interval cycle
-  transport->setSendQueueLength(66000);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->nSendQueueLengthQueries, 1);
+
+  // within one io_service turn, the queue length is queried again only when the bytes sent
+  // since the last query could have filled the transport queue
+  const size_t packetSize = transport->sentPackets.back().size();
+  const size_t nPerQuery = (1000 + packetSize - 1) / packetSize;
+  for (size_t i = 1; i < nPerQuery; ++i) {
+    face->sendInterest(*interest);
+  }
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), nPerQuery);
+  BOOST_CHECK_EQUAL(transport->nSendQueueLengthQueries, 1);
   face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 7);
-  lp::Packet pkt6(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt6.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 3);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 3);
-
-  this->advanceClocks(markingInterval);
+  BOOST_CHECK_EQUAL(transport->nSendQueueLengthQueries, 2);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), nPerQuery + 1);
 
-  // still congested, after marking interval cycle
-  transport->setSendQueueLength(66000);
+  // the queried length is forgotten in the next turn
+  advanceClocks(1_ms);
+  transport->setSendQueueLength(1000);
   face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 8);
-  lp::Packet pkt7(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt7.count<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(pkt7.get<lp::CongestionMarkField>(), 1);
-  markingInterval = time::nanoseconds(
-    static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                        std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime += markingInterval;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 4);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 4);
+  BOOST_CHECK_EQUAL(transport->nSendQueueLengthQueries, 3);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), nPerQuery + 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 1);
+}
 
-  // no more congestion
-  transport->setSendQueueLength(30000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 9);
-  lp::Packet pkt8(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt8.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 4);
+BOOST_AUTO_TEST_CASE(SendQueueTarget)
+{
+  GenericLinkService::Options options;
+  options.baseCongestionMarkingInterval = 20_ms;
+  options.sendQueueTarget = 1_ms;
+  initialize(options, MTU_UNLIMITED, 65536);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.getOptions().queueOptions.interval, 20_ms);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.getOptions().queueOptions.target, 1_ms);
 
-  this->advanceClocks(50_ms);
+  options.sendQueueTarget = 500_us;
+  service->setOptions(options);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.getOptions().queueOptions.target, 500_us);
+}
 
-  // send queue congested again, but can't mark packet because within one full interval of last mark
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 10);
-  lp::Packet pkt9(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt9.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  markingInterval = time::nanoseconds(
-      static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                          std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime = time::steady_clock::now() + markingInterval;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 4);
+BOOST_AUTO_TEST_CASE(UnsupportedQueueLength)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  initialize(options, MTU_UNLIMITED, QUEUE_UNSUPPORTED);
 
-  // advance clock past full 100ms interval since last mark
-  this->advanceClocks(markingInterval + 2_ms);
-  BOOST_CHECK_GT(time::steady_clock::now(), nextMarkTime);
+  auto interest = makeInterest("/12345678");
 
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 11);
-  lp::Packet pkt10(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt10.count<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(pkt10.get<lp::CongestionMarkField>(), 1);
-  markingInterval = time::nanoseconds(
-        static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                            std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime += markingInterval;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 5);
-
-  // advance clock partway through 100ms marking interval
-  this->advanceClocks(50_ms);
-
-  // not marked since within 100ms window before can mark again
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 12);
-  lp::Packet pkt11(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt11.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 5);
-
-  // advance clocks past m_nextMarkTime
-  this->advanceClocks(51_ms);
-
-  // markable packet, queue length still above threshold
-  transport->setSendQueueLength(66000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 13);
-  lp::Packet pkt12(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt12.count<lp::CongestionMarkField>(), 1);
-  BOOST_CHECK_EQUAL(pkt12.get<lp::CongestionMarkField>(), 1);
-  markingInterval = time::nanoseconds(
-    static_cast<time::nanoseconds::rep>(options.baseCongestionMarkingInterval.count() /
-                                        std::sqrt(service->m_nMarkedSinceInMarkingState + 1)));
-  nextMarkTime += markingInterval;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 2);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 6);
-
-  // no more congestion
-  transport->setSendQueueLength(10000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 14);
-  lp::Packet pkt13(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt13.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 6);
-
-  // advance clocks past one full interval since last mark
-  this->advanceClocks(102_ms);
-
-  // start congestion again
-  transport->setSendQueueLength(66000);
+  // a transport that cannot report its queue length is never considered busy
+  transport->setSendQueueLength(QUEUE_UNSUPPORTED);
   face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 15);
-  lp::Packet pkt14(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt14.count<lp::CongestionMarkField>(), 0);
-  nextMarkTime = time::steady_clock::now() + 100_ms;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 6);
-
-  // no more congestion, cancel marking interval
-  transport->setSendQueueLength(5000);
-  face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 16);
-  lp::Packet pkt15(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt15.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 6);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 0);
 }
 
-BOOST_AUTO_TEST_CASE(DefaultThreshold)
+class CongestionCoDelFixture : public GenericLinkServiceFixture
+{
+protected:
+  /** \brief send \p nPackets Interests while the transport is busy, then let the transport
+   *         accept one packet every 10 ms
+   */
+  void
+  sendThroughSlowTransport(size_t nPackets)
+  {
+    // the transport queue becomes busy again after each packet
+    transport->setSendQueueLength(1);
+    transport->afterSend = [this] (const Block&) { transport->setSendQueueLength(1); };
+
+    auto interest = makeInterest("/12345678");
+    for (size_t i = 0; i < nPackets; ++i) {
+      face->sendInterest(*interest);
+    }
+    BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 0);
+
+    while (service->getCounters().nSendQueueLength > 0) {
+      transport->setSendQueueLength(0);
+      advanceClocks(10_ms);
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(CongestionCoDel, CongestionCoDelFixture)
 {
   GenericLinkService::Options options;
   options.allowCongestionMarking = true;
   options.baseCongestionMarkingInterval = 100_ms;
-  initialize(options, MTU_UNLIMITED, QUEUE_UNSUPPORTED);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+  options.defaultCongestionThreshold = 1;
+  initialize(options, MTU_UNLIMITED, 65536);
+
+  // packet i (counting from 1) leaves the send queue at 10*i ms;
+  // sojourn time stays above target since packet 1, so CoDel enters dropping state at 110 ms;
+  // subsequent marks are at 210 ms, 210+100/sqrt(2)=280.7 ms, 280.7+100/sqrt(3)=338.4 ms;
+  // packet 39 leaves no more than one packet in the queue, so CoDel leaves dropping state
+  sendThroughSlowTransport(40);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 40);
+
+  std::vector<size_t> marked;
+  for (size_t i = 0; i < transport->sentPackets.size(); ++i) {
+    lp::Packet pkt(transport->sentPackets[i]);
+    if (pkt.has<lp::CongestionMarkField>()) {
+      BOOST_CHECK_EQUAL(pkt.get<lp::CongestionMarkField>(), 1);
+      marked.push_back(i + 1);
+    }
+  }
+  std::vector<size_t> expectedMarked{11, 21, 29, 34};
+  BOOST_CHECK_EQUAL_COLLECTIONS(marked.begin(), marked.end(),
+                                expectedMarked.begin(), expectedMarked.end());
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 4);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueDropped, 0);
+  BOOST_CHECK_EQUAL(service->m_sendQueue.getQueue(TxClass::INTEREST).isDropping(), false);
+}
+
+BOOST_FIXTURE_TEST_CASE(CongestionCoDelDrop, CongestionCoDelFixture)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = false;
+  options.baseCongestionMarkingInterval = 100_ms;
+  options.defaultCongestionThreshold = 1;
+  initialize(options, MTU_UNLIMITED, 65536);
+
+  // same as CongestionCoDel, but the packets that would be marked are dropped instead,
+  // and the next packet in the queue is sent in its place
+  sendThroughSlowTransport(20);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 19);
+
+  for (const Block& block : transport->sentPackets) {
+    lp::Packet pkt(block);
+    BOOST_CHECK_EQUAL(pkt.count<lp::CongestionMarkField>(), 0);
+  }
   BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueDropped, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueFull)
+{
+  GenericLinkService::Options options;
+  options.defaultCongestionThreshold = 1;
+  options.sendQueueCapacity = 2;
+  initialize(options, MTU_UNLIMITED, 65536);
 
   auto interest = makeInterest("/12345678");
 
-  // congestion threshold will be 65536 bytes, since the transport reports that it cannot measure
-  // the queue capacity
+  transport->setSendQueueLength(1);
+  face->sendInterest(*interest);
+  face->sendInterest(*interest);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 2);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueDropped, 1);
+
+  transport->setSendQueueLength(0);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+  const auto& cnt = service->getCounters();
+  BOOST_CHECK_EQUAL(cnt.nClassQueueDropped[static_cast<size_t>(TxClass::INTEREST)], 1);
+}
 
-  // no congestion
+BOOST_AUTO_TEST_CASE(PriorityClass)
+{
+  GenericLinkService::Options options;
+  options.defaultCongestionThreshold = 1;
+  initialize(options, MTU_UNLIMITED, 65536);
+
+  transport->setSendQueueLength(1);
+  face->sendData(*makeData("/bulk/1"));
+  face->sendInterest(*makeInterest("/bulk/2"));
+  face->sendNack(makeNack(*makeInterest("/bulk/3"), lp::NackReason::NO_ROUTE));
+  face->sendData(*makeData("/localhost/nfd/status"));
+  const auto& cnt = service->getCounters();
+  BOOST_CHECK_EQUAL(cnt.nSendQueueLength, 4);
+  BOOST_CHECK_EQUAL(cnt.nClassQueueLength[static_cast<size_t>(TxClass::PRIORITY)], 1);
+  BOOST_CHECK_EQUAL(cnt.nClassQueueLength[static_cast<size_t>(TxClass::INTEREST)], 1);
+  BOOST_CHECK_EQUAL(cnt.nClassQueueLength[static_cast<size_t>(TxClass::DATA)], 1);
+  BOOST_CHECK_EQUAL(cnt.nClassQueueLength[static_cast<size_t>(TxClass::NACK)], 1);
+
+  // the management response is sent first, although it was enqueued last
   transport->setSendQueueLength(0);
-  face->sendInterest(*interest);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 4);
+  lp::Packet pkt(transport->sentPackets.front());
+  ndn::Buffer::const_iterator fragBegin, fragEnd;
+  std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
+  Data data(Block(&*fragBegin, std::distance(fragBegin, fragEnd)));
+  BOOST_CHECK_EQUAL(data.getName(), "/localhost/nfd/status");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CongestionMark
+
+BOOST_AUTO_TEST_SUITE(TrafficLimits)
+
+BOOST_AUTO_TEST_CASE(InterestPolicerNack)
+{
+  GenericLinkService::Options options;
+  options.interestPolicer = {1.0, 2.0};
+  initialize(options);
+
+  auto interest = makeInterest("/policed");
+  const std::vector<uint8_t> pitToken{0xA2, 0x4B, 0x7E, 0x10};
+  lp::Packet lpPacket(interest->wireEncode());
+  lpPacket.set<lp::PitTokenField>(std::make_pair(pitToken.begin(), pitToken.end()));
+  for (int i = 0; i < 3; ++i) {
+    transport->receivePacket(lpPacket.wireEncode());
+  }
+
+  BOOST_CHECK_EQUAL(receivedInterests.size(), 2);
+  BOOST_CHECK_EQUAL(service->getCounters().nInInterestsPoliced, 1);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
-  lp::Packet pkt1(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt1.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  lp::Packet nackPkt(transport->sentPackets.back());
+  BOOST_REQUIRE(nackPkt.has<lp::NackField>());
+  BOOST_CHECK_EQUAL(nackPkt.get<lp::NackField>().getReason(), lp::NackReason::CONGESTION);
+  BOOST_CHECK(nackPkt.has<lp::PitTokenField>());
 
-  // no congestion
-  transport->setSendQueueLength(65536);
-  face->sendInterest(*interest);
+  // one token is added every second
+  advanceClocks(100_ms, 1_s);
+  transport->receivePacket(lpPacket.wireEncode());
+  BOOST_CHECK_EQUAL(receivedInterests.size(), 3);
+  BOOST_CHECK_EQUAL(service->getCounters().nInInterestsPoliced, 1);
+}
+
+BOOST_AUTO_TEST_CASE(InterestPolicerDrop)
+{
+  GenericLinkService::Options options;
+  options.interestPolicer = {1.0, 2.0};
+  face = make_unique<Face>(make_unique<GenericLinkService>(options),
+                           make_unique<DummyTransport>("dummy://", "dummy://",
+                                                       ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                                       ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                                                       ndn::nfd::LINK_TYPE_MULTI_ACCESS));
+  service = static_cast<GenericLinkService*>(face->getLinkService());
+  transport = static_cast<DummyTransport*>(face->getTransport());
+
+  auto interest = makeInterest("/policed");
+  for (int i = 0; i < 3; ++i) {
+    transport->receivePacket(interest->wireEncode());
+  }
+
+  // no Nack on a multi-access link
+  BOOST_CHECK_EQUAL(service->getCounters().nInInterests, 3);
+  BOOST_CHECK_EQUAL(service->getCounters().nInInterestsPoliced, 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DataShaper)
+{
+  GenericLinkService::Options options;
+  options.dataShaper = {1000.0, 1.0};
+  initialize(options);
+
+  // the first Data is allowed by the full bucket and leaves it in debt
+  face->sendData(*makeData("/shaped/1"));
+  face->sendData(*makeData("/shaped/2"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 1);
+
+  // Interests are not shaped
+  face->sendInterest(*makeInterest("/not-shaped"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+
+  // the second Data is released once the debt is repaid, at one octet per millisecond
+  advanceClocks(1_ms, 1_s);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueLength, 0);
+  BOOST_CHECK_EQUAL(service->getCounters().nSendQueueDropped, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TrafficLimits
+
+BOOST_AUTO_TEST_SUITE(Packing)
+
+static std::vector<Block>
+unpack(const Block& packet)
+{
+  std::vector<Block> elements;
+  const uint8_t* pos = packet.wire();
+  const uint8_t* end = packet.wire() + packet.size();
+  while (pos < end) {
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(pos, end - pos);
+    BOOST_REQUIRE(isOk);
+    elements.push_back(element);
+    pos += element.size();
+  }
+  return elements;
+}
+
+BOOST_AUTO_TEST_CASE(PackUntilDelay)
+{
+  GenericLinkService::Options options;
+  options.allowPacking = true;
+  options.packingDelay = 100_us;
+  initialize(options, 1500);
+
+  face->sendInterest(*makeInterest("/packed/1"));
+  face->sendInterest(*makeInterest("/packed/2"));
+  face->sendInterest(*makeInterest("/packed/3"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+
+  advanceClocks(100_us);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  auto elements = unpack(transport->sentPackets.front());
+  BOOST_REQUIRE_EQUAL(elements.size(), 3);
+  lp::Packet pkt(elements.at(2));
+  ndn::Buffer::const_iterator fragBegin, fragEnd;
+  std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
+  Interest interest(Block(&*fragBegin, std::distance(fragBegin, fragEnd)));
+  BOOST_CHECK_EQUAL(interest.getName(), "/packed/3");
+
+  BOOST_CHECK_EQUAL(service->getCounters().nOutInterests, 3);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutPackedPackets, 3);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutPackedDatagrams, 1);
+
+  // a single packet is sent as is
+  face->sendInterest(*makeInterest("/packed/4"));
+  advanceClocks(100_us);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
-  lp::Packet pkt2(transport->sentPackets.back());
-  BOOST_CHECK_EQUAL(pkt2.count<lp::CongestionMarkField>(), 0);
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK_EQUAL(unpack(transport->sentPackets.back()).size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutPackedDatagrams, 1);
+}
+
+BOOST_AUTO_TEST_CASE(PackUpToMtu)
+{
+  GenericLinkService::Options options;
+  options.allowPacking = true;
+  initialize(options, 1500);
+
+  // each Data is about 600 octets, so that only two of them fit in the MTU
+  auto content = make_shared<ndn::Buffer>(550);
+  for (int i = 0; i < 3; ++i) {
+    auto data = makeData("/packed/" + to_string(i));
+    data->setContent(content);
+    signData(*data);
+    face->sendData(*data);
+  }
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_LE(transport->sentPackets.front().size(), 1500);
+  BOOST_CHECK_EQUAL(unpack(transport->sentPackets.front()).size(), 2);
+
+  advanceClocks(100_us);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(unpack(transport->sentPackets.back()).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(UnlimitedMtu)
+{
+  GenericLinkService::Options options;
+  options.allowPacking = true;
+  initialize(options, MTU_UNLIMITED);
+
+  face->sendInterest(*makeInterest("/not-packed/1"));
+  face->sendInterest(*makeInterest("/not-packed/2"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutPackedDatagrams, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Packing
+
+BOOST_AUTO_TEST_SUITE(LatencyTracing)
+
+BOOST_AUTO_TEST_CASE(ReceiveSampled)
+{
+  transport->setLatencySampling(2);
+  BOOST_REQUIRE(transport->getLatencyStats() != nullptr);
+
+  for (int i = 0; i < 4; ++i) {
+    transport->receivePacket(makeInterest("/traced/" + to_string(i))->wireEncode());
+  }
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 4);
+  BOOST_CHECK(receivedInterests[0].getTag<PacketTraceTag>() == nullptr);
+  BOOST_CHECK(receivedInterests[1].getTag<PacketTraceTag>() != nullptr);
+  BOOST_CHECK(receivedInterests[2].getTag<PacketTraceTag>() == nullptr);
+  BOOST_CHECK(receivedInterests[3].getTag<PacketTraceTag>() != nullptr);
+
+  // the sample is not carried over to the next Interest if it falls on a Data
+  transport->receivePacket(makeInterest("/traced/4")->wireEncode());
+  transport->receivePacket(makeData("/traced/5")->wireEncode());
+  transport->receivePacket(makeInterest("/traced/6")->wireEncode());
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 6);
+  BOOST_CHECK(receivedInterests[4].getTag<PacketTraceTag>() == nullptr);
+  BOOST_CHECK(receivedInterests[5].getTag<PacketTraceTag>() == nullptr);
+
+  transport->setLatencySampling(0);
+  transport->receivePacket(makeInterest("/traced/7")->wireEncode());
+  transport->receivePacket(makeInterest("/traced/8")->wireEncode());
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 8);
+  BOOST_CHECK(receivedInterests[7].getTag<PacketTraceTag>() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SendTraced)
+{
+  auto stats = make_shared<LatencyStats>();
+  auto interest = makeInterest("/traced");
+  interest->setTag(make_shared<PacketTraceTag>(make_shared<PacketTrace>(stats)));
 
-  // first congested (not marked yet) packet
-  transport->setSendQueueLength(65537);
   face->sendInterest(*interest);
-  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 3);
-  lp::Packet pkt3(transport->sentPackets.back());
-  BOOST_REQUIRE_EQUAL(pkt3.count<lp::CongestionMarkField>(), 0);
-  time::steady_clock::TimePoint nextMarkTime = time::steady_clock::now() + 100_ms;
-  BOOST_CHECK_EQUAL(service->m_nextMarkTime, nextMarkTime);
-  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
-  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::SEND).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::TRANSMIT).getCount(), 1);
+
+  // untraced Interests are not recorded
+  face->sendInterest(*makeInterest("/untraced"));
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::SEND).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::TRANSMIT).getCount(), 1);
 }
 
-BOOST_AUTO_TEST_SUITE_END() // CongestionMark
+BOOST_AUTO_TEST_CASE(SendTracedPacked)
+{
+  GenericLinkService::Options options;
+  options.allowPacking = true;
+  options.packingDelay = 100_us;
+  initialize(options, 1500);
+
+  auto stats = make_shared<LatencyStats>();
+  auto interest = makeInterest("/traced");
+  interest->setTag(make_shared<PacketTraceTag>(make_shared<PacketTrace>(stats)));
+
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::SEND).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::TRANSMIT).getCount(), 0);
+
+  // TRANSMIT is recorded when the packing buffer is flushed
+  advanceClocks(100_us);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::TRANSMIT).getCount(), 1);
+  BOOST_CHECK_GE(stats->get(TraceStage::TRANSMIT).getPercentile(50), 100_us);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // LatencyTracing
 
 BOOST_AUTO_TEST_SUITE(LpFields)
 
@@ -151,6 +151,45 @@ BOOST_AUTO_TEST_CASE(FragmentMultipleFragments)
                                 reassembledPayload.begin(), reassembledPayload.end());
 }
 
+BOOST_AUTO_TEST_CASE(FragmentWithSequence)
+{
+  lp::Packet packet;
+  packet.add<lp::IncomingFaceIdField>(123);
+
+  auto data = makeData("/test/data123/123456789/987654321/123456789");
+  packet.add<lp::FragmentField>({data->wireEncode().begin(), data->wireEncode().end()});
+
+  bool isOk = false;
+  std::vector<lp::Packet> frags;
+
+  // not fragmented, sequence is not assigned
+  std::tie(isOk, frags) = fragmenter.fragmentPacket(packet, 256, 1000);
+  BOOST_REQUIRE(isOk);
+  BOOST_REQUIRE_EQUAL(frags.size(), 1);
+  BOOST_CHECK(!frags[0].has<lp::SequenceField>());
+
+  std::tie(isOk, frags) = fragmenter.fragmentPacket(packet, MIN_MTU, 1000);
+  BOOST_REQUIRE(isOk);
+  BOOST_REQUIRE_EQUAL(frags.size(), 5);
+
+  ndn::Buffer reassembledPayload;
+  for (size_t i = 0; i < frags.size(); ++i) {
+    // fragments decode from their own wire encoding, without being re-encoded
+    lp::Packet decoded(frags[i].wireEncode());
+    BOOST_CHECK_EQUAL(decoded.get<lp::SequenceField>(), 1000 + i);
+    BOOST_CHECK_EQUAL(decoded.get<lp::FragIndexField>(), i);
+    BOOST_CHECK_EQUAL(decoded.get<lp::FragCountField>(), 5);
+    BOOST_CHECK_EQUAL(decoded.has<lp::IncomingFaceIdField>(), i == 0);
+    BOOST_CHECK_LE(frags[i].wireEncode().size(), MIN_MTU);
+
+    ndn::Buffer::const_iterator fragBegin, fragEnd;
+    std::tie(fragBegin, fragEnd) = decoded.get<lp::FragmentField>();
+    reassembledPayload.insert(reassembledPayload.end(), fragBegin, fragEnd);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(data->wireEncode().begin(), data->wireEncode().end(),
+                                reassembledPayload.begin(), reassembledPayload.end());
+}
+
 BOOST_AUTO_TEST_CASE(FragmentMtuTooSmall)
 {
   size_t mtu = 20;
@@ -192,6 +192,34 @@ BOOST_AUTO_TEST_CASE(Normal)
   BOOST_CHECK_EQUAL(reassembler.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  // TLV-LENGTH of the reassembled packet does not match its size
+  const uint8_t malformed[] = {0x06, 0x09, 0x01, 0x02, 0x03, 0x04};
+  ndn::Buffer data1Buffer(malformed, 3);
+  ndn::Buffer data2Buffer(malformed + 3, 3);
+
+  lp::Packet received1;
+  received1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  received1.add<lp::FragIndexField>(0);
+  received1.add<lp::FragCountField>(2);
+  received1.add<lp::SequenceField>(1000);
+
+  lp::Packet received2;
+  received2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  received2.add<lp::FragIndexField>(1);
+  received2.add<lp::FragCountField>(2);
+  received2.add<lp::SequenceField>(1001);
+
+  bool isComplete = false;
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(received1);
+  BOOST_REQUIRE(!isComplete);
+
+  BOOST_CHECK_THROW(reassembler.receiveFragment(received2), tlv::Error);
+  // the partial packet is discarded even though reassembly failed
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(OmitFragIndex0)
 {
   ndn::Buffer data1Buffer(data, 4);
@@ -265,8 +293,11 @@ BOOST_AUTO_TEST_CASE(OutOfOrder)
   std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(frag0);
   BOOST_REQUIRE(!isComplete);
 
-  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(frag1);
+  Block netPacket;
+  std::tie(isComplete, netPacket, std::ignore) = reassembler.receiveFragment(frag1);
   BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.getNBytes(), 0);
 }
 
 BOOST_AUTO_TEST_CASE(Duplicate)
@@ -323,6 +354,103 @@ BOOST_AUTO_TEST_CASE(Timeout)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(MemoryBudget)
+{
+  ndn::Buffer fragBuffer(data, 4);
+
+  auto makeFrag = [&] (lp::Sequence seq, uint64_t fragIndex) {
+    lp::Packet frag;
+    frag.add<lp::FragmentField>(std::make_pair(fragBuffer.begin(), fragBuffer.end()));
+    frag.add<lp::FragIndexField>(fragIndex);
+    frag.add<lp::FragCountField>(3);
+    frag.add<lp::SequenceField>(seq + fragIndex);
+    return lp::Packet(frag.wireEncode());
+  };
+  // each partial packet preallocates room for three fragments
+  size_t packetBytes = 3 * makeFrag(1000, 0).wireEncode().size();
+
+  LpReassembler::Options options;
+  options.maxBytesPerEndpoint = packetBytes * 2;
+  options.maxBytes = packetBytes * 3;
+  reassembler.setOptions(options);
+
+  std::vector<std::pair<EndpointId, size_t>> evictionHistory;
+  reassembler.beforeEviction.connect([&] (EndpointId remoteEp, size_t nDroppedFragments) {
+    evictionHistory.push_back({remoteEp, nDroppedFragments});
+  });
+
+  const EndpointId EP1 = udp::Endpoint{boost::asio::ip::address_v4(0xC0A8010F), 8999};
+  const EndpointId EP2 = udp::Endpoint{boost::asio::ip::address_v4(0xC0A80110), 8999};
+
+  reassembler.receiveFragment(makeFrag(1000, 0), EP1);
+  reassembler.receiveFragment(makeFrag(2000, 0), EP1);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+  BOOST_CHECK_EQUAL(reassembler.getNBytes(), packetBytes * 2);
+
+  // over the per-endpoint budget, the oldest partial packet from EP1 is evicted
+  reassembler.receiveFragment(makeFrag(3000, 0), EP1);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+  BOOST_CHECK_EQUAL(reassembler.getNEvictions(), 1);
+  BOOST_REQUIRE_EQUAL(evictionHistory.size(), 1);
+  BOOST_CHECK(evictionHistory.back().first == EP1);
+  BOOST_CHECK_EQUAL(evictionHistory.back().second, 1);
+
+  // a new fragment makes its partial packet the most recently updated one
+  reassembler.receiveFragment(makeFrag(2000, 1), EP1);
+  BOOST_CHECK_EQUAL(reassembler.getNBytes(), packetBytes * 2);
+
+  reassembler.receiveFragment(makeFrag(5000, 0), EP2);
+  BOOST_CHECK_EQUAL(reassembler.size(), 3);
+  BOOST_CHECK_EQUAL(reassembler.getNEvictions(), 1);
+
+  // over the budget of the reassembler, the oldest partial packet from any endpoint is evicted
+  reassembler.receiveFragment(makeFrag(6000, 0), EP2);
+  BOOST_CHECK_EQUAL(reassembler.size(), 3);
+  BOOST_CHECK_EQUAL(reassembler.getNEvictions(), 2);
+  BOOST_REQUIRE_EQUAL(evictionHistory.size(), 2);
+  BOOST_CHECK(evictionHistory.back().first == EP1);
+  BOOST_CHECK_EQUAL(evictionHistory.back().second, 1);
+  BOOST_CHECK_EQUAL(reassembler.getNBytes(), packetBytes * 3);
+  BOOST_CHECK_EQUAL(reassembler.getPeakBytes(), packetBytes * 3);
+
+  // the remaining partial packets time out, including the one that was refreshed
+  advanceClocks(1_ms, 600);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_REQUIRE_EQUAL(timeoutHistory.size(), 3);
+  BOOST_CHECK_EQUAL(timeoutHistory[0].second, 2);
+  BOOST_CHECK_EQUAL(reassembler.getNBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(OverMaxPacketSize)
+{
+  std::vector<uint8_t> payload(1000, 0xBB);
+  auto makeFrag = [&] (uint64_t fragIndex) {
+    lp::Packet frag;
+    frag.add<lp::FragmentField>(std::make_pair(payload.cbegin(), payload.cend()));
+    frag.add<lp::FragIndexField>(fragIndex);
+    frag.add<lp::FragCountField>(400);
+    frag.add<lp::SequenceField>(1000 + fragIndex);
+    return lp::Packet(frag.wireEncode());
+  };
+
+  // the reservation of the first fragment is bounded by the largest network-layer packet
+  reassembler.receiveFragment(makeFrag(0));
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK_LE(reassembler.getNBytes(), ndn::MAX_NDN_PACKET_SIZE);
+
+  size_t nFragmentsFit = ndn::MAX_NDN_PACKET_SIZE / payload.size();
+  for (size_t i = 1; i < nFragmentsFit; ++i) {
+    reassembler.receiveFragment(makeFrag(i));
+  }
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK_LE(reassembler.getPeakBytes(), ndn::MAX_NDN_PACKET_SIZE);
+
+  // the partial packet is dropped once it cannot fit in MAX_NDN_PACKET_SIZE
+  BOOST_CHECK_THROW(reassembler.receiveFragment(makeFrag(nFragmentsFit)), tlv::Error);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_CHECK_EQUAL(reassembler.getNBytes(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(MissingSequence)
 {
   ndn::Buffer data1Buffer(data, 4);
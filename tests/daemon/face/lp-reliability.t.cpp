@@ -62,7 +62,7 @@ public:
     }
 
     for (auto frag : frags) {
-      this->sendLpPacket(std::move(frag));
+      this->sendLpPacket(std::move(frag), TxClass::INTEREST);
     }
   }
 
@@ -112,10 +112,10 @@ public:
   }
 
   static bool
-  netPktHasUnackedFrag(const shared_ptr<LpReliability::NetPkt>& netPkt, lp::Sequence txSeq)
+  netPktHasUnackedFrag(const LpReliability::NetPkt* netPkt, lp::Sequence txSeq)
   {
-    return std::any_of(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(),
-                       [txSeq] (auto fragIt) { return fragIt->first == txSeq; });
+    return std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq) !=
+           netPkt->unackedFrags.end();
   }
 
   /** \brief make an LpPacket with fragment of specified size
@@ -207,7 +207,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
                  reliability->m_unackedFrags.at(firstTxSeq + 1).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -225,7 +225,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 2).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 1);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -244,7 +244,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 4).retxCount, 2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 3), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 3).retxCount, 1);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -263,7 +263,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 6).retxCount, 3);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 5), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 5).retxCount, 2);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 5);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 5);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 7);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -280,7 +280,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 6), 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 7), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 7).retxCount, 3);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 7);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 7);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 8);
 
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -354,7 +354,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 2));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -389,7 +389,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -423,7 +423,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -457,7 +457,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 7));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -486,7 +486,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -500,7 +500,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -533,7 +533,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK(reliability->m_unackedFrags.at(3).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 0);
@@ -549,18 +549,14 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 4);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(0xFFFFFFFFFFFFFFFF), 1); // pkt1
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(0xFFFFFFFFFFFFFFFF).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(0xFFFFFFFFFFFFFFFF).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(0), 0); // pkt2
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(1), 1); // pkt3
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(1).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1); // pkt4
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(2).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(2).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -578,17 +574,14 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 3);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(0xFFFFFFFFFFFFFFFF), 1); // pkt1
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(0xFFFFFFFFFFFFFFFF).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(0xFFFFFFFFFFFFFFFF).nGreaterSeqAcks, 2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(0), 0); // pkt2
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(1), 1); // pkt3
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(1).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 0); // pkt4
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(101010), 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 2);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -609,11 +602,9 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 0); // pkt4
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 1); // pkt1 new TxSeq
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 1);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   lp::Packet sentRetxPkt(transport->sentPackets.back());
   BOOST_REQUIRE(sentRetxPkt.has<lp::TxSequenceField>());
@@ -638,9 +629,8 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 0); // pkt4
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 0); // pkt1 new TxSeq
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
@@ -665,7 +655,7 @@ BOOST_AUTO_TEST_CASE(SkipFragmentsRemovedInRtt)
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 5);
 
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // Ack the last 2 packets
   lp::Packet ackPkt1;
@@ -674,8 +664,11 @@ BOOST_AUTO_TEST_CASE(SkipFragmentsRemovedInRtt)
   BOOST_CHECK(reliability->processIncomingPacket(ackPkt1));
 
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 3);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).nGreaterSeqAcks, 2);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).nGreaterSeqAcks, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 1);
+  BOOST_REQUIRE_EQUAL(reliability->m_greatestAckedTxSeqs.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_greatestAckedTxSeqs[0], firstTxSeq + 4);
+  BOOST_CHECK_EQUAL(reliability->m_greatestAckedTxSeqs[1], firstTxSeq + 3);
 
   // Ack the third packet (5003)
   // This triggers a "loss by greater Acks" for packets 5001 and 5002
@@ -686,6 +679,62 @@ BOOST_AUTO_TEST_CASE(SkipFragmentsRemovedInRtt)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(LargeWindow)
+{
+  // Many fragments in flight, acknowledged out of order; also tests growth of the window
+  // across TxSequence wraparound
+
+  reliability->m_lastTxSeqNo = 0xFFFFFFFFFFFFFF00;
+  const lp::Sequence firstTxSeq = 0xFFFFFFFFFFFFFF01;
+  const size_t nPackets = 1000;
+
+  for (uint32_t i = 0; i < nPackets; i++) {
+    linkService->sendLpPackets({makeFrag(i)});
+  }
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), nPackets);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), nPackets);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
+  BOOST_CHECK_EQUAL(getPktNum(reliability->m_unackedFrags.at(firstTxSeq + 500).pkt), 500);
+  BOOST_CHECK_EQUAL(reliability->m_netPkts.size(), nPackets);
+
+  // Ack every packet except the first and the last
+  lp::Packet ackPkt;
+  for (size_t i = 1; i < nPackets - 1; i++) {
+    ackPkt.add<lp::AckField>(firstTxSeq + i);
+  }
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt));
+
+  // The first packet is considered lost and retransmitted, the last packet is not
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq), 0);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + nPackets - 1), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + nPackets - 1);
+  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + nPackets), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + nPackets).retxCount, 1);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), nPackets + 1);
+  BOOST_CHECK_EQUAL(getPktNum(lp::Packet(transport->sentPackets.back())), 0);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, nPackets - 2);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
+  BOOST_CHECK_EQUAL(reliability->m_freeNetPkts.size(), nPackets - 2);
+
+  lp::Packet ackPkt2;
+  ackPkt2.add<lp::AckField>(firstTxSeq + nPackets);
+  ackPkt2.add<lp::AckField>(firstTxSeq + nPackets - 1);
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt2));
+
+  BOOST_CHECK(reliability->m_unackedFrags.empty());
+  BOOST_CHECK(!reliability->m_rtoTimer);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, nPackets - 1);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
+  BOOST_CHECK_EQUAL(reliability->m_freeNetPkts.size(), nPackets);
+
+  // NetPkts are reused by subsequent packets
+  linkService->sendLpPackets({makeFrag(nPackets)});
+  BOOST_CHECK_EQUAL(reliability->m_netPkts.size(), nPackets);
+  BOOST_CHECK_EQUAL(reliability->m_freeNetPkts.size(), nPackets - 1);
+  BOOST_CHECK(reliability->m_rtoTimer);
+}
+
 BOOST_AUTO_TEST_CASE(CancelLossNotificationOnAck)
 {
   reliability->onDroppedInterest.connect([] (const Interest&) {
@@ -1020,7 +1069,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Will send out a single fragment
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // RTO is initially 1 second, so will time out and retx
   advanceClocks(1250_ms, 1);
@@ -1037,7 +1086,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Acknowledge second transmission
   // Ack will acknowledge retx and remove unacked frag
   lp::Packet ackPkt2;
-  ackPkt2.add<lp::AckField>(reliability->m_firstUnackedFrag->first);
+  ackPkt2.add<lp::AckField>(reliability->m_unackedFrags.getFirstTxSeq());
   reliability->processIncomingPacket(ackPkt2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
 }
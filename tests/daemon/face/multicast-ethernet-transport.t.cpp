@@ -26,8 +26,12 @@
 #include "transport-test-common.hpp"
 
 #include "ethernet-fixture.hpp"
+#include "veth-fixture.hpp"
+#include "dummy-link-service.hpp"
 
 #include "common/global.hpp"
+#include "face/ethernet-packet-ring.hpp"
+#include "face/face.hpp"
 
 namespace nfd {
 namespace face {
@@ -129,6 +133,71 @@ BOOST_AUTO_TEST_CASE(Close)
   BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
 }
 
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(PacketRing)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  initializeMulticast(getRunningNetif(), ndn::nfd::LINK_TYPE_MULTI_ACCESS,
+                      {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e}, true);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  // frames are sent through the ring's socket, padded to the minimum frame size
+  auto block = ndn::encoding::makeStringBlock(300, "hello");
+  BOOST_CHECK_NO_THROW(transport->send(block));
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  transport->close();
+  transport->afterStateChange.connectSingleShot([this] (auto oldState, auto newState) {
+    BOOST_CHECK_EQUAL(oldState, TransportState::CLOSING);
+    BOOST_CHECK_EQUAL(newState, TransportState::CLOSED);
+    this->limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+}
+class EthernetVethFixture : public EthernetFixture, public VethFixture
+{
+};
+
+BOOST_FIXTURE_TEST_CASE(PacketRingReceive, EthernetVethFixture)
+{
+  SKIP_IF_NO_VETH_PAIR();
+  ethernet::Address group{0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e};
+  initializeMulticast(const_pointer_cast<ndn::net::NetworkInterface>(veth1),
+                      ndn::nfd::LINK_TYPE_MULTI_ACCESS, group, true);
+  auto face = make_unique<Face>(make_unique<DummyLinkService>(), std::move(transport));
+  auto& receivedPackets = static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
+
+  // frames sent to the group from the other end of the pair are read from the ring
+  EthernetPacketRing peer(veth0->getName());
+  peer.activate();
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  for (const auto& pkt : {pkt1, pkt2}) {
+    auto frame = makeNdnFrame(group, veth0->getEthernetAddress(), pkt);
+    BOOST_REQUIRE_EQUAL(peer.send(frame.data(), frame.size()), static_cast<ssize_t>(frame.size()));
+  }
+  limitedIo.defer(100_ms);
+
+  BOOST_REQUIRE_EQUAL(receivedPackets.size(), 2);
+  BOOST_CHECK(receivedPackets[0].packet == pkt1);
+  BOOST_CHECK(receivedPackets[1].packet == pkt2);
+  BOOST_CHECK_EQUAL(face->getTransport()->getCounters().nInPackets, 2);
+
+  // closing the face closes the ring, so frames sent afterwards are not received
+  face->getTransport()->close();
+  face->getTransport()->afterStateChange.connectSingleShot([this] (auto, auto newState) {
+    BOOST_CHECK_EQUAL(newState, TransportState::CLOSED);
+    this->limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  auto frame = makeNdnFrame(group, veth0->getEthernetAddress(), pkt1);
+  BOOST_REQUIRE_EQUAL(peer.send(frame.data(), frame.size()), static_cast<ssize_t>(frame.size()));
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(receivedPackets.size(), 2);
+}
+
+#endif // __linux__
+
 BOOST_AUTO_TEST_CASE(SendQueueLength)
 {
   SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/receive-buffer-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestReceiveBufferPool)
+
+BOOST_AUTO_TEST_CASE(AcquireRelease)
+{
+  ReceiveBufferPool pool(100, 2);
+  BOOST_CHECK_EQUAL(pool.getBufferSize(), 100);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  auto buf1 = pool.acquire();
+  BOOST_REQUIRE(buf1 != nullptr);
+  BOOST_CHECK_EQUAL(buf1->size(), 100);
+  auto buf2 = pool.acquire();
+  BOOST_CHECK_NE(buf1, buf2);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK_EQUAL(pool.getNHits(), 0);
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 2);
+
+  // buffer is still referenced by a packet
+  ConstBufferPtr packetBuffer = buf1;
+  buf1.reset();
+  auto buf3 = pool.acquire();
+  BOOST_CHECK_NE(buf3, packetBuffer);
+  BOOST_CHECK_EQUAL(pool.size(), 2); // at capacity, buf3 does not belong to the pool
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 3);
+
+  // last reference is released, the buffer returns to the pool
+  const ndn::Buffer* rawBuffer = packetBuffer.get();
+  packetBuffer.reset();
+  auto buf4 = pool.acquire();
+  BOOST_CHECK_EQUAL(buf4.get(), rawBuffer);
+  BOOST_CHECK_EQUAL(pool.getNHits(), 1);
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 3);
+  BOOST_CHECK_EQUAL(pool.getHighWaterMark(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Resize)
+{
+  ReceiveBufferPool pool(100, 4);
+  auto buf1 = pool.acquire();
+  auto buf2 = pool.acquire();
+  auto buf3 = pool.acquire();
+  BOOST_CHECK_EQUAL(pool.size(), 3);
+
+  pool.resize(100, 2);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK_EQUAL(pool.getCapacity(), 2);
+  BOOST_CHECK_EQUAL(buf3->size(), 100); // buffers in use remain valid
+
+  pool.resize(200, 2);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+  buf1.reset();
+  auto buf4 = pool.acquire();
+  BOOST_CHECK_EQUAL(buf4->size(), 200);
+  BOOST_CHECK_EQUAL(pool.getHighWaterMark(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Trim)
+{
+  ReceiveBufferPool pool(100, 4);
+  auto buf1 = pool.acquire();
+  auto buf2 = pool.acquire();
+  auto buf3 = pool.acquire();
+  auto buf4 = pool.acquire();
+  buf2.reset();
+  buf3.reset();
+  buf4.reset();
+
+  // only idle buffers are removed
+  pool.trim(1);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  pool.trim(0);
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+  BOOST_CHECK_EQUAL(pool.getCapacity(), 4);
+
+  BOOST_CHECK_NE(pool.acquire(), buf1);
+  BOOST_CHECK_EQUAL(pool.getNMisses(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(Exhausted)
+{
+  ReceiveBufferPool pool(100, 2);
+  auto buf1 = pool.acquire();
+  BOOST_CHECK_EQUAL(pool.isExhausted(), false); // below capacity
+
+  auto buf2 = pool.acquire();
+  BOOST_CHECK_EQUAL(pool.isExhausted(), true);
+
+  buf1.reset();
+  BOOST_CHECK_EQUAL(pool.isExhausted(), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestReceiveBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
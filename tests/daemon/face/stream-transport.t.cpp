@@ -70,6 +70,40 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Send, T, StreamTransportFixtures, T)
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendBurst, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // each gather write is limited to 7 packets or 500 bytes, so that both limits are exercised
+  this->transport->setSendBatchLimits(7, 500);
+
+  std::vector<Block> blocks;
+  size_t nBytes = 0;
+  for (int i = 0; i < 300; ++i) {
+    blocks.push_back(ndn::encoding::makeStringBlock(300, std::string(i % 97, 'x')));
+    nBytes += blocks.back().size();
+    this->transport->send(blocks.back());
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, blocks.size());
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutBytes, nBytes);
+
+  std::vector<uint8_t> readBuf(nBytes);
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+
+  auto pos = readBuf.begin();
+  for (const auto& block : blocks) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(pos, pos + block.size(), block.begin(), block.end());
+    pos += block.size();
+  }
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -119,6 +153,87 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveMultipleSegments, T, StreamTransportFixt
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveAcrossChunks, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // enough 1000-octet packets to leave less than MAX_NDN_PACKET_SIZE at the end of the first
+  // receive buffer, followed by the first half of another packet
+  const size_t nPackets = (STREAM_RECEIVE_CHUNK_SIZE - ndn::MAX_NDN_PACKET_SIZE) / 1000 + 1;
+  std::vector<uint8_t> bytes(994, 0);
+  std::vector<Block> pkts;
+  ndn::Buffer buf1;
+  for (size_t i = 0; i <= nPackets; ++i) {
+    bytes[0] = static_cast<uint8_t>(i);
+    pkts.push_back(ndn::encoding::makeBinaryBlock(300, bytes.data(), bytes.size()));
+    BOOST_REQUIRE_EQUAL(pkts.back().size(), 1000);
+    buf1.insert(buf1.end(), pkts.back().begin(), pkts.back().end());
+  }
+  BOOST_REQUIRE_LE(buf1.size(), STREAM_RECEIVE_CHUNK_SIZE);
+  ndn::Buffer buf2(buf1.end() - 500, buf1.end());
+  buf1.resize(buf1.size() - 500);
+
+  this->remoteWrite(buf1);
+  BOOST_CHECK_EQUAL(this->receivedPackets->size(), nPackets);
+  BOOST_CHECK_GT(this->transport->getCounters().nInBytesCopied, 0);
+  BOOST_CHECK_LT(this->transport->getCounters().nInBytesCopied, ndn::MAX_NDN_PACKET_SIZE);
+
+  this->remoteWrite(buf2);
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), pkts.size());
+  for (size_t i = 0; i < pkts.size(); ++i) {
+    BOOST_CHECK(this->receivedPackets->at(i).packet == pkts[i]);
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, pkts.size());
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveSmallPacketCopied, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  auto pkt = ndn::encoding::makeStringBlock(300, "hello");
+  BOOST_REQUIRE_LT(pkt.size(), STREAM_RECEIVE_COPY_THRESHOLD);
+  ndn::Buffer buf(pkt.begin(), pkt.end());
+  this->remoteWrite(buf);
+
+  // the small packet has its own buffer and does not keep the receive buffer alive
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 1);
+  BOOST_CHECK(this->receivedPackets->back().packet == pkt);
+  BOOST_CHECK_EQUAL(this->receivedPackets->back().packet.getBuffer()->size(), pkt.size());
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytesCopied, pkt.size());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceivePinnedChunksLimit, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // the link service retains every received packet, so that no receive buffer is ever released;
+  // send enough 8000-octet packets to fill twice the number of receive buffers that may be pinned
+  std::vector<uint8_t> bytes(7994, 0);
+  auto pkt = ndn::encoding::makeBinaryBlock(300, bytes.data(), bytes.size());
+  BOOST_REQUIRE_EQUAL(pkt.size(), 8000);
+  const size_t nPackets = 2 * MAX_STREAM_RECEIVE_PINNED_CHUNKS * STREAM_RECEIVE_CHUNK_SIZE / 8000;
+  ndn::Buffer buf;
+  for (size_t i = 0; i < nPackets; ++i) {
+    buf.insert(buf.end(), pkt.begin(), pkt.end());
+  }
+  this->remoteWrite(buf);
+
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), nPackets);
+  std::set<const ndn::Buffer*> chunks;
+  for (const auto& rxPkt : *this->receivedPackets) {
+    BOOST_CHECK(rxPkt.packet == pkt);
+    if (rxPkt.packet.getBuffer()->size() > rxPkt.packet.size()) {
+      chunks.insert(rxPkt.packet.getBuffer().get());
+    }
+  }
+  // packets point into at most the pinned buffers and the current one, the rest were copied
+  BOOST_CHECK_LE(chunks.size(), MAX_STREAM_RECEIVE_PINNED_CHUNKS + 1);
+  BOOST_CHECK_GT(this->transport->getCounters().nInBytesCopied,
+                 MAX_STREAM_RECEIVE_PINNED_CHUNKS * STREAM_RECEIVE_CHUNK_SIZE / 2);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveMultipleBlocks, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
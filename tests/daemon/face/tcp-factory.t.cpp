@@ -312,6 +312,50 @@ BOOST_AUTO_TEST_CASE(BadPort)
   BOOST_CHECK_THROW(parseConfig(CONFIG3, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(SendBatchLimits)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        send_batch_packets 16
+        send_batch_bytes 8800
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+  checkChannelListEqual(factory, {"tcp4://0.0.0.0:6363", "tcp6://[::]:6363"});
+
+  const std::string CONFIG_ZERO_PACKETS = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        send_batch_packets 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_PACKETS, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_PACKETS, false), ConfigFile::Error);
+
+  const std::string CONFIG_ZERO_BYTES = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        send_batch_bytes 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_BYTES, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_BYTES, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownOption)
 {
   const std::string CONFIG = R"CONFIG(
@@ -27,6 +27,8 @@
 
 #include "tcp-transport-fixture.hpp"
 
+#include "face/generic-link-service.hpp"
+
 #include <boost/mpl/vector.hpp>
 
 namespace nfd {
@@ -231,6 +233,55 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(PermanentReconnectWithExponentialBackoff, T, Tc
                     asFloatMilliseconds(expectedWait1), 20.0); // 200ms tolerance
 }
 
+BOOST_AUTO_TEST_CASE(ReceiveThroughLinkService)
+{
+  TRANSPORT_TEST_CHECK_PRECONDITIONS();
+  // do not initialize
+
+  tcp::endpoint remoteEp(address, 7070);
+  startAccept(remoteEp);
+
+  tcp::socket sock(g_io);
+  sock.async_connect(remoteEp, [this] (const boost::system::error_code& error) {
+    BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+    limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(limitedIo.run(2, 1_s), LimitedIo::EXCEED_OPS);
+
+  Face face(make_unique<GenericLinkService>(),
+            make_unique<TcpTransport>(std::move(sock), ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                                      ndn::nfd::FACE_SCOPE_NON_LOCAL));
+  auto tcpTransport = static_cast<TcpTransport*>(face.getTransport());
+
+  std::vector<shared_ptr<const Data>> receivedData;
+  face.afterReceiveData.connect([&] (const Data& data, const EndpointId&) {
+    receivedData.push_back(data.shared_from_this());
+  });
+
+  // a bare Data and a Data encapsulated in an LpPacket, both above STREAM_RECEIVE_COPY_THRESHOLD
+  std::vector<uint8_t> content(1000, 0);
+  auto data1 = makeData("/A/1");
+  data1->setContent(content.data(), content.size());
+  signData(*data1);
+  auto data2 = makeData("/A/2");
+  data2->setContent(content.data(), content.size());
+  signData(*data2);
+  Block lpPacket = lp::Packet(data2->wireEncode()).wireEncode();
+
+  ndn::Buffer buf(data1->wireEncode().begin(), data1->wireEncode().end());
+  buf.insert(buf.end(), lpPacket.begin(), lpPacket.end());
+  remoteWrite(buf);
+
+  // neither the transport nor the link service copies the packets out of the receive buffer
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 2);
+  BOOST_CHECK_EQUAL(receivedData[0]->getName(), "/A/1");
+  BOOST_CHECK_EQUAL(receivedData[1]->getName(), "/A/2");
+  auto chunk = receivedData[0]->wireEncode().getBuffer();
+  BOOST_CHECK_EQUAL(chunk->size(), STREAM_RECEIVE_CHUNK_SIZE);
+  BOOST_CHECK_EQUAL(receivedData[1]->wireEncode().getBuffer(), chunk);
+  BOOST_CHECK_EQUAL(tcpTransport->getCounters().nInBytesCopied, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestTcpTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/token-bucket.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestTokenBucket)
+
+const time::steady_clock::TimePoint t0 = time::steady_clock::TimePoint(1_s);
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  TokenBucket bucket;
+  BOOST_CHECK_EQUAL(bucket.isEnabled(), false);
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(bucket.tryConsume(1e6, t0), true);
+  }
+  BOOST_CHECK_EQUAL(bucket.getWaitTime(1e6, t0), 0_ns);
+}
+
+BOOST_AUTO_TEST_CASE(Burst)
+{
+  TokenBucket bucket({10.0, 3.0});
+  BOOST_CHECK_EQUAL(bucket.isEnabled(), true);
+
+  // the bucket starts full
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), false);
+  BOOST_CHECK_EQUAL(bucket.getWaitTime(1, t0), 100_ms);
+
+  // one token is added every 100ms
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0 + 50_ms), false);
+  BOOST_CHECK_EQUAL(bucket.getWaitTime(1, t0 + 50_ms), 50_ms);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0 + 100_ms), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0 + 100_ms), false);
+
+  // tokens do not accumulate beyond the burst size
+  BOOST_CHECK_EQUAL(bucket.tryConsume(3, t0 + 10_s), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0 + 10_s), false);
+}
+
+BOOST_AUTO_TEST_CASE(Oversize)
+{
+  TokenBucket bucket({1000.0, 100.0});
+
+  // a request larger than the burst size is allowed on a full bucket and leaves it in debt
+  BOOST_CHECK_EQUAL(bucket.canConsume(300, t0), true);
+  bucket.consume(300, t0);
+  BOOST_CHECK_EQUAL(bucket.canConsume(1, t0), false);
+  BOOST_CHECK_EQUAL(bucket.getWaitTime(1, t0), 201_ms);
+  BOOST_CHECK_EQUAL(bucket.getWaitTime(300, t0), 300_ms);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(300, t0 + 299_ms), false);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(300, t0 + 300_ms), true);
+}
+
+BOOST_AUTO_TEST_CASE(SetOptions)
+{
+  TokenBucket bucket({1.0, 1.0});
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), false);
+
+  // changing the options fills up the bucket
+  bucket.setOptions({1.0, 2.0});
+  BOOST_CHECK_EQUAL(bucket.tryConsume(2, t0), true);
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), false);
+
+  bucket.setOptions({});
+  BOOST_CHECK_EQUAL(bucket.tryConsume(1, t0), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTokenBucket
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
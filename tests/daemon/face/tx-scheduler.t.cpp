@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/tx-scheduler.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+class TxSchedulerFixture
+{
+protected:
+  void
+  enqueue(TxClass cls, size_t n, size_t size = 1000)
+  {
+    for (size_t i = 0; i < n; ++i) {
+      BOOST_REQUIRE(scheduler.enqueue(cls, lp::Packet(), size, now));
+    }
+  }
+
+  std::vector<TxClass>
+  dequeue(size_t n)
+  {
+    std::vector<TxClass> classes;
+    for (size_t i = 0; i < n; ++i) {
+      auto res = scheduler.dequeue(now);
+      BOOST_REQUIRE(res.item);
+      classes.push_back(res.cls);
+    }
+    return classes;
+  }
+
+protected:
+  TxScheduler scheduler;
+  const time::steady_clock::TimePoint now = time::steady_clock::TimePoint(1_s);
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestTxScheduler, TxSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(Priority)
+{
+  enqueue(TxClass::DATA, 3);
+  enqueue(TxClass::INTEREST, 3);
+  enqueue(TxClass::PRIORITY, 2);
+  BOOST_CHECK_EQUAL(scheduler.size(), 8);
+  BOOST_CHECK_EQUAL(scheduler.getQueue(TxClass::PRIORITY).size(), 2);
+
+  auto classes = dequeue(2);
+  BOOST_CHECK_EQUAL(classes.at(0), TxClass::PRIORITY);
+  BOOST_CHECK_EQUAL(classes.at(1), TxClass::PRIORITY);
+
+  // a PRIORITY packet arriving later still overtakes the other classes
+  dequeue(1);
+  enqueue(TxClass::PRIORITY, 1);
+  BOOST_CHECK_EQUAL(dequeue(1).at(0), TxClass::PRIORITY);
+
+  dequeue(5);
+  BOOST_CHECK(scheduler.empty());
+  BOOST_CHECK(!scheduler.dequeue(now).item);
+}
+
+BOOST_AUTO_TEST_CASE(Weights)
+{
+  TxScheduler::Options options;
+  options.weights[static_cast<size_t>(TxClass::INTEREST)] = 1;
+  options.weights[static_cast<size_t>(TxClass::DATA)] = 3;
+  scheduler.setOptions(options);
+
+  enqueue(TxClass::INTEREST, 100);
+  enqueue(TxClass::DATA, 100);
+
+  // one round: 8800 octets of Interests, then 3*8800 octets of Data
+  auto classes = dequeue(36);
+  BOOST_CHECK_EQUAL(std::count(classes.begin(), classes.begin() + 9, TxClass::INTEREST), 9);
+  BOOST_CHECK_EQUAL(std::count(classes.begin() + 9, classes.end(), TxClass::DATA), 27);
+}
+
+BOOST_AUTO_TEST_CASE(SkipEmptyClass)
+{
+  enqueue(TxClass::NACK, 2);
+  auto classes = dequeue(2);
+  BOOST_CHECK_EQUAL(classes.at(0), TxClass::NACK);
+  BOOST_CHECK_EQUAL(classes.at(1), TxClass::NACK);
+
+  // an idle class does not keep its credit, so the next round starts with Interests
+  enqueue(TxClass::INTEREST, 20);
+  enqueue(TxClass::NACK, 20);
+  classes = dequeue(18);
+  BOOST_CHECK_EQUAL(std::count(classes.begin(), classes.begin() + 9, TxClass::INTEREST), 9);
+  BOOST_CHECK_EQUAL(std::count(classes.begin() + 9, classes.end(), TxClass::NACK), 9);
+}
+
+BOOST_AUTO_TEST_CASE(CodelDrop)
+{
+  TxScheduler::Options options;
+  options.queueOptions.useMarking = false;
+  scheduler.setOptions(options);
+
+  std::vector<std::pair<TxClass, size_t>> drops;
+  scheduler.onDrop.connect([&] (TxClass cls, size_t n) { drops.emplace_back(cls, n); });
+
+  for (int i = 0; i < 20; ++i) {
+    BOOST_REQUIRE(scheduler.enqueue(TxClass::DATA, lp::Packet(), 1000, now));
+  }
+  for (int i = 1; i <= 11; ++i) {
+    BOOST_REQUIRE(scheduler.dequeue(now + i * 10_ms).item);
+  }
+  BOOST_REQUIRE_EQUAL(drops.size(), 1);
+  BOOST_CHECK_EQUAL(drops.front().first, TxClass::DATA);
+  BOOST_CHECK_EQUAL(drops.front().second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Shaper)
+{
+  TxScheduler::Options options;
+  options.shapers[static_cast<size_t>(TxClass::DATA)] = {1000.0, 1000.0};
+  scheduler.setOptions(options);
+
+  enqueue(TxClass::DATA, 3);
+  enqueue(TxClass::INTEREST, 3);
+
+  // the shaper allows one Data, while Interests are not shaped
+  auto classes = dequeue(4);
+  BOOST_CHECK_EQUAL(std::count(classes.begin(), classes.end(), TxClass::INTEREST), 3);
+  BOOST_CHECK_EQUAL(std::count(classes.begin(), classes.end(), TxClass::DATA), 1);
+
+  auto res = scheduler.dequeue(now);
+  BOOST_CHECK(!res.item);
+  BOOST_CHECK_EQUAL(res.holdTime, 1_s);
+  BOOST_CHECK_EQUAL(scheduler.size(), 2);
+
+  res = scheduler.dequeue(now + 1_s);
+  BOOST_REQUIRE(res.item);
+  BOOST_CHECK_EQUAL(res.cls, TxClass::DATA);
+  BOOST_CHECK(!scheduler.dequeue(now + 1_s).item);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTxScheduler
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
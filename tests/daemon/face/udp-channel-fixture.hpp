@@ -44,7 +44,7 @@ protected:
     if (port == 0)
       port = getNextPort();
 
-    return std::make_shared<UdpChannel>(udp::Endpoint(addr, port), 2_s, false);
+    return std::make_shared<UdpChannel>(udp::Endpoint(addr, port), 2_s, false, channelOptions);
   }
 
   void
@@ -64,6 +64,7 @@ protected:
   }
 
 protected:
+  UdpChannel::Options channelOptions;
   std::vector<shared_ptr<Face>> clientFaces;
 };
 
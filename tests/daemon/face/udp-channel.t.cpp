@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "udp-channel-fixture.hpp"
+
+#include "face/shared-udp-transport.hpp"
+#include "face/unicast-udp-transport.hpp"
+
+#include "test-ip.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestUdpChannel, UdpChannelFixture)
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(ReusePortSockets)
+{
+  auto address = getTestIp(AddressFamily::V4, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+
+  channelOptions.nListenSockets = 4;
+  channelOptions.wantCpuSteering = true;
+  this->listen(address);
+  BOOST_CHECK_EQUAL(listenerChannel->isListening(), true);
+
+  auto ch1 = makeChannel(address);
+  this->connect(*ch1);
+  auto ch2 = makeChannel(address);
+  this->connect(*ch2);
+  auto ch3 = makeChannel(address);
+  this->connect(*ch3);
+
+  // 3 client faces created, 3 listener faces created
+  BOOST_CHECK_EQUAL(limitedIo.run(6, 2_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 3);
+  BOOST_CHECK_EQUAL(listenerFaces.size(), 3);
+  for (const auto& face : listenerFaces) {
+    BOOST_CHECK(dynamic_cast<UnicastUdpTransport*>(face->getTransport()) != nullptr);
+  }
+}
+#endif // __linux__
+
+BOOST_AUTO_TEST_CASE(SharedSocket)
+{
+  auto address = getTestIp(AddressFamily::V4, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+
+  channelOptions.wantSharedSocket = true;
+  this->listen(address);
+
+  auto clientChannel = std::make_shared<UdpChannel>(udp::Endpoint(address, getNextPort()),
+                                                    2_s, false);
+  this->connect(*clientChannel);
+  BOOST_CHECK_EQUAL(limitedIo.run(2, 2_s), LimitedIo::EXCEED_OPS);
+
+  BOOST_REQUIRE_EQUAL(listenerFaces.size(), 1);
+  auto listenerFace = listenerFaces.front();
+  BOOST_CHECK(dynamic_cast<SharedUdpTransport*>(listenerFace->getTransport()) != nullptr);
+  BOOST_CHECK_EQUAL(listenerFace->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  BOOST_CHECK_EQUAL(listenerFace->getLocalUri(), FaceUri(listenerEp));
+  BOOST_CHECK_EQUAL(listenerFace->getRemoteUri(), clientFaces.front()->getLocalUri());
+  BOOST_CHECK_EQUAL(listenerFace->getTransport()->getCounters().nInPackets, 1);
+  BOOST_CHECK_GT(listenerFace->getTransport()->getSendQueueCapacity(), 0);
+#ifdef __linux__
+  // the queue length of the shared socket is reported, so that congestion can be marked
+  BOOST_CHECK_EQUAL(listenerFace->getTransport()->getSendQueueLength(), 0);
+#endif // __linux__
+
+  // further datagrams from the same peer are demultiplexed to the existing face
+  clientFaces.front()->getTransport()->send(ndn::encoding::makeStringBlock(300, "world"));
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 1);
+  BOOST_CHECK_EQUAL(listenerFace->getTransport()->getCounters().nInPackets, 2);
+
+  // a datagram that contains several packed packets is delivered as separate packets
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  auto packed = make_shared<ndn::Buffer>(pkt1.begin(), pkt1.end());
+  packed->insert(packed->end(), pkt2.begin(), pkt2.end());
+  clientFaces.front()->getTransport()->send(Block(packed, packed->begin(), packed->end(), false));
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(listenerFace->getTransport()->getCounters().nInPackets, 4);
+
+  // the face sends through the shared listening socket
+  listenerFace->getTransport()->send(ndn::encoding::makeStringBlock(300, "hello"));
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(clientFaces.front()->getTransport()->getCounters().nInPackets, 1);
+
+  // closing the face leaves the shared socket open
+  listenerFace->close();
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 0);
+  BOOST_CHECK_EQUAL(listenerChannel->isListening(), true);
+}
+
+BOOST_AUTO_TEST_CASE(SharedSocketConnectNotListening)
+{
+  auto address = getTestIp(AddressFamily::V4, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+
+  channelOptions.wantSharedSocket = true;
+  auto channel = makeChannel(address);
+
+  bool hasFailed = false;
+  channel->connect(udp::Endpoint(address, 7040), {},
+                   [] (const shared_ptr<Face>&) { BOOST_ERROR("unexpected face creation"); },
+                   [&] (uint32_t status, const std::string&) {
+                     BOOST_CHECK_EQUAL(status, 504);
+                     hasFailed = true;
+                   });
+  BOOST_CHECK(hasFailed);
+  BOOST_CHECK_EQUAL(channel->size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestUdpChannel
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
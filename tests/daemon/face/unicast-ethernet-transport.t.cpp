@@ -26,8 +26,12 @@
 #include "transport-test-common.hpp"
 
 #include "ethernet-fixture.hpp"
+#include "dummy-link-service.hpp"
 
 #include "common/global.hpp"
+#include "face/face.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
 
 namespace nfd {
 namespace face {
@@ -169,6 +173,37 @@ BOOST_AUTO_TEST_CASE(IdleClose)
   BOOST_CHECK_EQUAL(nStateChanges, 2);
 }
 
+BOOST_AUTO_TEST_CASE(ReceivePacked)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+  initializeUnicast();
+  EthernetTransport* transportPtr = transport.get();
+  auto face = make_unique<Face>(make_unique<DummyLinkService>(), std::move(transport));
+  auto& receivedPackets = static_cast<DummyLinkService*>(face->getLinkService())->receivedPackets;
+
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  auto makePayload = [&] (std::initializer_list<uint8_t> trailer) {
+    std::vector<uint8_t> payload(pkt1.begin(), pkt1.end());
+    payload.insert(payload.end(), pkt2.begin(), pkt2.end());
+    payload.insert(payload.end(), trailer);
+    return payload;
+  };
+
+  // packed packets followed by zero padding
+  auto payload = makePayload({0, 0, 0, 0});
+  transportPtr->receivePayload(payload.data(), payload.size(), remoteEp);
+  BOOST_REQUIRE_EQUAL(receivedPackets.size(), 2);
+  BOOST_CHECK(receivedPackets[0].packet == pkt1);
+  BOOST_CHECK(receivedPackets[1].packet == pkt2);
+
+  // the whole frame is dropped if other trailing octets cannot be parsed
+  payload = makePayload({0x05, 0xff});
+  transportPtr->receivePayload(payload.data(), payload.size(), remoteEp);
+  BOOST_CHECK_EQUAL(receivedPackets.size(), 2);
+  BOOST_CHECK_EQUAL(face->getTransport()->getCounters().nInPackets, 2);
+}
+
 BOOST_AUTO_TEST_CASE(SendQueueLength)
 {
   SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
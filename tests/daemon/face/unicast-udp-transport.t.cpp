@@ -27,6 +27,9 @@
 
 #include "unicast-udp-transport-fixture.hpp"
 
+#include "face/generic-link-service.hpp"
+#include "table/cs.hpp"
+
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/vector_c.hpp>
 
@@ -174,6 +177,96 @@ BOOST_FIXTURE_TEST_CASE(RemoteClosePermanent, RemoteCloseFixture)
   BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE(ReceiveBufferPoolWithContentStore, RemoteCloseFixture)
+{
+  TRANSPORT_TEST_CHECK_PRECONDITIONS();
+
+  udp::socket sock(g_io);
+  sock.connect(udp::endpoint(address, 7070));
+  localEp = sock.local_endpoint();
+  remoteConnect(address);
+
+  Face face(make_unique<GenericLinkService>(),
+            make_unique<UnicastUdpTransport>(std::move(sock), ndn::nfd::FACE_PERSISTENCY_PERSISTENT, 3_s));
+  auto udpTransport = static_cast<UnicastUdpTransport*>(face.getTransport());
+
+  // the ContentStore retains every Data received through the link service
+  const size_t nPackets = 64;
+  Cs cs(nPackets);
+  size_t nShared = 0;
+  face.afterReceiveData.connect([&] (const Data& data, const EndpointId&) {
+    if (data.wireEncode().getBuffer()->size() == ndn::MAX_NDN_PACKET_SIZE) {
+      ++nShared;
+    }
+    cs.insert(data);
+    limitedIo.afterOp();
+  });
+
+  std::vector<uint8_t> content(1000, 0);
+  for (size_t i = 0; i < nPackets; ++i) {
+    auto data = makeData("/A/" + to_string(i));
+    data->setContent(content.data(), content.size());
+    signData(*data);
+    // alternate between bare Data and Data encapsulated in an LpPacket
+    Block wire = i % 2 == 0 ? data->wireEncode() : lp::Packet(data->wireEncode()).wireEncode();
+    remoteSocket.send(boost::asio::buffer(wire.wire(), wire.size()));
+  }
+  BOOST_REQUIRE_EQUAL(limitedIo.run(nPackets, 5_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(cs.size(), nPackets);
+
+  // received Data share their receive buffers until every pooled buffer is retained,
+  // then they are copied so that the receive buffers keep returning to the pool
+  const size_t poolCapacity = 2 * 1 + 16;
+  BOOST_CHECK_GT(nShared, 0);
+  BOOST_CHECK_GT(udpTransport->getCounters().nInBytesCopied, 0);
+  BOOST_CHECK_LE(udpTransport->getCounters().nInBufferPoolMisses, poolCapacity + 1);
+  BOOST_CHECK_GE(udpTransport->getCounters().nInBufferPoolHits, nPackets - poolCapacity - 1);
+}
+
+#ifdef __linux__
+BOOST_FIXTURE_TEST_CASE(SegmentationOffloadReceive, RemoteCloseFixture)
+{
+  TRANSPORT_TEST_INIT();
+
+  transport->setSegmentationOffload(true);
+  limitedIo.defer(10_ms); // let the receive loop restart in GRO mode
+
+  // send three packets as one GSO datagram from the remote side
+  auto pkt1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "world");
+  auto pkt3 = ndn::encoding::makeStringBlock(302, "end");
+  std::array<::iovec, 3> iov{{{const_cast<uint8_t*>(pkt1.wire()), pkt1.size()},
+                              {const_cast<uint8_t*>(pkt2.wire()), pkt2.size()},
+                              {const_cast<uint8_t*>(pkt3.wire()), pkt3.size()}}};
+  std::array<uint8_t, CMSG_SPACE(sizeof(uint16_t))> control{};
+  ::msghdr hdr{};
+  hdr.msg_iov = iov.data();
+  hdr.msg_iovlen = iov.size();
+  hdr.msg_control = control.data();
+  hdr.msg_controllen = control.size();
+  auto cmsg = CMSG_FIRSTHDR(&hdr);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t segmentSize = static_cast<uint16_t>(pkt1.size());
+  std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+  if (::sendmsg(remoteSocket.native_handle(), &hdr, 0) < 0) {
+    BOOST_TEST_MESSAGE("UDP GSO is not supported by the kernel, skipping test");
+    return;
+  }
+  limitedIo.defer(1_s);
+
+  // with or without GRO, the packets are delivered individually
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 3);
+  BOOST_CHECK_EQUAL(transport->getCounters().nInBytes, pkt1.size() + pkt2.size() + pkt3.size());
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 3);
+  BOOST_CHECK(receivedPackets->at(0).packet == pkt1);
+  BOOST_CHECK(receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK(receivedPackets->at(2).packet == pkt3);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnicastUdpTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
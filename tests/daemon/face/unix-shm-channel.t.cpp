@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/unix-shm-channel.hpp"
+
+#include "channel-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif // __linux__
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+namespace fs = boost::filesystem;
+namespace local = boost::asio::local;
+
+#ifdef __linux__
+
+/** \brief The application side of a shared memory face
+ */
+class UnixShmClient
+{
+public:
+  explicit
+  UnixShmClient(boost::asio::io_service& io)
+    : socket(io)
+    , region(UnixShmRegion::create(UnixShmRegion::MIN_RING_CAPACITY))
+    , nfdDoorbell(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , appDoorbell(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , txRing(region->getControl(UnixShmRegion::TO_NFD),
+             region->getData(UnixShmRegion::TO_NFD), region->getRingCapacity())
+    , rxRing(region->getControl(UnixShmRegion::FROM_NFD),
+             region->getData(UnixShmRegion::FROM_NFD), region->getRingCapacity())
+  {
+  }
+
+  ~UnixShmClient()
+  {
+    ::close(nfdDoorbell);
+    ::close(appDoorbell);
+  }
+
+  bool
+  sendSetup(uint8_t version = UnixShmRegion::VERSION, size_t nFds = 3)
+  {
+    int fds[] = {region->getFd(), nfdDoorbell, appDoorbell};
+    iovec iov{&version, sizeof(version)};
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * nFds);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nFds);
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nFds);
+    return ::sendmsg(socket.native_handle(), &msg, 0) == 1;
+  }
+
+  void
+  send(const Block& packet)
+  {
+    bool shouldNotify = false;
+    BOOST_REQUIRE(txRing.push(packet.wire(), packet.size(), shouldNotify));
+    if (shouldNotify) {
+      uint64_t one = 1;
+      BOOST_REQUIRE_EQUAL(::write(nfdDoorbell, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    }
+  }
+
+  std::vector<Block>
+  receive()
+  {
+    std::vector<Block> packets;
+    bool shouldNotifyProducer = false;
+    BOOST_CHECK(rxRing.pop([&] (const uint8_t* payload, size_t length) {
+      packets.emplace_back(payload, length);
+    }, shouldNotifyProducer));
+    return packets;
+  }
+
+  bool
+  hasDoorbellRung()
+  {
+    uint64_t value = 0;
+    return ::read(appDoorbell, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)) &&
+           value > 0;
+  }
+
+public:
+  local::stream_protocol::socket socket;
+  unique_ptr<UnixShmRegion> region;
+  int nfdDoorbell;
+  int appDoorbell;
+  UnixShmRing txRing;
+  UnixShmRing rxRing;
+};
+
+class UnixShmChannelFixture : public ChannelFixture<UnixShmChannel, unix_stream::Endpoint>
+{
+protected:
+  UnixShmChannelFixture()
+  {
+    listenerEp = unix_stream::Endpoint("nfd-test-unix-shm-channel.sock");
+  }
+
+  shared_ptr<UnixShmChannel>
+  makeChannel() final
+  {
+    return std::make_shared<UnixShmChannel>(listenerEp, false);
+  }
+
+  void
+  listen()
+  {
+    listenerChannel = makeChannel();
+    listenerChannel->listen(
+      [this] (const shared_ptr<Face>& newFace) {
+        BOOST_REQUIRE(newFace != nullptr);
+        connectFaceClosedSignal(*newFace, [this] { limitedIo.afterOp(); });
+        listenerFaces.push_back(newFace);
+        limitedIo.afterOp();
+      },
+      ChannelFixture::unexpectedFailure);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestUnixShmChannel, UnixShmChannelFixture)
+
+BOOST_AUTO_TEST_CASE(Uri)
+{
+  auto channel = makeChannel();
+  BOOST_CHECK_EQUAL(channel->getUri(), FaceUri(listenerEp));
+}
+
+BOOST_AUTO_TEST_CASE(Listen)
+{
+  auto channel = makeChannel();
+  BOOST_CHECK_EQUAL(channel->isListening(), false);
+
+  channel->listen(nullptr, nullptr);
+  BOOST_CHECK_EQUAL(channel->isListening(), true);
+
+  // listen() is idempotent
+  BOOST_CHECK_NO_THROW(channel->listen(nullptr, nullptr));
+  BOOST_CHECK_EQUAL(channel->isListening(), true);
+
+  channel.reset();
+  BOOST_CHECK_EQUAL(fs::symlink_status(listenerEp.path()).type(), fs::file_not_found);
+}
+
+BOOST_AUTO_TEST_CASE(Exchange)
+{
+  this->listen();
+
+  UnixShmClient client(g_io);
+  client.socket.connect(listenerEp);
+  BOOST_REQUIRE(client.sendSetup());
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(listenerFaces.size(), 1);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 1);
+
+  auto face = listenerFaces.front();
+  BOOST_CHECK_EQUAL(face->getScope(), ndn::nfd::FACE_SCOPE_LOCAL);
+  BOOST_CHECK_EQUAL(face->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+  BOOST_CHECK_EQUAL(face->getLinkType(), ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  BOOST_CHECK_EQUAL(face->getChannel().lock(), listenerChannel);
+
+  uint8_t reply = 0;
+  BOOST_CHECK_EQUAL(::read(client.socket.native_handle(), &reply, sizeof(reply)), 1);
+  BOOST_CHECK_EQUAL(reply, UnixShmRegion::VERSION);
+
+  std::vector<Interest> receivedInterests;
+  face->afterReceiveInterest.connect([&] (const Interest& interest, const EndpointId&) {
+    receivedInterests.push_back(interest);
+    limitedIo.afterOp();
+  });
+
+  client.send(makeInterest("/A")->wireEncode());
+  client.send(makeInterest("/B")->wireEncode());
+  BOOST_CHECK_EQUAL(limitedIo.run(2, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 2);
+  BOOST_CHECK_EQUAL(receivedInterests[0].getName(), "/A");
+  BOOST_CHECK_EQUAL(receivedInterests[1].getName(), "/B");
+  BOOST_CHECK_EQUAL(face->getCounters().nInInterests, 2);
+
+  face->sendData(*makeData("/A"));
+  BOOST_CHECK(client.hasDoorbellRung());
+  auto packets = client.receive();
+  BOOST_CHECK_EQUAL(packets.size(), 1);
+  BOOST_CHECK_EQUAL(face->getCounters().nOutData, 1);
+
+  // closing the control connection closes the face
+  client.socket.close();
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(face->getState(), FaceState::CLOSED);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BadSetup)
+{
+  this->listen();
+
+  UnixShmClient client1(g_io);
+  client1.socket.connect(listenerEp);
+  BOOST_REQUIRE(client1.sendSetup(UnixShmRegion::VERSION + 1));
+
+  UnixShmClient client2(g_io);
+  client2.socket.connect(listenerEp);
+  BOOST_REQUIRE(client2.sendSetup(UnixShmRegion::VERSION, 2));
+
+  // a ring that does not start empty
+  UnixShmClient client3(g_io);
+  client3.region->getControl(UnixShmRegion::TO_NFD).head.store(8);
+  client3.socket.connect(listenerEp);
+  BOOST_REQUIRE(client3.sendSetup());
+
+  BOOST_CHECK_EQUAL(limitedIo.run(1, 200_ms), LimitedIo::EXCEED_TIME);
+  BOOST_CHECK_EQUAL(listenerFaces.size(), 0);
+
+  // the connections are closed without a reply
+  uint8_t reply = 0;
+  BOOST_CHECK_EQUAL(::read(client1.socket.native_handle(), &reply, sizeof(reply)), 0);
+  BOOST_CHECK_EQUAL(::read(client2.socket.native_handle(), &reply, sizeof(reply)), 0);
+  BOOST_CHECK_EQUAL(::read(client3.socket.native_handle(), &reply, sizeof(reply)), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestUnixShmChannel
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+#endif // __linux__
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/unix-shm-ring.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+class UnixShmRingFixture
+{
+protected:
+  UnixShmRingFixture()
+    : data(CAPACITY)
+    , producer(control, data.data(), CAPACITY)
+    , consumer(control, data.data(), CAPACITY)
+  {
+  }
+
+  std::vector<std::vector<uint8_t>>
+  popAll(bool expectOk = true)
+  {
+    std::vector<std::vector<uint8_t>> records;
+    bool shouldNotifyProducer = false;
+    bool isOk = consumer.pop([&] (const uint8_t* payload, size_t length) {
+      records.emplace_back(payload, payload + length);
+    }, shouldNotifyProducer);
+    BOOST_CHECK_EQUAL(isOk, expectOk);
+    return records;
+  }
+
+protected:
+  static constexpr size_t CAPACITY = 256;
+  UnixShmRing::Control control{};
+  std::vector<uint8_t> data;
+  UnixShmRing producer;
+  UnixShmRing consumer;
+};
+
+constexpr size_t UnixShmRingFixture::CAPACITY;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestUnixShmRing, UnixShmRingFixture)
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  BOOST_CHECK_EQUAL(UnixShmRing::getRecordSize(0), 8);
+  BOOST_CHECK_EQUAL(UnixShmRing::getRecordSize(4), 8);
+  BOOST_CHECK_EQUAL(UnixShmRing::getRecordSize(5), 16);
+  BOOST_CHECK_EQUAL(producer.getMaxPayloadLength(), CAPACITY / 2 - 4);
+
+  const std::vector<uint8_t> rec1{0x05, 0x01, 0x00};
+  const std::vector<uint8_t> rec2(20, 0xAA);
+
+  bool shouldNotify = false;
+  BOOST_CHECK(producer.push(rec1.data(), rec1.size(), shouldNotify));
+  BOOST_CHECK_EQUAL(shouldNotify, true); // ring was empty
+  BOOST_CHECK(producer.push(rec2.data(), rec2.size(), shouldNotify));
+  BOOST_CHECK_EQUAL(shouldNotify, false); // consumer has not drained rec1 yet
+  BOOST_CHECK_EQUAL(producer.getOccupancy(), 8 + 24);
+
+  auto records = popAll();
+  BOOST_REQUIRE_EQUAL(records.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(records[0].begin(), records[0].end(), rec1.begin(), rec1.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(records[1].begin(), records[1].end(), rec2.begin(), rec2.end());
+  BOOST_CHECK_EQUAL(producer.getOccupancy(), 0);
+
+  BOOST_CHECK_EQUAL(popAll().size(), 0);
+  BOOST_CHECK(producer.push(rec1.data(), rec1.size(), shouldNotify));
+  BOOST_CHECK_EQUAL(shouldNotify, true);
+}
+
+BOOST_AUTO_TEST_CASE(Wrap)
+{
+  const std::vector<uint8_t> rec(100, 0x42);
+  bool shouldNotify = false;
+
+  // 104 + 104 octets, leaving 48 contiguous octets at the end
+  BOOST_CHECK(producer.push(rec.data(), rec.size(), shouldNotify));
+  BOOST_CHECK(producer.push(rec.data(), rec.size(), shouldNotify));
+  BOOST_CHECK_EQUAL(popAll().size(), 2);
+
+  // does not fit at the end, and is written at the beginning behind a wrap marker
+  BOOST_CHECK(producer.push(rec.data(), rec.size(), shouldNotify));
+  BOOST_CHECK_EQUAL(producer.getOccupancy(), 48 + 104);
+  auto records = popAll();
+  BOOST_REQUIRE_EQUAL(records.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(records[0].begin(), records[0].end(), rec.begin(), rec.end());
+}
+
+BOOST_AUTO_TEST_CASE(Full)
+{
+  const std::vector<uint8_t> rec(60, 0x42);
+  bool shouldNotify = false;
+
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(producer.push(rec.data(), rec.size(), shouldNotify));
+  }
+  BOOST_CHECK_EQUAL(producer.push(rec.data(), rec.size(), shouldNotify), false);
+  BOOST_CHECK_EQUAL(control.isProducerWaiting.load(), 1);
+
+  bool shouldNotifyProducer = false;
+  size_t nRecords = 0;
+  BOOST_CHECK(consumer.pop([&] (const uint8_t*, size_t) { ++nRecords; }, shouldNotifyProducer));
+  BOOST_CHECK_EQUAL(nRecords, 4);
+  BOOST_CHECK_EQUAL(shouldNotifyProducer, true);
+  BOOST_CHECK_EQUAL(control.isProducerWaiting.load(), 0);
+
+  BOOST_CHECK(producer.push(rec.data(), rec.size(), shouldNotify));
+}
+
+BOOST_AUTO_TEST_CASE(Inconsistent)
+{
+  const std::vector<uint8_t> rec(8, 0x42);
+  bool shouldNotify = false;
+  BOOST_CHECK(producer.push(rec.data(), rec.size(), shouldNotify));
+
+  // length points past the published head
+  uint32_t length = 200;
+  std::memcpy(data.data(), &length, sizeof(length));
+  BOOST_CHECK_EQUAL(popAll(false).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(InitialCursors)
+{
+  UnixShmRing::Control c{};
+  c.head.store(16);
+  c.tail.store(16);
+  BOOST_CHECK_NO_THROW(UnixShmRing(c, data.data(), CAPACITY));
+
+  // misaligned
+  c.head.store(20);
+  c.tail.store(20);
+  BOOST_CHECK_THROW(UnixShmRing(c, data.data(), CAPACITY), UnixShmRing::Error);
+
+  // not empty
+  c.head.store(16);
+  c.tail.store(0);
+  BOOST_CHECK_THROW(UnixShmRing(c, data.data(), CAPACITY), UnixShmRing::Error);
+
+  // tail ahead of head
+  c.head.store(0);
+  c.tail.store(16);
+  BOOST_CHECK_THROW(UnixShmRing(c, data.data(), CAPACITY), UnixShmRing::Error);
+
+  // beyond the capacity
+  c.head.store(CAPACITY);
+  c.tail.store(CAPACITY);
+  BOOST_CHECK_THROW(UnixShmRing(c, data.data(), CAPACITY), UnixShmRing::Error);
+}
+
+BOOST_AUTO_TEST_CASE(HeadOutOfRange)
+{
+  control.head.store(CAPACITY + 8);
+  BOOST_CHECK_EQUAL(popAll(false).size(), 0);
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(Region)
+{
+  auto region = UnixShmRegion::create(UnixShmRegion::MIN_RING_CAPACITY);
+  BOOST_CHECK_EQUAL(region->getRingCapacity(), UnixShmRegion::MIN_RING_CAPACITY);
+
+  int fd = ::dup(region->getFd());
+  BOOST_REQUIRE_GE(fd, 0);
+  auto attached = UnixShmRegion::attach(fd);
+  BOOST_CHECK_EQUAL(attached->getRingCapacity(), UnixShmRegion::MIN_RING_CAPACITY);
+
+  UnixShmRing appTx(region->getControl(UnixShmRegion::TO_NFD),
+                    region->getData(UnixShmRegion::TO_NFD), region->getRingCapacity());
+  UnixShmRing nfdRx(attached->getControl(UnixShmRegion::TO_NFD),
+                    attached->getData(UnixShmRegion::TO_NFD), attached->getRingCapacity());
+
+  const std::vector<uint8_t> rec{0x05, 0x00};
+  bool shouldNotify = false;
+  BOOST_CHECK(appTx.push(rec.data(), rec.size(), shouldNotify));
+
+  size_t nRecords = 0;
+  BOOST_CHECK(nfdRx.pop([&] (const uint8_t* payload, size_t length) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(payload, payload + length, rec.begin(), rec.end());
+    ++nRecords;
+  }, shouldNotify));
+  BOOST_CHECK_EQUAL(nRecords, 1);
+}
+
+BOOST_AUTO_TEST_CASE(AttachInvalid)
+{
+  BOOST_CHECK_THROW(UnixShmRegion::create(1000), UnixShmRegion::Error);
+
+  // not sealed
+  int fd = ::memfd_create("nfd-test", MFD_CLOEXEC);
+  BOOST_REQUIRE_GE(fd, 0);
+  BOOST_CHECK_EQUAL(::ftruncate(fd, UnixShmRegion::getRegionSize(UnixShmRegion::MIN_RING_CAPACITY)), 0);
+  BOOST_CHECK_THROW(UnixShmRegion::attach(fd), UnixShmRegion::Error);
+
+  // sealed, but without a valid header
+  fd = ::memfd_create("nfd-test", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  BOOST_REQUIRE_GE(fd, 0);
+  BOOST_CHECK_EQUAL(::ftruncate(fd, UnixShmRegion::getRegionSize(UnixShmRegion::MIN_RING_CAPACITY)), 0);
+  BOOST_CHECK_EQUAL(::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK), 0);
+  BOOST_CHECK_THROW(UnixShmRegion::attach(fd), UnixShmRegion::Error);
+}
+#endif // __linux__
+
+BOOST_AUTO_TEST_SUITE_END() // TestUnixShmRing
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
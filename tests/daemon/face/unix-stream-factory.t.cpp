@@ -63,6 +63,31 @@ BOOST_AUTO_TEST_CASE(Normal)
   BOOST_CHECK_NE(uri.getPath().find("nfd-test.sock"), std::string::npos);
 }
 
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(ShmPath)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        shm_path /tmp/nfd-test-shm.sock
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(factory.getChannels().size(), 0);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, {"unix:///tmp/nfd-test.sock", "unix:///tmp/nfd-test-shm.sock"});
+  for (const auto& channel : factory.getChannels()) {
+    BOOST_CHECK_EQUAL(channel->isListening(), true);
+  }
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_CASE(Omitted)
 {
   const std::string CONFIG = R"CONFIG(
@@ -77,6 +102,53 @@ BOOST_AUTO_TEST_CASE(Omitted)
   BOOST_CHECK_EQUAL(factory.getChannels().size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(SendBatchLimits)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        send_batch_packets 16
+        send_batch_bytes 8800
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(factory.getChannels().size(), 1);
+
+  const std::string CONFIG_ZERO_PACKETS = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        send_batch_packets 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_PACKETS, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_PACKETS, false), ConfigFile::Error);
+
+  const std::string CONFIG_ZERO_BYTES = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        send_batch_bytes 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_BYTES, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG_ZERO_BYTES, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownOption)
 {
   const std::string CONFIG = R"CONFIG(
@@ -121,6 +193,17 @@ BOOST_AUTO_TEST_CASE(CreateChannel)
   BOOST_CHECK_NE(channel1, channel2);
 }
 
+BOOST_AUTO_TEST_CASE(CreateShmChannel)
+{
+  auto channel1 = factory.createShmChannel(CHANNEL_PATH1);
+  auto channel1a = factory.createShmChannel(CHANNEL_PATH1);
+  BOOST_CHECK_EQUAL(channel1, channel1a);
+
+  // a stream channel on another path is a separate channel
+  factory.createChannel(CHANNEL_PATH2);
+  BOOST_CHECK_EQUAL(factory.getChannels().size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(UnsupportedCreateFace)
 {
   createFace(factory,
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_TESTS_DAEMON_FACE_VETH_FIXTURE_HPP
+#define NFD_TESTS_DAEMON_FACE_VETH_FIXTURE_HPP
+
+#include "face/ethernet-protocol.hpp"
+
+#include "tests/daemon/global-io-fixture.hpp"
+#include "test-netif.hpp"
+
+#include <cstdlib>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+#define NFD_TEST_VETH0_NAME "nfdtest-veth0"
+#define NFD_TEST_VETH1_NAME "nfdtest-veth1"
+
+/** \brief Fixture that creates a pair of connected virtual Ethernet interfaces.
+ *
+ *  Frames sent on one interface of the pair are received on the other one, which lets tests
+ *  exercise the receive path of Ethernet faces without relying on external traffic.
+ *  Creating the pair requires the \c ip utility and CAP_NET_ADMIN; if that fails, \c veth0 and
+ *  \c veth1 are null, and tests should use SKIP_IF_NO_VETH_PAIR() to skip themselves.
+ *  The pair is deleted when the fixture is destroyed.
+ */
+class VethFixture : public virtual GlobalIoFixture
+{
+protected:
+  VethFixture()
+  {
+#ifdef __linux__
+    // remove a pair left behind by an aborted test run, if any
+    static_cast<void>(std::system("ip link del " NFD_TEST_VETH0_NAME " >/dev/null 2>&1"));
+    if (std::system("ip link add " NFD_TEST_VETH0_NAME " type veth peer name " NFD_TEST_VETH1_NAME
+                    " >/dev/null 2>&1") != 0) {
+      return;
+    }
+    m_isCreated = true;
+    if (std::system("ip link set " NFD_TEST_VETH0_NAME " up >/dev/null 2>&1") != 0 ||
+        std::system("ip link set " NFD_TEST_VETH1_NAME " up >/dev/null 2>&1") != 0) {
+      return;
+    }
+
+    for (const auto& netif : collectNetworkInterfaces(false)) {
+      if (netif->getName() == NFD_TEST_VETH0_NAME) {
+        veth0 = netif;
+      }
+      else if (netif->getName() == NFD_TEST_VETH1_NAME) {
+        veth1 = netif;
+      }
+    }
+    if (veth0 == nullptr || veth1 == nullptr) {
+      veth0 = veth1 = nullptr;
+    }
+#endif // __linux__
+  }
+
+  ~VethFixture()
+  {
+    if (m_isCreated) {
+      // deleting one end deletes the pair
+      static_cast<void>(std::system("ip link del " NFD_TEST_VETH0_NAME " >/dev/null 2>&1"));
+      // do not let later tests find the deleted interfaces in the cached list
+      collectNetworkInterfaces(false);
+    }
+  }
+
+public:
+  /** \brief Returns an NDN Ethernet frame carrying \p payload, padded to the minimum frame size
+   */
+  static std::vector<uint8_t>
+  makeNdnFrame(const ethernet::Address& dst, const ethernet::Address& src, const Block& payload)
+  {
+    std::vector<uint8_t> frame(dst.begin(), dst.end());
+    frame.insert(frame.end(), src.begin(), src.end());
+    frame.push_back(ethernet::ETHERTYPE_NDN >> 8);
+    frame.push_back(ethernet::ETHERTYPE_NDN & 0xFF);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    frame.resize(std::max(frame.size(), ethernet::HDR_LEN + ethernet::MIN_DATA_LEN));
+    return frame;
+  }
+
+protected:
+  shared_ptr<const ndn::net::NetworkInterface> veth0;
+  shared_ptr<const ndn::net::NetworkInterface> veth1;
+
+private:
+  bool m_isCreated = false;
+};
+
+#define SKIP_IF_NO_VETH_PAIR() \
+  do { \
+    if (this->veth0 == nullptr) { \
+      BOOST_WARN_MESSAGE(false, "skipping assertions that require a veth pair " \
+                                "(needs CAP_NET_ADMIN and the ip utility)"); \
+      return; \
+    } \
+  } while (false)
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_TESTS_DAEMON_FACE_VETH_FIXTURE_HPP
@@ -31,6 +31,8 @@
 // sorted alphabetically.
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/cache-affinity-strategy.hpp"
+#include "fw/congestion-aware-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 #include "fw/random-strategy.hpp"
 
@@ -89,6 +91,8 @@ BOOST_AUTO_TEST_SUITE(TestAdHocForwarding)
 using Strategies = boost::mpl::vector<
   AsfStrategy,
   BestRouteStrategy2,
+  CacheAffinityStrategy,
+  CongestionAwareStrategy,
   MulticastStrategy,
   RandomStrategy
 >;
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/cache-affinity-strategy.hpp"
+#include "common/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "strategy-tester.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using CacheAffinityStrategyTester = StrategyTester<CacheAffinityStrategy>;
+NFD_REGISTER_STRATEGY(CacheAffinityStrategyTester);
+
+BOOST_AUTO_TEST_SUITE(Fw)
+
+class CacheAffinityStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  CacheAffinityStrategyFixture()
+    : face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+    , face4(make_shared<DummyFace>())
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+    faceTable.add(face3);
+    faceTable.add(face4);
+  }
+
+  /** \brief deliver a new Interest from face1 to the strategy
+   *  \return FaceId of the chosen upstream, or INVALID_FACEID if nothing was sent
+   */
+  FaceId
+  forwardNewInterest(const Name& name)
+  {
+    auto interest = makeInterest(name);
+    auto pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(*face1, *interest);
+
+    size_t nSent = strategy.sendInterestHistory.size();
+    strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+    pit.erase(pitEntry.get());
+
+    if (strategy.sendInterestHistory.size() == nSent) {
+      return face::INVALID_FACEID;
+    }
+    return strategy.sendInterestHistory.back().outFaceId;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  CacheAffinityStrategyTester strategy{forwarder, CacheAffinityStrategyTester::getStrategyName()
+                                                  .append("prefix-length~2")};
+  Fib& fib{forwarder.getFib()};
+  Pit& pit{forwarder.getPit()};
+
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+  shared_ptr<DummyFace> face4;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCacheAffinityStrategy, CacheAffinityStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(Parameters)
+{
+  BOOST_CHECK_EQUAL(strategy.getPrefixLength(), 2);
+
+  CacheAffinityStrategy defaultInstance(forwarder);
+  BOOST_CHECK_EQUAL(defaultInstance.getPrefixLength(), 0);
+
+  Name name = CacheAffinityStrategy::getStrategyName();
+  BOOST_CHECK_THROW(CacheAffinityStrategy(forwarder, Name(name).append("prefix-length~-1")),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(CacheAffinityStrategy(forwarder, Name(name).append("prefix-length~x")),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(CacheAffinityStrategy(forwarder, Name(name).append("prefix-length")),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(CacheAffinityStrategy(forwarder, Name(name).append("unknown~1")),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Affinity)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fib.addOrUpdateNextHop(fibEntry, *face2, 10);
+  fib.addOrUpdateNextHop(fibEntry, *face3, 10);
+  fib.addOrUpdateNextHop(fibEntry, *face4, 10);
+
+  std::map<FaceId, int> load;
+  for (int i = 0; i < 300; ++i) {
+    Name object("/A/" + to_string(i));
+    FaceId first = forwardNewInterest(Name(object).append("seg0"));
+    BOOST_REQUIRE_NE(first, face::INVALID_FACEID);
+    // all segments of the same object go to the same upstream
+    BOOST_CHECK_EQUAL(forwardNewInterest(Name(object).append("seg1")), first);
+    BOOST_CHECK_EQUAL(forwardNewInterest(Name(object).append("seg2")), first);
+    ++load[first];
+  }
+
+  // the namespace is spread across all upstreams
+  BOOST_CHECK_EQUAL(load.count(face1->getId()), 0);
+  BOOST_CHECK_GE(load[face2->getId()], 50);
+  BOOST_CHECK_GE(load[face3->getId()], 50);
+  BOOST_CHECK_GE(load[face4->getId()], 50);
+}
+
+BOOST_AUTO_TEST_CASE(CostWeight)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fib.addOrUpdateNextHop(fibEntry, *face2, 0);
+  fib.addOrUpdateNextHop(fibEntry, *face3, 3);
+
+  std::map<FaceId, int> load;
+  for (int i = 0; i < 1000; ++i) {
+    ++load[forwardNewInterest("/B/" + to_string(i))];
+  }
+
+  // face2 has weight 1, face3 has weight 1/4
+  BOOST_CHECK_GT(load[face2->getId()], load[face3->getId()] * 2);
+  BOOST_CHECK_GT(load[face3->getId()], 0);
+}
+
+BOOST_AUTO_TEST_CASE(MinimalDisruption)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fib.addOrUpdateNextHop(fibEntry, *face2, 10);
+  fib.addOrUpdateNextHop(fibEntry, *face3, 10);
+
+  std::map<int, FaceId> before;
+  for (int i = 0; i < 200; ++i) {
+    before[i] = forwardNewInterest("/C/" + to_string(i));
+  }
+
+  // adding an upstream only moves Interests onto the new upstream
+  fib.addOrUpdateNextHop(fibEntry, *face4, 10);
+  for (int i = 0; i < 200; ++i) {
+    FaceId after = forwardNewInterest("/C/" + to_string(i));
+    if (after != face4->getId()) {
+      BOOST_CHECK_EQUAL(after, before[i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RetransmissionFailover)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fib.addOrUpdateNextHop(fibEntry, *face2, 10);
+  fib.addOrUpdateNextHop(fibEntry, *face3, 10);
+
+  auto interest = makeInterest("/D/1");
+  auto pitEntry = pit.insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(*face1, *interest);
+  strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  FaceId preferred = strategy.sendInterestHistory.back().outFaceId;
+
+  // retransmission within suppression interval is suppressed
+  strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+
+  // retransmission after suppression interval goes to the other upstream
+  this->advanceClocks(CacheAffinityStrategy::RETX_SUPPRESSION_INITIAL * 2);
+  strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_NE(strategy.sendInterestHistory.back().outFaceId, preferred);
+}
+
+BOOST_AUTO_TEST_CASE(NackFailover)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fib.addOrUpdateNextHop(fibEntry, *face2, 10);
+  fib.addOrUpdateNextHop(fibEntry, *face3, 10);
+
+  auto interest = makeInterest("/E/1", false, nullopt, 1535);
+  auto pitEntry = pit.insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(*face1, *interest);
+  strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  Face* first = faceTable.get(strategy.sendInterestHistory.back().outFaceId);
+  Face* second = first == face2.get() ? face3.get() : face2.get();
+
+  // Nack from the preferred upstream causes failover to the other upstream
+  lp::Nack nack1 = makeNack(*interest, lp::NackReason::CONGESTION);
+  pitEntry->getOutRecord(*first)->setIncomingNack(nack1);
+  strategy.afterReceiveNack(FaceEndpoint(*first), nack1, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, second->getId());
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+
+  // once every upstream has returned a Nack, a Nack is returned downstream
+  lp::Nack nack2 = makeNack(*interest, lp::NackReason::NO_ROUTE);
+  pitEntry->getOutRecord(*second)->setIncomingNack(nack2);
+  strategy.afterReceiveNack(FaceEndpoint(*second), nack2, pitEntry);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_REQUIRE_EQUAL(strategy.sendNackHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.back().outFaceId, face1->getId());
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.back().header.getReason(), lp::NackReason::CONGESTION);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCacheAffinityStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/congestion-aware-strategy.hpp"
+#include "common/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+#include "strategy-tester.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using CongestionAwareStrategyTester = StrategyTester<CongestionAwareStrategy>;
+NFD_REGISTER_STRATEGY(CongestionAwareStrategyTester);
+
+BOOST_AUTO_TEST_SUITE(Fw)
+
+class CongestionAwareStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  CongestionAwareStrategyFixture()
+    : face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+    faceTable.add(face3);
+
+    fibEntry = fib.insert(Name()).first;
+    fib.addOrUpdateNextHop(*fibEntry, *face2, 10);
+    fib.addOrUpdateNextHop(*fibEntry, *face3, 20);
+  }
+
+  shared_ptr<pit::Entry>
+  receiveNewInterest(const shared_ptr<Interest>& interest)
+  {
+    auto pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(*face1, *interest);
+    strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+    return pitEntry;
+  }
+
+  double
+  getShare(const Interest& interest, const Face& face)
+  {
+    auto& mi = strategy.getOrCreateMtInfo(*fibEntry, interest);
+    auto stats = mi.getFaceStats(face.getId());
+    return stats == nullptr ? 0.0 : stats->share;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  CongestionAwareStrategyTester& strategy{choose<CongestionAwareStrategyTester>(forwarder)};
+  Fib& fib{forwarder.getFib()};
+  Pit& pit{forwarder.getPit()};
+  fib::Entry* fibEntry;
+
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCongestionAwareStrategy, CongestionAwareStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(InitialLowestCost)
+{
+  for (int i = 0; i < 50; ++i) {
+    receiveNewInterest(makeInterest("/A/" + to_string(i)));
+  }
+
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 50);
+  for (const auto& sent : strategy.sendInterestHistory) {
+    BOOST_CHECK_EQUAL(sent.outFaceId, face2->getId());
+  }
+  BOOST_CHECK_EQUAL(getShare(*makeInterest("/A"), *face2), 1.0);
+  BOOST_CHECK_EQUAL(getShare(*makeInterest("/A"), *face3), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(ShiftOnCongestionMark)
+{
+  size_t nToFace3 = 0;
+  for (int i = 0; i < 30; ++i) {
+    auto interest = makeInterest("/A/" + to_string(i));
+    auto pitEntry = receiveNewInterest(interest);
+    BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), static_cast<size_t>(i + 1));
+    FaceId outFaceId = strategy.sendInterestHistory.back().outFaceId;
+
+    this->advanceClocks(10_ms);
+
+    // the path through face2 is congested
+    auto data = makeData(interest->getName());
+    if (outFaceId == face2->getId()) {
+      data->setCongestionMark(1);
+    }
+    else {
+      ++nToFace3;
+    }
+    strategy.beforeSatisfyInterest(pitEntry, FaceEndpoint(*faceTable.get(outFaceId)), *data);
+    pit.erase(pitEntry.get());
+  }
+
+  auto interest = makeInterest("/A");
+  double share2 = getShare(*interest, *face2);
+  double share3 = getShare(*interest, *face3);
+  BOOST_CHECK_LT(share2, 0.9);
+  BOOST_CHECK_GT(share3, 0.1);
+  BOOST_CHECK_CLOSE(share2 + share3, 1.0, 0.001);
+  BOOST_CHECK_GT(nToFace3, 0);
+
+  auto& mi = strategy.getOrCreateMtInfo(*fibEntry, *interest);
+  BOOST_CHECK_GT(mi.getFaceStats(face2->getId())->markRate, 0.0);
+  BOOST_CHECK_GT(mi.getFaceStats(face2->getId())->rtt.getSmoothedRtt(), 0_ns);
+}
+
+BOOST_AUTO_TEST_CASE(ShiftOnTimeout)
+{
+  auto interest = makeInterest("/A/1", false, 4_s);
+  auto pitEntry = receiveNewInterest(interest);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, face2->getId());
+
+  // retransmission after the initial RTO
+  this->advanceClocks(100_ms, 1500_ms);
+  strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, face3->getId());
+
+  BOOST_CHECK_CLOSE(getShare(*interest, *face2),
+                    1.0 - CongestionAwareStrategy::SHARE_CHANGE_ON_TIMEOUT, 0.001);
+  BOOST_CHECK_CLOSE(getShare(*interest, *face3),
+                    CongestionAwareStrategy::SHARE_CHANGE_ON_TIMEOUT, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(NackCongestion)
+{
+  auto interest = makeInterest("/A/1", false, nullopt, 2345);
+  auto pitEntry = receiveNewInterest(interest);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, face2->getId());
+
+  // Nack-Congestion is retried on the other upstream
+  lp::Nack nack2 = makeNack(*interest, lp::NackReason::CONGESTION);
+  pitEntry->getOutRecord(*face2)->setIncomingNack(nack2);
+  strategy.afterReceiveNack(FaceEndpoint(*face2), nack2, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, face3->getId());
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+
+  // Nack is returned downstream when no upstream is left
+  lp::Nack nack3 = makeNack(*interest, lp::NackReason::CONGESTION);
+  pitEntry->getOutRecord(*face3)->setIncomingNack(nack3);
+  strategy.afterReceiveNack(FaceEndpoint(*face3), nack3, pitEntry);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_REQUIRE_EQUAL(strategy.sendNackHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.back().outFaceId, face1->getId());
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.back().header.getReason(), lp::NackReason::CONGESTION);
+}
+
+BOOST_AUTO_TEST_CASE(MarkPropagation)
+{
+  auto interest = makeInterest("/A/1");
+  auto pitEntry = receiveNewInterest(interest);
+
+  // congestion mark on Data from upstream is propagated downstream
+  auto data = makeData("/A/1");
+  data->setCongestionMark(1);
+  strategy.afterReceiveData(pitEntry, FaceEndpoint(*face2), *data);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentData.back().getCongestionMark(), 1);
+
+  // congestion mark on a cached Data is removed
+  auto pitEntry2 = receiveNewInterest(makeInterest("/A/2"));
+  auto cached = makeData("/A/2");
+  cached->setCongestionMark(1);
+  strategy.afterContentStoreHit(pitEntry2, FaceEndpoint(*face1), *cached);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face1->sentData.back().getCongestionMark(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCongestionAwareStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -29,6 +29,8 @@
 #include "tests/daemon/global-io-fixture.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
 
+#include <boost/range/adaptor/reversed.hpp>
+
 namespace nfd {
 namespace tests {
 
@@ -137,6 +139,93 @@ BOOST_AUTO_TEST_CASE(Enumerate)
   BOOST_CHECK_EQUAL(hasFace2, true);
 }
 
+BOOST_AUTO_TEST_CASE(EnumerateOrder)
+{
+  FaceTable faceTable;
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 5; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    faceTable.add(faces.back());
+  }
+  faceTable.addReserved(make_shared<DummyFace>(), 3);
+  faces[2]->close();
+
+  std::vector<FaceId> expectedIds{3, faces[0]->getId(), faces[1]->getId(),
+                                  faces[3]->getId(), faces[4]->getId()};
+  std::vector<FaceId> actualIds;
+  for (const Face& face : faceTable) {
+    actualIds.push_back(face.getId());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actualIds.begin(), actualIds.end(),
+                                expectedIds.begin(), expectedIds.end());
+
+  std::reverse(expectedIds.begin(), expectedIds.end());
+  actualIds.clear();
+  for (const Face& face : faceTable | boost::adaptors::reversed) {
+    actualIds.push_back(face.getId());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actualIds.begin(), actualIds.end(),
+                                expectedIds.begin(), expectedIds.end());
+
+  // iterator remains valid when the face it refers to is removed
+  auto it = faceTable.begin();
+  ++it;
+  BOOST_CHECK_EQUAL(it->getId(), faces[0]->getId());
+  faces[0]->close();
+  ++it;
+  BOOST_CHECK_EQUAL(it->getId(), faces[1]->getId());
+}
+
+BOOST_AUTO_TEST_CASE(ManyFaces)
+{
+  FaceTable faceTable;
+  const size_t nFaces = FaceTable::SLOTS_PER_PAGE * 3;
+
+  std::vector<shared_ptr<Face>> faces;
+  for (size_t i = 0; i < nFaces; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    faceTable.add(faces.back());
+  }
+  BOOST_CHECK_EQUAL(faceTable.size(), nFaces);
+  BOOST_CHECK_EQUAL(std::distance(faceTable.begin(), faceTable.end()), nFaces);
+  for (const auto& face : faces) {
+    BOOST_CHECK(faceTable.get(face->getId()) == face.get());
+  }
+
+  // close every face in the second page, so that the page is released
+  const FaceId pageBegin = FaceTable::SLOTS_PER_PAGE;
+  const FaceId pageEnd = FaceTable::SLOTS_PER_PAGE * 2;
+  std::vector<FaceId> closedIds;
+  for (const auto& face : faces) {
+    if (face->getId() >= pageBegin && face->getId() < pageEnd) {
+      closedIds.push_back(face->getId());
+      face->close();
+    }
+  }
+  BOOST_CHECK_EQUAL(closedIds.size(), FaceTable::SLOTS_PER_PAGE);
+  BOOST_CHECK_EQUAL(faceTable.size(), nFaces - closedIds.size());
+  BOOST_CHECK_EQUAL(std::distance(faceTable.begin(), faceTable.end()), faceTable.size());
+  for (FaceId id : closedIds) {
+    BOOST_CHECK(faceTable.get(id) == nullptr);
+  }
+  BOOST_CHECK(faceTable.get(face::INVALID_FACEID) == nullptr);
+  BOOST_CHECK(faceTable.get(std::numeric_limits<FaceId>::max()) == nullptr);
+
+  // FaceIds are not reused after the page is released
+  auto newFace = make_shared<DummyFace>();
+  faceTable.add(newFace);
+  BOOST_CHECK_GT(newFace->getId(), faces.back()->getId());
+  BOOST_CHECK(faceTable.get(newFace->getId()) == newFace.get());
+
+  for (const auto& face : faces) {
+    face->close();
+  }
+  newFace->close();
+  BOOST_CHECK_EQUAL(faceTable.size(), 0);
+  BOOST_CHECK(faceTable.begin() == faceTable.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestFaceTable
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
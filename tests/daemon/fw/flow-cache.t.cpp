@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/flow-cache.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+#include "dummy-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class FlowCacheFixture : public GlobalIoFixture
+{
+protected:
+  FlowCacheFixture()
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+    fib.addOrUpdateNextHop(*fib.insert("/A").first, *face1, 10);
+    flowCache.setLimit(100);
+  }
+
+  shared_ptr<pit::Entry>
+  makePitEntry(const Name& name)
+  {
+    return pit.insert(*makeInterest(name)).first;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  Fib& fib{forwarder.getFib()};
+  Pit& pit{forwarder.getPit()};
+  FlowCache& flowCache{forwarder.getFlowCache()};
+  DummyStrategy& strategyRoot{choose<DummyStrategy>(forwarder, "/", DummyStrategy::getStrategyName())};
+
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestFlowCache, FlowCacheFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  flowCache.setLimit(0);
+  auto pitEntry = makePitEntry("/A/B/1");
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*pitEntry).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(&flowCache.findEffectiveStrategy(*pitEntry), &strategyRoot);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+  BOOST_CHECK_EQUAL(flowCache.nHits, 0);
+  BOOST_CHECK_EQUAL(flowCache.nMisses, 0);
+}
+
+BOOST_AUTO_TEST_CASE(HitWithinFlow)
+{
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*makePitEntry("/A/B/1")).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(flowCache.nMisses, 1);
+
+  // FIB and StrategyChoice entries are at most one component deep, so /A/B/2 is in the same flow
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*makePitEntry("/A/B/2")).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(&flowCache.findEffectiveStrategy(*makePitEntry("/A/C/3")), &strategyRoot);
+  BOOST_CHECK_EQUAL(flowCache.nHits, 2);
+  BOOST_CHECK_EQUAL(flowCache.nMisses, 1);
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*makePitEntry("/Z/1")).getPrefix(), "/");
+  BOOST_CHECK_EQUAL(flowCache.nMisses, 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(FibChange)
+{
+  auto pitEntry = makePitEntry("/A/B/1");
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*pitEntry).getPrefix(), "/A");
+
+  // a change in nexthops invalidates the cached entry
+  fib.addOrUpdateNextHop(*fib.findExactMatch("/A"), *face2, 20);
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*pitEntry).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(flowCache.nInvalidations, 1);
+  BOOST_CHECK_EQUAL(flowCache.nHits, 0);
+
+  // a deeper FIB entry splits the flow
+  fib.addOrUpdateNextHop(*fib.insert("/A/B").first, *face2, 10);
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*pitEntry).getPrefix(), "/A/B");
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*makePitEntry("/A/C/1")).getPrefix(), "/A");
+
+  // the erased FIB entry is not returned
+  fib.erase("/A/B");
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*pitEntry).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(flowCache.nHits, 0);
+
+  // without the deeper entry, the flows are merged again
+  BOOST_CHECK_EQUAL(flowCache.findLongestPrefixMatch(*makePitEntry("/A/C/2")).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(flowCache.nHits, 1);
+}
+
+BOOST_AUTO_TEST_CASE(StrategyChoiceChange)
+{
+  auto pitEntry = makePitEntry("/A/B/1");
+  BOOST_CHECK_EQUAL(&flowCache.findEffectiveStrategy(*pitEntry), &strategyRoot);
+
+  DummyStrategy& strategyAB = choose<DummyStrategy>(forwarder, "/A/B", DummyStrategy::getStrategyName());
+  BOOST_CHECK_EQUAL(&flowCache.findEffectiveStrategy(*pitEntry), &strategyAB);
+  BOOST_CHECK_EQUAL(&flowCache.findEffectiveStrategy(*makePitEntry("/A/C/1")), &strategyRoot);
+  BOOST_CHECK_EQUAL(flowCache.nHits, 0);
+
+  BOOST_CHECK_EQUAL(&flowCache.findEffectiveStrategy(*makePitEntry("/A/B/2")), &strategyAB);
+  BOOST_CHECK_EQUAL(flowCache.nHits, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Limit)
+{
+  flowCache.setLimit(2);
+  flowCache.findLongestPrefixMatch(*makePitEntry("/A/1"));
+  flowCache.findLongestPrefixMatch(*makePitEntry("/B/1"));
+  BOOST_CHECK_EQUAL(flowCache.size(), 2);
+  flowCache.findLongestPrefixMatch(*makePitEntry("/C/1"));
+  BOOST_CHECK_LE(flowCache.size(), 2);
+
+  flowCache.setLimit(1);
+  BOOST_CHECK_LE(flowCache.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFlowCache
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
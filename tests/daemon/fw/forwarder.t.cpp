@@ -98,6 +98,66 @@ BOOST_AUTO_TEST_CASE(SimpleExchange)
   BOOST_CHECK_EQUAL(forwarder.getCounters().nUnsolicitedData, 0);
 }
 
+BOOST_AUTO_TEST_CASE(IngressScheduling)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/A").first, *face2, 0);
+
+  auto options = forwarder.getIngressScheduler().getOptions();
+  options.batchSize = 64;
+  forwarder.getIngressScheduler().setOptions(options);
+
+  // packets are queued per face and processed after returning to the io_service
+  face1->receiveInterest(*makeInterest("/A/B"));
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(forwarder.getIngressScheduler().size(face1->getId()), 1);
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 1);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+
+  face2->receiveData(*makeData("/A/B"));
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 0);
+  this->advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nSatisfiedInterests, 1);
+}
+
+BOOST_AUTO_TEST_CASE(LatencyTracing)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/A").first, *face2, 0);
+
+  auto stats = make_shared<face::LatencyStats>();
+  auto interest = makeInterest("/A/B");
+  interest->setTag(make_shared<face::PacketTraceTag>(make_shared<face::PacketTrace>(stats)));
+  face1->receiveInterest(*interest);
+  this->advanceClocks(1_ms);
+
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::INCOMING).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::CS_LOOKUP).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::STRATEGY).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::SEND).getCount(), 1);
+
+  // the Interest kept in the PIT entry is no longer traced
+  auto pitEntry = forwarder.getPit().find(*interest);
+  BOOST_REQUIRE(pitEntry != nullptr);
+  BOOST_CHECK(pitEntry->getInterest().getTag<face::PacketTraceTag>() == nullptr);
+
+  // untraced Interests are not recorded
+  face1->receiveInterest(*makeInterest("/A/C"));
+  this->advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::INCOMING).getCount(), 1);
+  BOOST_CHECK_EQUAL(stats->get(TraceStage::SEND).getCount(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(CsMatched)
 {
   auto face1 = addFace();
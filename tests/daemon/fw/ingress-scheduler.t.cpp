@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/ingress-scheduler.hpp"
+#include "common/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class IngressSchedulerFixture : public GlobalIoTimeFixture
+{
+protected:
+  void
+  enable(size_t batchSize, size_t queueCapacity = 1000)
+  {
+    IngressScheduler::Options options;
+    options.batchSize = batchSize;
+    options.queueCapacity = queueCapacity;
+    scheduler.setOptions(options);
+  }
+
+  bool
+  schedule(FaceId faceId)
+  {
+    return scheduler.schedule(faceId, [this, faceId] { processed.push_back(faceId); });
+  }
+
+protected:
+  IngressScheduler scheduler;
+  std::vector<FaceId> processed;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestIngressScheduler, IngressSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  BOOST_CHECK_EQUAL(scheduler.isEnabled(), false);
+  enable(64);
+  BOOST_CHECK_EQUAL(scheduler.isEnabled(), true);
+
+  // packets queued while enabled are still processed after disabling
+  schedule(1);
+  schedule(1);
+  enable(0);
+  BOOST_CHECK_EQUAL(scheduler.isEnabled(), false);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(processed.size(), 2);
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Weights)
+{
+  enable(100);
+  scheduler.setWeight(2, 3);
+  BOOST_CHECK_EQUAL(scheduler.getWeight(1), 1);
+  BOOST_CHECK_EQUAL(scheduler.getWeight(2), 3);
+
+  for (int i = 0; i < 100; ++i) {
+    schedule(1);
+    schedule(2);
+  }
+  BOOST_CHECK_EQUAL(scheduler.size(), 200);
+  BOOST_CHECK_EQUAL(scheduler.size(2), 100);
+  BOOST_CHECK(processed.empty());
+
+  advanceClocks(1_ms, 10_ms);
+  BOOST_REQUIRE_EQUAL(processed.size(), 200);
+  // while both faces are backlogged, each face's share matches its weight
+  BOOST_CHECK_EQUAL(std::count(processed.begin(), processed.begin() + 100, 1), 25);
+  BOOST_CHECK_EQUAL(std::count(processed.begin(), processed.begin() + 100, 2), 75);
+}
+
+BOOST_AUTO_TEST_CASE(YieldBetweenBatches)
+{
+  enable(10);
+  int nProcessedBeforeIo = -1;
+  scheduler.schedule(1, [&] {
+    processed.push_back(1);
+    getGlobalIoService().post([&] { nProcessedBeforeIo = static_cast<int>(processed.size()); });
+  });
+  for (int i = 0; i < 29; ++i) {
+    schedule(1);
+  }
+
+  advanceClocks(1_ms, 10_ms);
+  BOOST_CHECK_EQUAL(processed.size(), 30);
+  BOOST_CHECK_GE(nProcessedBeforeIo, 10);
+  BOOST_CHECK_LT(nProcessedBeforeIo, 30);
+}
+
+BOOST_AUTO_TEST_CASE(QueueFull)
+{
+  enable(64, 2);
+  BOOST_CHECK_EQUAL(schedule(1), true);
+  BOOST_CHECK_EQUAL(schedule(1), true);
+  BOOST_CHECK_EQUAL(schedule(1), false);
+  BOOST_CHECK_EQUAL(schedule(2), true);
+  BOOST_CHECK_EQUAL(scheduler.nDropped, 1);
+
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(processed.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFace)
+{
+  enable(64);
+  for (int i = 0; i < 5; ++i) {
+    schedule(1);
+    schedule(2);
+  }
+  scheduler.removeFace(1);
+  BOOST_CHECK_EQUAL(scheduler.size(), 5);
+  BOOST_CHECK_EQUAL(scheduler.size(1), 0);
+
+  // a face removed while its packet is being processed
+  scheduler.schedule(3, [this] {
+    processed.push_back(3);
+    scheduler.removeFace(3);
+  });
+  schedule(3);
+
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(std::count(processed.begin(), processed.end(), 1), 0);
+  BOOST_CHECK_EQUAL(std::count(processed.begin(), processed.end(), 2), 5);
+  BOOST_CHECK_EQUAL(std::count(processed.begin(), processed.end(), 3), 1);
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestIngressScheduler
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -124,6 +124,7 @@ BOOST_AUTO_TEST_CASE(Exponential)
   BOOST_CHECK(rs.decidePerPitEntry(*pitEntry) == RetxSuppressionResult::FORWARD);
   pitEntry->insertOrUpdateOutRecord(*face2, *interest);
   // suppression interval is 30ms, until 41ms
+  BOOST_CHECK_EQUAL(pitEntry->retxSuppressionInterval, 30_ms);
 
   this->advanceClocks(25_ms); // @ 36ms
   pitEntry->insertOrUpdateInRecord(*face1, *interest);
@@ -195,6 +196,7 @@ BOOST_AUTO_TEST_CASE(ExponentialPerUpstream)
   BOOST_CHECK(rs.decidePerUpstream(*pitEntry, *face2) == RetxSuppressionResult::FORWARD);
   // Assume interest is sent and increment interval
   rs.incrementIntervalForOutRecord(*pitEntry->getOutRecord(*face2));
+  BOOST_CHECK_EQUAL(pitEntry->getOutRecord(*face2)->retxSuppressionInterval, 30_ms);
 
   pitEntry->insertOrUpdateInRecord(*face2, *interest);
   BOOST_CHECK(rs.decidePerUpstream(*pitEntry, *face2) == RetxSuppressionResult::SUPPRESS);
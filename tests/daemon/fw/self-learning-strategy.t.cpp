@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/self-learning-strategy.hpp"
+#include "common/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/key-chain-fixture.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+#include "strategy-tester.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using SelfLearningStrategyTester = StrategyTester<SelfLearningStrategy>;
+NFD_REGISTER_STRATEGY(SelfLearningStrategyTester);
+
+BOOST_AUTO_TEST_SUITE(Fw)
+
+class SelfLearningStrategyFixture : public GlobalIoTimeFixture, public KeyChainFixture
+{
+protected:
+  SelfLearningStrategyFixture()
+    : face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+    faceTable.add(face3);
+  }
+
+  shared_ptr<pit::Entry>
+  receiveDiscoveryInterest(const Name& name)
+  {
+    auto interest = makeInterest(name);
+    auto pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(*face1, *interest);
+    strategy.afterReceiveInterest(FaceEndpoint(*face1), *interest, pitEntry);
+    return pitEntry;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  SelfLearningStrategyTester& strategy{choose<SelfLearningStrategyTester>(forwarder)};
+  Pit& pit{forwarder.getPit()};
+
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSelfLearningStrategy, SelfLearningStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(Parameters)
+{
+  Name prefix = SelfLearningStrategy::getStrategyName();
+  SelfLearningStrategy s1(forwarder, Name(prefix).append("discovery-interval~50")
+                                                  .append("discovery-max-interval~2000"));
+  BOOST_CHECK_EQUAL(s1.m_discoveryInterval, 50_ms);
+  BOOST_CHECK_EQUAL(s1.m_maxDiscoveryInterval, 2_s);
+
+  BOOST_CHECK_THROW(SelfLearningStrategy(forwarder, Name(prefix).append("discovery-interval~-1")),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(SelfLearningStrategy(forwarder, Name(prefix).append("discovery-interval~20000")),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(SelfLearningStrategy(forwarder, Name(prefix).append("unknown~1")),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(DiscoveryRateLimit)
+{
+  // first discovery Interest under /A is broadcast to face2 and face3
+  receiveDiscoveryInterest("/A/1");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+
+  // within the discovery interval, further discovery Interests are held
+  this->advanceClocks(10_ms, 50_ms);
+  receiveDiscoveryInterest("/A/2");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 2);
+
+  // a different prefix is not affected
+  receiveDiscoveryInterest("/B/1");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 4);
+
+  // after the interval, discovery is broadcast again, and the interval is doubled
+  this->advanceClocks(10_ms, 60_ms);
+  receiveDiscoveryInterest("/A/3");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 6);
+
+  this->advanceClocks(10_ms, 150_ms);
+  receiveDiscoveryInterest("/A/4");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 6);
+
+  this->advanceClocks(10_ms, 60_ms);
+  receiveDiscoveryInterest("/A/5");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 8);
+  BOOST_CHECK_EQUAL(strategy.rejectPendingInterestHistory.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseHeldOnRouteLearned)
+{
+  auto pitEntry1 = receiveDiscoveryInterest("/A/1");
+  receiveDiscoveryInterest("/A/2");
+  receiveDiscoveryInterest("/A/3");
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+
+  auto data = makeData("/A/1");
+  auto pa = signPrefixAnn(makePrefixAnn("/A", 1_h), m_keyChain);
+  data->setTag(make_shared<lp::PrefixAnnouncementTag>(lp::PrefixAnnouncementHeader(pa)));
+  strategy.afterReceiveData(pitEntry1, FaceEndpoint(*face2), *data);
+
+  // held Interests are forwarded to the learned face as non-discovery Interests
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 4);
+  for (size_t i = 2; i < 4; ++i) {
+    BOOST_CHECK_EQUAL(strategy.sendInterestHistory[i].outFaceId, face2->getId());
+    BOOST_CHECK(strategy.sendInterestHistory[i].interest.getTag<lp::NonDiscoveryTag>() != nullptr);
+  }
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[2].interest.getName(), "/A/2");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory[3].interest.getName(), "/A/3");
+
+  // the announcement is queued for the RIB thread, which does not exist in this test
+  BOOST_CHECK_EQUAL(strategy.m_pendingAnnouncements.size(), 1);
+  strategy.m_announceFlushEvent.cancel();
+  strategy.m_pendingAnnouncements.clear();
+
+  // discovery state is reset, so the next discovery Interest under /A is broadcast without backoff
+  this->advanceClocks(10_ms, 110_ms);
+  receiveDiscoveryInterest("/A/4");
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(BatchAnnouncements)
+{
+  // the RIB io_service is never run, so tasks posted to it can be counted
+  boost::asio::io_service ribIo;
+  setRibIoService(&ribIo);
+
+  auto receivePrefixAnn = [this] (const Name& name, const Name& prefix, Face& inFace) {
+    auto pitEntry = receiveDiscoveryInterest(name);
+    auto data = makeData(name);
+    auto pa = signPrefixAnn(makePrefixAnn(prefix, 1_h), m_keyChain);
+    data->setTag(make_shared<lp::PrefixAnnouncementTag>(lp::PrefixAnnouncementHeader(pa)));
+    strategy.afterReceiveData(pitEntry, FaceEndpoint(inFace), *data);
+  };
+
+  receivePrefixAnn("/A/1", "/A", *face2);
+  receivePrefixAnn("/B/1", "/B", *face3);
+  this->advanceClocks(1_ms, 2_ms);
+  receivePrefixAnn("/C/1", "/C", *face2);
+  // the same prefix on the same face replaces the queued announcement
+  receivePrefixAnn("/X/1", "/A", *face2);
+  BOOST_CHECK_EQUAL(strategy.m_pendingAnnouncements.size(), 3);
+
+  // nothing is handed to the RIB thread before the batch delay elapses
+  this->advanceClocks(1_ms, SelfLearningStrategy::ANNOUNCE_BATCH_DELAY - 3_ms);
+  BOOST_CHECK_EQUAL(strategy.m_pendingAnnouncements.size(), 3);
+  BOOST_CHECK_EQUAL(ribIo.poll_one(), 0);
+
+  // all announcements are handed over in a single task, which needs the RIB service
+  this->advanceClocks(1_ms, 2_ms);
+  BOOST_CHECK_EQUAL(strategy.m_pendingAnnouncements.size(), 0);
+  BOOST_CHECK_THROW(ribIo.poll_one(), std::logic_error);
+  BOOST_CHECK_EQUAL(ribIo.poll_one(), 0);
+
+  // a later announcement starts a new batch
+  receivePrefixAnn("/D/1", "/D", *face3);
+  BOOST_CHECK_EQUAL(strategy.m_pendingAnnouncements.size(), 1);
+  this->advanceClocks(1_ms, SelfLearningStrategy::ANNOUNCE_BATCH_DELAY);
+  BOOST_CHECK_THROW(ribIo.poll_one(), std::logic_error);
+  BOOST_CHECK_EQUAL(ribIo.poll_one(), 0);
+
+  setRibIoService(nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSelfLearningStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
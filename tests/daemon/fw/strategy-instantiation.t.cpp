@@ -32,6 +32,8 @@
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/cache-affinity-strategy.hpp"
+#include "fw/congestion-aware-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 #include "fw/ncc-strategy.hpp"
 #include "fw/self-learning-strategy.hpp"
@@ -79,9 +81,11 @@ using Tests = boost::mpl::vector<
   Test<AsfStrategy, true, 3>,
   Test<BestRouteStrategy, false, 1>,
   Test<BestRouteStrategy2, false, 5>,
+  Test<CacheAffinityStrategy, true, 1>,
+  Test<CongestionAwareStrategy, false, 1>,
   Test<MulticastStrategy, false, 3>,
   Test<NccStrategy, false, 1>,
-  Test<SelfLearningStrategy, false, 2>,
+  Test<SelfLearningStrategy, true, 2>,
   Test<RandomStrategy, false, 1>
 >;
 
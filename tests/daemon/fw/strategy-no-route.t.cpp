@@ -32,6 +32,8 @@
 // sorted alphabetically.
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/cache-affinity-strategy.hpp"
+#include "fw/congestion-aware-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 #include "fw/random-strategy.hpp"
 
@@ -151,6 +153,14 @@ using Tests = boost::mpl::vector<
   Test<BestRouteStrategy2, NextHopIsDownstream<BestRouteStrategy2>>,
   Test<BestRouteStrategy2, NextHopViolatesScope<BestRouteStrategy2>>,
 
+  Test<CacheAffinityStrategy, EmptyNextHopList<CacheAffinityStrategy>>,
+  Test<CacheAffinityStrategy, NextHopIsDownstream<CacheAffinityStrategy>>,
+  Test<CacheAffinityStrategy, NextHopViolatesScope<CacheAffinityStrategy>>,
+
+  Test<CongestionAwareStrategy, EmptyNextHopList<CongestionAwareStrategy>>,
+  Test<CongestionAwareStrategy, NextHopIsDownstream<CongestionAwareStrategy>>,
+  Test<CongestionAwareStrategy, NextHopViolatesScope<CongestionAwareStrategy>>,
+
   Test<MulticastStrategy, EmptyNextHopList<MulticastStrategy>>,
   Test<MulticastStrategy, NextHopIsDownstream<MulticastStrategy>>,
   Test<MulticastStrategy, NextHopViolatesScope<MulticastStrategy>>,
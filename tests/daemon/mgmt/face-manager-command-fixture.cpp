@@ -36,7 +36,7 @@ FaceManagerCommandNode::FaceManagerCommandNode(ndn::KeyChain& keyChain, uint16_t
   , dispatcher(face, keyChain, ndn::security::SigningInfo())
   , authenticator(CommandAuthenticator::create())
   , faceSystem(faceTable, make_shared<ndn::net::NetworkMonitorStub>(0))
-  , manager(faceSystem, dispatcher, *authenticator)
+  , manager(faceSystem, ingressScheduler, dispatcher, *authenticator)
 {
   dispatcher.addTopPrefix("/localhost/nfd");
 
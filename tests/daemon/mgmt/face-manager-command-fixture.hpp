@@ -55,6 +55,7 @@ public:
 
   FaceTable faceTable;
   FaceSystem faceSystem;
+  fw::IngressScheduler ingressScheduler;
   FaceManager manager;
 };
 
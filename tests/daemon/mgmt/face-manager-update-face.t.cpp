@@ -24,11 +24,13 @@
  */
 
 #include "mgmt/face-manager.hpp"
+#include "core/face-link-options.hpp"
 #include "face/generic-link-service.hpp"
 
 #include "face-manager-command-fixture.hpp"
 #include "tests/daemon/face/dummy-transport.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
 #include <thread>
@@ -308,6 +310,229 @@ BOOST_AUTO_TEST_CASE(UpdateMtuUnsupportedFace)
   });
 }
 
+BOOST_AUTO_TEST_CASE(UpdateRateLimits)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  FaceLinkOptions limits;
+  limits.interestRate = 100;
+  limits.dataRate = 2000000;
+  limits.dataBurst = 64000;
+  ControlParameters updateParams;
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(limits.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+    BOOST_TEST_MESSAGE(actual.getText());
+
+    ControlParameters actualParams(actual.getBody());
+    BOOST_CHECK(actualParams.hasFaceId());
+    FaceLinkOptions actualLimits(actual.getBody());
+    BOOST_CHECK_EQUAL(actualLimits.interestRate.value_or(0), 100);
+    BOOST_CHECK_EQUAL(actualLimits.interestBurst.value_or(0), 100);
+    BOOST_CHECK_EQUAL(actualLimits.dataRate.value_or(0), 2000000);
+    BOOST_CHECK_EQUAL(actualLimits.dataBurst.value_or(0), 64000);
+    // packing is always reported in the response
+    BOOST_CHECK_EQUAL(actualLimits.wantPacking.value_or(true), false);
+  });
+
+  auto linkService = dynamic_cast<face::GenericLinkService*>(
+                       node1.faceTable.get(faceId)->getLinkService());
+  BOOST_REQUIRE(linkService != nullptr);
+  BOOST_CHECK_EQUAL(linkService->getOptions().interestPolicer.rate, 100);
+  BOOST_CHECK_EQUAL(linkService->getOptions().interestPolicer.burst, 100);
+  BOOST_CHECK_EQUAL(linkService->getOptions().dataShaper.rate, 2000000);
+  BOOST_CHECK_EQUAL(linkService->getOptions().dataShaper.burst, 64000);
+
+  // a zero rate disables the limit, which is then absent from the response
+  limits = FaceLinkOptions();
+  limits.interestRate = 0;
+  updateParams = ControlParameters();
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(limits.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+
+    FaceLinkOptions actualLimits(actual.getBody());
+    BOOST_CHECK(!actualLimits.interestRate);
+    BOOST_CHECK(!actualLimits.interestBurst);
+    BOOST_CHECK_EQUAL(actualLimits.dataRate.value_or(0), 2000000);
+  });
+  BOOST_CHECK_EQUAL(linkService->getOptions().interestPolicer.rate, 0);
+  BOOST_CHECK_EQUAL(linkService->getOptions().dataShaper.rate, 2000000);
+}
+
+BOOST_AUTO_TEST_CASE(UpdatePacking)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  auto linkService = dynamic_cast<face::GenericLinkService*>(
+                       node1.faceTable.get(faceId)->getLinkService());
+  BOOST_REQUIRE(linkService != nullptr);
+  BOOST_CHECK_EQUAL(linkService->getOptions().allowPacking, false);
+
+  FaceLinkOptions linkOptions;
+  linkOptions.wantPacking = true;
+  ControlParameters updateParams;
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.wantPacking.value_or(false), true);
+    BOOST_CHECK(!actualOptions.hasRateLimits());
+  });
+  BOOST_CHECK_EQUAL(linkService->getOptions().allowPacking, true);
+  // the rate limits are left unchanged
+  BOOST_CHECK_EQUAL(linkService->getOptions().interestPolicer.rate, 0);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateSendQueueTarget)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  auto linkService = dynamic_cast<face::GenericLinkService*>(
+                       node1.faceTable.get(faceId)->getLinkService());
+  BOOST_REQUIRE(linkService != nullptr);
+  BOOST_CHECK_EQUAL(linkService->getOptions().sendQueueTarget, 5_ms);
+
+  FaceLinkOptions linkOptions;
+  linkOptions.sendQueueTarget = 500_us;
+  ControlParameters updateParams;
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.sendQueueTarget.value_or(0_ns), 500_us);
+  });
+  BOOST_CHECK_EQUAL(linkService->getOptions().sendQueueTarget, 500_us);
+
+  // a zero target is rejected
+  linkOptions.sendQueueTarget = 0_ns;
+  updateParams = ControlParameters();
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 409);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.sendQueueTarget.value_or(1_ns), 0_ns);
+  });
+  BOOST_CHECK_EQUAL(linkService->getOptions().sendQueueTarget, 500_us);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateClassWeights)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  auto linkService = dynamic_cast<face::GenericLinkService*>(
+                       node1.faceTable.get(faceId)->getLinkService());
+  BOOST_REQUIRE(linkService != nullptr);
+  auto getWeight = [linkService] (TxClass cls) {
+    return linkService->getOptions().txClassWeights[static_cast<size_t>(cls)];
+  };
+
+  FaceLinkOptions linkOptions;
+  linkOptions.dataWeight = 3;
+  ControlParameters updateParams;
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.interestWeight.value_or(0), 1);
+    BOOST_CHECK_EQUAL(actualOptions.dataWeight.value_or(0), 3);
+    BOOST_CHECK_EQUAL(actualOptions.nackWeight.value_or(0), 1);
+  });
+  BOOST_CHECK_EQUAL(getWeight(TxClass::INTEREST), 1);
+  BOOST_CHECK_EQUAL(getWeight(TxClass::DATA), 3);
+
+  // a zero weight is rejected
+  linkOptions = FaceLinkOptions();
+  linkOptions.interestWeight = 0;
+  updateParams = ControlParameters();
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 409);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.interestWeight.value_or(1), 0);
+  });
+  BOOST_CHECK_EQUAL(getWeight(TxClass::INTEREST), 1);
+
+  // so is a weight that does not fit in 32 bits
+  linkOptions.interestWeight = uint64_t(1) << 32;
+  updateParams = ControlParameters();
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 409);
+  });
+  BOOST_CHECK_EQUAL(getWeight(TxClass::INTEREST), 1);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateIngressWeight)
+{
+  createFace("udp4://127.0.0.1:26363");
+  BOOST_CHECK_EQUAL(node1.ingressScheduler.getWeight(faceId), 1);
+
+  FaceLinkOptions linkOptions;
+  linkOptions.ingressWeight = 4;
+  ControlParameters updateParams;
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.ingressWeight.value_or(0), 4);
+  });
+  BOOST_CHECK_EQUAL(node1.ingressScheduler.getWeight(faceId), 4);
+
+  // a zero weight is rejected
+  linkOptions.ingressWeight = 0;
+  updateParams = ControlParameters();
+  updateParams.setFaceId(faceId);
+  updateParams.wireDecode(linkOptions.appendTo(updateParams.wireEncode()));
+
+  updateFace(updateParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 409);
+
+    FaceLinkOptions actualOptions(actual.getBody());
+    BOOST_CHECK_EQUAL(actualOptions.ingressWeight.value_or(1), 0);
+  });
+  BOOST_CHECK_EQUAL(node1.ingressScheduler.getWeight(faceId), 4);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateLinkOptionsMalformed)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  Block wire = ControlParameters().setFaceId(faceId).wireEncode();
+  wire.push_back(ndn::encoding::makeStringBlock(tlv::InterestRateLimit, "bad"));
+  wire.encode();
+
+  updateFace(ControlParameters(wire), false, [] (const ControlResponse& actual) {
+    ControlResponse expected(400, "Malformed link options");
+    BOOST_CHECK_EQUAL(actual.getCode(), expected.getCode());
+    BOOST_CHECK_EQUAL(actual.getText(), expected.getText());
+  });
+}
+
 class TcpLocalFieldsEnable
 {
 public:
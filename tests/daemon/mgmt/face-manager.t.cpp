@@ -24,6 +24,9 @@
  */
 
 #include "mgmt/face-manager.hpp"
+#include "core/face-link-options.hpp"
+#include "core/face-link-status.hpp"
+#include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
 
 #include "manager-common-fixture.hpp"
@@ -47,7 +50,7 @@ class FaceManagerFixture : public ManagerFixtureWithAuthenticator
 public:
   FaceManagerFixture()
     : m_faceSystem(m_faceTable, make_shared<ndn::net::NetworkMonitorStub>(0))
-    , m_manager(m_faceSystem, m_dispatcher, *m_authenticator)
+    , m_manager(m_faceSystem, m_forwarder.getIngressScheduler(), m_dispatcher, *m_authenticator)
   {
     setTopPrefix();
     setPrivilege("faces");
@@ -208,6 +211,45 @@ BOOST_AUTO_TEST_CASE(FaceDataset)
   BOOST_CHECK_EQUAL(status.getNOutBytes(), face->getCounters().nOutBytes);
 }
 
+BOOST_AUTO_TEST_CASE(FaceDatasetLinkStatus)
+{
+  auto face1 = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                 make_unique<face::tests::DummyTransport>());
+  m_faceTable.add(face1);
+  auto face2 = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                 make_unique<face::tests::DummyTransport>());
+  m_faceTable.add(face2);
+  face1->sendInterest(*makeInterest("/A"));
+  m_forwarder.getIngressScheduler().setWeight(face2->getId(), 3);
+  advanceClocks(1_ms, 10); // wait for notifications posted
+  m_responses.clear();
+
+  receiveInterest(Interest("/localhost/nfd/faces/list").setCanBePrefix(true));
+
+  Block content = concatenateResponses();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 2);
+  for (const Block& element : content.elements()) {
+    ndn::nfd::FaceStatus status(element);
+    FaceLinkStatus linkStatus(element);
+    if (status.getFaceId() == face1->getId()) {
+      // the Interest left the send queue immediately
+      BOOST_CHECK_EQUAL(linkStatus.sojournP50.value_or(0_ns), 1_us);
+      BOOST_CHECK_EQUAL(linkStatus.sojournP90.value_or(0_ns), 1_us);
+      BOOST_CHECK_EQUAL(linkStatus.sojournP99.value_or(0_ns), 1_us);
+      // options with their default values are not reported
+      BOOST_CHECK(FaceLinkOptions(element).empty());
+    }
+    else {
+      // nothing has been sent on the face
+      BOOST_CHECK(linkStatus.empty());
+      FaceLinkOptions linkOptions(element);
+      BOOST_CHECK_EQUAL(linkOptions.ingressWeight.value_or(0), 3);
+      BOOST_CHECK(!linkOptions.sendQueueTarget);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(FaceQuery)
 {
   using ndn::nfd::FaceQueryFilter;
@@ -24,9 +24,14 @@
  */
 
 #include "mgmt/forwarder-status-manager.hpp"
+#include "core/latency-status.hpp"
+#include "core/send-queue-status.hpp"
 #include "core/version.hpp"
+#include "face/generic-link-service.hpp"
 
 #include "manager-common-fixture.hpp"
+#include "tests/daemon/face/dummy-link-service.hpp"
+#include "tests/daemon/face/dummy-transport.hpp"
 
 namespace nfd {
 namespace tests {
@@ -106,6 +111,93 @@ BOOST_AUTO_TEST_CASE(GeneralStatusDataset)
 
   BOOST_CHECK_EQUAL(status.getNSatisfiedInterests(), m_forwarder.getCounters().nSatisfiedInterests);
   BOOST_CHECK_EQUAL(status.getNUnsatisfiedInterests(), m_forwarder.getCounters().nUnsatisfiedInterests);
+
+  // NFD-specific fields follow the ForwarderStatus fields
+  response.parse();
+  for (uint32_t type : {tlv::NFlowCacheHits, tlv::NFlowCacheMisses, tlv::NFlowCacheInvalidations}) {
+    auto element = response.find(type);
+    BOOST_REQUIRE(element != response.elements_end());
+    BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(*element), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LatencyStatusDataset)
+{
+  auto addFace = [this] {
+    auto face = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                  make_unique<face::tests::DummyTransport>());
+    m_faceTable.add(face);
+    face->getTransport()->setLatencySampling(1);
+    return face;
+  };
+  auto face1 = addFace();
+  auto face2 = addFace(); // no Interest is received on this face
+
+  // the Interest has no route, and is Nacked by the strategy
+  static_cast<face::tests::DummyTransport*>(face1->getTransport())
+    ->receivePacket(makeInterest("/no-route")->wireEncode());
+  this->advanceClocks(1_ms);
+
+  receiveInterest(Interest("/localhost/nfd/status/latency").setCanBePrefix(true));
+
+  Block response = this->concatenateResponses(0, m_responses.size());
+  response.parse();
+  BOOST_REQUIRE_EQUAL(response.elements_size(), 1);
+  FaceLatencyStatus status(response.elements().front());
+  BOOST_CHECK_EQUAL(status.faceId, face1->getId());
+  BOOST_REQUIRE_EQUAL(status.stages.size(), 3);
+  BOOST_CHECK_EQUAL(status.stages[0].stage, TraceStage::INCOMING);
+  BOOST_CHECK_EQUAL(status.stages[1].stage, TraceStage::CS_LOOKUP);
+  BOOST_CHECK_EQUAL(status.stages[2].stage, TraceStage::STRATEGY);
+  for (const auto& stage : status.stages) {
+    BOOST_CHECK_EQUAL(stage.nSamples, 1);
+    BOOST_CHECK_LE(stage.p50, stage.p99);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueStatusDataset)
+{
+  face::GenericLinkService::Options options;
+  options.defaultCongestionThreshold = 1;
+  options.sendQueueCapacity = 1;
+  options.txClassWeights = {{0, 1, 3, 1}};
+  auto transport = make_unique<face::tests::DummyTransport>("dummy://", "dummy://",
+                                                            ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                                            ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                                                            ndn::nfd::LINK_TYPE_POINT_TO_POINT,
+                                                            face::MTU_UNLIMITED, 65536);
+  auto transportPtr = transport.get();
+  auto face1 = make_shared<Face>(make_unique<face::GenericLinkService>(options),
+                                 std::move(transport));
+  m_faceTable.add(face1);
+  // a face without GenericLinkService is not listed
+  auto face2 = make_shared<Face>(make_unique<face::tests::DummyLinkService>(),
+                                 make_unique<face::tests::DummyTransport>());
+  m_faceTable.add(face2);
+
+  // the transport is busy, so the first Interest is queued and the second is dropped
+  transportPtr->setSendQueueLength(1);
+  face1->sendInterest(*makeInterest("/A"));
+  face1->sendInterest(*makeInterest("/B"));
+
+  receiveInterest(Interest("/localhost/nfd/status/send-queue").setCanBePrefix(true));
+
+  Block response = this->concatenateResponses(0, m_responses.size());
+  response.parse();
+  BOOST_REQUIRE_EQUAL(response.elements_size(), 1);
+  FaceSendQueueStatus status(response.elements().front());
+  BOOST_CHECK_EQUAL(status.faceId, face1->getId());
+  BOOST_REQUIRE_EQUAL(status.classes.size(), TX_CLASS_COUNT);
+  const auto& interests = status.classes[static_cast<size_t>(TxClass::INTEREST)];
+  BOOST_CHECK_EQUAL(interests.txClass, TxClass::INTEREST);
+  BOOST_CHECK_EQUAL(interests.weight, 1);
+  BOOST_CHECK_EQUAL(interests.queueLength, 1);
+  BOOST_CHECK_EQUAL(interests.nDropped, 1);
+  const auto& data = status.classes[static_cast<size_t>(TxClass::DATA)];
+  BOOST_CHECK_EQUAL(data.txClass, TxClass::DATA);
+  BOOST_CHECK_EQUAL(data.weight, 3);
+  BOOST_CHECK_EQUAL(data.queueLength, 0);
+  BOOST_CHECK_EQUAL(data.nDropped, 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarderStatusManager
@@ -155,6 +155,96 @@ BOOST_AUTO_TEST_CASE(InvalidValue)
 
 BOOST_AUTO_TEST_SUITE_END() // CsMaxPackets
 
+BOOST_AUTO_TEST_SUITE(FlowCacheMaxEntries)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getFlowCache().getLimit(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      flow_cache_max_entries 4096
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(forwarder.getFlowCache().getLimit(), 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getFlowCache().getLimit(), 4096);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      flow_cache_max_entries -1
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // FlowCacheMaxEntries
+
+BOOST_AUTO_TEST_SUITE(IngressBatchSize)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getIngressScheduler().isEnabled(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      ingress_batch_size 64
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(forwarder.getIngressScheduler().getOptions().batchSize, 0);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(forwarder.getIngressScheduler().getOptions().batchSize, 64);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      ingress_batch_size -1
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // IngressBatchSize
+
 BOOST_AUTO_TEST_SUITE(CsPolicy)
 
 BOOST_AUTO_TEST_CASE(Default)
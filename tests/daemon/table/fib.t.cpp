@@ -362,6 +362,26 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(MaxEntryDepth)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  BOOST_CHECK_EQUAL(fib.getMaxEntryDepth(), 0);
+
+  fib.insert("/A");
+  fib.insert("/A/B/C");
+  fib.insert("/D/E/F");
+  BOOST_CHECK_EQUAL(fib.getMaxEntryDepth(), 3);
+
+  // the depth shrinks only after all deepest entries are erased
+  fib.erase("/A/B/C");
+  BOOST_CHECK_EQUAL(fib.getMaxEntryDepth(), 3);
+  fib.erase("/D/E/F");
+  BOOST_CHECK_EQUAL(fib.getMaxEntryDepth(), 1);
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.getMaxEntryDepth(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(Iterator)
 {
   NameTree nameTree;
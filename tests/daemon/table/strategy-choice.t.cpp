@@ -268,6 +268,22 @@ BOOST_AUTO_TEST_CASE(Erase)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(MaxEntryDepth)
+{
+  BOOST_CHECK_EQUAL(sc.getMaxEntryDepth(), 0);
+
+  sc.insert("/A", strategyNameP);
+  sc.insert("/A/B/C", strategyNameQ);
+  BOOST_CHECK_EQUAL(sc.getMaxEntryDepth(), 3);
+
+  // changing the strategy of an existing entry does not count it twice
+  sc.insert("/A/B/C", strategyNameP);
+  sc.erase("/A/B/C");
+  BOOST_CHECK_EQUAL(sc.getMaxEntryDepth(), 1);
+  sc.erase("/A");
+  BOOST_CHECK_EQUAL(sc.getMaxEntryDepth(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(Enumerate)
 {
   sc.insert("/",      strategyNameP);
@@ -0,0 +1,179 @@
+#!/usr/bin/env bash
+# Compares the goodput of forwarding strategies over two shaped upstream paths.
+#
+# Three NFD instances run on the loopback interface of a private network namespace:
+# a router R (port 6363) and two producers P1 (port 6364) and P2 (port 6365), connected
+# with UDP or TCP faces. Data flowing from each producer to R is rate-limited with tc. R has routes toward
+# both producers, and a consumer on R retrieves the same file once per strategy.
+#
+# Must be run as root. See congestion-benchmark.md for details.
+
+set -eo pipefail
+
+NS=nfd-congestion-benchmark
+RATE1=${RATE1:-20mbit}
+RATE2=${RATE2:-20mbit}
+FILE_SIZE=${FILE_SIZE:-20M}
+STRATEGIES=${STRATEGIES:-"best-route multicast congestion-aware"}
+PROTOCOL=${PROTOCOL:-udp}
+PREFIX=/benchmark/file/%FD%01
+
+case $PROTOCOL in
+  udp) IPPROTO=17 ;;
+  tcp) IPPROTO=6 ;;
+  *) echo "PROTOCOL must be udp or tcp" >&2; exit 2 ;;
+esac
+
+if [[ $EUID -ne 0 ]]; then
+  echo "This script must be run as root" >&2
+  exit 2
+fi
+
+for cmd in nfd nfdc ndnputchunks ndncatchunks tc ip; do
+  if ! command -v $cmd >/dev/null; then
+    echo "$cmd not found" >&2
+    exit 2
+  fi
+done
+
+if [[ -z $IN_BENCHMARK_NETNS ]]; then
+  ip netns add $NS
+  trap "ip netns del $NS" EXIT
+  IN_BENCHMARK_NETNS=1 ip netns exec $NS "$0" "$@"
+  exit
+fi
+
+WORKDIR=$(mktemp -d)
+PIDS=()
+
+cleanup() {
+  kill "${PIDS[@]}" 2>/dev/null || true
+  wait 2>/dev/null || true
+  rm -rf "$WORKDIR"
+}
+trap cleanup EXIT
+
+make_config() {
+  local name=$1 port=$2
+  cat > "$WORKDIR/$name.conf" <<CONF
+general
+{
+}
+log
+{
+  default_level WARN
+}
+tables
+{
+  cs_max_packets 65536
+}
+face_system
+{
+  general
+  {
+    enable_congestion_marking yes
+  }
+  unix
+  {
+    path $WORKDIR/$name.sock
+  }
+  udp
+  {
+    listen yes
+    port $port
+    mcast no
+  }
+  tcp
+  {
+    listen yes
+    port $port
+  }
+}
+authorizations
+{
+  authorize
+  {
+    certfile any
+    privileges
+    {
+      faces
+      fib
+      cs
+      strategy-choice
+    }
+  }
+}
+rib
+{
+  localhost_security
+  {
+    trust-anchor
+    {
+      type any
+    }
+  }
+  readvertise_nlsr no
+}
+CONF
+}
+
+start_nfd() {
+  local name=$1
+  nfd --config "$WORKDIR/$name.conf" >"$WORKDIR/$name.log" 2>&1 &
+  PIDS+=($!)
+}
+
+at() {
+  local name=$1
+  shift
+  NDN_CLIENT_TRANSPORT=unix://$WORKDIR/$name.sock "$@"
+}
+
+ip link set lo up
+
+# Data sent by P1 and P2 leaves from source ports 6364 and 6365, and is placed into
+# separate token bucket filters; all other traffic uses the unshaped middle band.
+tc qdisc add dev lo root handle 1: prio bands 3 priomap 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1 1
+tc qdisc add dev lo parent 1:1 handle 10: tbf rate $RATE1 burst 32kbit limit 1mb
+tc qdisc add dev lo parent 1:3 handle 30: tbf rate $RATE2 burst 32kbit limit 1mb
+tc filter add dev lo parent 1: protocol ip prio 1 u32 \
+  match ip protocol $IPPROTO 0xff match ip sport 6364 0xffff flowid 1:1
+tc filter add dev lo parent 1: protocol ip prio 1 u32 \
+  match ip protocol $IPPROTO 0xff match ip sport 6365 0xffff flowid 1:3
+
+make_config R 6363
+make_config P1 6364
+make_config P2 6365
+start_nfd R
+start_nfd P1
+start_nfd P2
+sleep 2
+
+head -c $FILE_SIZE /dev/urandom > "$WORKDIR/file"
+at P1 ndnputchunks -q $PREFIX < "$WORKDIR/file" &
+PIDS+=($!)
+at P2 ndnputchunks -q $PREFIX < "$WORKDIR/file" &
+PIDS+=($!)
+
+at R nfdc face create remote ${PROTOCOL}4://127.0.0.1:6364 persistency permanent
+at R nfdc face create remote ${PROTOCOL}4://127.0.0.1:6365 persistency permanent
+at R nfdc route add prefix /benchmark nexthop ${PROTOCOL}4://127.0.0.1:6364 cost 10
+at R nfdc route add prefix /benchmark nexthop ${PROTOCOL}4://127.0.0.1:6365 cost 20
+at R nfdc cs config admit off serve off
+
+# wait until both producers have finished signing and registered their prefix
+for name in P1 P2; do
+  until at $name nfdc route list | grep -q '^prefix=/benchmark '; do
+    sleep 1
+  done
+done
+
+for strategy in $STRATEGIES; do
+  at R nfdc strategy set prefix /benchmark strategy /localhost/nfd/strategy/$strategy >/dev/null
+  # the summary of ndncatchunks includes the goodput and the number of congestion marks
+  result=$(at R ndncatchunks -f $PREFIX 2>&1 >/dev/null |
+           grep -i -e '^goodput' -e '^congestion marks' | paste -sd ';' -) || true
+  printf '%-20s %s\n' "$strategy" "${result:-failed}"
+  at R nfdc face list | grep "remote=${PROTOCOL}4://127.0.0.1:636[45]"
+  sleep 2
+done
@@ -24,14 +24,22 @@
  */
 
 #include "common/global.hpp"
+#include "face/datagram-transport.hpp"
 #include "face/face.hpp"
+#include "face/stream-transport.hpp"
 #include "face/tcp-channel.hpp"
 #include "face/udp-channel.hpp"
+#include "face/unix-stream-channel.hpp"
+#include "fw/ingress-scheduler.hpp"
 
 #include <boost/exception/diagnostic_information.hpp>
+#include <boost/lexical_cast.hpp>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 
 #ifdef HAVE_VALGRIND
 #include <valgrind/callgrind.h>
@@ -43,11 +51,14 @@ namespace tests {
 class FaceBenchmark
 {
 public:
-  FaceBenchmark(const char* configFileName)
+  FaceBenchmark(const char* configFileName, size_t batchSize, size_t streamBatchSize,
+                size_t ingressBatchSize)
     : m_terminationSignalSet{getGlobalIoService()}
     , m_tcpChannel{tcp::Endpoint{boost::asio::ip::tcp::v4(), 6363}, false,
                    bind([] { return ndn::nfd::FACE_SCOPE_NON_LOCAL; })}
-    , m_udpChannel{udp::Endpoint{boost::asio::ip::udp::v4(), 6363}, 10_min, false}
+    , m_udpChannel{udp::Endpoint{boost::asio::ip::udp::v4(), 6363}, 10_min, false,
+                   makeUdpChannelOptions(batchSize)}
+    , m_ingressScheduler{makeIngressSchedulerOptions(ingressBatchSize)}
   {
     m_terminationSignalSet.add(SIGINT);
     m_terminationSignalSet.add(SIGTERM);
@@ -58,35 +69,86 @@ public:
 
     parseConfig(configFileName);
 
+    m_tcpChannel.setSendBatchLimits(streamBatchSize, face::DEFAULT_STREAM_SEND_BATCH_BYTES);
     m_tcpChannel.listen(bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
                         bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
-    std::clog << "Listening on " << m_tcpChannel.getUri() << std::endl;
+    std::clog << "Listening on " << m_tcpChannel.getUri()
+              << " (gather write size " << streamBatchSize << ")" << std::endl;
 
     m_udpChannel.listen(bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
                         bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
-    std::clog << "Listening on " << m_udpChannel.getUri() << std::endl;
+    std::clog << "Listening on " << m_udpChannel.getUri()
+              << " (batch size " << batchSize << ")" << std::endl;
+
+    if (!m_unixPath.empty()) {
+      m_unixChannel = make_unique<face::UnixStreamChannel>(unix_stream::Endpoint(m_unixPath), false);
+      m_unixChannel->setSendBatchLimits(streamBatchSize, face::DEFAULT_STREAM_SEND_BATCH_BYTES);
+      m_unixChannel->listen(bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
+                            bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
+      std::clog << "Listening on " << m_unixChannel->getUri()
+                << " (gather write size " << streamBatchSize << ")" << std::endl;
+    }
+    if (m_ingressScheduler.isEnabled()) {
+      std::clog << "Ingress scheduling enabled (batch size " << ingressBatchSize << ")" << std::endl;
+    }
+
+    scheduleReport();
   }
 
 private:
+  static face::UdpChannel::Options
+  makeUdpChannelOptions(size_t batchSize)
+  {
+    face::UdpChannel::Options options;
+    options.batchSize = batchSize;
+    return options;
+  }
+
+  static fw::IngressScheduler::Options
+  makeIngressSchedulerOptions(size_t batchSize)
+  {
+    fw::IngressScheduler::Options options;
+    options.batchSize = batchSize;
+    return options;
+  }
+
   void
   parseConfig(const char* configFileName)
   {
     std::ifstream file{configFileName};
-    std::string uriStrL;
-    std::string uriStrR;
+    std::string line;
+
+    while (std::getline(file, line)) {
+      std::istringstream is{line};
+      std::string uriStrL;
+      std::string uriStrR;
+      uint32_t weight = 1;
+      if (!(is >> uriStrL >> uriStrR)) {
+        continue;
+      }
+      if (!is.eof() && !(is >> weight)) {
+        std::clog << "Invalid weight in line '" << line << "'" << std::endl;
+        continue;
+      }
 
-    while (file >> uriStrL >> uriStrR) {
       FaceUri uriL{uriStrL};
       FaceUri uriR{uriStrR};
 
-      if (uriL.getScheme() != "tcp4" && uriL.getScheme() != "udp4") {
+      if (uriL.getScheme() == "unix" && !m_unixPath.empty() && uriL.getPath() != m_unixPath) {
+        std::clog << "Only one Unix stream listener is supported" << std::endl;
+      }
+      else if (uriL.getScheme() != "tcp4" && uriL.getScheme() != "udp4" &&
+               uriL.getScheme() != "unix") {
         std::clog << "Unsupported protocol '" << uriL.getScheme() << "'" << std::endl;
       }
       else if (uriR.getScheme() != "tcp4" && uriR.getScheme() != "udp4") {
         std::clog << "Unsupported protocol '" << uriR.getScheme() << "'" << std::endl;
       }
       else {
-        m_faceUris.push_back(std::make_pair(uriL, uriR));
+        if (uriL.getScheme() == "unix") {
+          m_unixPath = uriL.getPath();
+        }
+        m_faceUris.push_back({uriL, uriR, weight});
       }
     }
 
@@ -103,14 +165,23 @@ private:
 
     // find a matching right uri
     FaceUri uriR;
+    uint32_t weight = 1;
     for (const auto& pair : m_faceUris) {
-      if (pair.first.getHost() == faceL->getRemoteUri().getHost() &&
-          pair.first.getScheme() == faceL->getRemoteUri().getScheme()) {
-        uriR = pair.second;
+      // Unix stream faces have an fd:// remote URI and are matched by their listener path
+      if (pair.left.getScheme() == "unix" && faceL->getRemoteUri().getScheme() == "fd" &&
+          pair.left.getPath() == faceL->getLocalUri().getPath()) {
+        uriR = pair.right;
+        weight = pair.weight;
+      }
+      else if (pair.left.getHost() == faceL->getRemoteUri().getHost() &&
+          pair.left.getScheme() == faceL->getRemoteUri().getScheme()) {
+        uriR = pair.right;
+        weight = pair.weight;
       }
-      else if (pair.second.getHost() == faceL->getRemoteUri().getHost() &&
-               pair.second.getScheme() == faceL->getRemoteUri().getScheme()) {
-        uriR = pair.first;
+      else if (pair.right.getHost() == faceL->getRemoteUri().getHost() &&
+               pair.right.getScheme() == faceL->getRemoteUri().getScheme()) {
+        uriR = pair.left;
+        weight = pair.weight;
       }
     }
 
@@ -125,37 +196,104 @@ private:
     auto port = boost::lexical_cast<uint16_t>(uriR.getPort());
     if (uriR.getScheme() == "tcp4") {
       m_tcpChannel.connect(tcp::Endpoint(addr, port), {},
-                           bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
+                           bind(&FaceBenchmark::onRightFaceCreated, this, faceL, weight, _1),
                            bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     }
     else if (uriR.getScheme() == "udp4") {
       m_udpChannel.connect(udp::Endpoint(addr, port), {},
-                           bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
+                           bind(&FaceBenchmark::onRightFaceCreated, this, faceL, weight, _1),
                            bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     }
   }
 
   void
-  onRightFaceCreated(const shared_ptr<Face>& faceL, const shared_ptr<Face>& faceR)
+  onRightFaceCreated(const shared_ptr<Face>& faceL, uint32_t weight, const shared_ptr<Face>& faceR)
   {
     std::clog << "Right face created: remote=" << faceR->getRemoteUri()
               << " local=" << faceR->getLocalUri() << std::endl;
 
-    tieFaces(faceR, faceL);
-    tieFaces(faceL, faceR);
+    // faces are not added to a FaceTable, so the ingress scheduler uses benchmark-assigned IDs
+    FaceId idL = m_faces.size() + 1;
+    FaceId idR = m_faces.size() + 2;
+    m_ingressScheduler.setWeight(idL, weight);
+    m_ingressScheduler.setWeight(idR, weight);
+    tieFaces(faceR, idR, faceL);
+    tieFaces(faceL, idL, faceR);
+
+    m_faces.push_back(faceL);
+    m_faces.push_back(faceR);
   }
 
-  static void
-  tieFaces(const shared_ptr<Face>& face1, const shared_ptr<Face>& face2)
+  /** \brief print the aggregate packet rate of all faces, and the outgoing throughput
+   *         of the faces of each FaceUri scheme, once per second
+   */
+  void
+  scheduleReport()
   {
-    face1->afterReceiveInterest.connect([face2] (const Interest& interest, const EndpointId&) {
-      face2->sendInterest(interest);
+    m_reportEvent = getScheduler().schedule(1_s, [this] {
+      uint64_t nInPackets = 0;
+      uint64_t nOutPackets = 0;
+      std::map<std::string, uint64_t> nOutBytes;
+      for (const auto& face : m_faces) {
+        nInPackets += face->getCounters().nInInterests + face->getCounters().nInData +
+                      face->getCounters().nInNacks;
+        nOutPackets += face->getCounters().nOutInterests + face->getCounters().nOutData +
+                       face->getCounters().nOutNacks;
+        nOutBytes[face->getLocalUri().getScheme()] += face->getCounters().nOutBytes;
+      }
+      if (!m_faces.empty()) {
+        std::cout << "in-pps=" << nInPackets - m_lastInPackets
+                  << " out-pps=" << nOutPackets - m_lastOutPackets;
+        for (const auto& scheme : nOutBytes) {
+          std::cout << " " << scheme.first << "-out-mbps="
+                    << (scheme.second - m_lastOutBytes[scheme.first]) * 8 / 1000000;
+        }
+        m_lastOutBytes = nOutBytes;
+        if (m_ingressScheduler.isEnabled()) {
+          std::cout << " ingress-dropped=" << m_ingressScheduler.nDropped - m_lastIngressDropped;
+          for (size_t i = 0; i < m_faces.size(); ++i) {
+            FaceId faceId = i + 1;
+            std::cout << " face" << faceId << "(w" << m_ingressScheduler.getWeight(faceId)
+                      << ")-pps=" << m_nForwarded[i] - m_lastForwarded[i];
+          }
+          m_lastIngressDropped = m_ingressScheduler.nDropped;
+          m_lastForwarded = m_nForwarded;
+        }
+        std::cout << std::endl;
+      }
+      m_lastInPackets = nInPackets;
+      m_lastOutPackets = nOutPackets;
+      scheduleReport();
     });
-    face1->afterReceiveData.connect([face2] (const Data& data, const EndpointId&) {
-      face2->sendData(data);
+  }
+
+  /** \brief forward packets received on \p face1 to \p face2, through the ingress scheduler
+   *         if it is enabled
+   */
+  void
+  tieFaces(const shared_ptr<Face>& face1, FaceId id1, const shared_ptr<Face>& face2)
+  {
+    m_nForwarded.resize(std::max<size_t>(m_nForwarded.size(), id1));
+    m_lastForwarded.resize(m_nForwarded.size());
+    auto forward = [this, id1] (std::function<void()> send) {
+      if (!m_ingressScheduler.isEnabled()) {
+        send();
+        return;
+      }
+      m_ingressScheduler.schedule(id1, [this, id1, send = std::move(send)] {
+        send();
+        ++m_nForwarded[id1 - 1];
+      });
+    };
+
+    face1->afterReceiveInterest.connect([=] (const Interest& interest, const EndpointId&) {
+      forward([face2, interest = interest.shared_from_this()] { face2->sendInterest(*interest); });
+    });
+    face1->afterReceiveData.connect([=] (const Data& data, const EndpointId&) {
+      forward([face2, data = data.shared_from_this()] { face2->sendData(*data); });
     });
-    face1->afterReceiveNack.connect([face2] (const ndn::lp::Nack& nack, const EndpointId&) {
-      face2->sendNack(nack);
+    face1->afterReceiveNack.connect([=] (const ndn::lp::Nack& nack, const EndpointId&) {
+      forward([face2, nack] { face2->sendNack(nack); });
     });
   }
 
@@ -169,7 +307,24 @@ private:
   boost::asio::signal_set m_terminationSignalSet;
   face::TcpChannel m_tcpChannel;
   face::UdpChannel m_udpChannel;
-  std::vector<std::pair<FaceUri, FaceUri>> m_faceUris;
+  std::string m_unixPath;
+  unique_ptr<face::UnixStreamChannel> m_unixChannel;
+  struct FaceUriPair
+  {
+    FaceUri left;
+    FaceUri right;
+    uint32_t weight;
+  };
+  std::vector<FaceUriPair> m_faceUris;
+  std::vector<shared_ptr<Face>> m_faces;
+  fw::IngressScheduler m_ingressScheduler;
+  std::vector<uint64_t> m_nForwarded; ///< packets forwarded per ingress face, indexed by ID - 1
+  std::vector<uint64_t> m_lastForwarded;
+  uint64_t m_lastIngressDropped = 0;
+  scheduler::ScopedEventId m_reportEvent;
+  uint64_t m_lastInPackets = 0;
+  uint64_t m_lastOutPackets = 0;
+  std::map<std::string, uint64_t> m_lastOutBytes; ///< indexed by FaceUri scheme
 };
 
 } // namespace tests
@@ -182,13 +337,51 @@ main(int argc, char** argv)
   std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
 #endif
 
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <config-file>" << std::endl;
+  size_t batchSize = 1;
+  size_t streamBatchSize = nfd::face::DEFAULT_STREAM_SEND_BATCH_PACKETS;
+  size_t ingressBatchSize = 0;
+  auto parseSize = [] (const char* arg, size_t min, size_t max, size_t& value) {
+    try {
+      value = boost::lexical_cast<size_t>(arg);
+    }
+    catch (const boost::bad_lexical_cast&) {
+      return false;
+    }
+    return value >= min && value <= max;
+  };
+
+  int argi = 1;
+  for (; argi + 1 < argc && argv[argi][0] == '-'; argi += 2) {
+    if (std::strcmp(argv[argi], "-b") == 0) {
+      if (!parseSize(argv[argi + 1], 1, nfd::face::MAX_DATAGRAM_BATCH_SIZE, batchSize)) {
+        std::cerr << "Invalid batch size '" << argv[argi + 1] << "'" << std::endl;
+        return 2;
+      }
+    }
+    else if (std::strcmp(argv[argi], "-w") == 0) {
+      if (!parseSize(argv[argi + 1], 1, std::numeric_limits<size_t>::max(), streamBatchSize)) {
+        std::cerr << "Invalid gather write size '" << argv[argi + 1] << "'" << std::endl;
+        return 2;
+      }
+    }
+    else if (std::strcmp(argv[argi], "-s") == 0) {
+      if (!parseSize(argv[argi + 1], 0, std::numeric_limits<size_t>::max(), ingressBatchSize)) {
+        std::cerr << "Invalid ingress batch size '" << argv[argi + 1] << "'" << std::endl;
+        return 2;
+      }
+    }
+    else {
+      break;
+    }
+  }
+  if (argi != argc - 1) {
+    std::cerr << "Usage: " << argv[0] << " [-b <udp-batch-size>] [-w <stream-gather-write-size>]"
+              << " [-s <ingress-batch-size>] <config-file>" << std::endl;
     return 2;
   }
 
   try {
-    nfd::tests::FaceBenchmark bench{argv[1]};
+    nfd::tests::FaceBenchmark bench{argv[argc - 1], batchSize, streamBatchSize, ingressBatchSize};
 #ifdef HAVE_VALGRIND
     CALLGRIND_START_INSTRUMENTATION;
 #endif
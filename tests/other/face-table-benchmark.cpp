@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/channel.hpp"
+#include "face/null-face.hpp"
+#include "fw/face-table.hpp"
+
+#include <iostream>
+#include <random>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+class FaceTableBenchmarkFixture
+{
+protected:
+  FaceTableBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  static void
+  printRate(const std::string& label, size_t nOps, time::nanoseconds duration)
+  {
+    auto us = time::duration_cast<time::microseconds>(duration);
+    std::cout << label << ": time=" << us
+              << " rate=" << static_cast<uint64_t>(nOps * 1e6 / std::max<int64_t>(us.count(), 1))
+              << "/s" << std::endl;
+  }
+
+protected:
+  // number of on-demand faces, modeling a router serving a large number of consumers
+  const size_t nFaces = 500000;
+  // number of lookups in each lookup phase
+  const size_t nLookups = 10000000;
+};
+
+// This test case models FaceTable operations of a router with nFaces faces:
+// face creation, lookup by FaceId (as done for every incoming/outgoing packet via
+// PIT in-records, out-records, and FIB nexthops), enumeration, and face closure.
+BOOST_FIXTURE_TEST_CASE(FaceTableOperations, FaceTableBenchmarkFixture)
+{
+  FaceTable faceTable;
+  std::vector<shared_ptr<Face>> faces;
+  faces.reserve(nFaces);
+  for (size_t i = 0; i < nFaces; ++i) {
+    faces.push_back(face::makeNullFace());
+  }
+
+  std::mt19937 rng(0);
+  std::vector<FaceId> lookupIds(nLookups);
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  auto t1 = time::steady_clock::now();
+  for (const auto& face : faces) {
+    faceTable.add(face);
+  }
+  auto t2 = time::steady_clock::now();
+  printRate("add", nFaces, t2 - t1);
+
+  std::uniform_int_distribution<size_t> dist(0, nFaces - 1);
+  for (auto& id : lookupIds) {
+    id = faces[dist(rng)]->getId();
+  }
+  size_t nFound = 0;
+  t1 = time::steady_clock::now();
+  for (FaceId id : lookupIds) {
+    nFound += faceTable.get(id) != nullptr;
+  }
+  t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nFound, nLookups);
+  printRate("get", nLookups, t2 - t1);
+
+  size_t nEnumerated = 0;
+  t1 = time::steady_clock::now();
+  for (const Face& face : faceTable) {
+    nEnumerated += face.getId() != face::INVALID_FACEID;
+  }
+  t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nEnumerated, nFaces);
+  printRate("enumerate", nFaces, t2 - t1);
+
+  t1 = time::steady_clock::now();
+  for (const auto& face : faces) {
+    face->close();
+  }
+  getGlobalIoService().poll(); // deallocate faces
+  t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(faceTable.size(), 0);
+  printRate("close", nFaces, t2 - t1);
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+}
+
+// This test case models the demultiplexing of incoming datagrams to on-demand faces
+// in UdpChannel, which indexes its faces by remote endpoint.
+BOOST_FIXTURE_TEST_CASE(ChannelDemultiplexing, FaceTableBenchmarkFixture)
+{
+  std::unordered_map<udp::Endpoint, shared_ptr<Face>, face::IpEndpointHash> channelFaces;
+  std::vector<udp::Endpoint> endpoints;
+  endpoints.reserve(nFaces);
+  for (size_t i = 0; i < nFaces; ++i) {
+    // spread remote endpoints over addresses in 10.0.0.0/8 and a range of ports
+    boost::asio::ip::address_v4 addr(0x0A000000 | static_cast<uint32_t>(i / 8));
+    endpoints.emplace_back(addr, static_cast<uint16_t>(6363 + i % 8));
+  }
+  auto face = face::makeNullFace();
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<size_t> dist(0, nFaces - 1);
+  std::vector<size_t> lookupIndices(nLookups);
+  for (auto& index : lookupIndices) {
+    index = dist(rng);
+  }
+
+  auto t1 = time::steady_clock::now();
+  for (const auto& ep : endpoints) {
+    channelFaces.emplace(ep, face);
+  }
+  auto t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(channelFaces.size(), nFaces);
+  printRate("insert", nFaces, t2 - t1);
+
+  size_t nFound = 0;
+  t1 = time::steady_clock::now();
+  for (size_t index : lookupIndices) {
+    nFound += channelFaces.count(endpoints[index]);
+  }
+  t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nFound, nLookups);
+  printRate("find", nLookups, t2 - t1);
+}
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,172 @@
+#!/usr/bin/env bash
+# Measures the forwarding cost of latency sampling (face_system.general.latency_sample_interval).
+#
+# A router R (port 6363) forwards the Interests of a consumer to a producer P (port 6364) over
+# a UDP face on the loopback interface. For each sampling interval, R is restarted with that
+# interval, and the consumer retrieves the same file RUNS times with a fixed pipeline. The script
+# reports the goodput and the CPU time that R spent per forwarded Interest, relative to the
+# first interval.
+#
+# See latency-sampling-benchmark.md for details.
+
+set -eo pipefail
+
+INTERVALS=${INTERVALS:-"0 1000 100 1"}
+RUNS=${RUNS:-5}
+FILE_SIZE=${FILE_SIZE:-100M}
+PIPELINE_SIZE=${PIPELINE_SIZE:-256}
+PREFIX=/benchmark/file/%FD%01
+
+for cmd in nfd nfdc ndnputchunks ndncatchunks; do
+  if ! command -v $cmd >/dev/null; then
+    echo "$cmd not found" >&2
+    exit 2
+  fi
+done
+
+WORKDIR=$(mktemp -d)
+PIDS=()
+ROUTER_PID=
+
+cleanup() {
+  kill "${PIDS[@]}" $ROUTER_PID 2>/dev/null || true
+  wait 2>/dev/null || true
+  rm -rf "$WORKDIR"
+}
+trap cleanup EXIT
+
+make_config() {
+  local name=$1 port=$2 interval=$3
+  cat > "$WORKDIR/$name.conf" <<CONF
+log
+{
+  default_level WARN
+}
+face_system
+{
+  general
+  {
+    latency_sample_interval $interval
+  }
+  unix
+  {
+    path $WORKDIR/$name.sock
+  }
+  udp
+  {
+    listen yes
+    port $port
+    mcast no
+  }
+}
+authorizations
+{
+  authorize
+  {
+    certfile any
+    privileges
+    {
+      faces
+      fib
+      cs
+      strategy-choice
+    }
+  }
+}
+rib
+{
+  localhost_security
+  {
+    trust-anchor
+    {
+      type any
+    }
+  }
+  readvertise_nlsr no
+}
+CONF
+}
+
+at() {
+  local name=$1
+  shift
+  NDN_CLIENT_TRANSPORT=unix://$WORKDIR/$name.sock "$@"
+}
+
+# user and system CPU time of a process, in clock ticks
+cpu_ticks() {
+  awk '{ print $14 + $15 }' /proc/$1/stat
+}
+
+in_interests() {
+  at R nfdc status general | grep -o -E 'nInInterests=[0-9]+' | cut -d= -f2
+}
+
+start_router() {
+  local interval=$1
+  make_config R 6363 $interval
+  nfd --config "$WORKDIR/R.conf" >"$WORKDIR/R.log" 2>&1 &
+  ROUTER_PID=$!
+  until at R nfdc status general >/dev/null 2>&1; do
+    sleep 0.2
+  done
+  at R nfdc face create remote udp4://127.0.0.1:6364 persistency permanent >/dev/null
+  at R nfdc route add prefix /benchmark nexthop udp4://127.0.0.1:6364 >/dev/null
+  # every Interest must be forwarded to P
+  at R nfdc cs config admit off serve off >/dev/null
+}
+
+stop_router() {
+  kill $ROUTER_PID
+  wait $ROUTER_PID 2>/dev/null || true
+  ROUTER_PID=
+}
+
+make_config P 6364 0
+nfd --config "$WORKDIR/P.conf" >"$WORKDIR/P.log" 2>&1 &
+PIDS+=($!)
+sleep 2
+
+head -c $FILE_SIZE /dev/urandom > "$WORKDIR/file"
+at P ndnputchunks -q $PREFIX < "$WORKDIR/file" &
+PIDS+=($!)
+# wait until the producer has finished signing and registered its prefix
+until at P nfdc route list | grep -q '^prefix=/benchmark '; do
+  sleep 1
+done
+
+CLK_TCK=$(getconf CLK_TCK)
+BASELINE_GOODPUT=
+BASELINE_CPU=
+printf '%-10s %16s %10s %18s %10s\n' interval goodput-Mbps change cpu-us-per-interest change
+
+for interval in $INTERVALS; do
+  start_router $interval
+  goodputs=()
+  cpu_total=0
+  interests_total=0
+  for ((run = 0; run < RUNS; ++run)); do
+    ticks=$(cpu_ticks $ROUTER_PID)
+    interests=$(in_interests)
+    # the summary of ndncatchunks includes the goodput, e.g. "Goodput: 512.3 Mbit/s"
+    goodput=$(at R ndncatchunks --fresh --pipeline-type fixed --pipeline-size $PIPELINE_SIZE \
+                $PREFIX 2>&1 >/dev/null |
+              awk 'tolower($1) == "goodput:" {
+                     print ($3 == "Gbit/s" ? $2 * 1000 : $3 == "kbit/s" ? $2 / 1000 : $2) }')
+    goodputs+=(${goodput:-0})
+    cpu_total=$((cpu_total + $(cpu_ticks $ROUTER_PID) - ticks))
+    interests_total=$((interests_total + $(in_interests) - interests))
+  done
+  stop_router
+
+  # the median goodput is less sensitive to a single slow run than the mean
+  goodput=$(printf '%s\n' "${goodputs[@]}" | sort -g |
+            awk '{ v[NR] = $1 } END { print v[int((NR + 1) / 2)] }')
+  cpu=$(awk -v t=$cpu_total -v hz=$CLK_TCK -v n=$interests_total \
+        'BEGIN { printf "%.3f", n > 0 ? t * 1e6 / hz / n : 0 }')
+  BASELINE_GOODPUT=${BASELINE_GOODPUT:-$goodput}
+  BASELINE_CPU=${BASELINE_CPU:-$cpu}
+  awk -v i=$interval -v g=$goodput -v g0=$BASELINE_GOODPUT -v c=$cpu -v c0=$BASELINE_CPU \
+    'BEGIN { printf "%-10s %16.1f %+9.1f%% %18.3f %+9.1f%%\n", i, g,
+             g0 > 0 ? (g / g0 - 1) * 100 : 0, c, c0 > 0 ? (c / c0 - 1) * 100 : 0 }'
+done
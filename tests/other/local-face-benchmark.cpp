@@ -0,0 +1,392 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/unix-shm-channel.hpp"
+#include "face/unix-stream-channel.hpp"
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif // __linux__
+
+namespace nfd {
+namespace tests {
+
+/** \brief The application side of a local face, using blocking I/O
+ */
+class LocalClient : noncopyable
+{
+public:
+  virtual
+  ~LocalClient()
+  {
+    if (m_socket >= 0)
+      ::close(m_socket);
+  }
+
+  virtual void
+  send(const Block& packet) = 0;
+
+  /** \brief Wait until \p count packets have been received
+   */
+  virtual void
+  receive(size_t count) = 0;
+
+protected:
+  explicit
+  LocalClient(const std::string& path)
+    : m_socket(::socket(AF_UNIX, SOCK_STREAM, 0))
+  {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.data(), sizeof(addr.sun_path) - 1);
+    if (m_socket < 0 || ::connect(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+      NDN_THROW_ERRNO(std::runtime_error("Cannot connect to " + path));
+    }
+  }
+
+protected:
+  int m_socket;
+};
+
+/** \brief Sends one packet per write(), as ndn-cxx does, and reframes the received stream
+ */
+class StreamClient final : public LocalClient
+{
+public:
+  explicit
+  StreamClient(const std::string& path)
+    : LocalClient(path)
+  {
+  }
+
+  void
+  send(const Block& packet) final
+  {
+    const uint8_t* buf = packet.wire();
+    size_t remaining = packet.size();
+    while (remaining > 0) {
+      ssize_t n = ::write(m_socket, buf, remaining);
+      if (n < 0) {
+        NDN_THROW_ERRNO(std::runtime_error("write"));
+      }
+      buf += n;
+      remaining -= static_cast<size_t>(n);
+    }
+  }
+
+  void
+  receive(size_t count) final
+  {
+    while (count > 0) {
+      ssize_t n = ::read(m_socket, m_buffer + m_bufferSize, sizeof(m_buffer) - m_bufferSize);
+      if (n <= 0) {
+        NDN_THROW_ERRNO(std::runtime_error("read"));
+      }
+      m_bufferSize += static_cast<size_t>(n);
+
+      size_t offset = 0;
+      while (count > 0 && offset < m_bufferSize) {
+        bool isOk = false;
+        Block element;
+        std::tie(isOk, element) = Block::fromBuffer(m_buffer + offset, m_bufferSize - offset);
+        if (!isOk)
+          break;
+        offset += element.size();
+        --count;
+      }
+      std::memmove(m_buffer, m_buffer + offset, m_bufferSize - offset);
+      m_bufferSize -= offset;
+    }
+  }
+
+private:
+  uint8_t m_buffer[ndn::MAX_NDN_PACKET_SIZE * 8];
+  size_t m_bufferSize = 0;
+};
+
+#ifdef __linux__
+/** \brief Exchanges packets through a UnixShmRegion set up over the control socket
+ */
+class ShmClient final : public LocalClient
+{
+public:
+  explicit
+  ShmClient(const std::string& path)
+    : LocalClient(path)
+    , m_region(face::UnixShmRegion::create())
+    , m_nfdDoorbell(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , m_appDoorbell(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    , m_txRing(m_region->getControl(face::UnixShmRegion::TO_NFD),
+               m_region->getData(face::UnixShmRegion::TO_NFD), m_region->getRingCapacity())
+    , m_rxRing(m_region->getControl(face::UnixShmRegion::FROM_NFD),
+               m_region->getData(face::UnixShmRegion::FROM_NFD), m_region->getRingCapacity())
+  {
+    int fds[] = {m_region->getFd(), m_nfdDoorbell, m_appDoorbell};
+    uint8_t version = face::UnixShmRegion::VERSION;
+    iovec iov{&version, sizeof(version)};
+    alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    if (::sendmsg(m_socket, &msg, 0) != 1 ||
+        ::read(m_socket, &version, sizeof(version)) != 1 ||
+        version != face::UnixShmRegion::VERSION) {
+      NDN_THROW(std::runtime_error("Shared memory face setup failed"));
+    }
+  }
+
+  ~ShmClient() final
+  {
+    ::close(m_nfdDoorbell);
+    ::close(m_appDoorbell);
+  }
+
+  void
+  send(const Block& packet) final
+  {
+    bool shouldNotify = false;
+    while (!m_txRing.push(packet.wire(), packet.size(), shouldNotify)) {
+      // NFD rings our doorbell once it has drained the ring
+      waitForDoorbell();
+    }
+    if (shouldNotify)
+      ringNfdDoorbell();
+  }
+
+  void
+  receive(size_t count) final
+  {
+    while (true) {
+      bool shouldNotifyProducer = false;
+      m_rxRing.pop([&count] (const uint8_t*, size_t) { --count; }, shouldNotifyProducer);
+      if (shouldNotifyProducer)
+        ringNfdDoorbell();
+      if (count == 0)
+        return;
+      waitForDoorbell();
+    }
+  }
+
+private:
+  void
+  ringNfdDoorbell()
+  {
+    uint64_t one = 1;
+    if (::write(m_nfdDoorbell, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+      NDN_THROW_ERRNO(std::runtime_error("write"));
+    }
+  }
+
+  void
+  waitForDoorbell()
+  {
+    pollfd pfd{m_appDoorbell, POLLIN, 0};
+    if (::poll(&pfd, 1, -1) < 0) {
+      NDN_THROW_ERRNO(std::runtime_error("poll"));
+    }
+    uint64_t value = 0;
+    ignore_unused(::read(m_appDoorbell, &value, sizeof(value)));
+  }
+
+private:
+  unique_ptr<face::UnixShmRegion> m_region;
+  int m_nfdDoorbell;
+  int m_appDoorbell;
+  face::UnixShmRing m_txRing;
+  face::UnixShmRing m_rxRing;
+};
+#endif // __linux__
+
+/** \brief Measures the throughput of local faces
+ *
+ *  An application thread sends Interests in windows of a fixed size and waits for as many Data,
+ *  which NFD returns on the same face. The same workload runs over a Unix stream face and over
+ *  a shared memory face.
+ */
+class LocalFaceBenchmark
+{
+public:
+  LocalFaceBenchmark(size_t nPackets, size_t windowSize, size_t payloadSize)
+    : m_streamChannel(make_shared<face::UnixStreamChannel>(unix_stream::Endpoint(STREAM_PATH), false))
+    , m_shmChannel(make_shared<face::UnixShmChannel>(unix_stream::Endpoint(SHM_PATH), false))
+    , m_nPackets(nPackets)
+    , m_windowSize(windowSize)
+  {
+    auto interest = make_shared<Interest>("/local-face-benchmark/interest");
+    interest->setCanBePrefix(false);
+    m_interest = interest->wireEncode();
+
+    auto data = make_shared<Data>("/local-face-benchmark/interest");
+    data->setContent(std::vector<uint8_t>(payloadSize, 0xBB).data(), payloadSize);
+    ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(ndn::encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    m_data = data;
+
+    auto onFaceCreated = [this] (const shared_ptr<Face>& face) {
+      face->afterReceiveInterest.connect([this, face] (const Interest&, const EndpointId&) {
+        face->sendData(*m_data);
+      });
+      m_faces.push_back(face);
+    };
+    auto onFaceCreationFailed = [] (uint32_t status, const std::string& reason) {
+      NDN_THROW(std::runtime_error("Failed to create face: [" + to_string(status) + "] " + reason));
+    };
+    m_streamChannel->listen(onFaceCreated, onFaceCreationFailed);
+    m_shmChannel->listen(onFaceCreated, onFaceCreationFailed);
+  }
+
+  void
+  run()
+  {
+    std::exception_ptr error;
+    std::thread app([&] {
+      try {
+        measure<StreamClient>("unix-stream", STREAM_PATH);
+#ifdef __linux__
+        measure<ShmClient>("unix-shm", SHM_PATH);
+#else
+        std::cout << "unix-shm: not supported on this platform" << std::endl;
+#endif // __linux__
+      }
+      catch (const std::exception&) {
+        error = std::current_exception();
+      }
+      getGlobalIoService().post([] { getGlobalIoService().stop(); });
+    });
+
+    getGlobalIoService().run();
+    app.join();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  template<typename Client>
+  void
+  measure(const char* label, const std::string& path)
+  {
+    Client client(path);
+
+    auto t1 = time::steady_clock::now();
+    for (size_t sent = 0; sent < m_nPackets; sent += m_windowSize) {
+      size_t count = std::min(m_windowSize, m_nPackets - sent);
+      for (size_t i = 0; i < count; ++i) {
+        client.send(m_interest);
+      }
+      client.receive(count);
+    }
+    auto t2 = time::steady_clock::now();
+
+    auto us = time::duration_cast<time::microseconds>(t2 - t1).count();
+    double seconds = std::max<double>(us, 1) / 1e6;
+    double bytes = static_cast<double>(m_nPackets) * (m_interest.size() + m_data->wireEncode().size());
+    std::cout << label << ": " << m_nPackets << " round trips in " << us << " us, "
+              << static_cast<uint64_t>(m_nPackets / seconds) << " pps, "
+              << bytes * 8 / seconds / 1e6 << " Mbps" << std::endl;
+  }
+
+private:
+  static const std::string STREAM_PATH;
+  static const std::string SHM_PATH;
+
+  shared_ptr<face::UnixStreamChannel> m_streamChannel;
+  shared_ptr<face::UnixShmChannel> m_shmChannel;
+  std::vector<shared_ptr<Face>> m_faces;
+  Block m_interest;
+  shared_ptr<const Data> m_data;
+  size_t m_nPackets;
+  size_t m_windowSize;
+};
+
+const std::string LocalFaceBenchmark::STREAM_PATH("nfd-local-face-benchmark.sock");
+const std::string LocalFaceBenchmark::SHM_PATH("nfd-local-face-benchmark-shm.sock");
+
+} // namespace tests
+} // namespace nfd
+
+int
+main(int argc, char** argv)
+{
+#ifdef _DEBUG
+  std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+  size_t nPackets = 1000000;
+  size_t windowSize = 64;
+  size_t payloadSize = 1024;
+  bool isValid = argc <= 4;
+  try {
+    if (argc > 1)
+      nPackets = boost::lexical_cast<size_t>(argv[1]);
+    if (argc > 2)
+      windowSize = boost::lexical_cast<size_t>(argv[2]);
+    if (argc > 3)
+      payloadSize = boost::lexical_cast<size_t>(argv[3]);
+  }
+  catch (const boost::bad_lexical_cast&) {
+    isValid = false;
+  }
+  if (!isValid || nPackets == 0 || windowSize == 0 || payloadSize > 8000) {
+    std::cerr << "Usage: " << argv[0] << " [<n-round-trips> [<window-size> [<payload-size>]]]"
+              << std::endl;
+    return 2;
+  }
+
+  try {
+    nfd::tests::LocalFaceBenchmark bench{nPackets, windowSize, payloadSize};
+    bench.run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << boost::diagnostic_information(e);
+    return 1;
+  }
+
+  return 0;
+}
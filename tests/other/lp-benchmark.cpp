@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/lp-fragmenter.hpp"
+#include "face/lp-reassembler.hpp"
+
+#include "tests/daemon/face/dummy-transport.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <iostream>
+#include <random>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+using face::GenericLinkService;
+using face::LpFragmenter;
+using face::LpReassembler;
+using face::tests::DummyTransport;
+
+class LpBenchmarkFixture
+{
+protected:
+  LpBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    auto data = make_shared<Data>("/lp-benchmark/data");
+    std::vector<uint8_t> content(DATA_PAYLOAD_SIZE, 0xCC);
+    data->setContent(content.data(), content.size());
+    ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(ndn::encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    const Block& wire = data->wireEncode();
+    packet.add<lp::FragmentField>({wire.begin(), wire.end()});
+  }
+
+  static time::microseconds
+  timedRun(const std::function<void()>& f)
+  {
+#ifdef HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+  /** \brief fragments the packet into \p nFrags fragments and reassembles it, N_ITERATIONS times
+   */
+  void
+  run(size_t nFrags)
+  {
+    // the MTU is chosen so that the packet is split into exactly nFrags fragments
+    size_t mtu = nFrags == 1 ? ndn::MAX_NDN_PACKET_SIZE : packet.wireEncode().size() / nFrags + 64;
+
+    LpFragmenter fragmenter({});
+    LpReassembler::Options reassemblerOptions;
+    reassemblerOptions.reassemblyTimeout = 10_s;
+    LpReassembler reassembler(reassemblerOptions);
+    lp::Sequence seq = 0;
+    size_t nSentBytes = 0;
+    size_t nReassembled = 0;
+
+    std::vector<lp::Packet> frags;
+    auto fragmentTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        std::tie(std::ignore, frags) = fragmenter.fragmentPacket(packet, mtu, seq);
+        for (const auto& frag : frags) {
+          nSentBytes += frag.wireEncode().size();
+        }
+        seq += frags.size();
+      }
+    });
+    BOOST_REQUIRE_EQUAL(frags.size(), nFrags);
+
+    // fragments as they would be received from a transport
+    std::vector<lp::Packet> received;
+    for (const auto& frag : frags) {
+      received.emplace_back(frag.wireEncode());
+    }
+    auto reassembleTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        for (const auto& frag : received) {
+          bool isComplete = false;
+          std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(frag);
+          nReassembled += isComplete;
+        }
+      }
+    });
+    BOOST_CHECK_EQUAL(nReassembled, N_ITERATIONS);
+
+    std::cout << nFrags << " fragment(s), MTU " << mtu << ", " << N_ITERATIONS << " packets: "
+              << "fragment " << fragmentTime << " (" << nSentBytes / N_ITERATIONS << " bytes/packet), "
+              << "reassemble " << reassembleTime << std::endl;
+  }
+
+protected:
+  static constexpr size_t DATA_PAYLOAD_SIZE = 8000;
+  static constexpr size_t N_ITERATIONS = 200000;
+  lp::Packet packet;
+};
+
+constexpr size_t LpBenchmarkFixture::DATA_PAYLOAD_SIZE;
+constexpr size_t LpBenchmarkFixture::N_ITERATIONS;
+
+BOOST_FIXTURE_TEST_CASE(OneFragment, LpBenchmarkFixture)
+{
+  run(1);
+}
+
+BOOST_FIXTURE_TEST_CASE(FourFragments, LpBenchmarkFixture)
+{
+  run(4);
+}
+
+BOOST_FIXTURE_TEST_CASE(EightFragments, LpBenchmarkFixture)
+{
+  run(8);
+}
+
+class LpReliabilityBenchmarkFixture : public LpBenchmarkFixture
+{
+protected:
+  LpReliabilityBenchmarkFixture()
+  {
+    GenericLinkService::Options options;
+    options.reliabilityOptions.isEnabled = true;
+    auto linkService = make_unique<GenericLinkService>(options);
+    auto transport = make_unique<DummyTransport>();
+    this->linkService = linkService.get();
+    this->transport = transport.get();
+    face = make_unique<Face>(std::move(linkService), std::move(transport));
+
+    for (size_t i = 0; i < N_IN_FLIGHT; ++i) {
+      Interest interest(Name("/lp-reliability-benchmark").appendNumber(i));
+      interest.setCanBePrefix(false);
+      interest.wireEncode();
+      interests.push_back(std::move(interest));
+    }
+  }
+
+protected:
+  // number of packets sent in each round before any of them is acknowledged
+  static constexpr size_t N_IN_FLIGHT = 10000;
+  static constexpr size_t N_ROUNDS = 20;
+  static constexpr double LOSS_RATE = 0.01;
+  static constexpr size_t ACKS_PER_PACKET = 100;
+
+  unique_ptr<Face> face;
+  GenericLinkService* linkService;
+  DummyTransport* transport;
+  std::vector<Interest> interests;
+};
+
+constexpr size_t LpReliabilityBenchmarkFixture::N_IN_FLIGHT;
+constexpr size_t LpReliabilityBenchmarkFixture::N_ROUNDS;
+constexpr double LpReliabilityBenchmarkFixture::LOSS_RATE;
+constexpr size_t LpReliabilityBenchmarkFixture::ACKS_PER_PACKET;
+
+// This test case models a link with a large bandwidth-delay product: in each round, N_IN_FLIGHT
+// packets are sent, then the fragments that are not randomly lost are acknowledged, in order of
+// transmission, ACKS_PER_PACKET per IDLE packet. Losses are detected from Acks for greater
+// TxSequences, and retransmissions are delivered in the same round. The RTO timer never expires.
+BOOST_FIXTURE_TEST_CASE(Reliability, LpReliabilityBenchmarkFixture)
+{
+  std::mt19937 rng(0);
+  std::bernoulli_distribution isLost(LOSS_RATE);
+  size_t nTransmitted = 0;
+  size_t nLost = 0;
+
+  auto d = timedRun([&] {
+    for (size_t round = 0; round < N_ROUNDS; ++round) {
+      for (const auto& interest : interests) {
+        face->sendInterest(interest);
+      }
+
+      lp::Packet ackPkt;
+      size_t nAcks = 0;
+      size_t nDelivered = 0;
+      // retransmissions are appended to sentPackets while Acks are being processed
+      while (nDelivered < transport->sentPackets.size()) {
+        lp::Packet frag(transport->sentPackets[nDelivered++]);
+        if (isLost(rng)) {
+          ++nLost;
+        }
+        else {
+          ackPkt.add<lp::AckField>(frag.get<lp::TxSequenceField>());
+          ++nAcks;
+        }
+
+        if (nAcks == ACKS_PER_PACKET || (nAcks > 0 && nDelivered == transport->sentPackets.size())) {
+          transport->receivePacket(ackPkt.wireEncode());
+          ackPkt = lp::Packet();
+          nAcks = 0;
+        }
+      }
+
+      nTransmitted += transport->sentPackets.size();
+      transport->sentPackets.clear();
+    }
+  });
+
+  const auto& counters = linkService->getCounters();
+  std::cout << N_IN_FLIGHT << " packets in flight, loss rate " << LOSS_RATE << ", "
+            << N_ROUNDS << " rounds: " << d << " (" << nTransmitted << " transmissions, "
+            << nLost << " lost, " << counters.nAcknowledged << " acknowledged, "
+            << counters.nRetransmitted << " acknowledged after retransmission, "
+            << counters.nRetxExhausted << " exceeded retransmissions)" << std::endl;
+}
+
+} // namespace tests
+} // namespace nfd
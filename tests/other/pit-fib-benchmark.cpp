@@ -24,9 +24,15 @@
  */
 
 #include "benchmark-helpers.hpp"
+#include "face/null-face.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/retx-suppression-exponential.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <chrono>
 #include <iostream>
 
 #ifdef HAVE_VALGRIND
@@ -149,5 +155,159 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
 }
 
+// This test case models PIT and FIB operations together with retransmission suppression,
+// in a workload where 20% of the Interests are retransmitted twice by the downstream before
+// Data arrives. Each Interest creates an in-record and an out-record. The first retransmission
+// arrives within the 10 ms initial suppression interval and is suppressed; the second one arrives
+// after it and is forwarded, exercising the per-upstream decision and the interval increment.
+// The suppression logic reads the steady clock, so a virtual clock advancing by a fixed step
+// per iteration makes the arrival times independent of the speed of the machine.
+BOOST_FIXTURE_TEST_CASE(ExchangesWithRetransmissions, PitFibBenchmarkFixture)
+{
+  // number of Interest-Data exchanges
+  const size_t nRoundTrip = 1000000;
+  // virtual time between consecutive iterations
+  const time::nanoseconds tick = 1_us;
+  // number of iterations between processing incoming Interest and processing incoming Data
+  const size_t replyGap = 20000; // 20 ms
+  // number of iterations between processing incoming Interest and its retransmissions;
+  // these fall on both sides of the initial suppression interval below
+  const size_t retxGaps[] = {5000, 15000}; // 5 ms and 15 ms
+  // one in every retxInterval Interests is retransmitted
+  const size_t retxInterval = 5;
+  const size_t nFibEntries = 2000;
+  const size_t fibPrefixLength = 1;
+  const size_t interestNameLength = 2;
+  const size_t dataNameLength = 3;
+
+  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
+                                interestNameLength, dataNameLength);
+
+  auto steadyClock = make_shared<time::UnitTestSteadyClock>();
+  time::setCustomClocks(steadyClock);
+
+  auto inFace = face::makeNullFace();
+  auto outFace = face::makeNullFace();
+  fw::RetxSuppressionExponential retxSuppression(10_ms, 2.0, 250_ms);
+  size_t nRetx = 0;
+  size_t nRetxForwarded = 0;
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  // the virtual clock replaces time::steady_clock, so the wall clock is read directly
+  auto t1 = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+    steadyClock->advance(tick);
+    if (i < nRoundTrip) {
+      // process incoming Interest
+      const Interest& interest = *interests[i];
+      auto pitEntry = m_pit.insert(interest).first;
+      pitEntry->insertOrUpdateInRecord(*inFace, interest);
+      m_fib.findLongestPrefixMatch(*pitEntry);
+      if (retxSuppression.decidePerPitEntry(*pitEntry) == fw::RetxSuppressionResult::NEW) {
+        pitEntry->insertOrUpdateOutRecord(*outFace, interest);
+      }
+    }
+    for (size_t retxGap : retxGaps) {
+      if (i < retxGap || i - retxGap >= nRoundTrip || (i - retxGap) % retxInterval != 0) {
+        continue;
+      }
+      // process retransmitted Interest
+      const Interest& interest = *interests[i - retxGap];
+      auto pitEntry = m_pit.insert(interest).first;
+      pitEntry->insertOrUpdateInRecord(*inFace, interest);
+      ++nRetx;
+      auto perEntry = retxSuppression.decidePerPitEntry(*pitEntry);
+      auto perUpstream = retxSuppression.decidePerUpstream(*pitEntry, *outFace);
+      if (perEntry == fw::RetxSuppressionResult::FORWARD &&
+          perUpstream != fw::RetxSuppressionResult::SUPPRESS) {
+        auto outRecord = pitEntry->insertOrUpdateOutRecord(*outFace, interest);
+        retxSuppression.incrementIntervalForOutRecord(*outRecord);
+        ++nRetxForwarded;
+      }
+    }
+    if (i >= replyGap) {
+      // process incoming Data
+      auto matches = m_pit.findAllDataMatches(*data[i - replyGap]);
+      for (const auto& pitEntry : matches) {
+        m_pit.erase(pitEntry.get());
+      }
+    }
+  }
+
+  auto t2 = std::chrono::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  time::setCustomClocks(nullptr, nullptr);
+
+  // half of the retransmissions, i.e. the second one of each Interest, are forwarded
+  std::cout << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()
+            << " microseconds (" << nRetx << " retransmissions, "
+            << nRetxForwarded << " forwarded)" << std::endl;
+}
+
+// This test case compares FIB longest prefix match with and without the flow cache,
+// for the lookups made while forwarding Interests that belong to a limited number of flows.
+// Each of nFlows FIB prefixes has fibPrefixLength components, so the flow cache keys flows
+// on that many components of the Interest name.
+BOOST_AUTO_TEST_CASE(FlowCacheLookups)
+{
+  // number of distinct Interest names, i.e. PIT entries
+  const size_t nInterests = 100000;
+  // number of times each PIT entry is looked up
+  const size_t nRounds = 10;
+  // number of flows, each one under its own FIB entry
+  const size_t nFlows = 2000;
+  const size_t fibPrefixLength = 3;
+  const size_t interestNameLength = 6;
+
+  FaceTable faceTable;
+  Forwarder forwarder(faceTable);
+  Fib& fib = forwarder.getFib();
+  fw::FlowCache& flowCache = forwarder.getFlowCache();
+
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+  pitEntries.reserve(nInterests);
+  for (size_t i = 0; i < nInterests; ++i) {
+    Name name(to_string(i % nFlows));
+    while (name.size() < fibPrefixLength) {
+      name.append("prefix");
+    }
+    fib.insert(name);
+    name.appendNumber(i);
+    while (name.size() < interestNameLength) {
+      name.append("suffix");
+    }
+    pitEntries.push_back(forwarder.getPit().insert(*make_shared<Interest>(name)).first);
+  }
+
+  auto measure = [&] (const std::string& label, const auto& lookup) {
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < nRounds; ++round) {
+      for (const auto& pitEntry : pitEntries) {
+        lookup(*pitEntry);
+      }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << label << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()
+              << " microseconds" << std::endl;
+  };
+
+  measure("Fib", [&] (const pit::Entry& pitEntry) { fib.findLongestPrefixMatch(pitEntry); });
+
+  flowCache.setLimit(2 * nFlows);
+  measure("FlowCache", [&] (const pit::Entry& pitEntry) {
+    flowCache.findLongestPrefixMatch(pitEntry);
+  });
+  std::cout << "FlowCache hits=" << flowCache.nHits << " misses=" << flowCache.nMisses << std::endl;
+}
+
 } // namespace tests
 } // namespace nfd
@@ -0,0 +1,160 @@
+#!/usr/bin/env bash
+# Measures discovery traffic and RIB work of the self-learning strategy on a broadcast network.
+#
+# NODES NFD instances run in separate network namespaces attached to a common Linux bridge,
+# and communicate over UDP multicast. Node 1 runs ndnpingserver; every other node runs ndnping
+# toward it, so each node performs self-learning discovery at the same time.
+#
+# Must be run as root. See self-learning-benchmark.md for details.
+
+set -eo pipefail
+
+NODES=${NODES:-50}
+DURATION=${DURATION:-30}
+PING_INTERVAL=${PING_INTERVAL:-100}
+STRATEGY_PARAMS=${STRATEGY_PARAMS:-}
+PREFIX=/sl/ping
+BRIDGE=slbench-br
+
+if [[ $EUID -ne 0 ]]; then
+  echo "This script must be run as root" >&2
+  exit 2
+fi
+
+for cmd in nfd nfdc ndnpingserver ndnping ip; do
+  if ! command -v $cmd >/dev/null; then
+    echo "$cmd not found" >&2
+    exit 2
+  fi
+done
+
+WORKDIR=$(mktemp -d)
+PIDS=()
+
+cleanup() {
+  kill "${PIDS[@]}" 2>/dev/null || true
+  wait 2>/dev/null || true
+  for i in $(seq 1 $NODES); do
+    ip netns del slbench$i 2>/dev/null || true
+  done
+  ip link del $BRIDGE 2>/dev/null || true
+  rm -rf "$WORKDIR"
+}
+trap cleanup EXIT
+
+make_config() {
+  local i=$1
+  cat > "$WORKDIR/$i.conf" <<CONF
+general
+{
+}
+log
+{
+  default_level WARN
+  SelfLearningStrategy DEBUG
+}
+face_system
+{
+  unix
+  {
+    path $WORKDIR/$i.sock
+  }
+  udp
+  {
+    listen yes
+    port 6363
+    mcast yes
+    mcast_group 224.0.23.170
+    mcast_port 56363
+  }
+}
+authorizations
+{
+  authorize
+  {
+    certfile any
+    privileges
+    {
+      faces
+      fib
+      rib
+      strategy-choice
+    }
+  }
+}
+rib
+{
+  localhost_security
+  {
+    trust-anchor
+    {
+      type any
+    }
+  }
+  localhop_security
+  {
+    trust-anchor
+    {
+      type any
+    }
+  }
+  readvertise_nlsr no
+}
+CONF
+}
+
+at() {
+  local i=$1
+  shift
+  NDN_CLIENT_TRANSPORT=unix://$WORKDIR/$i.sock ip netns exec slbench$i "$@"
+}
+
+ip link add $BRIDGE type bridge
+ip link set $BRIDGE up
+for i in $(seq 1 $NODES); do
+  ip netns add slbench$i
+  ip link add veth$i type veth peer name eth0 netns slbench$i
+  ip link set veth$i master $BRIDGE up
+  ip netns exec slbench$i ip link set lo up
+  ip netns exec slbench$i ip addr add 10.99.$((i / 250)).$((i % 250 + 1))/16 dev eth0
+  ip netns exec slbench$i ip link set eth0 up
+  ip netns exec slbench$i ip route add 224.0.0.0/4 dev eth0
+
+  make_config $i
+  ip netns exec slbench$i nfd --config "$WORKDIR/$i.conf" >"$WORKDIR/$i.log" 2>&1 &
+  PIDS+=($!)
+done
+sleep 3
+
+for i in $(seq 1 $NODES); do
+  at $i nfdc strategy set prefix /sl strategy /localhost/nfd/strategy/self-learning$STRATEGY_PARAMS >/dev/null
+done
+
+at 1 ndnpingserver $PREFIX >/dev/null 2>&1 &
+PIDS+=($!)
+sleep 1
+
+for i in $(seq 2 $NODES); do
+  at $i ndnping -i $PING_INTERVAL -o 1000 $PREFIX >"$WORKDIR/$i.ping" 2>&1 &
+  PIDS+=($!)
+done
+sleep $DURATION
+
+# count Interests sent on multicast faces, which are discovery broadcasts
+discovery=0
+for i in $(seq 1 $NODES); do
+  n=$(at $i nfdc face list remote udp4://224.0.23.170:56363 2>/dev/null |
+      sed -n 's/.*out={\([0-9]*\)i.*/\1/p' | awk '{s += $1} END {print s + 0}')
+  discovery=$((discovery + n))
+done
+
+tasks=$(cat "$WORKDIR"/*.log | grep -c 'PrefixAnnouncements to RIB' || true)
+announcements=$(cat "$WORKDIR"/*.log | grep -c 'Add route via PrefixAnnouncement' || true)
+received=$(cat "$WORKDIR"/*.ping | grep -c 'content from' || true)
+
+echo "strategy:                /localhost/nfd/strategy/self-learning$STRATEGY_PARAMS"
+echo "nodes:                   $NODES"
+echo "ping replies:            $received"
+echo "discovery Interests:     $discovery"
+echo "RIB tasks (batches):     $tasks"
+echo "slAnnounce invocations:  $announcements"
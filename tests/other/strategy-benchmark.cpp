@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/null-face.hpp"
+#include "fw/best-route-strategy2.hpp"
+#include "fw/cache-affinity-strategy.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/random-strategy.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <random>
+
+namespace nfd {
+namespace tests {
+
+/** \brief A fixed-capacity LRU cache of content IDs, modeling an upstream caching router.
+ */
+class SimulatedCache
+{
+public:
+  explicit
+  SimulatedCache(size_t capacity)
+    : m_capacity(capacity)
+  {
+  }
+
+  /** \return whether \p id was cached; \p id is cached afterwards
+   */
+  bool
+  request(size_t id)
+  {
+    auto it = m_index.find(id);
+    if (it != m_index.end()) {
+      m_queue.splice(m_queue.begin(), m_queue, it->second);
+      return true;
+    }
+
+    m_queue.push_front(id);
+    m_index[id] = m_queue.begin();
+    if (m_queue.size() > m_capacity) {
+      m_index.erase(m_queue.back());
+      m_queue.pop_back();
+    }
+    return false;
+  }
+
+private:
+  size_t m_capacity;
+  std::list<size_t> m_queue;
+  std::unordered_map<size_t, std::list<size_t>::iterator> m_index;
+};
+
+/** \brief Simulates a router with one downstream and several upstream caches.
+ *
+ *  Interests for a Zipf-distributed catalog are fed into a Forwarder running the strategy
+ *  under test. Each upstream face is backed by a SimulatedCache, which determines whether
+ *  the Interest would be a hit at that upstream. Local caching is disabled so that all
+ *  Interests reach the strategy.
+ */
+class StrategyBenchmarkFixture
+{
+protected:
+  StrategyBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    std::vector<double> weights;
+    weights.reserve(N_CONTENTS);
+    for (size_t i = 1; i <= N_CONTENTS; ++i) {
+      weights.push_back(1.0 / std::pow(i, ZIPF_EXPONENT));
+    }
+    std::discrete_distribution<size_t> zipf(weights.begin(), weights.end());
+
+    std::mt19937 rng(RANDOM_SEED);
+    requests.reserve(N_REQUESTS);
+    for (size_t i = 0; i < N_REQUESTS; ++i) {
+      requests.push_back(zipf(rng));
+    }
+
+    for (size_t i = 0; i < N_CONTENTS; ++i) {
+      names.push_back(Name("/bench").appendNumber(i).append("seg0"));
+    }
+  }
+
+  void
+  run(const std::string& label, const Name& strategyName)
+  {
+    FaceTable faceTable;
+    Forwarder forwarder(faceTable);
+    forwarder.getCs().enableAdmit(false);
+    forwarder.getStrategyChoice().insert("/", strategyName);
+
+    auto downstream = face::makeNullFace();
+    faceTable.add(downstream);
+
+    fib::Entry* fibEntry = forwarder.getFib().insert("/bench").first;
+    std::map<FaceId, size_t> upstreamIndex;
+    std::vector<SimulatedCache> caches;
+    for (size_t i = 0; i < N_UPSTREAMS; ++i) {
+      auto face = face::makeNullFace();
+      faceTable.add(face);
+      forwarder.getFib().addOrUpdateNextHop(*fibEntry, *face, 10);
+      upstreamIndex[face->getId()] = i;
+      caches.emplace_back(CACHE_CAPACITY);
+    }
+
+    std::vector<size_t> load(N_UPSTREAMS);
+    size_t nHits = 0;
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t id : requests) {
+      auto interest = make_shared<Interest>(names[id]);
+      interest->setCanBePrefix(false);
+      forwarder.startProcessInterest(FaceEndpoint(*downstream), *interest);
+
+      auto pitEntry = forwarder.getPit().find(*interest);
+      if (pitEntry == nullptr || pitEntry->getOutRecords().empty()) {
+        continue;
+      }
+      Face& upstream = pitEntry->getOutRecords().front().getFace();
+      size_t index = upstreamIndex.at(upstream.getId());
+      ++load[index];
+      nHits += caches[index].request(id);
+
+      forwarder.startProcessData(FaceEndpoint(upstream), *makeData(names[id]));
+      getGlobalIoService().poll(); // erase satisfied PIT entry
+    }
+
+    auto t2 = time::steady_clock::now();
+
+    size_t total = std::accumulate(load.begin(), load.end(), size_t(0));
+    size_t maxLoad = *std::max_element(load.begin(), load.end());
+
+    std::cout << label << ": time=" << time::duration_cast<time::milliseconds>(t2 - t1)
+              << std::fixed << std::setprecision(3)
+              << " hit-ratio=" << static_cast<double>(nHits) / total
+              << " max/mean-load=" << static_cast<double>(maxLoad) * N_UPSTREAMS / total
+              << " load=";
+    for (size_t i = 0; i < N_UPSTREAMS; ++i) {
+      std::cout << (i == 0 ? "" : ",") << static_cast<double>(load[i]) / total;
+    }
+    std::cout << std::endl;
+  }
+
+private:
+  static shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(ndn::encoding::makeEmptyBlock(tlv::SignatureValue));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    return data;
+  }
+
+protected:
+  // number of upstream caching routers
+  static constexpr size_t N_UPSTREAMS = 4;
+  // catalog size
+  static constexpr size_t N_CONTENTS = 100000;
+  // capacity of each upstream cache, in contents
+  static constexpr size_t CACHE_CAPACITY = 5000;
+  // number of Interests
+  static constexpr size_t N_REQUESTS = 500000;
+  // popularity distribution
+  static constexpr double ZIPF_EXPONENT = 0.8;
+  static constexpr unsigned RANDOM_SEED = 1;
+
+  std::vector<size_t> requests;
+  std::vector<Name> names;
+};
+
+// This test case compares per-upstream load balance and aggregate upstream cache hit ratio
+// among strategies that distribute Interests over multiple upstream caches.
+BOOST_FIXTURE_TEST_CASE(CacheAffinity, StrategyBenchmarkFixture)
+{
+  run("best-route", fw::BestRouteStrategy2::getStrategyName());
+  run("random", fw::RandomStrategy::getStrategyName());
+  run("cache-affinity", fw::CacheAffinityStrategy::getStrategyName());
+}
+
+} // namespace tests
+} // namespace nfd
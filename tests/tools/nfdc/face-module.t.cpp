@@ -24,6 +24,8 @@
  */
 
 #include "nfdc/face-module.hpp"
+#include "core/face-link-options.hpp"
+#include "core/face-link-status.hpp"
 
 #include "execute-command-fixture.hpp"
 #include "status-fixture.hpp"
@@ -218,6 +220,66 @@ BOOST_AUTO_TEST_CASE(NormalAllCongestionParams)
   BOOST_CHECK(err.is_empty());
 }
 
+const std::string LINK_OPTIONS_OUTPUT = std::string(R"TEXT(
+    faceid=256
+    remote=udp4://84.67.35.111:6363
+     local=udp4://79.91.49.215:6363
+       mtu=4000
+send-queue-target=500us
+class-weights={interest=1 data=4 nack=1}
+ingress-weight=2
+rate-limits={interest=200/s burst=200}
+send-queue-sojourn={p50=64us p90=1024us p99=8192us}
+  counters={in={28975i 28232d 212n 13307258B} out={19525i 30993d 1038n 6231946B}}
+     flags={non-local on-demand point-to-point}
+)TEXT").substr(1);
+
+BOOST_AUTO_TEST_CASE(LinkOptionsAndStatus)
+{
+  this->processInterest = [this] (const Interest& interest) {
+    BOOST_CHECK(Name("/localhost/nfd/faces/query").isPrefixOf(interest.getName()));
+
+    FaceStatus payload;
+    payload.setFaceId(256)
+           .setRemoteUri("udp4://84.67.35.111:6363")
+           .setLocalUri("udp4://79.91.49.215:6363")
+           .setFaceScope(ndn::nfd::FACE_SCOPE_NON_LOCAL)
+           .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_ON_DEMAND)
+           .setMtu(4000)
+           .setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT)
+           .setNInInterests(28975)
+           .setNInData(28232)
+           .setNInNacks(212)
+           .setNOutInterests(19525)
+           .setNOutData(30993)
+           .setNOutNacks(1038)
+           .setNInBytes(13307258)
+           .setNOutBytes(6231946);
+
+    // the NFD-specific fields are appended to the FaceStatus
+    FaceLinkOptions linkOptions;
+    linkOptions.interestRate = 200;
+    linkOptions.interestBurst = 200;
+    linkOptions.sendQueueTarget = 500_us;
+    linkOptions.interestWeight = 1;
+    linkOptions.dataWeight = 4;
+    linkOptions.nackWeight = 1;
+    linkOptions.ingressWeight = 2;
+    FaceLinkStatus linkStatus;
+    linkStatus.sojournP50 = 64_us;
+    linkStatus.sojournP90 = 1024_us;
+    linkStatus.sojournP99 = 8192_us;
+    payload.wireDecode(linkStatus.appendTo(linkOptions.appendTo(payload.wireEncode())));
+
+    this->sendDataset(interest.getName(), payload);
+  };
+
+  this->execute("face show 256");
+  BOOST_CHECK_EQUAL(exitCode, 0);
+  BOOST_CHECK(out.is_equal(LINK_OPTIONS_OUTPUT));
+  BOOST_CHECK(err.is_empty());
+}
+
 const std::string NORMAL_INTERVAL_CONGESTION_OUTPUT = std::string(R"TEXT(
     faceid=256
     remote=udp4://84.67.35.111:6363
@@ -922,6 +984,123 @@ BOOST_AUTO_TEST_CASE(ErrorUpdate)
 
 BOOST_AUTO_TEST_SUITE_END() // CreateCommand
 
+BOOST_FIXTURE_TEST_SUITE(UpdateCommand, ExecuteCommandFixture)
+
+BOOST_AUTO_TEST_CASE(Normal)
+{
+  this->processInterest = [this] (const Interest& interest) {
+    if (this->respondFaceQuery(interest)) {
+      return;
+    }
+
+    ControlParameters req = MOCK_NFD_MGMT_REQUIRE_COMMAND_IS("/localhost/nfd/faces/update");
+    BOOST_REQUIRE(req.hasFaceId());
+    BOOST_CHECK_EQUAL(req.getFaceId(), 10156);
+    FaceLinkOptions limits(req.wireEncode());
+    BOOST_CHECK_EQUAL(limits.interestRate.value_or(0), 200);
+    BOOST_CHECK(!limits.interestBurst);
+    BOOST_CHECK_EQUAL(limits.dataRate.value_or(0), 1000000);
+    BOOST_CHECK_EQUAL(limits.dataBurst.value_or(0), 64000);
+    BOOST_CHECK_EQUAL(limits.wantPacking.value_or(false), true);
+    BOOST_CHECK_EQUAL(limits.sendQueueTarget.value_or(0_ns), 500_us);
+    BOOST_CHECK(!limits.interestWeight);
+    BOOST_CHECK_EQUAL(limits.dataWeight.value_or(0), 4);
+    BOOST_CHECK(!limits.nackWeight);
+    BOOST_CHECK_EQUAL(limits.ingressWeight.value_or(0), 8);
+
+    limits.interestBurst = 200;
+    ControlParameters resp;
+    resp.setFaceId(10156)
+        .setFacePersistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+    resp.wireDecode(limits.appendTo(resp.wireEncode()));
+    this->succeedCommand(interest, resp);
+  };
+
+  this->execute("face update 10156 interest-rate-limit 200 "
+                "data-rate-limit 1000000 data-burst-limit 64000 packing on "
+                "send-queue-target 500 data-weight 4 ingress-weight 8");
+  BOOST_CHECK_EQUAL(exitCode, 0);
+  BOOST_CHECK(out.is_equal("face-updated id=10156 local=tcp4://151.26.163.27:22967 "
+                           "remote=tcp4://198.57.27.40:6363 persistency=persistent "
+                           "reliability=off congestion-marking=off packing=on "
+                           "send-queue-target=500us class-weights={data=4} ingress-weight=8 "
+                           "rate-limits={interest=200/s burst=200 "
+                           "data=1000000B/s burst=64000B}\n"));
+  BOOST_CHECK(err.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(NoLimit)
+{
+  this->processInterest = nullptr; // no request is expected
+
+  this->execute("face update 10156");
+  BOOST_CHECK_EQUAL(exitCode, 2);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("At least one link option must be specified\n"));
+}
+
+BOOST_AUTO_TEST_CASE(ZeroSendQueueTarget)
+{
+  this->processInterest = nullptr; // no request is expected
+
+  this->execute("face update 10156 send-queue-target 0");
+  BOOST_CHECK_EQUAL(exitCode, 2);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("The send queue target must be positive\n"));
+}
+
+BOOST_AUTO_TEST_CASE(ZeroClassWeight)
+{
+  this->processInterest = nullptr; // no request is expected
+
+  this->execute("face update 10156 interest-weight 2 nack-weight 0");
+  BOOST_CHECK_EQUAL(exitCode, 2);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("The class weights must be positive\n"));
+}
+
+BOOST_AUTO_TEST_CASE(ZeroIngressWeight)
+{
+  this->processInterest = nullptr; // no request is expected
+
+  this->execute("face update 10156 ingress-weight 0");
+  BOOST_CHECK_EQUAL(exitCode, 2);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("The ingress weight must be positive\n"));
+}
+
+BOOST_AUTO_TEST_CASE(NotSupported)
+{
+  this->processInterest = [this] (const Interest& interest) {
+    if (this->respondFaceQuery(interest)) {
+      return;
+    }
+
+    MOCK_NFD_MGMT_REQUIRE_COMMAND_IS("/localhost/nfd/faces/update");
+    this->failCommand(interest, 409, "Invalid properties specified");
+  };
+
+  this->execute("face update 10156 interest-rate-limit 200");
+  BOOST_CHECK_EQUAL(exitCode, 1);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("Cannot update face 10156: "
+                           "the face does not support link options\n"));
+}
+
+BOOST_AUTO_TEST_CASE(FaceNotExist)
+{
+  this->processInterest = [this] (const Interest& interest) {
+    BOOST_CHECK(this->respondFaceQuery(interest));
+  };
+
+  this->execute("face update 23728 interest-rate-limit 200");
+  BOOST_CHECK_EQUAL(exitCode, 3);
+  BOOST_CHECK(out.is_empty());
+  BOOST_CHECK(err.is_equal("Face not found\n"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UpdateCommand
+
 BOOST_FIXTURE_TEST_SUITE(DestroyCommand, ExecuteCommandFixture)
 
 BOOST_AUTO_TEST_CASE(NormalByFaceId)
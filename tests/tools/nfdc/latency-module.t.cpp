@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nfdc/latency-module.hpp"
+
+#include "status-fixture.hpp"
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Nfdc)
+BOOST_FIXTURE_TEST_SUITE(TestLatencyModule, StatusFixture<LatencyModule>)
+
+const std::string STATUS_XML = stripXmlSpaces(R"XML(
+  <latency>
+    <faceLatency>
+      <faceId>262</faceId>
+      <stages>
+        <stage>
+          <name>incoming</name>
+          <nSamples>120</nSamples>
+          <p50>4</p50>
+          <p90>8</p90>
+          <p99>64</p99>
+        </stage>
+        <stage>
+          <name>transmit</name>
+          <nSamples>118</nSamples>
+          <p50>32</p50>
+          <p90>64</p90>
+          <p99>1024</p99>
+        </stage>
+      </stages>
+    </faceLatency>
+    <faceLatency>
+      <faceId>270</faceId>
+      <stages>
+        <stage>
+          <name>strategy</name>
+          <nSamples>1</nSamples>
+          <p50>16</p50>
+          <p90>16</p90>
+          <p99>16</p99>
+        </stage>
+      </stages>
+    </faceLatency>
+  </latency>
+)XML");
+
+const std::string STATUS_TEXT = std::string(R"TEXT(
+Interest latency:
+  faceid=262 incoming={samples=120 p50=4us p90=8us p99=64us} transmit={samples=118 p50=32us p90=64us p99=1024us}
+  faceid=270 strategy={samples=1 p50=16us p90=16us p99=16us}
+)TEXT").substr(1);
+
+BOOST_AUTO_TEST_CASE(Status)
+{
+  this->fetchStatus();
+  FaceLatencyStatus payload1;
+  payload1.faceId = 262;
+  payload1.stages.push_back({TraceStage::INCOMING, 120, 4_us, 8_us, 64_us});
+  payload1.stages.push_back({TraceStage::TRANSMIT, 118, 32_us, 64_us, 1024_us});
+  FaceLatencyStatus payload2;
+  payload2.faceId = 270;
+  payload2.stages.push_back({TraceStage::STRATEGY, 1, 16_us, 16_us, 16_us});
+  this->sendDataset("/localhost/nfd/status/latency", payload1, payload2);
+  this->prepareStatusOutput();
+
+  BOOST_CHECK(statusXml.is_equal(STATUS_XML));
+  BOOST_CHECK(statusText.is_equal(STATUS_TEXT));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLatencyModule
+BOOST_AUTO_TEST_SUITE_END() // Nfdc
+
+} // namespace tests
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nfdc/send-queue-module.hpp"
+
+#include "status-fixture.hpp"
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Nfdc)
+BOOST_FIXTURE_TEST_SUITE(TestSendQueueModule, StatusFixture<SendQueueModule>)
+
+const std::string STATUS_XML = stripXmlSpaces(R"XML(
+  <sendQueues>
+    <faceSendQueue>
+      <faceId>262</faceId>
+      <classes>
+        <class>
+          <name>priority</name>
+          <weight>0</weight>
+          <queueLength>0</queueLength>
+          <nDropped>0</nDropped>
+        </class>
+        <class>
+          <name>data</name>
+          <weight>4</weight>
+          <queueLength>120</queueLength>
+          <nDropped>37</nDropped>
+        </class>
+      </classes>
+    </faceSendQueue>
+    <faceSendQueue>
+      <faceId>270</faceId>
+      <classes></classes>
+    </faceSendQueue>
+  </sendQueues>
+)XML");
+
+const std::string STATUS_TEXT = std::string(R"TEXT(
+Send queues:
+  faceid=262 priority={weight=0 length=0 dropped=0} data={weight=4 length=120 dropped=37}
+  faceid=270
+)TEXT").substr(1);
+
+BOOST_AUTO_TEST_CASE(Status)
+{
+  this->fetchStatus();
+  FaceSendQueueStatus payload1;
+  payload1.faceId = 262;
+  payload1.classes.push_back({TxClass::PRIORITY, 0, 0, 0});
+  payload1.classes.push_back({TxClass::DATA, 4, 120, 37});
+  FaceSendQueueStatus payload2;
+  payload2.faceId = 270;
+  this->sendDataset("/localhost/nfd/status/send-queue", payload1, payload2);
+  this->prepareStatusOutput();
+
+  BOOST_CHECK(statusXml.is_equal(STATUS_XML));
+  BOOST_CHECK(statusText.is_equal(STATUS_TEXT));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSendQueueModule
+BOOST_AUTO_TEST_SUITE_END() // Nfdc
+
+} // namespace tests
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
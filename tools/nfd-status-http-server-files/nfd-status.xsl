@@ -391,4 +391,58 @@
   </table>
 </xsl:template>
 
+<xsl:template match="nfd:latency">
+  <h2>Interest Latency</h2>
+  <table class="item-list alt-row-colors">
+    <thead>
+      <tr>
+        <th>Face ID</th>
+        <th>Stage</th>
+        <th>Samples</th>
+        <th>50th percentile (&#181;s)</th>
+        <th>90th percentile (&#181;s)</th>
+        <th>99th percentile (&#181;s)</th>
+      </tr>
+    </thead>
+    <tbody>
+      <xsl:for-each select="nfd:faceLatency/nfd:stages/nfd:stage">
+      <tr>
+        <td><xsl:value-of select="../../nfd:faceId"/></td>
+        <td><xsl:value-of select="nfd:name"/></td>
+        <td><xsl:value-of select="nfd:nSamples"/></td>
+        <td><xsl:value-of select="nfd:p50"/></td>
+        <td><xsl:value-of select="nfd:p90"/></td>
+        <td><xsl:value-of select="nfd:p99"/></td>
+      </tr>
+      </xsl:for-each>
+    </tbody>
+  </table>
+</xsl:template>
+
+<xsl:template match="nfd:sendQueues">
+  <h2>Send Queues</h2>
+  <table class="item-list alt-row-colors">
+    <thead>
+      <tr>
+        <th>Face ID</th>
+        <th>Traffic class</th>
+        <th>Weight</th>
+        <th>Queued packets</th>
+        <th>Dropped packets</th>
+      </tr>
+    </thead>
+    <tbody>
+      <xsl:for-each select="nfd:faceSendQueue/nfd:classes/nfd:class">
+      <tr>
+        <td><xsl:value-of select="../../nfd:faceId"/></td>
+        <td><xsl:value-of select="nfd:name"/></td>
+        <td><xsl:value-of select="nfd:weight"/></td>
+        <td><xsl:value-of select="nfd:queueLength"/></td>
+        <td><xsl:value-of select="nfd:nDropped"/></td>
+      </tr>
+      </xsl:for-each>
+    </tbody>
+  </table>
+</xsl:template>
+
 </xsl:stylesheet>
@@ -27,6 +27,9 @@
 #include "canonizer.hpp"
 #include "find-face.hpp"
 
+#include "core/face-link-options.hpp"
+#include "core/face-link-status.hpp"
+
 namespace nfd {
 namespace tools {
 namespace nfdc {
@@ -62,6 +65,22 @@ FaceModule::registerCommands(CommandParser& parser)
     .addArg("mtu", ArgValueType::STRING, Required::NO, Positional::NO);
   parser.addCommand(defFaceCreate, &FaceModule::create);
 
+  CommandDefinition defFaceUpdate("face", "update");
+  defFaceUpdate
+    .setTitle("change the link options of a face")
+    .addArg("face", ArgValueType::FACE_ID_OR_URI, Required::YES, Positional::YES)
+    .addArg("interest-rate-limit", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("interest-burst-limit", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("data-rate-limit", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("data-burst-limit", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("packing", ArgValueType::BOOLEAN, Required::NO, Positional::NO)
+    .addArg("send-queue-target", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("interest-weight", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("data-weight", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("nack-weight", ArgValueType::UNSIGNED, Required::NO, Positional::NO)
+    .addArg("ingress-weight", ArgValueType::UNSIGNED, Required::NO, Positional::NO);
+  parser.addCommand(defFaceUpdate, &FaceModule::update);
+
   CommandDefinition defFaceDestroy("face", "destroy");
   defFaceDestroy
     .setTitle("destroy a face")
@@ -316,6 +335,100 @@ FaceModule::create(ExecuteContext& ctx)
   ctx.face.processEvents();
 }
 
+void
+FaceModule::update(ExecuteContext& ctx)
+{
+  FaceLinkOptions linkOptions;
+  linkOptions.interestRate = ctx.args.getOptional<uint64_t>("interest-rate-limit");
+  linkOptions.interestBurst = ctx.args.getOptional<uint64_t>("interest-burst-limit");
+  linkOptions.dataRate = ctx.args.getOptional<uint64_t>("data-rate-limit");
+  linkOptions.dataBurst = ctx.args.getOptional<uint64_t>("data-burst-limit");
+  linkOptions.wantPacking = ctx.args.getOptional<bool>("packing");
+  auto sendQueueTargetUs = ctx.args.getOptional<uint64_t>("send-queue-target");
+  if (sendQueueTargetUs) {
+    if (*sendQueueTargetUs == 0) {
+      ctx.exitCode = 2;
+      ctx.err << "The send queue target must be positive\n";
+      return;
+    }
+    linkOptions.sendQueueTarget = time::microseconds(*sendQueueTargetUs);
+  }
+  linkOptions.interestWeight = ctx.args.getOptional<uint64_t>("interest-weight");
+  linkOptions.dataWeight = ctx.args.getOptional<uint64_t>("data-weight");
+  linkOptions.nackWeight = ctx.args.getOptional<uint64_t>("nack-weight");
+  if (linkOptions.interestWeight.value_or(1) == 0 || linkOptions.dataWeight.value_or(1) == 0 ||
+      linkOptions.nackWeight.value_or(1) == 0) {
+    ctx.exitCode = 2;
+    ctx.err << "The class weights must be positive\n";
+    return;
+  }
+  linkOptions.ingressWeight = ctx.args.getOptional<uint64_t>("ingress-weight");
+  if (linkOptions.ingressWeight.value_or(1) == 0) {
+    ctx.exitCode = 2;
+    ctx.err << "The ingress weight must be positive\n";
+    return;
+  }
+  if (linkOptions.empty()) {
+    ctx.exitCode = 2;
+    ctx.err << "At least one link option must be specified\n";
+    return;
+  }
+
+  FindFace findFace(ctx);
+  FindFace::Code res = findFace.execute(ctx.args.at("face"));
+
+  ctx.exitCode = static_cast<int>(res);
+  switch (res) {
+    case FindFace::Code::OK:
+      break;
+    case FindFace::Code::ERROR:
+    case FindFace::Code::CANONIZE_ERROR:
+    case FindFace::Code::NOT_FOUND:
+      ctx.err << findFace.getErrorReason() << '\n';
+      return;
+    case FindFace::Code::AMBIGUOUS:
+      ctx.err << "Multiple faces match specified remote FaceUri. Re-run the command with a FaceId:";
+      findFace.printDisambiguation(ctx.err, FindFace::DisambiguationStyle::LOCAL_URI);
+      ctx.err << '\n';
+      return;
+    default:
+      BOOST_ASSERT_MSG(false, "unexpected FindFace result");
+      return;
+  }
+
+  const FaceStatus& face = findFace.getFaceStatus();
+
+  // the link options are NFD-specific fields appended to the ControlParameters
+  ControlParameters params;
+  params.setFaceId(face.getFaceId());
+  params.wireDecode(linkOptions.appendTo(params.wireEncode()));
+
+  ctx.controller.start<ndn::nfd::FaceUpdateCommand>(
+    params,
+    [&] (const ControlParameters& resp) {
+      // We can't use printSuccess because the FaceUris come from FaceStatus not ControlResponse
+      ctx.out << "face-updated ";
+      text::ItemAttributes ia;
+      ctx.out << ia("id") << face.getFaceId()
+              << ia("local") << face.getLocalUri()
+              << ia("remote") << face.getRemoteUri()
+              << ia("persistency") << face.getFacePersistency();
+      printFaceParams(ctx.out, ia, resp);
+    },
+    [&] (const ControlResponse& resp) {
+      if (resp.getCode() == 409) {
+        ctx.exitCode = 1;
+        ctx.err << "Cannot update face " << face.getFaceId()
+                << ": the face does not support link options\n";
+        return;
+      }
+      ctx.makeCommandFailureHandler("updating face")(resp); // invoke general error handler
+    },
+    ctx.makeCommandOptions());
+
+  ctx.face.processEvents();
+}
+
 void
 FaceModule::destroy(ExecuteContext& ctx)
 {
@@ -494,6 +607,24 @@ FaceModule::formatItemText(std::ostream& os, const FaceStatus& item, bool wantMu
     os << ia("mtu") << item.getMtu();
   }
 
+  printLinkOptions(os, ia, item.wireEncode());
+
+  FaceLinkStatus linkStatus(item.wireEncode());
+  if (!linkStatus.empty()) {
+    os << ia("send-queue-sojourn") << "{";
+    text::Separator sep("", " ");
+    if (linkStatus.sojournP50) {
+      os << sep << "p50=" << text::formatDuration<time::microseconds>(*linkStatus.sojournP50);
+    }
+    if (linkStatus.sojournP90) {
+      os << sep << "p90=" << text::formatDuration<time::microseconds>(*linkStatus.sojournP90);
+    }
+    if (linkStatus.sojournP99) {
+      os << sep << "p99=" << text::formatDuration<time::microseconds>(*linkStatus.sojournP99);
+    }
+    os << "}";
+  }
+
   os << ia("counters")
      << "{in={"
      << item.getNInInterests() << "i "
@@ -554,9 +685,58 @@ FaceModule::printFaceParams(std::ostream& os, text::ItemAttributes& ia, const Co
   if (resp.hasMtu()) {
     os << ia("mtu") << resp.getMtu();
   }
+  printLinkOptions(os, ia, resp.wireEncode());
   os << '\n';
 }
 
+void
+FaceModule::printLinkOptions(std::ostream& os, text::ItemAttributes& ia, const Block& wire)
+{
+  FaceLinkOptions limits(wire);
+  if (limits.wantPacking) {
+    os << ia("packing") << text::OnOff{*limits.wantPacking};
+  }
+  if (limits.sendQueueTarget) {
+    os << ia("send-queue-target") << text::formatDuration<time::microseconds>(*limits.sendQueueTarget);
+  }
+  if (limits.hasWeights()) {
+    os << ia("class-weights") << "{";
+    text::Separator sep("", " ");
+    if (limits.interestWeight) {
+      os << sep << "interest=" << *limits.interestWeight;
+    }
+    if (limits.dataWeight) {
+      os << sep << "data=" << *limits.dataWeight;
+    }
+    if (limits.nackWeight) {
+      os << sep << "nack=" << *limits.nackWeight;
+    }
+    os << "}";
+  }
+  if (limits.ingressWeight) {
+    os << ia("ingress-weight") << *limits.ingressWeight;
+  }
+  if (!limits.hasRateLimits()) {
+    return;
+  }
+
+  os << ia("rate-limits") << "{";
+  text::Separator sep("", " ");
+  if (limits.interestRate) {
+    os << sep << "interest=" << *limits.interestRate << "/s";
+    if (limits.interestBurst) {
+      os << " burst=" << *limits.interestBurst;
+    }
+  }
+  if (limits.dataRate) {
+    os << sep << "data=" << *limits.dataRate << "B/s";
+    if (limits.dataBurst) {
+      os << " burst=" << *limits.dataBurst << "B";
+    }
+  }
+  os << "}";
+}
+
 } // namespace nfdc
 } // namespace tools
 } // namespace nfd
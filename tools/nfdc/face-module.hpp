@@ -42,7 +42,8 @@ using ndn::nfd::FaceStatus;
 class FaceModule : public Module, noncopyable
 {
 public:
-  /** \brief register 'face list', 'face show', 'face create', 'face destroy' commands
+  /** \brief register 'face list', 'face show', 'face create', 'face update', 'face destroy'
+   *         commands
    */
   static void
   registerCommands(CommandParser& parser);
@@ -62,6 +63,11 @@ public:
   static void
   create(ExecuteContext& ctx);
 
+  /** \brief the 'face update' command
+   */
+  static void
+  update(ExecuteContext& ctx);
+
   /** \brief the 'face destroy' command
    */
   static void
@@ -110,6 +116,12 @@ public:
   static void
   printFaceParams(std::ostream& os, text::ItemAttributes& ia, const ControlParameters& resp);
 
+private:
+  /** \brief print the link options appended to \p wire, if any
+   */
+  static void
+  printLinkOptions(std::ostream& os, text::ItemAttributes& ia, const Block& wire);
+
 private:
   std::vector<FaceStatus> m_status;
 };
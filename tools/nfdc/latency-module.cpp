@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "latency-module.hpp"
+#include "format-helpers.hpp"
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+
+LatencyDataset::LatencyDataset()
+  : StatusDataset("status/latency")
+{
+}
+
+LatencyDataset::ResultType
+LatencyDataset::parseResult(ndn::ConstBufferPtr payload) const
+{
+  ResultType result;
+
+  size_t offset = 0;
+  while (offset < payload->size()) {
+    bool isOk = false;
+    Block block;
+    std::tie(isOk, block) = Block::fromBuffer(payload, offset);
+    if (!isOk) {
+      NDN_THROW(FaceLatencyStatus::Error("Cannot decode FaceLatency"));
+    }
+    offset += block.size();
+    result.emplace_back(block);
+  }
+
+  return result;
+}
+
+void
+LatencyModule::fetchStatus(Controller& controller,
+                           const std::function<void()>& onSuccess,
+                           const Controller::DatasetFailCallback& onFailure,
+                           const CommandOptions& options)
+{
+  controller.fetch<LatencyDataset>(
+    [this, onSuccess] (const std::vector<FaceLatencyStatus>& result) {
+      m_status = result;
+      onSuccess();
+    },
+    onFailure, options);
+}
+
+void
+LatencyModule::formatStatusXml(std::ostream& os) const
+{
+  os << "<latency>";
+  for (const FaceLatencyStatus& item : m_status) {
+    this->formatItemXml(os, item);
+  }
+  os << "</latency>";
+}
+
+void
+LatencyModule::formatItemXml(std::ostream& os, const FaceLatencyStatus& item) const
+{
+  os << "<faceLatency>";
+  os << "<faceId>" << item.faceId << "</faceId>";
+
+  os << "<stages>";
+  for (const auto& stage : item.stages) {
+    os << "<stage>"
+       << "<name>" << stage.stage << "</name>"
+       << "<nSamples>" << stage.nSamples << "</nSamples>"
+       << "<p50>" << time::duration_cast<time::microseconds>(stage.p50).count() << "</p50>"
+       << "<p90>" << time::duration_cast<time::microseconds>(stage.p90).count() << "</p90>"
+       << "<p99>" << time::duration_cast<time::microseconds>(stage.p99).count() << "</p99>"
+       << "</stage>";
+  }
+  os << "</stages>";
+
+  os << "</faceLatency>";
+}
+
+void
+LatencyModule::formatStatusText(std::ostream& os) const
+{
+  os << "Interest latency:\n";
+  for (const FaceLatencyStatus& item : m_status) {
+    this->formatItemText(os, item);
+  }
+}
+
+void
+LatencyModule::formatItemText(std::ostream& os, const FaceLatencyStatus& item) const
+{
+  os << "  faceid=" << item.faceId;
+
+  for (const auto& stage : item.stages) {
+    os << " " << stage.stage << "={"
+       << "samples=" << stage.nSamples
+       << " p50=" << text::formatDuration<time::microseconds>(stage.p50)
+       << " p90=" << text::formatDuration<time::microseconds>(stage.p90)
+       << " p99=" << text::formatDuration<time::microseconds>(stage.p99)
+       << "}";
+  }
+
+  os << "\n";
+}
+
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
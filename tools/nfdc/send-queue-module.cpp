@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2020,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "send-queue-module.hpp"
+#include "format-helpers.hpp"
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+
+SendQueueDataset::SendQueueDataset()
+  : StatusDataset("status/send-queue")
+{
+}
+
+SendQueueDataset::ResultType
+SendQueueDataset::parseResult(ndn::ConstBufferPtr payload) const
+{
+  ResultType result;
+
+  size_t offset = 0;
+  while (offset < payload->size()) {
+    bool isOk = false;
+    Block block;
+    std::tie(isOk, block) = Block::fromBuffer(payload, offset);
+    if (!isOk) {
+      NDN_THROW(FaceSendQueueStatus::Error("Cannot decode FaceSendQueue"));
+    }
+    offset += block.size();
+    result.emplace_back(block);
+  }
+
+  return result;
+}
+
+void
+SendQueueModule::fetchStatus(Controller& controller,
+                             const std::function<void()>& onSuccess,
+                             const Controller::DatasetFailCallback& onFailure,
+                             const CommandOptions& options)
+{
+  controller.fetch<SendQueueDataset>(
+    [this, onSuccess] (const std::vector<FaceSendQueueStatus>& result) {
+      m_status = result;
+      onSuccess();
+    },
+    onFailure, options);
+}
+
+void
+SendQueueModule::formatStatusXml(std::ostream& os) const
+{
+  os << "<sendQueues>";
+  for (const FaceSendQueueStatus& item : m_status) {
+    this->formatItemXml(os, item);
+  }
+  os << "</sendQueues>";
+}
+
+void
+SendQueueModule::formatItemXml(std::ostream& os, const FaceSendQueueStatus& item) const
+{
+  os << "<faceSendQueue>";
+  os << "<faceId>" << item.faceId << "</faceId>";
+
+  os << "<classes>";
+  for (const auto& cls : item.classes) {
+    os << "<class>"
+       << "<name>" << cls.txClass << "</name>"
+       << "<weight>" << cls.weight << "</weight>"
+       << "<queueLength>" << cls.queueLength << "</queueLength>"
+       << "<nDropped>" << cls.nDropped << "</nDropped>"
+       << "</class>";
+  }
+  os << "</classes>";
+
+  os << "</faceSendQueue>";
+}
+
+void
+SendQueueModule::formatStatusText(std::ostream& os) const
+{
+  os << "Send queues:\n";
+  for (const FaceSendQueueStatus& item : m_status) {
+    this->formatItemText(os, item);
+  }
+}
+
+void
+SendQueueModule::formatItemText(std::ostream& os, const FaceSendQueueStatus& item) const
+{
+  os << "  faceid=" << item.faceId;
+
+  for (const auto& cls : item.classes) {
+    os << " " << cls.txClass << "={"
+       << "weight=" << cls.weight
+       << " length=" << cls.queueLength
+       << " dropped=" << cls.nDropped
+       << "}";
+  }
+
+  os << "\n";
+}
+
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
@@ -31,6 +31,8 @@
 #include "rib-module.hpp"
 #include "cs-module.hpp"
 #include "strategy-choice-module.hpp"
+#include "latency-module.hpp"
+#include "send-queue-module.hpp"
 
 #include <ndn-cxx/security/validator-null.hpp>
 
@@ -71,6 +73,14 @@ reportStatus(ExecuteContext& ctx, const StatusReportOptions& options)
     report.sections.push_back(make_unique<StrategyChoiceModule>());
   }
 
+  if (options.wantLatency) {
+    report.sections.push_back(make_unique<LatencyModule>());
+  }
+
+  if (options.wantSendQueues) {
+    report.sections.push_back(make_unique<SendQueueModule>());
+  }
+
   uint32_t code = report.collect(ctx.face, ctx.keyChain,
                                  ndn::security::getAcceptAllValidator(),
                                  CommandOptions());
@@ -112,7 +122,8 @@ reportStatusComprehensive(ExecuteContext& ctx)
   StatusReportOptions options;
   options.output = ctx.args.get<ReportFormat>("format", ReportFormat::TEXT);
   options.wantForwarderGeneral = options.wantChannels = options.wantFaces = options.wantFib =
-    options.wantRib = options.wantCs = options.wantStrategyChoice = true;
+    options.wantRib = options.wantCs = options.wantStrategyChoice = options.wantLatency =
+    options.wantSendQueues = true;
   reportStatus(ctx, options);
 }
 
@@ -131,6 +142,16 @@ registerStatusCommands(CommandParser& parser)
   parser.addCommand(defStatusShow, bind(&reportStatusSingleSection, _1, &StatusReportOptions::wantForwarderGeneral));
   parser.addAlias("status", "show", "");
 
+  CommandDefinition defStatusLatency("status", "latency");
+  defStatusLatency
+    .setTitle("print latency of sampled Interests");
+  parser.addCommand(defStatusLatency, bind(&reportStatusSingleSection, _1, &StatusReportOptions::wantLatency));
+
+  CommandDefinition defStatusSendQueue("status", "send-queue");
+  defStatusSendQueue
+    .setTitle("print send queues of traffic classes");
+  parser.addCommand(defStatusSendQueue, bind(&reportStatusSingleSection, _1, &StatusReportOptions::wantSendQueues));
+
   CommandDefinition defChannelList("channel", "list");
   defChannelList
     .setTitle("print channel list");
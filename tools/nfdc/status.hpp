@@ -43,6 +43,8 @@ struct StatusReportOptions
   bool wantRib = false;
   bool wantCs = false;
   bool wantStrategyChoice = false;
+  bool wantLatency = false;
+  bool wantSendQueues = false;
 };
 
 /** \brief collect a status report and write to stdout
@@ -55,6 +57,8 @@ reportStatus(ExecuteContext& ctx, const StatusReportOptions& options);
  *  Providing the following commands:
  *  \li status report
  *  \li status show
+ *  \li status latency
+ *  \li status send-queue
  *  \li channel list
  *  \li strategy list
  *  \li fib list